@@ -92,6 +92,10 @@ struct perf_sparse<
 #ifdef __HIP_PLATFORM_AMD__
         (std::is_same<Ti, To>{} && (std::is_same<Ti, __half>{} || std::is_same<Ti, hip_bfloat16>{})
          && std::is_same<Tc, float>{})
+        || ((std::is_same<Ti, __half>{} || std::is_same<Ti, hip_bfloat16>{})
+            && (std::is_same<To, int8_t>{} || std::is_same<To, hipsparselt_f8>{}
+                || std::is_same<To, hipsparselt_bf8>{})
+            && std::is_same<Tc, float>{})
 #else
         (std::is_same<Ti, To>{}
          && ((std::is_same<Ti, __half>{} && std::is_same<Tc, __half>{})
@@ -418,11 +422,11 @@ try
 
         ("activation_type",
          value<std::string>(&activation_type)->default_value("none"),
-         "Options: None, clippedrelu, gelu, relu")
+         "Options: None, clippedrelu, gelu, relu, silu, hardswish")
 
         ("activation_arg1",
          value<float>(&arg.activation_arg1)->default_value(std::numeric_limits<float>::quiet_NaN()),
-         "activation argument #1, when activation_type is clippedrelu, this argument used to be the threshold(default=0). when type is gelu, this argument used to be the gelu scaling. (default=1)")
+         "activation argument #1, when activation_type is clippedrelu, this argument used to be the threshold(default=0). when type is gelu, this argument used to be the gelu scaling. when type is silu, this argument used to be the beta. (default=1)")
 
         ("activation_arg2",
          value<float>(&arg.activation_arg2)->default_value(std::numeric_limits<float>::infinity()),
@@ -500,6 +504,62 @@ try
          bool_switch(&arg.alpha_vector_scaling)->default_value(false),
          "Apply alpha vector scaling")
 
+        ("beta_vector_scaling",
+         bool_switch(&arg.beta_vector_scaling)->default_value(false),
+         "Apply beta vector scaling")
+
+        ("scale_ab",
+         bool_switch(&arg.scale_ab)->default_value(false),
+         "Set the per-tensor scales of A and B")
+
+        ("pointer_array_batch",
+         bool_switch(&arg.pointer_array_batch)->default_value(false),
+         "Pass the dense matrix, C and D as arrays of batch pointers")
+
+        ("gated_epilogue",
+         bool_switch(&arg.gated_epilogue)->default_value(false),
+         "Combine pairs of outputs along the structured matrix into act(gate) * up")
+
+        ("d_scale_vector",
+         bool_switch(&arg.d_scale_vector)->default_value(false),
+         "Scale the rows of D by a vector of M scales before it is rounded")
+
+        ("d_rounding_mode",
+         value<int>(&arg.d_rounding_mode)->default_value(0),
+         "Rounding of an 8 bit D: 0 = nearest even, 1 = stochastic")
+
+        ("d_amax",
+         bool_switch(&arg.d_amax)->default_value(false),
+         "Write the absolute maximum of each row of D")
+
+        ("residual",
+         bool_switch(&arg.residual)->default_value(false),
+         "Add a residual matrix with the layout of C to D after the activation")
+
+        ("bias_gradient",
+         bool_switch(&arg.bias_gradient)->default_value(false),
+         "Write the sums of the rows or columns of D for the bias gradient")
+
+        ("bias_gradient_mode",
+         value<int>(&arg.bias_gradient_mode)->default_value(0),
+         "Sums of the bias gradient: 0 = each row of D, 1 = each column of D")
+
+        ("streams",
+         value<int32_t>(&arg.matmul_streams)->default_value(1),
+         "Number of streams hipsparseLtMatmul spreads the problem over")
+
+        ("host_backend",
+         bool_switch(&arg.host_backend)->default_value(false),
+         "Run on the host backend of the handle (rocSPARSELt only). Buffers use managed memory")
+
+        ("split_k",
+         value<int32_t>(&arg.split_k)->default_value(0),
+         "Split-K factor of the alg selection, 0 = chosen by the library")
+
+        ("split_k_mode",
+         value<int32_t>(&arg.split_k_mode)->default_value(1),
+         "Reduction of a split K: 0 = one kernel, 1 = two kernels")
+
         ("help,h", "produces this help message")
 
         ("version", "Prints the version number");
@@ -599,7 +659,8 @@ try
         throw std::invalid_argument("Invalid value for --activation_type " + activation_type);
     if(std::isnan(arg.activation_arg1))
     {
-        if(arg.activation_type == hipsparselt_activation_type::gelu)
+        if(arg.activation_type == hipsparselt_activation_type::gelu
+           || arg.activation_type == hipsparselt_activation_type::silu)
             arg.activation_arg1 = 1.f;
         else
             arg.activation_arg1 = 0.f;
@@ -0,0 +1,205 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * Host-only microbenchmark of the per-launch kernel argument packing of the
+ * HIP kernel launcher. It compares building a KernelArguments from scratch,
+ * as the launcher did for every launch, with refilling a PackedKernelArguments
+ * buffer whose layout was computed once. No GPU is needed.
+ *
+ * Usage: hipsparselt-kernel-args-bench [iterations]
+ *******************************************************************************/
+
+#include "kernel_arguments.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+    // Pointer/scalar values which change on every launch
+    struct LaunchValues
+    {
+        const void*          d;
+        const void*          c;
+        const void*          a;
+        const void*          b;
+        const unsigned char* metadata;
+        float                alpha;
+        float                beta;
+    };
+
+    // Same argument sequence as the HIP kernel launcher uses for a sparse GEMM
+    template <typename Args>
+    void appendArguments(Args& args, const LaunchValues& v)
+    {
+        args.template append<uint64_t>("tensor2dSizeC", 1024 * 1024);
+        args.template append<uint64_t>("tensor2dSizeA", 1024 * 512);
+        args.template append<uint64_t>("tensor2dSizeB", 1024 * 1024);
+
+        args.template append<const void*>("d", v.d);
+        args.template append<const void*>("c", v.c);
+        args.template append<const void*>("a", v.a);
+        args.template append<const void*>("b", v.b);
+        args.template append<unsigned char const*>("metadata", v.metadata);
+
+        args.template append<float>("alpha", v.alpha);
+        args.template append<float>("beta", v.beta);
+
+        for(size_t i = 1; i < 3; i++)
+            args.template append<uint32_t>("strideD" + std::to_string(i), 1024);
+        for(size_t i = 1; i < 3; i++)
+            args.template append<uint32_t>("strideC" + std::to_string(i), 1024);
+        for(size_t i = 1; i < 3; i++)
+            args.template append<uint32_t>("strideA" + std::to_string(i), 512);
+        for(size_t i = 1; i < 3; i++)
+            args.template append<uint32_t>("strideB" + std::to_string(i), 1024);
+        for(size_t i = 0; i < 4; i++)
+            args.template append<uint32_t>("size_" + std::to_string(i), 1024);
+
+        args.template append<int32_t>("staggerUIter", 31);
+        args.template append<uint32_t>("problemNumGroupTiles0", 4);
+        args.template append<uint32_t>("problemNumGroupTiles1", 4);
+        args.template append<uint32_t>("numFullBlocks", 4);
+        args.template append<uint32_t>("wgmRemainder1", 8);
+        args.template append<uint32_t>("magicNumberWgmRemainder1", 268435457);
+        args.template append<uint32_t>("offsetD", 0);
+        args.template append<uint32_t>("offsetC", 0);
+        args.template append<uint32_t>("offsetA", 0);
+        args.template append<uint32_t>("offsetB", 0);
+        args.template append<uint32_t>("pad", 0);
+    }
+
+    struct LayoutBuilder
+    {
+        KernelArgumentsLayout& layout;
+        PackedKernelArguments& args;
+
+        template <typename T>
+        void append(std::string const& name, T value)
+        {
+            size_t offset = layout.append<T>(name);
+            args.resize(layout.size());
+            args.write(offset, value);
+        }
+    };
+
+    LaunchValues values(size_t i)
+    {
+        auto base = reinterpret_cast<const char*>(0x7f0000000000) + i * 256;
+        return {base,
+                base + 64,
+                base + 128,
+                base + 192,
+                reinterpret_cast<const unsigned char*>(base + 224),
+                1.0f,
+                static_cast<float>(i & 1)};
+    }
+
+    template <typename F>
+    double nsPerLaunch(size_t iterations, F&& launch)
+    {
+        uint64_t checksum = 0;
+        auto     start    = std::chrono::steady_clock::now();
+        for(size_t i = 0; i < iterations; i++)
+            checksum += launch(values(i));
+        auto stop = std::chrono::steady_clock::now();
+
+        // Keep the packed buffers observable so the loop is not optimized away
+        volatile uint64_t sink = checksum;
+        (void)sink;
+
+        return std::chrono::duration<double, std::nano>(stop - start).count() / iterations;
+    }
+
+    uint64_t firstWord(void const* data)
+    {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        return word;
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    if(!iterations)
+    {
+        std::cerr << "Usage: " << argv[0] << " [iterations]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    double logged = nsPerLaunch(iterations, [](const LaunchValues& v) {
+        KernelArguments args(true);
+        args.reserve(1024, 128);
+        appendArguments(args, v);
+        return firstWord(args.data()) + args.size();
+    });
+
+    double unlogged = nsPerLaunch(iterations, [](const LaunchValues& v) {
+        KernelArguments args(false);
+        args.reserve(1024, 128);
+        appendArguments(args, v);
+        return firstWord(args.data()) + args.size();
+    });
+
+    // The layout and the constant arguments are computed once, like in a plan
+    KernelArgumentsLayout layout;
+    PackedKernelArguments packed;
+    LayoutBuilder         builder{layout, packed};
+    appendArguments(builder, values(0));
+
+    size_t offset_d        = layout.offset("d");
+    size_t offset_c        = layout.offset("c");
+    size_t offset_a        = layout.offset("a");
+    size_t offset_b        = layout.offset("b");
+    size_t offset_metadata = layout.offset("metadata");
+    size_t offset_alpha    = layout.offset("alpha");
+    size_t offset_beta     = layout.offset("beta");
+
+    double fixed = nsPerLaunch(iterations, [&](const LaunchValues& v) {
+        PackedKernelArguments args(packed);
+        args.write(offset_d, v.d);
+        args.write(offset_c, v.c);
+        args.write(offset_a, v.a);
+        args.write(offset_b, v.b);
+        args.write(offset_metadata, v.metadata);
+        args.write(offset_alpha, v.alpha);
+        args.write(offset_beta, v.beta);
+        return firstWord(args.data()) + args.size();
+    });
+
+    std::cout << "kernel argument bytes: " << layout.size() << ", iterations: " << iterations
+              << std::endl;
+    std::cout << "KernelArguments (log=true)  : " << logged << " ns/launch" << std::endl;
+    std::cout << "KernelArguments (log=false) : " << unlogged << " ns/launch" << std::endl;
+    std::cout << "PackedKernelArguments       : " << fixed << " ns/launch" << std::endl;
+
+    return EXIT_SUCCESS;
+}
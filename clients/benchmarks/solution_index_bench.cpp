@@ -0,0 +1,177 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+/*******************************************************************************
+ * Host-only harness of the nearest tuned size lookup of solution_index.hpp,
+ * over the sizes of the Tensile logic files. No GPU is needed.
+ *
+ * Hit quality is measured leaving one size out at a time: every tuned size is
+ * looked up with its own entries removed, and counts as a hit when the vote of
+ * its neighbors puts the solution tuned for it first (top-1) or among the
+ * first three (top-3). The lookups are checked against a linear scan, and
+ * their latency is timed at sizes off the table.
+ *
+ * Usage: hipsparselt-solution-index-bench [neighbors] [iterations]
+ *******************************************************************************/
+
+#include "solution_index.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <tuple>
+
+namespace
+{
+    using TypeKey = std::tuple<std::string, int32_t, int32_t, bool, bool, int32_t>;
+    using SizeKey = std::tuple<int64_t, int64_t, int64_t, int64_t>;
+
+    struct Group
+    {
+        std::vector<const RocsparseltTunedSize*> sizes;
+        std::map<SizeKey, size_t>                entries; // per size
+        std::unique_ptr<RocsparseltSizeIndex>    index;
+    };
+
+    double distance(const RocsparseltTunedSize& a, int64_t m, int64_t n, int64_t batch, int64_t k)
+    {
+        int64_t x[] = {a.m, a.n, a.batch, a.k};
+        int64_t y[] = {m, n, batch, k};
+        double  sum = 0;
+        for(int i = 0; i < 4; i++)
+        {
+            double d = std::log2(double(std::max<int64_t>(x[i], 1)))
+                       - std::log2(double(std::max<int64_t>(y[i], 1)));
+            sum += d * d;
+        }
+        return std::sqrt(sum);
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t neighbors  = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4;
+    size_t iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100;
+    if(!neighbors || !iterations)
+    {
+        std::cerr << "Usage: " << argv[0] << " [neighbors] [iterations]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::map<TypeKey, Group> groups;
+    for(size_t i = 0; i < rocsparselt_tuned_sizes_count; i++)
+    {
+        auto& size  = rocsparselt_tuned_sizes[i];
+        auto& group = groups[TypeKey{
+            size.arch, size.type_ab, size.type_cd, size.trans_a, size.trans_b, size.sparse}];
+        group.sizes.push_back(&size);
+        group.entries[SizeKey{size.m, size.n, size.batch, size.k}]++;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for(auto& group : groups)
+        group.second.index = std::make_unique<RocsparseltSizeIndex>(group.second.sizes);
+    auto stop = std::chrono::steady_clock::now();
+
+    size_t lookups = 0, top1 = 0, top3 = 0, nearest1 = 0, mismatches = 0;
+    for(auto& group : groups)
+    {
+        auto& index = *group.second.index;
+        for(auto size : group.second.sizes)
+        {
+            // Drop the entries of the size itself, they are all at distance 0
+            size_t same = group.second.entries[SizeKey{size->m, size->n, size->batch, size->k}];
+            auto   near = index.nearest(size->m, size->n, size->batch, size->k, neighbors + same);
+            if(near.size() <= same)
+                continue;
+            near.erase(near.begin(), near.begin() + same);
+
+            // The farthest neighbor found must be as near as the same rank of a linear scan
+            std::vector<double> scan;
+            for(auto other : group.second.sizes)
+                scan.push_back(distance(*other, size->m, size->n, size->batch, size->k));
+            std::sort(scan.begin(), scan.end());
+            if(std::abs(scan[same + near.size() - 1] - near.back().distance) > 1e-9)
+                mismatches++;
+
+            auto votes = RocsparseltSizeIndex::vote(near);
+            for(size_t rank = 0; rank < votes.size() && rank < 3; rank++)
+                if(strcmp(votes[rank].solution, size->solution) == 0)
+                {
+                    top1 += rank == 0;
+                    top3++;
+                }
+            nearest1 += strcmp(near.front().size->solution, size->solution) == 0;
+            lookups++;
+        }
+    }
+
+    // Latency at sizes between the tuned ones
+    std::vector<std::pair<const RocsparseltSizeIndex*, const RocsparseltTunedSize*>> queries;
+    for(auto& group : groups)
+        for(auto size : group.second.sizes)
+            queries.emplace_back(group.second.index.get(), size);
+
+    double checksum = 0;
+    auto   begin    = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < iterations; i++)
+        for(auto& query : queries)
+        {
+            auto& size  = *query.second;
+            auto  votes = RocsparseltSizeIndex::vote(query.first->nearest(
+                size.m * 3 / 2 + 1, size.n * 3 / 2 + 1, size.batch, size.k * 3 / 2 + 1, neighbors));
+            checksum += votes.empty() ? 0 : votes.front().weight;
+        }
+    auto end = std::chrono::steady_clock::now();
+
+    // Keep the votes observable so the loop is not optimized away
+    volatile double sink = checksum;
+    (void)sink;
+
+    auto percent = [&](size_t hits) { return lookups ? 100.0 * hits / lookups : 0.0; };
+    std::cout << "tuned sizes: " << rocsparselt_tuned_sizes_count
+              << ", problem types: " << groups.size() << ", neighbors: " << neighbors
+              << std::endl;
+    std::cout << "index build              : "
+              << std::chrono::duration<double, std::micro>(stop - start).count() << " us"
+              << std::endl;
+    std::cout << "lookup (nearest + vote)  : "
+              << std::chrono::duration<double, std::nano>(end - begin).count()
+                     / (iterations * queries.size())
+              << " ns" << std::endl;
+    std::cout << "leave-one-out top-1 hits : " << percent(top1) << " %" << std::endl;
+    std::cout << "leave-one-out top-3 hits : " << percent(top3) << " %" << std::endl;
+    std::cout << "nearest size alone       : " << percent(nearest1) << " %" << std::endl;
+    std::cout << "linear scan mismatches   : " << mismatches << std::endl;
+
+    return mismatches ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -73,6 +73,7 @@ void cblas_gemm<hip_bfloat16, hip_bfloat16, float>(hipsparseOrder_t     order,
                                                    int64_t              ldc,
                                                    int64_t              sizeC,
                                                    float*               alphaVec,
+                                                   float*               betaVec,
                                                    bool                 alt)
 {
     // cblas does not support hip_bfloat16, so convert to higher precision float
@@ -87,7 +88,7 @@ void cblas_gemm<hip_bfloat16, hip_bfloat16, float>(hipsparseOrder_t     order,
     for(size_t i = 0; i < sizeC; i++)
         C_float[i] = static_cast<float>(C[i]);
 
-    if(alphaVec != nullptr)
+    if(alphaVec != nullptr || betaVec != nullptr)
     {
         host_vector<float> T_float(sizeC);
         memset(T_float, 0, sizeC);
@@ -107,10 +108,12 @@ void cblas_gemm<hip_bfloat16, hip_bfloat16, float>(hipsparseOrder_t     order,
                     ldc);
         for(int i = 0; i < m; i++)
         {
+            float alpha_i = alphaVec != nullptr ? alphaVec[i] : alpha;
+            float beta_i  = betaVec != nullptr ? betaVec[i] : beta;
             for(int j = 0; j < n; j++)
             {
                 size_t pos   = order == HIPSPARSE_ORDER_COL ? j * ldc + i : i * ldc + j;
-                C_float[pos] = T_float[pos] * alphaVec[i] + C_float[pos] * beta;
+                C_float[pos] = T_float[pos] * alpha_i + C_float[pos] * beta_i;
             }
         }
     }
@@ -157,6 +160,7 @@ void cblas_gemm<hip_bfloat16, float, float>(hipsparseOrder_t     order,
                                             int64_t              ldc,
                                             int64_t              sizeC,
                                             float*               alphaVec,
+                                            float*               betaVec,
                                             bool                 alt)
 {
     // cblas does not support hip_bfloat16, so convert to higher precision float
@@ -169,7 +173,7 @@ void cblas_gemm<hip_bfloat16, float, float>(hipsparseOrder_t     order,
     for(size_t i = 0; i < sizeB; i++)
         B_float[i] = static_cast<float>(B[i]);
 
-    if(alphaVec != nullptr)
+    if(alphaVec != nullptr || betaVec != nullptr)
     {
         host_vector<float> T_float(sizeC);
         memset(T_float, 0, sizeC);
@@ -189,10 +193,12 @@ void cblas_gemm<hip_bfloat16, float, float>(hipsparseOrder_t     order,
                     ldc);
         for(int i = 0; i < m; i++)
         {
+            float alpha_i = alphaVec != nullptr ? alphaVec[i] : alpha;
+            float beta_i  = betaVec != nullptr ? betaVec[i] : beta;
             for(int j = 0; j < n; j++)
             {
                 size_t pos = order == HIPSPARSE_ORDER_COL ? j * ldc + i : i * ldc + j;
-                C[pos]     = T_float[pos] * alphaVec[i] + C[pos] * beta;
+                C[pos]     = T_float[pos] * alpha_i + C[pos] * beta_i;
             }
         }
     }
@@ -236,6 +242,7 @@ void cblas_gemm<__half, __half, float>(hipsparseOrder_t     order,
                                        int64_t              ldc,
                                        int64_t              sizeC,
                                        float*               alphaVec,
+                                       float*               betaVec,
                                        bool                 alt)
 {
     // cblas does not support __half, so convert to higher precision float
@@ -262,7 +269,7 @@ void cblas_gemm<__half, __half, float>(hipsparseOrder_t     order,
             C_float[i] = C[i];
     }
 
-    if(alphaVec != nullptr)
+    if(alphaVec != nullptr || betaVec != nullptr)
     {
         host_vector<float> T_float(sizeC);
         memset(T_float, 0, sizeC);
@@ -282,10 +289,12 @@ void cblas_gemm<__half, __half, float>(hipsparseOrder_t     order,
                     ldc);
         for(int i = 0; i < m; i++)
         {
+            float alpha_i = alphaVec != nullptr ? alphaVec[i] : alpha;
+            float beta_i  = betaVec != nullptr ? betaVec[i] : beta;
             for(int j = 0; j < n; j++)
             {
                 size_t pos   = order == HIPSPARSE_ORDER_COL ? j * ldc + i : i * ldc + j;
-                C_float[pos] = T_float[pos] * alphaVec[i] + C_float[pos] * beta;
+                C_float[pos] = T_float[pos] * alpha_i + C_float[pos] * beta_i;
             }
         }
     }
@@ -332,6 +341,7 @@ void cblas_gemm<__half, float, float>(hipsparseOrder_t     order,
                                       int64_t              ldc,
                                       int64_t              sizeC,
                                       float*               alphaVec,
+                                      float*               betaVec,
                                       bool                 alt)
 {
     // cblas does not support __half, so convert to higher precision float
@@ -354,7 +364,7 @@ void cblas_gemm<__half, float, float>(hipsparseOrder_t     order,
             B_float[i] = B[i];
     }
 
-    if(alphaVec != nullptr)
+    if(alphaVec != nullptr || betaVec != nullptr)
     {
         host_vector<float> T_float(sizeC);
         memset(T_float, 0, sizeC);
@@ -374,10 +384,12 @@ void cblas_gemm<__half, float, float>(hipsparseOrder_t     order,
                     ldc);
         for(int i = 0; i < m; i++)
         {
+            float alpha_i = alphaVec != nullptr ? alphaVec[i] : alpha;
+            float beta_i  = betaVec != nullptr ? betaVec[i] : beta;
             for(int j = 0; j < n; j++)
             {
                 size_t pos = order == HIPSPARSE_ORDER_COL ? j * ldc + i : i * ldc + j;
-                C[pos]     = T_float[pos] * alphaVec[i] + C[pos] * beta;
+                C[pos]     = T_float[pos] * alpha_i + C[pos] * beta_i;
             }
         }
     }
@@ -422,6 +434,7 @@ void cblas_gemm<int8_t, int8_t, float>(hipsparseOrder_t     order,
                                        int64_t              ldc,
                                        int64_t              sizeC,
                                        float*               alphaVec,
+                                       float*               betaVec,
                                        bool                 alt)
 {
     // cblas does not support int8_t input / int8_t output, however non-overflowing
@@ -441,7 +454,7 @@ void cblas_gemm<int8_t, int8_t, float>(hipsparseOrder_t     order,
     for(size_t i = 0; i < sizeC; i++)
         C_double[i] = static_cast<double>(C[i]);
 
-    if(alphaVec != nullptr)
+    if(alphaVec != nullptr || betaVec != nullptr)
     {
         host_vector<double> T_double(sizeC);
         memset(T_double, 0, sizeC);
@@ -461,11 +474,12 @@ void cblas_gemm<int8_t, int8_t, float>(hipsparseOrder_t     order,
                     ldc);
         for(int i = 0; i < m; i++)
         {
+            double alpha_i = alphaVec != nullptr ? alphaVec[i] : alpha;
+            double beta_i  = betaVec != nullptr ? betaVec[i] : beta;
             for(int j = 0; j < n; j++)
             {
                 size_t pos    = order == HIPSPARSE_ORDER_COL ? j * ldc + i : i * ldc + j;
-                C_double[pos] = T_double[pos] * static_cast<double>(alphaVec[i])
-                                + C_double[pos] * static_cast<double>(beta);
+                C_double[pos] = T_double[pos] * alpha_i + C_double[pos] * beta_i;
             }
         }
     }
@@ -517,6 +531,7 @@ void cblas_gemm<int8_t, float, float>(hipsparseOrder_t     order,
                                       int64_t              ldc,
                                       int64_t              sizeC,
                                       float*               alphaVec,
+                                      float*               betaVec,
                                       bool                 alt)
 {
     // cblas does not support int8_t input / int8_t output, however non-overflowing
@@ -536,7 +551,7 @@ void cblas_gemm<int8_t, float, float>(hipsparseOrder_t     order,
     for(size_t i = 0; i < sizeC; i++)
         C_double[i] = static_cast<double>(C[i]);
 
-    if(alphaVec != nullptr)
+    if(alphaVec != nullptr || betaVec != nullptr)
     {
         host_vector<double> T_double(sizeC);
         memset(T_double, 0, sizeC);
@@ -556,11 +571,12 @@ void cblas_gemm<int8_t, float, float>(hipsparseOrder_t     order,
                     ldc);
         for(int i = 0; i < m; i++)
         {
+            double alpha_i = alphaVec != nullptr ? alphaVec[i] : alpha;
+            double beta_i  = betaVec != nullptr ? betaVec[i] : beta;
             for(int j = 0; j < n; j++)
             {
                 size_t pos    = order == HIPSPARSE_ORDER_COL ? j * ldc + i : i * ldc + j;
-                C_double[pos] = T_double[pos] * static_cast<double>(alphaVec[i])
-                                + C_double[pos] * static_cast<double>(beta);
+                C_double[pos] = T_double[pos] * alpha_i + C_double[pos] * beta_i;
             }
         }
     }
@@ -606,6 +622,7 @@ void cblas_gemm<int8_t, __half, float>(hipsparseOrder_t     order,
                                        int64_t              ldc,
                                        int64_t              sizeC,
                                        float*               alphaVec,
+                                       float*               betaVec,
                                        bool                 alt)
 {
     // cblas does not support int8_t input / int8_t output, however non-overflowing
@@ -625,7 +642,7 @@ void cblas_gemm<int8_t, __half, float>(hipsparseOrder_t     order,
     for(size_t i = 0; i < sizeC; i++)
         C_double[i] = static_cast<double>(C[i]);
 
-    if(alphaVec != nullptr)
+    if(alphaVec != nullptr || betaVec != nullptr)
     {
         host_vector<double> T_double(sizeC);
         memset(T_double, 0, sizeC);
@@ -645,11 +662,12 @@ void cblas_gemm<int8_t, __half, float>(hipsparseOrder_t     order,
                     ldc);
         for(int i = 0; i < m; i++)
         {
+            double alpha_i = alphaVec != nullptr ? alphaVec[i] : alpha;
+            double beta_i  = betaVec != nullptr ? betaVec[i] : beta;
             for(int j = 0; j < n; j++)
             {
                 size_t pos    = order == HIPSPARSE_ORDER_COL ? j * ldc + i : i * ldc + j;
-                C_double[pos] = T_double[pos] * static_cast<double>(alphaVec[i])
-                                + C_double[pos] * static_cast<double>(beta);
+                C_double[pos] = T_double[pos] * alpha_i + C_double[pos] * beta_i;
             }
         }
     }
@@ -695,6 +713,7 @@ void cblas_gemm<int8_t, hip_bfloat16, float>(hipsparseOrder_t     order,
                                              int64_t              ldc,
                                              int64_t              sizeC,
                                              float*               alphaVec,
+                                             float*               betaVec,
                                              bool                 alt)
 {
     // cblas does not support int8_t input / int8_t output, however non-overflowing
@@ -714,7 +733,7 @@ void cblas_gemm<int8_t, hip_bfloat16, float>(hipsparseOrder_t     order,
     for(size_t i = 0; i < sizeC; i++)
         C_double[i] = static_cast<double>(C[i]);
 
-    if(alphaVec != nullptr)
+    if(alphaVec != nullptr || betaVec != nullptr)
     {
         host_vector<double> T_double(sizeC);
         memset(T_double, 0, sizeC);
@@ -734,11 +753,12 @@ void cblas_gemm<int8_t, hip_bfloat16, float>(hipsparseOrder_t     order,
                     ldc);
         for(int i = 0; i < m; i++)
         {
+            double alpha_i = alphaVec != nullptr ? alphaVec[i] : alpha;
+            double beta_i  = betaVec != nullptr ? betaVec[i] : beta;
             for(int j = 0; j < n; j++)
             {
                 size_t pos    = order == HIPSPARSE_ORDER_COL ? j * ldc + i : i * ldc + j;
-                C_double[pos] = T_double[pos] * static_cast<double>(alphaVec[i])
-                                + C_double[pos] * static_cast<double>(beta);
+                C_double[pos] = T_double[pos] * alpha_i + C_double[pos] * beta_i;
             }
         }
     }
@@ -764,3 +784,344 @@ void cblas_gemm<int8_t, hip_bfloat16, float>(hipsparseOrder_t     order,
     for(size_t i = 0; i < sizeC; i++)
         C[i] = static_cast<hip_bfloat16>(C_double[i]);
 }
+
+// cblas does not support the 8 bit floats, so convert to float. Every 8 bit float is exact in
+// float, and the result is rounded once to To
+template <typename Ti, typename To>
+static void cblas_gemm_f8(hipsparseOrder_t     order,
+                          hipsparseOperation_t transA,
+                          hipsparseOperation_t transB,
+                          int64_t              m,
+                          int64_t              n,
+                          int64_t              k,
+                          float                alpha,
+                          const Ti*            A,
+                          int64_t              lda,
+                          int64_t              sizeA,
+                          const Ti*            B,
+                          int64_t              ldb,
+                          int64_t              sizeB,
+                          float                beta,
+                          To*                  C,
+                          int64_t              ldc,
+                          int64_t              sizeC,
+                          float*               alphaVec,
+                          float*               betaVec)
+{
+    host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
+
+    for(size_t i = 0; i < sizeA; i++)
+        A_float[i] = static_cast<float>(A[i]);
+    for(size_t i = 0; i < sizeB; i++)
+        B_float[i] = static_cast<float>(B[i]);
+    for(size_t i = 0; i < sizeC; i++)
+        C_float[i] = static_cast<float>(C[i]);
+
+    if(alphaVec != nullptr || betaVec != nullptr)
+    {
+        host_vector<float> T_float(sizeC);
+        memset(T_float, 0, sizeC);
+        cblas_sgemm(HIPOrderToCBLASOrder(order),
+                    HIPOperationToCBLASTanspose(transA),
+                    HIPOperationToCBLASTanspose(transB),
+                    m,
+                    n,
+                    k,
+                    static_cast<float>(1),
+                    A_float,
+                    lda,
+                    B_float,
+                    ldb,
+                    static_cast<float>(0),
+                    T_float,
+                    ldc);
+        for(int i = 0; i < m; i++)
+        {
+            float alpha_i = alphaVec != nullptr ? alphaVec[i] : alpha;
+            float beta_i  = betaVec != nullptr ? betaVec[i] : beta;
+            for(int j = 0; j < n; j++)
+            {
+                size_t pos   = order == HIPSPARSE_ORDER_COL ? j * ldc + i : i * ldc + j;
+                C_float[pos] = T_float[pos] * alpha_i + C_float[pos] * beta_i;
+            }
+        }
+    }
+    else
+    {
+        cblas_sgemm(HIPOrderToCBLASOrder(order),
+                    HIPOperationToCBLASTanspose(transA),
+                    HIPOperationToCBLASTanspose(transB),
+                    m,
+                    n,
+                    k,
+                    alpha,
+                    A_float,
+                    lda,
+                    B_float,
+                    ldb,
+                    beta,
+                    C_float,
+                    ldc);
+    }
+
+    for(size_t i = 0; i < sizeC; i++)
+        C[i] = static_cast<To>(C_float[i]);
+}
+
+template <>
+void cblas_gemm<hipsparselt_f8, __half, float>(hipsparseOrder_t      order,
+                                               hipsparseOperation_t  transA,
+                                               hipsparseOperation_t  transB,
+                                               int64_t               m,
+                                               int64_t               n,
+                                               int64_t               k,
+                                               float                 alpha,
+                                               const hipsparselt_f8* A,
+                                               int64_t               lda,
+                                               int64_t               sizeA,
+                                               const hipsparselt_f8* B,
+                                               int64_t               ldb,
+                                               int64_t               sizeB,
+                                               float                 beta,
+                                               __half*               C,
+                                               int64_t               ldc,
+                                               int64_t               sizeC,
+                                               float*                alphaVec,
+                                               float*                betaVec,
+                                               bool                  alt)
+{
+    cblas_gemm_f8(order,
+                  transA,
+                  transB,
+                  m,
+                  n,
+                  k,
+                  alpha,
+                  A,
+                  lda,
+                  sizeA,
+                  B,
+                  ldb,
+                  sizeB,
+                  beta,
+                  C,
+                  ldc,
+                  sizeC,
+                  alphaVec,
+                  betaVec);
+}
+
+template <>
+void cblas_gemm<hipsparselt_f8, hip_bfloat16, float>(hipsparseOrder_t      order,
+                                                     hipsparseOperation_t  transA,
+                                                     hipsparseOperation_t  transB,
+                                                     int64_t               m,
+                                                     int64_t               n,
+                                                     int64_t               k,
+                                                     float                 alpha,
+                                                     const hipsparselt_f8* A,
+                                                     int64_t               lda,
+                                                     int64_t               sizeA,
+                                                     const hipsparselt_f8* B,
+                                                     int64_t               ldb,
+                                                     int64_t               sizeB,
+                                                     float                 beta,
+                                                     hip_bfloat16*         C,
+                                                     int64_t               ldc,
+                                                     int64_t               sizeC,
+                                                     float*                alphaVec,
+                                                     float*                betaVec,
+                                                     bool                  alt)
+{
+    cblas_gemm_f8(order,
+                  transA,
+                  transB,
+                  m,
+                  n,
+                  k,
+                  alpha,
+                  A,
+                  lda,
+                  sizeA,
+                  B,
+                  ldb,
+                  sizeB,
+                  beta,
+                  C,
+                  ldc,
+                  sizeC,
+                  alphaVec,
+                  betaVec);
+}
+
+template <>
+void cblas_gemm<hipsparselt_f8, float, float>(hipsparseOrder_t      order,
+                                              hipsparseOperation_t  transA,
+                                              hipsparseOperation_t  transB,
+                                              int64_t               m,
+                                              int64_t               n,
+                                              int64_t               k,
+                                              float                 alpha,
+                                              const hipsparselt_f8* A,
+                                              int64_t               lda,
+                                              int64_t               sizeA,
+                                              const hipsparselt_f8* B,
+                                              int64_t               ldb,
+                                              int64_t               sizeB,
+                                              float                 beta,
+                                              float*                C,
+                                              int64_t               ldc,
+                                              int64_t               sizeC,
+                                              float*                alphaVec,
+                                              float*                betaVec,
+                                              bool                  alt)
+{
+    cblas_gemm_f8(order,
+                  transA,
+                  transB,
+                  m,
+                  n,
+                  k,
+                  alpha,
+                  A,
+                  lda,
+                  sizeA,
+                  B,
+                  ldb,
+                  sizeB,
+                  beta,
+                  C,
+                  ldc,
+                  sizeC,
+                  alphaVec,
+                  betaVec);
+}
+
+template <>
+void cblas_gemm<hipsparselt_bf8, __half, float>(hipsparseOrder_t       order,
+                                                hipsparseOperation_t   transA,
+                                                hipsparseOperation_t   transB,
+                                                int64_t                m,
+                                                int64_t                n,
+                                                int64_t                k,
+                                                float                  alpha,
+                                                const hipsparselt_bf8* A,
+                                                int64_t                lda,
+                                                int64_t                sizeA,
+                                                const hipsparselt_bf8* B,
+                                                int64_t                ldb,
+                                                int64_t                sizeB,
+                                                float                  beta,
+                                                __half*                C,
+                                                int64_t                ldc,
+                                                int64_t                sizeC,
+                                                float*                 alphaVec,
+                                                float*                 betaVec,
+                                                bool                   alt)
+{
+    cblas_gemm_f8(order,
+                  transA,
+                  transB,
+                  m,
+                  n,
+                  k,
+                  alpha,
+                  A,
+                  lda,
+                  sizeA,
+                  B,
+                  ldb,
+                  sizeB,
+                  beta,
+                  C,
+                  ldc,
+                  sizeC,
+                  alphaVec,
+                  betaVec);
+}
+
+template <>
+void cblas_gemm<hipsparselt_bf8, hip_bfloat16, float>(hipsparseOrder_t       order,
+                                                      hipsparseOperation_t   transA,
+                                                      hipsparseOperation_t   transB,
+                                                      int64_t                m,
+                                                      int64_t                n,
+                                                      int64_t                k,
+                                                      float                  alpha,
+                                                      const hipsparselt_bf8* A,
+                                                      int64_t                lda,
+                                                      int64_t                sizeA,
+                                                      const hipsparselt_bf8* B,
+                                                      int64_t                ldb,
+                                                      int64_t                sizeB,
+                                                      float                  beta,
+                                                      hip_bfloat16*          C,
+                                                      int64_t                ldc,
+                                                      int64_t                sizeC,
+                                                      float*                 alphaVec,
+                                                      float*                 betaVec,
+                                                      bool                   alt)
+{
+    cblas_gemm_f8(order,
+                  transA,
+                  transB,
+                  m,
+                  n,
+                  k,
+                  alpha,
+                  A,
+                  lda,
+                  sizeA,
+                  B,
+                  ldb,
+                  sizeB,
+                  beta,
+                  C,
+                  ldc,
+                  sizeC,
+                  alphaVec,
+                  betaVec);
+}
+
+template <>
+void cblas_gemm<hipsparselt_bf8, float, float>(hipsparseOrder_t       order,
+                                               hipsparseOperation_t   transA,
+                                               hipsparseOperation_t   transB,
+                                               int64_t                m,
+                                               int64_t                n,
+                                               int64_t                k,
+                                               float                  alpha,
+                                               const hipsparselt_bf8* A,
+                                               int64_t                lda,
+                                               int64_t                sizeA,
+                                               const hipsparselt_bf8* B,
+                                               int64_t                ldb,
+                                               int64_t                sizeB,
+                                               float                  beta,
+                                               float*                 C,
+                                               int64_t                ldc,
+                                               int64_t                sizeC,
+                                               float*                 alphaVec,
+                                               float*                 betaVec,
+                                               bool                   alt)
+{
+    cblas_gemm_f8(order,
+                  transA,
+                  transB,
+                  m,
+                  n,
+                  k,
+                  alpha,
+                  A,
+                  lda,
+                  sizeA,
+                  B,
+                  ldb,
+                  sizeB,
+                  beta,
+                  C,
+                  ldc,
+                  sizeC,
+                  alphaVec,
+                  betaVec);
+}
@@ -103,6 +103,14 @@ void Arguments::init()
     HMM             = false;
     search          = false;
     search_iters    = 10;
+    matmul_streams  = 1;
+    host_backend    = false;
+    split_k         = 0;
+    split_k_mode    = 1;
+    group_count     = 1;
+    weight_bits     = 0;
+    weight_group    = 0;
+    weight_zero     = false;
 }
 
 // Function to print Arguments out to stream in YAML format
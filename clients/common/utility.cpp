@@ -235,6 +235,13 @@ hipsparselt_local_handle::hipsparselt_local_handle(const Arguments& arg)
             throw std::bad_alloc();
     }
 
+    if(arg.host_backend)
+    {
+        auto status = hipsparseLtSetBackend(&m_handle, HIPSPARSELT_BACKEND_HOST);
+        if(status != HIPSPARSE_STATUS_SUCCESS)
+            throw std::runtime_error(hipsparse_status_to_string(status));
+    }
+
     // memory guard control, with multi-threading should not change values across threads
     d_vector_set_pad_length(arg.pad);
 }
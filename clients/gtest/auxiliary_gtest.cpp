@@ -56,7 +56,8 @@ namespace
         Tc,
         TBias,
         std::enable_if_t<std::is_same<Ti, __half>{} || std::is_same<Ti, hip_bfloat16>{}
-                         || std::is_same<Ti, int8_t>{}>> : hipsparselt_test_valid
+                         || std::is_same<Ti, int8_t>{} || std::is_same<Ti, hipsparselt_f8>{}
+                         || std::is_same<Ti, hipsparselt_bf8>{}>> : hipsparselt_test_valid
     {
         void operator()(const Arguments& arg)
         {
@@ -66,10 +67,14 @@ namespace
                 testing_aux_handle_destroy_bad_arg(arg);
             else if(!strcmp(arg.function, "aux_handle"))
                 testing_aux_handle(arg);
+            else if(!strcmp(arg.function, "aux_handle_backend"))
+                testing_aux_handle_backend(arg);
             else if(!strcmp(arg.function, "aux_mat_init_dense_bad_arg"))
                 testing_aux_mat_init_dense_bad_arg(arg);
             else if(!strcmp(arg.function, "aux_mat_init_structured_bad_arg"))
                 testing_aux_mat_init_structured_bad_arg(arg);
+            else if(!strcmp(arg.function, "aux_mat_init_type_bad_arg"))
+                testing_aux_mat_init_type_bad_arg(arg);
             else if(!strcmp(arg.function, "aux_mat_dense_init_arg"))
                 testing_aux_mat_dense_init(arg);
             else if(!strcmp(arg.function, "aux_mat_structured_init"))
@@ -116,6 +121,8 @@ namespace
                 testing_aux_get_workspace_size_bad_arg(arg);
             else if(!strcmp(arg.function, "aux_get_workspace_size"))
                 testing_aux_get_workspace_size(arg);
+            else if(!strcmp(arg.function, "aux_float8_conversion"))
+                testing_aux_float8_conversion(arg);
             else
                 FAIL() << "Internal error: Test called with unknown function: " << arg.function;
         }
@@ -132,11 +139,18 @@ namespace
         // Filter for which functions apply to this suite
         static bool function_filter(const Arguments& arg)
         {
+#ifndef __HIP_PLATFORM_AMD__
+            // cuSPARSELt has structured F32 and no I4
+            if(!strcmp(arg.function, "aux_mat_init_type_bad_arg"))
+                return false;
+#endif
             return !strcmp(arg.function, "aux_handle_init_bad_arg")
                    || !strcmp(arg.function, "aux_handle_destroy_bad_arg")
                    || !strcmp(arg.function, "aux_handle")
+                   || !strcmp(arg.function, "aux_handle_backend")
                    || !strcmp(arg.function, "aux_mat_init_dense_bad_arg")
                    || !strcmp(arg.function, "aux_mat_init_structured_bad_arg")
+                   || !strcmp(arg.function, "aux_mat_init_type_bad_arg")
                    || !strcmp(arg.function, "aux_mat_dense_init_arg")
                    || !strcmp(arg.function, "aux_mat_structured_init")
                    || !strcmp(arg.function, "aux_mat_assign")
@@ -159,7 +173,8 @@ namespace
                    || !strcmp(arg.function, "aux_matmul_plan_init_bad_arg")
                    || !strcmp(arg.function, "aux_matmul_plan_init")
                    || !strcmp(arg.function, "aux_get_workspace_size_bad_arg")
-                   || !strcmp(arg.function, "aux_get_workspace_size");
+                   || !strcmp(arg.function, "aux_get_workspace_size")
+                   || !strcmp(arg.function, "aux_float8_conversion");
         }
 
         // Google Test name suffix based on parameters
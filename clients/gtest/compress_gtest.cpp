@@ -56,7 +56,8 @@ namespace
         Tc,
         TBias,
         std::enable_if_t<std::is_same<Ti, __half>{} || std::is_same<Ti, hip_bfloat16>{}
-                         || std::is_same<Ti, int8_t>{}>> : hipsparselt_test_valid
+                         || std::is_same<Ti, int8_t>{} || std::is_same<Ti, hipsparselt_f8>{}
+                         || std::is_same<Ti, hipsparselt_bf8>{}>> : hipsparselt_test_valid
     {
         void operator()(const Arguments& arg)
         {
@@ -68,6 +69,10 @@ namespace
                 testing_compress<Ti, To, Tc, hipsparselt_batch_type::strided_batched>(arg);
             else if(!strcmp(arg.function, "compress_bad_arg"))
                 testing_compress_bad_arg<Ti, To, Tc>(arg);
+            else if(!strcmp(arg.function, "compress_stream"))
+                testing_compress_stream<Ti, To, Tc>(arg);
+            else if(!strcmp(arg.function, "compress_stream_strided_batched"))
+                testing_compress_stream<Ti, To, Tc, hipsparselt_batch_type::strided_batched>(arg);
             else
                 FAIL() << "Internal error: Test called with unknown function: " << arg.function;
         }
@@ -84,9 +89,17 @@ namespace
         // Filter for which functions apply to this suite
         static bool function_filter(const Arguments& arg)
         {
+#ifndef __HIP_PLATFORM_AMD__
+            // the host backend and streamed compression are only supported by the rocSPARSELt
+            // backend
+            if(arg.host_backend || strstr(arg.function, "compress_stream") != nullptr)
+                return false;
+#endif
             return !strcmp(arg.function, "compress") || !strcmp(arg.function, "compress_batched")
                    || !strcmp(arg.function, "compress_strided_batched")
-                   || !strcmp(arg.function, "compress_bad_arg");
+                   || !strcmp(arg.function, "compress_bad_arg")
+                   || !strcmp(arg.function, "compress_stream")
+                   || !strcmp(arg.function, "compress_stream_strided_batched");
         }
 
         // Google Test name suffix based on parameters
@@ -119,6 +132,9 @@ namespace
 
                 if(arg.func_version > 1)
                     name << "_v" << arg.func_version;
+
+                if(arg.host_backend)
+                    name << "_host";
             }
             return std::move(name);
         }
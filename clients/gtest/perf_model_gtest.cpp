@@ -0,0 +1,243 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Host-only tests of the cost model of perf_model.hpp, checked against the
+// [solutionIndex, gflops] entries the Tensile logic files record for their
+// tuned sizes.
+
+#include "perf_model.hpp"
+#include "solution_index.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <gtest/gtest.h>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+    // Highest mean rank of the recorded winners among the candidates of a logic file, as
+    // the fraction of the other candidates ranked before it
+    constexpr double MAX_WINNER_RANK = 0.35;
+
+    // The GFLOPS are recorded to three decimals, so below 1 they are mostly rounding.
+    // Sizes recorded faster than MIN_RECORDED_US are bound by launch and fixed latency,
+    // which the model holds constant, so the tuning picked among near ties. Logic files
+    // with fewer sizes left, such as the small sizes of structured B, are not checked.
+    constexpr double MIN_RECORDED_GFLOPS = 1;
+    constexpr double MIN_RECORDED_US     = 100;
+    constexpr size_t MIN_SIZES           = 8;
+
+    // Tensile::DataType of the logic files
+    constexpr int32_t TENSILE_FLOAT = 0;
+    constexpr int32_t TENSILE_INT8  = 8;
+
+    int32_t tensile_type_bytes(int32_t type)
+    {
+        return type == TENSILE_FLOAT ? 4 : type == TENSILE_INT8 ? 1 : 2;
+    }
+
+    int64_t ceil_div(int64_t a, int64_t b)
+    {
+        return (a + b - 1) / b;
+    }
+
+    // The tiling of a solution, from the MT, MI, MIWT and GSU fields of its name. The work
+    // group holds MT / (MI * MIWT) waves of 64 threads in each dimension; names leave out
+    // WG when all solutions of a file share it.
+    bool kernel_of(const char* solution, RocsparseltModelKernel& kernel)
+    {
+        const char* mt   = strstr(solution, "_MT");
+        const char* mi   = strstr(solution, "_MI");
+        const char* miwt = strstr(solution, "_MIWT");
+        const char* gsu  = strstr(solution, "_GSU");
+        int64_t     mi0 = 0, mi1 = 0, miwt0 = 0, miwt1 = 0;
+        if(!mt || !mi || !miwt || !gsu
+           || sscanf(mt,
+                     "_MT%ldx%ldx%ld",
+                     &kernel.macro_tile_m,
+                     &kernel.macro_tile_n,
+                     &kernel.depth_u)
+                  != 3
+           || sscanf(mi, "_MI%ldx%ld", &mi0, &mi1) != 2
+           || sscanf(miwt, "_MIWT%ld_%ld", &miwt0, &miwt1) != 2
+           || sscanf(gsu, "_GSU%ld", &kernel.global_split_u) != 1 || mi0 * miwt0 <= 0
+           || mi1 * miwt1 <= 0)
+            return false;
+        kernel.workgroup_size = static_cast<int32_t>(kernel.macro_tile_m / (mi0 * miwt0)
+                                                     * (kernel.macro_tile_n / (mi1 * miwt1)) * 64);
+        return true;
+    }
+
+    using Tiling = std::tuple<int64_t, int64_t, int64_t, int64_t, int32_t>;
+
+    Tiling tiling_of(const RocsparseltModelKernel& kernel)
+    {
+        return Tiling{kernel.macro_tile_m,
+                      kernel.macro_tile_n,
+                      kernel.depth_u,
+                      kernel.global_split_u,
+                      kernel.workgroup_size};
+    }
+
+    /***************************************************************************
+     * The MI300 devices the logic files are tuned on, by the numbers          *
+     * hipDeviceProp_t reports for an MI300X                                   *
+     ***************************************************************************/
+    RocsparseltModelDevice mi300_device(const char* arch)
+    {
+        return rocsparselt_model_device(arch, 304, 65536, 2048, 2100000, 1300000, 8192);
+    }
+
+    // Rank of candidate w by cost, as the fraction of the other candidates that cost less;
+    // a tie counts half, so a cost that ties everything ranks 0.5
+    double rank_of(const std::vector<double>& costs, size_t w)
+    {
+        double before = 0;
+        for(size_t i = 0; i < costs.size(); i++)
+            if(i != w)
+                before += costs[i] < costs[w] ? 1 : costs[i] == costs[w] ? 0.5 : 0;
+        return before / (costs.size() - 1);
+    }
+}
+
+TEST(PerfModel, AgreementOfSameOrder)
+{
+    auto agreement = rocsparselt_model_agreement({1, 2, 3, 4}, {10, 40, 90, 160});
+    EXPECT_DOUBLE_EQ(agreement.spearman, 1.0);
+    EXPECT_DOUBLE_EQ(agreement.kendall, 1.0);
+    EXPECT_DOUBLE_EQ(agreement.regret, 0.0);
+}
+
+TEST(PerfModel, AgreementOfReversedOrder)
+{
+    auto agreement = rocsparselt_model_agreement({1, 2, 3, 4}, {4, 3, 2, 1});
+    EXPECT_DOUBLE_EQ(agreement.spearman, -1.0);
+    EXPECT_DOUBLE_EQ(agreement.kendall, -1.0);
+    // The first predicted measured 4, the fastest 1
+    EXPECT_DOUBLE_EQ(agreement.regret, 3.0);
+}
+
+/*******************************************************************************
+ * At each tuned size of a logic file, the model ranks the tilings of all the   *
+ * solutions the file records, and the tiling of the recorded winner must come  *
+ * early. Solutions that differ in what the model does not see share a tiling.  *
+ * The model must also beat two baselines: the FLOP count, which is the same    *
+ * for every candidate and so ranks the winner 0.5, and the FLOP count padded   *
+ * to whole tiles in M, N and K.                                               *
+ ******************************************************************************/
+TEST(PerfModel, RanksRecordedWinners)
+{
+    using Key = std::tuple<std::string, int32_t, int32_t, bool, bool, int32_t>;
+    std::map<Key, std::vector<const RocsparseltTunedSize*>> files;
+    for(size_t i = 0; i < rocsparselt_tuned_sizes_count; i++)
+    {
+        auto& size = rocsparselt_tuned_sizes[i];
+        files[Key{size.arch, size.type_ab, size.type_cd, size.trans_a, size.trans_b, size.sparse}]
+            .push_back(&size);
+    }
+    ASSERT_FALSE(files.empty());
+
+    size_t checked = 0;
+    for(auto& file : files)
+    {
+        std::set<Tiling> tilings;
+        for(auto size : file.second)
+        {
+            RocsparseltModelKernel kernel;
+            ASSERT_TRUE(kernel_of(size->solution, kernel)) << size->solution;
+            tilings.insert(tiling_of(kernel));
+        }
+        std::vector<RocsparseltModelKernel> candidates;
+        for(auto& t : tilings)
+            candidates.push_back(RocsparseltModelKernel{std::get<0>(t),
+                                                        std::get<1>(t),
+                                                        std::get<2>(t),
+                                                        std::get<3>(t),
+                                                        std::get<4>(t)});
+        if(candidates.size() < 2)
+            continue;
+
+        double model_rank = 0, padded_rank = 0;
+        size_t sizes      = 0;
+        for(auto size : file.second)
+        {
+            if(size->gflops < MIN_RECORDED_GFLOPS
+               || 2.0 * size->m * size->n * size->k * size->batch / (size->gflops * 1e3)
+                      < MIN_RECORDED_US)
+                continue;
+
+            RocsparseltModelKernel winner;
+            kernel_of(size->solution, winner);
+            size_t w = std::distance(tilings.begin(), tilings.find(tiling_of(winner)));
+
+            RocsparseltModelProblem problem{size->m,
+                                            size->n,
+                                            size->k,
+                                            size->batch,
+                                            tensile_type_bytes(size->type_ab),
+                                            tensile_type_bytes(size->type_ab),
+                                            tensile_type_bytes(size->type_cd),
+                                            4,
+                                            size->sparse == 1,
+                                            size->type_ab == TENSILE_INT8};
+            auto device = mi300_device(size->arch);
+
+            std::vector<double> model, padded;
+            for(auto& kernel : candidates)
+            {
+                model.push_back(rocsparselt_model_time_us(problem, kernel, device));
+                int64_t k_split = ceil_div(size->k, kernel.global_split_u);
+                padded.push_back(double(ceil_div(size->m, kernel.macro_tile_m))
+                                 * kernel.macro_tile_m * ceil_div(size->n, kernel.macro_tile_n)
+                                 * kernel.macro_tile_n * ceil_div(k_split, kernel.depth_u)
+                                 * kernel.depth_u * kernel.global_split_u);
+            }
+            model_rank += rank_of(model, w);
+            padded_rank += rank_of(padded, w);
+            sizes++;
+        }
+        if(sizes < MIN_SIZES)
+            continue;
+        checked++;
+
+        model_rank /= sizes;
+        padded_rank /= sizes;
+        std::ostringstream name;
+        name << std::get<0>(file.first) << " types " << std::get<1>(file.first) << ", "
+             << std::get<2>(file.first) << " trans " << std::get<3>(file.first)
+             << std::get<4>(file.first) << " sparse " << std::get<5>(file.first) << ": "
+             << sizes << " sizes, " << candidates.size() << " tilings";
+        EXPECT_LE(model_rank, MAX_WINNER_RANK) << name.str();
+        EXPECT_LT(model_rank, padded_rank) << name.str();
+    }
+    EXPECT_GT(checked, 0u);
+}
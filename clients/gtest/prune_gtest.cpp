@@ -56,7 +56,8 @@ namespace
         Tc,
         TBias,
         std::enable_if_t<std::is_same<Ti, __half>{} || std::is_same<Ti, hip_bfloat16>{}
-                         || std::is_same<Ti, int8_t>{}>> : hipsparselt_test_valid
+                         || std::is_same<Ti, int8_t>{} || std::is_same<Ti, hipsparselt_f8>{}
+                         || std::is_same<Ti, hipsparselt_bf8>{}>> : hipsparselt_test_valid
     {
         void operator()(const Arguments& arg)
         {
@@ -84,6 +85,11 @@ namespace
         // Filter for which functions apply to this suite
         static bool function_filter(const Arguments& arg)
         {
+#ifndef __HIP_PLATFORM_AMD__
+            // the host backend is only supported by the rocSPARSELt backend
+            if(arg.host_backend)
+                return false;
+#endif
             return !strcmp(arg.function, "prune") || !strcmp(arg.function, "prune_batched")
                    || !strcmp(arg.function, "prune_strided_batched")
                    || !strcmp(arg.function, "prune_bad_arg");
@@ -132,6 +138,9 @@ namespace
 
                 if(arg.func_version > 1)
                     name << "_v" << arg.func_version;
+
+                if(arg.host_backend)
+                    name << "_host";
             }
             return std::move(name);
         }
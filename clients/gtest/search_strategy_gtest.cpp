@@ -0,0 +1,238 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022-2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Host-only tests of the search strategies of rocsparselt_matmul_search(),
+// driven by a synthetic timer instead of kernel runs.
+
+#include "search_strategy.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace
+{
+    // 1.96 * sqrt(pi / 2) * 1.4826, the factor of the MAD in the half width of the
+    // 95% interval of the median
+    constexpr float MAD_TO_HALF_WIDTH = 1.96f * 1.2533f * 1.4826f;
+
+    /***************************************************************************
+     * Deterministic timer: candidate c takes times[c] ms, scaled by a repeating *
+     * +-1% jitter so that the intervals have a nonzero width. Every run is     *
+     * counted, warm-ups included.                                              *
+     ***************************************************************************/
+    class FakeSampler
+    {
+    public:
+        explicit FakeSampler(std::vector<float> times)
+            : m_times(std::move(times))
+        {
+        }
+
+        RocsparseltSearchSampler sampler()
+        {
+            return [this](int candidate, float& ms) {
+                static const float jitter[] = {1.f, 1.01f, 0.99f};
+                ms = m_times[candidate] * jitter[m_runs[candidate]++ % 3];
+                m_spent_ms += ms;
+                return rocsparselt_status_success;
+            };
+        }
+
+        int runs(int candidate) const
+        {
+            auto it = m_runs.find(candidate);
+            return it == m_runs.end() ? 0 : it->second;
+        }
+
+        float spent_ms() const
+        {
+            return m_spent_ms;
+        }
+
+    private:
+        std::vector<float> m_times;
+        std::map<int, int> m_runs;
+        float              m_spent_ms = 0.f;
+    };
+
+    std::vector<int> all_candidates(const std::vector<float>& times)
+    {
+        std::vector<int> candidates;
+        for(int i = 0; i < (int)times.size(); i++)
+            candidates.push_back(i);
+        return candidates;
+    }
+
+    int search(rocsparselt_search_strategy strategy,
+               FakeSampler&                timer,
+               const std::vector<int>&     candidates,
+               float                       budget_ms = 0.f)
+    {
+        RocsparseltSearchOptions options;
+        options.strategy  = strategy;
+        options.budget_ms = budget_ms;
+
+        int best = -1;
+        EXPECT_EQ(rocsparselt_make_search_strategy(options)->run(
+                      candidates, timer.sampler(), best),
+                  rocsparselt_status_success);
+        return best;
+    }
+
+    const std::vector<float> shuffled_times = {1.7f, 1.3f, 2.9f, 1.05f, 1.1f, 2.2f, 1.5f, 3.4f};
+    constexpr int            fastest        = 3;
+}
+
+TEST(SearchStrategy, ExhaustivePicksMinimum)
+{
+    FakeSampler timer(shuffled_times);
+    EXPECT_EQ(search(rocsparselt_search_strategy::exhaustive, timer, all_candidates(shuffled_times)),
+              fastest);
+}
+
+TEST(SearchStrategy, HalvingPicksMinimum)
+{
+    FakeSampler timer(shuffled_times);
+    EXPECT_EQ(search(rocsparselt_search_strategy::halving, timer, all_candidates(shuffled_times)),
+              fastest);
+}
+
+TEST(SearchStrategy, RacingPicksMinimum)
+{
+    FakeSampler timer(shuffled_times);
+    EXPECT_EQ(search(rocsparselt_search_strategy::racing, timer, all_candidates(shuffled_times)),
+              fastest);
+}
+
+TEST(SearchStrategy, RacingDropsLosersEarly)
+{
+    // 0 and 1 overlap and race to the iteration limit, 2 is clearly slower and
+    // leaves after the first round of 3 timed samples
+    std::vector<float> times = {1.f, 1.001f, 10.f};
+    FakeSampler        timer(times);
+    EXPECT_EQ(search(rocsparselt_search_strategy::racing, timer, all_candidates(times)), 0);
+
+    RocsparseltSearchOptions options;
+    EXPECT_EQ(timer.runs(0), 1 + options.iterations);
+    EXPECT_EQ(timer.runs(1), 1 + options.iterations);
+    EXPECT_EQ(timer.runs(2), 1 + 3);
+}
+
+TEST(SearchStrategy, HalvingSamplesLessThanExhaustive)
+{
+    FakeSampler exhaustive(shuffled_times), halving(shuffled_times);
+    search(rocsparselt_search_strategy::exhaustive, exhaustive, all_candidates(shuffled_times));
+    search(rocsparselt_search_strategy::halving, halving, all_candidates(shuffled_times));
+    EXPECT_LT(halving.spent_ms(), exhaustive.spent_ms());
+
+    // the slowest candidate does not make it past the first round
+    EXPECT_EQ(halving.runs(7), 1 + 3);
+}
+
+TEST(SearchStrategy, BudgetStopsSampling)
+{
+    // all candidates but the last take 1 ms; the budget runs out long before
+    // the fastest one is reached
+    std::vector<float> times(8, 1.f);
+    times.back()    = 0.5f;
+    float budget_ms = 6.f;
+
+    for(auto strategy : {rocsparselt_search_strategy::exhaustive,
+                         rocsparselt_search_strategy::halving,
+                         rocsparselt_search_strategy::racing})
+    {
+        FakeSampler timer(times);
+        int         best = search(strategy, timer, all_candidates(times), budget_ms);
+
+        // no sample starts once the budget is spent, so it is overrun by at
+        // most one sample
+        EXPECT_GE(timer.spent_ms(), budget_ms);
+        EXPECT_LT(timer.spent_ms(), budget_ms + 1.02f);
+        EXPECT_EQ(timer.runs(7), 0);
+        EXPECT_GT(timer.runs(best), 1);
+    }
+}
+
+TEST(SearchStrategy, SamplerErrorIsReturned)
+{
+    RocsparseltSearchOptions options;
+    for(auto strategy : {rocsparselt_search_strategy::exhaustive,
+                         rocsparselt_search_strategy::halving,
+                         rocsparselt_search_strategy::racing})
+    {
+        options.strategy = strategy;
+        int  runs        = 0;
+        auto failing     = [&](int candidate, float& ms) {
+            ms = 1.f;
+            return ++runs == 5 ? rocsparselt_status_internal_error : rocsparselt_status_success;
+        };
+
+        int best = -1;
+        EXPECT_EQ(rocsparselt_make_search_strategy(options)->run({0, 1, 2}, failing, best),
+                  rocsparselt_status_internal_error);
+        EXPECT_EQ(runs, 5);
+    }
+}
+
+TEST(SampleStats, FewSamplesHaveInfiniteInterval)
+{
+    constexpr float inf = std::numeric_limits<float>::infinity();
+
+    auto one = rocsparselt_sample_stats({2.f});
+    EXPECT_EQ(one.median, 2.f);
+    EXPECT_EQ(one.lower, -inf);
+    EXPECT_EQ(one.upper, inf);
+
+    auto two = rocsparselt_sample_stats({3.f, 1.f});
+    EXPECT_EQ(two.median, 2.f);
+    EXPECT_EQ(two.lower, -inf);
+    EXPECT_EQ(two.upper, inf);
+}
+
+TEST(SampleStats, MedianAndMad)
+{
+    // odd count: the outlier moves neither the median (3) nor the MAD (1)
+    auto  odd      = rocsparselt_sample_stats({4.f, 100.f, 1.f, 3.f, 2.f});
+    float odd_half = MAD_TO_HALF_WIDTH * 1.f / std::sqrt(5.f);
+    EXPECT_FLOAT_EQ(odd.median, 3.f);
+    EXPECT_FLOAT_EQ(odd.lower, 3.f - odd_half);
+    EXPECT_FLOAT_EQ(odd.upper, 3.f + odd_half);
+
+    // even count: median 2.5, deviations {1.5, 0.5, 0.5, 1.5} give a MAD of 1
+    auto  even      = rocsparselt_sample_stats({1.f, 4.f, 2.f, 3.f});
+    float even_half = MAD_TO_HALF_WIDTH * 1.f / std::sqrt(4.f);
+    EXPECT_FLOAT_EQ(even.median, 2.5f);
+    EXPECT_FLOAT_EQ(even.lower, 2.5f - even_half);
+    EXPECT_FLOAT_EQ(even.upper, 2.5f + even_half);
+
+    // identical samples: zero width
+    auto flat = rocsparselt_sample_stats({1.5f, 1.5f, 1.5f});
+    EXPECT_EQ(flat.lower, 1.5f);
+    EXPECT_EQ(flat.upper, 1.5f);
+}
@@ -56,7 +56,8 @@ namespace
         Tc,
         TBias,
         std::enable_if_t<std::is_same<Ti, __half>{} || std::is_same<Ti, hip_bfloat16>{}
-                         || std::is_same<Ti, int8_t>{}>> : hipsparselt_test_valid
+                         || std::is_same<Ti, int8_t>{} || std::is_same<Ti, hipsparselt_f8>{}
+                         || std::is_same<Ti, hipsparselt_bf8>{}>> : hipsparselt_test_valid
     {
         void operator()(const Arguments& arg)
         {
@@ -66,10 +67,28 @@ namespace
                 testing_spmm<Ti, To, Tc, TBias, hipsparselt_batch_type::batched>(arg);
             else if(!strcmp(arg.function, "spmm_strided_batched"))
                 testing_spmm<Ti, To, Tc, TBias, hipsparselt_batch_type::strided_batched>(arg);
+            else if(!strcmp(arg.function, "spmm_grouped"))
+            {
+                if constexpr(!quantized_output<Ti, To>)
+                    testing_spmm_grouped<Ti, To, Tc, TBias>(arg);
+            }
+            else if(!strcmp(arg.function, "spmm_weight_only"))
+            {
+                if constexpr(std::is_same<Ti, To>{} && sizeof(Ti) == 2 && std::is_same<Tc, float>{})
+                    testing_spmm_weight_only<Ti, To, Tc>(arg);
+            }
+            else if(!strcmp(arg.function, "spmm_dynamic_m"))
+            {
+                if constexpr(!quantized_output<Ti, To>)
+                    testing_spmm_dynamic_m<Ti, To, Tc>(arg);
+            }
             else if(!strcmp(arg.function, "spmm_bad_arg"))
                 testing_spmm_bad_arg<Ti, To, Tc>(arg);
             else if(!strcmp(arg.function, "aux_plan_assign"))
-                testing_aux_plan_assign<Ti, To, Tc>(arg);
+            {
+                if constexpr(!quantized_output<Ti, To>)
+                    testing_aux_plan_assign<Ti, To, Tc>(arg);
+            }
             else
                 FAIL() << "Internal error: Test called with unknown function: " << arg.function;
         }
@@ -86,8 +105,20 @@ namespace
         // Filter for which functions apply to this suite
         static bool function_filter(const Arguments& arg)
         {
+#ifndef __HIP_PLATFORM_AMD__
+            // pointer-array batches, gated epilogues, the scales of A, B and D, residuals and
+            // bias gradients, weight-only quantization, dynamic M and the host backend are only
+            // supported by the rocSPARSELt backend
+            if(arg.pointer_array_batch || arg.gated_epilogue || arg.scale_ab || arg.d_scale_vector
+               || arg.d_rounding_mode || arg.d_amax || arg.residual || arg.bias_gradient
+               || arg.weight_bits || arg.host_backend || !strcmp(arg.function, "spmm_dynamic_m"))
+                return false;
+#endif
             return !strcmp(arg.function, "spmm") || !strcmp(arg.function, "spmm_batched")
                    || !strcmp(arg.function, "spmm_strided_batched")
+                   || !strcmp(arg.function, "spmm_grouped")
+                   || !strcmp(arg.function, "spmm_weight_only")
+                   || !strcmp(arg.function, "spmm_dynamic_m")
                    || !strcmp(arg.function, "spmm_bad_arg")
                    || !strcmp(arg.function, "aux_plan_assign");
         }
@@ -116,6 +147,7 @@ namespace
                         break;
                     case hipsparselt_activation_type::leakyrelu:
                     case hipsparselt_activation_type::gelu:
+                    case hipsparselt_activation_type::silu:
                         name << '_' << arg.activation_arg1;
                         break;
                     default:
@@ -134,6 +166,75 @@ namespace
                     name << "_avs";
                 }
 
+                if(arg.beta_vector_scaling)
+                {
+                    name << "_bvs";
+                }
+
+                if(arg.scale_ab)
+                {
+                    name << "_scaleab";
+                }
+
+                if(arg.pointer_array_batch)
+                {
+                    name << "_ptr_array";
+                }
+
+                if(arg.gated_epilogue)
+                {
+                    name << "_gated";
+                }
+
+                if(arg.d_scale_vector)
+                {
+                    name << "_dscale";
+                }
+
+                if(arg.d_rounding_mode == HIPSPARSELT_ROUNDING_STOCHASTIC)
+                {
+                    name << "_sr";
+                }
+
+                if(arg.d_amax)
+                {
+                    name << "_amax";
+                }
+
+                if(arg.residual)
+                {
+                    name << "_residual";
+                }
+
+                if(arg.bias_gradient)
+                {
+                    name << (arg.bias_gradient_mode == HIPSPARSELT_BIAS_GRADIENT_COLUMNS
+                                 ? "_dbias_cols"
+                                 : "_dbias");
+                }
+
+                if(arg.weight_bits)
+                {
+                    name << "_w" << arg.weight_bits << "_g" << arg.weight_group;
+                    if(arg.weight_zero)
+                        name << "_zero";
+                }
+
+                if(arg.matmul_streams > 1)
+                {
+                    name << "_streams" << arg.matmul_streams;
+                }
+
+                if(arg.split_k)
+                {
+                    name << "_splitk" << arg.split_k << '_' << arg.split_k_mode;
+                }
+
+                if(arg.host_backend)
+                {
+                    name << "_host";
+                }
+
                 name << '_' << (char)std::toupper(arg.transA) << (char)std::toupper(arg.transB);
 
                 name << '_' << arg.M << '_' << arg.N << '_' << arg.K << '_' << arg.alpha << '_'
@@ -148,6 +249,9 @@ namespace
 
                 if(strstr(arg.function, "_strided_batched") != nullptr)
                     name << '_' << arg.stride_a << '_' << arg.stride_b << '_' << arg.stride_c;
+
+                if(!strcmp(arg.function, "spmm_grouped"))
+                    name << "_groups" << arg.group_count;
             }
 
             return std::move(name);
@@ -0,0 +1,188 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022-2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Host-only tests of the stream planners of rocsparselt_matmul() and
+// rocsparselt_matmul_grouped().
+
+#include "stream_partition.hpp"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace
+{
+    // Partitions must be contiguous, in order, and cover the whole problem
+    void expect_covers(const std::vector<RocsparseltStreamPartition>& parts,
+                       int64_t                                        batch_count,
+                       int64_t                                        extent,
+                       bool                                           by_batch)
+    {
+        ASSERT_FALSE(parts.empty());
+        int64_t next = 0;
+        for(auto& p : parts)
+        {
+            if(by_batch)
+            {
+                EXPECT_EQ(p.batch_begin, next);
+                EXPECT_EQ(p.begin, 0);
+                EXPECT_EQ(p.count, extent);
+                next += p.batch_count;
+            }
+            else
+            {
+                EXPECT_EQ(p.batch_begin, 0);
+                EXPECT_EQ(p.batch_count, 1);
+                EXPECT_EQ(p.begin, next);
+                next += p.count;
+            }
+        }
+        EXPECT_EQ(next, by_batch ? batch_count : extent);
+    }
+}
+
+TEST(StreamPartition, BalancedBatchSplit)
+{
+    auto parts = rocsparselt_plan_stream_partitions(10, 500, 128, 4);
+    ASSERT_EQ(parts.size(), 4u);
+    expect_covers(parts, 10, 500, true);
+
+    const int64_t sizes[] = {3, 3, 2, 2};
+    for(size_t i = 0; i < parts.size(); i++)
+        EXPECT_EQ(parts[i].batch_count, sizes[i]);
+}
+
+TEST(StreamPartition, MoreStreamsThanBatches)
+{
+    auto parts = rocsparselt_plan_stream_partitions(3, 500, 128, 8);
+    ASSERT_EQ(parts.size(), 3u);
+    expect_covers(parts, 3, 500, true);
+    for(auto& p : parts)
+        EXPECT_EQ(p.batch_count, 1);
+}
+
+TEST(StreamPartition, TileAlignedSplitWithRaggedLastTile)
+{
+    // 1000 = 7 full tiles of 128 and a partial one, cut as 3 + 3 + 2 tiles
+    auto parts = rocsparselt_plan_stream_partitions(1, 1000, 128, 3);
+    ASSERT_EQ(parts.size(), 3u);
+    expect_covers(parts, 1, 1000, false);
+
+    const int64_t begins[] = {0, 384, 768};
+    const int64_t counts[] = {384, 384, 232};
+    for(size_t i = 0; i < parts.size(); i++)
+    {
+        EXPECT_EQ(parts[i].begin, begins[i]);
+        EXPECT_EQ(parts[i].count, counts[i]);
+        EXPECT_EQ(parts[i].begin % 128, 0);
+    }
+}
+
+TEST(StreamPartition, MoreStreamsThanTiles)
+{
+    // 3 tiles, one per partition, the last one partial
+    auto parts = rocsparselt_plan_stream_partitions(1, 300, 128, 8);
+    ASSERT_EQ(parts.size(), 3u);
+    expect_covers(parts, 1, 300, false);
+
+    const int64_t counts[] = {128, 128, 44};
+    for(size_t i = 0; i < parts.size(); i++)
+        EXPECT_EQ(parts[i].count, counts[i]);
+}
+
+TEST(StreamPartition, NoSplit)
+{
+    struct
+    {
+        int64_t batch_count, extent, tile;
+        int32_t num_streams;
+    } cases[] = {
+        {1, 128, 128, 4}, // a single tile
+        {1, 100, 128, 4}, // less than a tile
+        {1, 1000, 0, 4}, // no tile size
+        {6, 1000, 128, 1}, // one stream
+        {1, 1000, 128, 1},
+    };
+
+    for(auto& c : cases)
+    {
+        auto parts = rocsparselt_plan_stream_partitions(
+            c.batch_count, c.extent, c.tile, c.num_streams);
+        ASSERT_EQ(parts.size(), 1u);
+        EXPECT_EQ(parts[0].batch_begin, 0);
+        EXPECT_EQ(parts[0].batch_count, c.batch_count);
+        EXPECT_EQ(parts[0].begin, 0);
+        EXPECT_EQ(parts[0].count, c.extent);
+    }
+}
+
+TEST(ScheduleGroups, LongestFirstOnLeastLoadedStream)
+{
+    // LPT: 7 -> s0, 5 -> s1, 4 -> s1, 3 -> s0, 2 -> s1, 1 -> s0
+    std::vector<double> costs = {2, 7, 4, 5, 3, 1};
+    auto                launches = rocsparselt_schedule_groups(costs, 2);
+    ASSERT_EQ(launches.size(), costs.size());
+
+    const int32_t groups[]  = {1, 3, 2, 4, 0, 5};
+    const int32_t streams[] = {0, 1, 1, 0, 1, 0};
+    double        load[2]   = {};
+    for(size_t i = 0; i < launches.size(); i++)
+    {
+        EXPECT_EQ(launches[i].group, groups[i]);
+        EXPECT_EQ(launches[i].stream, streams[i]);
+        load[launches[i].stream] += costs[launches[i].group];
+    }
+    EXPECT_EQ(load[0], 11);
+    EXPECT_EQ(load[1], 11);
+}
+
+TEST(ScheduleGroups, TiesKeepGroupOrder)
+{
+    auto launches = rocsparselt_schedule_groups({1, 1, 1}, 2);
+    ASSERT_EQ(launches.size(), 3u);
+
+    const int32_t streams[] = {0, 1, 0};
+    for(int32_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(launches[i].group, i);
+        EXPECT_EQ(launches[i].stream, streams[i]);
+    }
+}
+
+TEST(ScheduleGroups, SingleStream)
+{
+    for(int32_t num_streams : {0, 1})
+    {
+        auto launches = rocsparselt_schedule_groups({1, 3, 2}, num_streams);
+        ASSERT_EQ(launches.size(), 3u);
+
+        const int32_t groups[] = {1, 2, 0};
+        for(size_t i = 0; i < launches.size(); i++)
+        {
+            EXPECT_EQ(launches[i].group, groups[i]);
+            EXPECT_EQ(launches[i].stream, 0);
+        }
+    }
+}
@@ -55,4 +55,5 @@ void cblas_gemm(hipsparseOrder_t       order,
                 int64_t                ldc,
                 int64_t                sizeC,
                 Tc*                    alphaVec,
+                Tc*                    betaVec,
                 bool                   alt = false);
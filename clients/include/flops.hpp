@@ -93,3 +93,15 @@ constexpr double tanh_gflop_count(int64_t m, int64_t n)
 {
     return 3 * (m * n) / 1e9;
 }
+
+template <typename T>
+constexpr double silu_gflop_count(int64_t m, int64_t n)
+{
+    return 5 * (m * n) / 1e9;
+}
+
+template <typename T>
+constexpr double hardswish_gflop_count(int64_t m, int64_t n)
+{
+    return 5 * (m * n) / 1e9;
+}
@@ -127,6 +127,25 @@ struct Arguments
     int  func_version;
 
     bool alpha_vector_scaling;
+    bool beta_vector_scaling;
+    bool scale_ab;
+    bool pointer_array_batch;
+    bool gated_epilogue;
+    bool d_scale_vector;
+    int  d_rounding_mode;
+    bool d_amax;
+    bool residual;
+    bool bias_gradient;
+    int  bias_gradient_mode;
+
+    int32_t matmul_streams;
+    bool    host_backend;
+    int32_t split_k;
+    int32_t split_k_mode;
+    int32_t group_count;
+    int32_t weight_bits;
+    int32_t weight_group;
+    bool    weight_zero;
 
     char orderA;
     char orderB;
@@ -196,6 +215,24 @@ struct Arguments
     OPER(sparse_b) SEP               \
     OPER(func_version) SEP           \
     OPER(alpha_vector_scaling) SEP   \
+    OPER(beta_vector_scaling) SEP    \
+    OPER(scale_ab) SEP               \
+    OPER(pointer_array_batch) SEP    \
+    OPER(gated_epilogue) SEP         \
+    OPER(d_scale_vector) SEP         \
+    OPER(d_rounding_mode) SEP        \
+    OPER(d_amax) SEP                 \
+    OPER(residual) SEP               \
+    OPER(bias_gradient) SEP          \
+    OPER(bias_gradient_mode) SEP     \
+    OPER(matmul_streams) SEP         \
+    OPER(host_backend) SEP           \
+    OPER(split_k) SEP                \
+    OPER(split_k_mode) SEP           \
+    OPER(group_count) SEP            \
+    OPER(weight_bits) SEP            \
+    OPER(weight_group) SEP           \
+    OPER(weight_zero) SEP            \
     OPER(orderA) SEP                 \
     OPER(orderB) SEP                 \
     OPER(orderC) SEP                 \
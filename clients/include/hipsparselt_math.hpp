@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include "hipsparselt_float8.hpp"
 #include <cmath>
 #include <hip/hip_runtime.h>
 #include <hipsparselt/hipsparselt.h>
@@ -74,3 +75,12 @@ inline hip_bfloat16 negate(hip_bfloat16 x)
     return raw;
 #endif
 }
+
+// The 8 bit floats have no negative zero, its encoding is the NaN
+template <int Mantissa>
+inline hipsparselt_float8<Mantissa> negate(hipsparselt_float8<Mantissa> x)
+{
+    if(x.data & 0x7f)
+        x.data ^= 0x80;
+    return x;
+}
@@ -123,6 +123,13 @@ public:
     {
         return random_nan_data<hip_bfloat16, uint16_t, 7, 8>();
     }
+
+    // The NaN of the 8 bit floats has a single encoding
+    template <int Mantissa>
+    explicit operator hipsparselt_float8<Mantissa>()
+    {
+        return hipsparselt_float8<Mantissa>::from_bits(hipsparselt_float8<Mantissa>::nan_bits);
+    }
 };
 
 /* ============================================================================================ */
@@ -239,6 +246,20 @@ inline hip_bfloat16 random_generator<hip_bfloat16>()
     return hip_bfloat16(CAST(std::uniform_int_distribution<int>(-2, 2)(t_hipsparselt_rng)));
 };
 
+/*! \brief  generate a random number in range [-2,-1,0,1,2] */
+template <>
+inline hipsparselt_f8 random_generator<hipsparselt_f8>()
+{
+    return hipsparselt_f8(float(std::uniform_int_distribution<int>(-2, 2)(t_hipsparselt_rng)));
+};
+
+/*! \brief  generate a random number in range [-2,-1,0,1,2] */
+template <>
+inline hipsparselt_bf8 random_generator<hipsparselt_bf8>()
+{
+    return hipsparselt_bf8(float(std::uniform_int_distribution<int>(-2, 2)(t_hipsparselt_rng)));
+};
+
 /*! \brief  generate a random number in range [1,2,3] */
 template <>
 inline int8_t random_generator<int8_t>()
@@ -300,6 +321,20 @@ inline hip_bfloat16 random_hpl_generator()
     return hip_bfloat16(std::uniform_real_distribution<float>(-0.5, 0.5)(t_hipsparselt_rng));
 }
 
+/*! \brief  generate a random number in HPL-like [-0.5,0.5] doubles  */
+template <>
+inline hipsparselt_f8 random_hpl_generator()
+{
+    return hipsparselt_f8(std::uniform_real_distribution<float>(-0.5, 0.5)(t_hipsparselt_rng));
+}
+
+/*! \brief  generate a random number in HPL-like [-0.5,0.5] doubles  */
+template <>
+inline hipsparselt_bf8 random_hpl_generator()
+{
+    return hipsparselt_bf8(std::uniform_real_distribution<float>(-0.5, 0.5)(t_hipsparselt_rng));
+}
+
 /*! \brief  generate a random ASCII string of up to length n */
 inline std::string random_string(size_t n)
 {
@@ -27,6 +27,7 @@
 #pragma once
 
 #include "cblas.h"
+#include "hipsparselt_math.hpp"
 #include "hipsparselt_vector.hpp"
 #include "norm.hpp"
 #include "utility.hpp"
@@ -138,10 +139,13 @@ double norm_check_general(char norm_type, int64_t M, int64_t N, int64_t lda, T*
     return error;
 }
 
-// For BF16 and half, we convert the results to double first
+// For BF16, half and the 8 bit floats, we convert the results to double first
 template <typename T,
           typename VEC,
-          std::enable_if_t<std::is_same<T, __half>{} || std::is_same<T, hip_bfloat16>{}, int> = 0>
+          std::enable_if_t<std::is_same<T, __half>{} || std::is_same<T, hip_bfloat16>{}
+                               || std::is_same<T, hipsparselt_f8>{}
+                               || std::is_same<T, hipsparselt_bf8>{},
+                           int> = 0>
 double norm_check_general(char norm_type, int64_t M, int64_t N, int64_t lda, VEC&& hCPU, T* hGPU)
 {
     size_t              size = N * (size_t)lda;
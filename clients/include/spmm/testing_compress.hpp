@@ -359,7 +359,7 @@ void testing_compress(const Arguments& arg)
     gpu_time_used = cpu_time_used                = 0.0;
     double                   hipsparselt_error_c = 0.0;
     double                   hipsparselt_error_m = 0.0;
-    bool                     HMM                 = arg.HMM;
+    bool                     HMM                 = arg.HMM || arg.host_backend;
     hipsparselt_local_handle handle{arg};
     hipStream_t              stream;
     CHECK_HIP_ERROR(hipStreamCreate(&stream));
@@ -921,3 +921,157 @@ void testing_compress(const Arguments& arg)
     }
     CHECK_HIP_ERROR(hipStreamDestroy(stream));
 }
+
+// Dense input and compressed output of hipsparseLtSpMMACompressStream, in host memory
+struct compress_stream_buffers
+{
+    const unsigned char* dense;
+    size_t               dense_size;
+    unsigned char*       compressed;
+    size_t               compressed_size;
+};
+
+inline int compress_stream_read(void* user_data, size_t offset, size_t size, void* buffer)
+{
+    auto io = static_cast<compress_stream_buffers*>(user_data);
+    if(offset + size > io->dense_size)
+        return -1;
+    memcpy(buffer, io->dense + offset, size);
+    return 0;
+}
+
+inline int compress_stream_write(void* user_data, size_t offset, size_t size, const void* buffer)
+{
+    auto io = static_cast<compress_stream_buffers*>(user_data);
+    if(offset + size > io->compressed_size)
+        return -1;
+    memcpy(io->compressed + offset, buffer, size);
+    return 0;
+}
+
+// Streams the structured matrix in panels of eight and of sixteen lines, pruning each panel,
+// and checks that the result is byte for byte that of hipsparseLtSpMMAPrune2 and
+// hipsparseLtSpMMACompress2.
+template <typename Ti,
+          typename To,
+          typename Tc,
+          hipsparselt_batch_type btype = hipsparselt_batch_type::none>
+void testing_compress_stream(const Arguments& arg)
+{
+    bool                     HMM = arg.HMM || arg.host_backend;
+    hipsparselt_local_handle handle{arg};
+    hipStream_t              stream;
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+
+    hipsparseOperation_t trans = char_to_hipsparselt_operation(arg.sparse_b ? arg.transB : arg.transA);
+    hipsparseOrder_t     order = char_to_hipsparselt_order(arg.sparse_b ? arg.orderB : arg.orderA);
+    hipDataType          type  = arg.sparse_b ? arg.b_type : arg.a_type;
+    int64_t              ld    = arg.sparse_b ? arg.ldb : arg.lda;
+
+    // Rows and columns of the structured matrix as stored
+    int64_t rows = arg.sparse_b ? (trans == HIPSPARSE_OPERATION_NON_TRANSPOSE ? arg.K : arg.N)
+                                : (trans == HIPSPARSE_OPERATION_NON_TRANSPOSE ? arg.M : arg.K);
+    int64_t cols = arg.sparse_b ? (trans == HIPSPARSE_OPERATION_NON_TRANSPOSE ? arg.N : arg.K)
+                                : (trans == HIPSPARSE_OPERATION_NON_TRANSPOSE ? arg.K : arg.M);
+
+    constexpr bool do_strided_batched = (btype == hipsparselt_batch_type::strided_batched);
+    int            num_batches        = do_strided_batched ? arg.batch_count : 1;
+    int64_t        stride             = do_strided_batched ? (arg.sparse_b ? arg.stride_b : arg.stride_a)
+                                        : order == HIPSPARSE_ORDER_COL ? ld * cols
+                                                                       : ld * rows;
+
+    hipsparselt_local_mat_descr matS(
+        hipsparselt_matrix_type_structured, handle, rows, cols, ld, type, order);
+    hipsparseStatus_t eStatus
+        = expected_hipsparse_status_of_matrix_size(type, rows, cols, ld, order, true);
+    EXPECT_HIPSPARSE_STATUS(matS.status(), eStatus);
+    if(eStatus != HIPSPARSE_STATUS_SUCCESS)
+        return;
+
+    if(do_strided_batched)
+    {
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatDescSetAttribute(
+                handle, matS, HIPSPARSELT_MAT_NUM_BATCHES, &num_batches, sizeof(int)),
+            HIPSPARSE_STATUS_SUCCESS);
+        eStatus = expected_hipsparse_status_of_matrix_stride(stride, rows, cols, ld, order);
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatDescSetAttribute(
+                handle, matS, HIPSPARSELT_MAT_BATCH_STRIDE, &stride, sizeof(int64_t)),
+            eStatus);
+        if(eStatus != HIPSPARSE_STATUS_SUCCESS)
+            return;
+    }
+
+    size_t compressed_size, compress_buffer_size;
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtSpMMACompressedSize2(handle, matS, &compressed_size, &compress_buffer_size),
+        HIPSPARSE_STATUS_SUCCESS);
+
+    const size_t size_T = stride == 0 ? (order == HIPSPARSE_ORDER_COL ? cols * ld : rows * ld)
+                                      : stride * num_batches;
+
+    device_vector<Ti>            dT(size_T, 1, HMM);
+    device_vector<unsigned char> dT_compressed(compressed_size, 1, HMM);
+    device_vector<unsigned char> dT_compressBuffer(compress_buffer_size, 1, HMM);
+    CHECK_DEVICE_ALLOCATION(dT.memcheck());
+    CHECK_DEVICE_ALLOCATION(dT_compressed.memcheck());
+    CHECK_DEVICE_ALLOCATION(dT_compressBuffer.memcheck());
+
+    host_vector<Ti>     hT(size_T);
+    host_vector<int8_t> hT_gold(compressed_size);
+    host_vector<int8_t> hT_1(compressed_size);
+
+    hipsparselt_seedrand();
+
+    int64_t T_row = order == HIPSPARSE_ORDER_COL ? rows : cols;
+    int64_t T_col = order == HIPSPARSE_ORDER_COL ? cols : rows;
+    if(arg.initialization == hipsparselt_initialization::special)
+        hipsparselt_init_alt_impl_big<Ti>(hT, T_row, T_col, ld, stride, num_batches);
+    else
+        hipsparselt_init<Ti>(hT, T_row, T_col, ld, stride, num_batches);
+
+    auto pruneAlg = hipsparseLtPruneAlg_t(arg.prune_algo);
+
+    // The reference: prune and compress the whole matrix
+    CHECK_HIP_ERROR(dT.transfer_from(hT));
+    CHECK_HIP_ERROR(hipMemset(dT_compressed, 0, compressed_size));
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtSpMMAPrune2(handle, matS, !arg.sparse_b, trans, dT, dT, pruneAlg, stream),
+        HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtSpMMACompress2(handle,
+                                                      matS,
+                                                      !arg.sparse_b,
+                                                      trans,
+                                                      dT,
+                                                      dT_compressed,
+                                                      dT_compressBuffer,
+                                                      stream),
+                            HIPSPARSE_STATUS_SUCCESS);
+    CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+    CHECK_HIP_ERROR(hipMemcpy(hT_gold, dT_compressed, compressed_size, hipMemcpyDeviceToHost));
+
+    // A line is the contiguous run of ld elements
+    for(int64_t panel_lines : {8, 16})
+    {
+        std::fill(hT_1.begin(), hT_1.end(), 0);
+        compress_stream_buffers io{reinterpret_cast<const unsigned char*>(hT.data()),
+                                   size_T * sizeof(Ti),
+                                   reinterpret_cast<unsigned char*>(hT_1.data()),
+                                   compressed_size};
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtSpMMACompressStream(handle,
+                                                               matS,
+                                                               !arg.sparse_b,
+                                                               trans,
+                                                               &pruneAlg,
+                                                               compress_stream_read,
+                                                               compress_stream_write,
+                                                               &io,
+                                                               panel_lines * ld * sizeof(Ti)),
+                                HIPSPARSE_STATUS_SUCCESS);
+
+        unit_check_general<int8_t>(compressed_size, 1, compressed_size, 0, hT_gold, hT_1, 1);
+    }
+
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+}
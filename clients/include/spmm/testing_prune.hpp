@@ -472,7 +472,7 @@ void testing_prune(const Arguments& arg)
     double gpu_time_used, cpu_time_used;
     gpu_time_used = cpu_time_used              = 0.0;
     double                   hipsparselt_error = 0.0;
-    bool                     HMM               = arg.HMM;
+    bool                     HMM               = arg.HMM || arg.host_backend;
     hipsparselt_local_handle handle{arg};
     hipStream_t              stream;
     CHECK_HIP_ERROR(hipStreamCreate(&stream));
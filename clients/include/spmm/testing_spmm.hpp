@@ -31,6 +31,7 @@
 #include "hipsparselt_datatype2string.hpp"
 #include "hipsparselt_init.hpp"
 #include "hipsparselt_math.hpp"
+#include "hipsparselt_quantize.hpp"
 #include "hipsparselt_random.hpp"
 #include "hipsparselt_test.hpp"
 #include "hipsparselt_vector.hpp"
@@ -39,6 +40,7 @@
 #include "unit.hpp"
 #include "utility.hpp"
 #include <cstddef>
+#include <memory>
 #include <hipsparselt/hipsparselt.h>
 #include <omp.h>
 
@@ -106,6 +108,134 @@ void activation(int64_t m, int64_t n, int64_t ld, Ti* in, To* out, Tact arg1, Ta
     }
 }
 
+// out(h) = func(gate) * up + beta * C(h) of a gated epilogue, where the gate and up of
+// output h are in(2h) and in(2h + 1) along M (pair_m) or along N.
+template <typename Tact, typename Tc, typename To, hipsparseOrder_t order, typename F>
+void gated(int64_t      m,
+           int64_t      n,
+           int64_t      ld,
+           bool         pair_m,
+           const Tact*  in,
+           const Tc*    c,
+           int64_t      ldc,
+           To*          out,
+           Tact         beta,
+           const Tact*  beta_vec,
+           Tact         arg1,
+           Tact         arg2,
+           F&           func)
+{
+    auto saturate_i8 = [](Tact val) {
+        auto _val = std::nearbyint(static_cast<double>(val));
+        _val      = _val > 127.f ? 127.f : _val < -128.f ? -128.f : _val;
+        return static_cast<To>(_val);
+    };
+
+    auto saturate_o = [](Tact val) { return static_cast<To>(val); };
+
+    To (*saturate)(Tact val);
+    saturate = std::is_same<int8_t, To>() ? saturate_i8 : saturate_o;
+
+    auto pos = [](int64_t i, int64_t j, int64_t lead) {
+        if constexpr(order == HIPSPARSE_ORDER_COL)
+            return j * lead + i;
+        else
+            return i * lead + j;
+    };
+
+    for(int64_t i = 0; i < (pair_m ? m / 2 : m); i++)
+    {
+        Tact _beta = beta_vec ? beta_vec[i] : beta;
+#pragma omp parallel for
+        for(int64_t j = 0; j < (pair_m ? n : n / 2); j++)
+        {
+            Tact gate = in[pair_m ? pos(2 * i, j, ld) : pos(i, 2 * j, ld)];
+            Tact up   = in[pair_m ? pos(2 * i + 1, j, ld) : pos(i, 2 * j + 1, ld)];
+            out[pos(i, j, ld)]
+                = saturate(func(gate, arg1, arg2) * up
+                           + _beta * static_cast<Tact>(c[pos(i, j, ldc)]));
+        }
+    }
+}
+
+// out(i, j) = scale(i) * in(i, j) rounded to To, and amax(i) = max |in(i, j)| of row i, as
+// the quantization of D does. Stochastic rounding takes the random bits of the library.
+template <typename To, hipsparseOrder_t order>
+void quantize(int64_t      m,
+              int64_t      n,
+              int64_t      ld,
+              const float* in,
+              To*          out,
+              const float* scale,
+              bool         stochastic,
+              uint64_t     seed,
+              int64_t      batch,
+              float*       amax)
+{
+    auto pos = [ld](int64_t i, int64_t j) {
+        if constexpr(order == HIPSPARSE_ORDER_COL)
+            return j * ld + i;
+        else
+            return i * ld + j;
+    };
+
+#pragma omp parallel for
+    for(int64_t i = 0; i < m; i++)
+    {
+        float _amax = 0;
+        for(int64_t j = 0; j < n; j++)
+        {
+            float v = in[pos(i, j)];
+            _amax   = std::max(_amax, std::abs(v));
+            if(scale)
+                v *= scale[i];
+            out[pos(i, j)] = hipsparselt_quantize<To>::round(
+                v,
+                stochastic && sizeof(To) == 1,
+                hipsparselt_rounding_bits(seed, batch, i, j));
+        }
+        if(amax)
+            amax[i] = _amax;
+    }
+}
+
+// d(i, j) += r(i, j) of a residual with the layout of C, and grad gets the sums of the rows
+// of the result, or of its columns when by_columns, as the epilogue does before quantizing D.
+template <typename To, hipsparseOrder_t order>
+void residual_gradient(int64_t   m,
+                       int64_t   n,
+                       int64_t   ld,
+                       float*    d,
+                       const To* r,
+                       int64_t   ldr,
+                       float*    grad,
+                       bool      by_columns)
+{
+    auto pos = [](int64_t i, int64_t j, int64_t ld) {
+        if constexpr(order == HIPSPARSE_ORDER_COL)
+            return j * ld + i;
+        else
+            return i * ld + j;
+    };
+
+    for(int64_t i = 0; i < m; i++)
+        for(int64_t j = 0; j < n; j++)
+        {
+            float v = d[pos(i, j, ld)];
+            if(r)
+                v += static_cast<float>(r[pos(i, j, ldr)]);
+            d[pos(i, j, ld)] = v;
+            if(grad)
+                grad[by_columns ? j : i] += v;
+        }
+}
+
+// An 8 bit D from 16 bit inputs is always quantized, and has no reference of its own
+template <typename Ti, typename To>
+constexpr bool quantized_output = sizeof(Ti) == 2 && sizeof(To) == 1;
+
+auto _identity = [](auto in, auto /*arg1*/, auto /*arg2*/) -> decltype(in) { return in; };
+
 auto _relu = [](auto in, auto /*arg1*/, auto /*arg2*/) -> decltype(in) {
     return static_cast<decltype(in)>(std::max(static_cast<decltype(in)>(0), in));
 };
@@ -156,6 +286,19 @@ auto _tanh = [](auto in, auto arg1, auto arg2) -> decltype(in) {
     return static_cast<decltype(in)>(std::tanh(in_Tc * arg1_Tc) * arg2_Tc);
 };
 
+auto _silu = [](auto in, auto arg1, auto /*arg2*/) -> decltype(in) {
+    using Tc   = float;
+    Tc in_Tc   = static_cast<Tc>(in);
+    Tc arg1_Tc = static_cast<Tc>(arg1);
+    return static_cast<decltype(in)>(in_Tc / (1.f + std::exp(-arg1_Tc * in_Tc)));
+};
+
+auto _hardswish = [](auto in, auto /*arg1*/, auto /*arg2*/) -> decltype(in) {
+    using Tc = float;
+    Tc in_Tc = static_cast<Tc>(in);
+    return static_cast<decltype(in)>(in_Tc * std::min(std::max(in_Tc + 3.f, 0.f), 6.f) / 6.f);
+};
+
 template <typename Ti, typename To, typename Tc>
 void testing_spmm_bad_arg(const Arguments& arg)
 {
@@ -235,6 +378,22 @@ void testing_spmm_bad_arg(const Arguments& arg)
     EXPECT_HIPSPARSE_STATUS(
         hipsparseLtMatmul(handle, plan, &alpha, dA, dB, &beta, dC, dD, workspace, nullptr, 1),
         HIPSPARSE_STATUS_INVALID_VALUE);
+
+#ifdef __HIP_PLATFORM_AMD__
+    // The plan has a fixed M, which cannot become dynamic while A is structured
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDynamicM(
+            handle, plan, M, &alpha, dA, dB, &beta, dC, dD, workspace, &stream, 1),
+        HIPSPARSE_STATUS_INVALID_VALUE);
+
+    int64_t dynamic_m_min = 1;
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulDescSetAttribute(handle,
+                                                              matmul,
+                                                              HIPSPARSELT_MATMUL_DYNAMIC_M_MIN,
+                                                              &dynamic_m_min,
+                                                              sizeof(dynamic_m_min)),
+                            HIPSPARSE_STATUS_NOT_SUPPORTED);
+#endif
 }
 
 template <typename Ti,
@@ -262,11 +421,18 @@ void testing_spmm(const Arguments& arg)
     double gpu_time_used, cpu_time_used;
     gpu_time_used = cpu_time_used              = 0.0;
     double                   hipsparselt_error = 0.0;
-    bool                     HMM               = arg.HMM;
+    bool                     HMM               = arg.HMM || arg.host_backend;
     hipsparselt_local_handle handle{arg};
     hipStream_t              stream;
     CHECK_HIP_ERROR(hipStreamCreate(&stream));
 
+    // hipsparseLtMatmul runs on stream and may spread the problem over the other streams
+    int32_t                  num_streams = std::max(arg.matmul_streams, 1);
+    std::vector<hipStream_t> streams(num_streams);
+    streams[0] = stream;
+    for(int32_t i = 1; i < num_streams; i++)
+        CHECK_HIP_ERROR(hipStreamCreate(&streams[i]));
+
     hipsparseOrder_t orderA = char_to_hipsparselt_order(arg.orderA);
     hipsparseOrder_t orderB = char_to_hipsparselt_order(arg.orderB);
     hipsparseOrder_t orderC = char_to_hipsparselt_order(arg.orderC);
@@ -513,6 +679,31 @@ void testing_spmm(const Arguments& arg)
                                               sizeof(float)),
             HIPSPARSE_STATUS_SUCCESS);
         break;
+    case hipsparselt_activation_type::silu:
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_ACTIVATION_SILU,
+                                              &activation_on,
+                                              sizeof(activation_on)),
+            HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_ACTIVATION_SILU_BETA,
+                                              &arg.activation_arg1,
+                                              sizeof(float)),
+            HIPSPARSE_STATUS_SUCCESS);
+        break;
+    case hipsparselt_activation_type::hardswish:
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_ACTIVATION_HARDSWISH,
+                                              &activation_on,
+                                              sizeof(activation_on)),
+            HIPSPARSE_STATUS_SUCCESS);
+        break;
     default:
         activation_on = 0;
         break;
@@ -567,8 +758,183 @@ void testing_spmm(const Arguments& arg)
         h_alpha = static_cast<Talpha>(1);
     }
 
+    const size_t size_beta_vec = arg.beta_vector_scaling ? M : 0;
+
+    device_vector<Talpha> dBetaVector(size_beta_vec, 1, HMM);
+    CHECK_DEVICE_ALLOCATION(dBetaVector.memcheck());
+    host_vector<Talpha> hBetaVector(size_beta_vec);
+    if(arg.beta_vector_scaling)
+    {
+        hipsparselt_init<Talpha>(hBetaVector, M, 1, M, size_beta_vec, 1);
+        CHECK_HIP_ERROR(dBetaVector.transfer_from(hBetaVector));
+        int beta_vector_scaling = 1;
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_BETA_VECTOR_SCALING,
+                                              &beta_vector_scaling,
+                                              sizeof(int)),
+            HIPSPARSE_STATUS_SUCCESS);
+        h_beta = static_cast<Talpha>(1);
+    }
+
+    // The per-tensor scales of A and B multiply alpha, or each entry of the alpha vector. The
+    // reference takes their product instead, which is a power of two to keep it exact.
+    const size_t size_scale_ab = arg.scale_ab ? 1 : 0;
+    const Talpha h_scale_ab    = static_cast<Talpha>(arg.scale_ab ? 0.5f * 4.f : 1.f);
+
+    device_vector<float> dScaleA(size_scale_ab, 1, HMM);
+    device_vector<float> dScaleB(size_scale_ab, 1, HMM);
+    CHECK_DEVICE_ALLOCATION(dScaleA.memcheck());
+    CHECK_DEVICE_ALLOCATION(dScaleB.memcheck());
+    if(arg.scale_ab)
+    {
+        host_vector<float> hScale(1);
+        hScale[0] = 0.5f;
+        CHECK_HIP_ERROR(dScaleA.transfer_from(hScale));
+        hScale[0] = 4.f;
+        CHECK_HIP_ERROR(dScaleB.transfer_from(hScale));
+#ifdef __HIP_PLATFORM_AMD__
+        void* _dScaleA = dScaleA;
+        void* _dScaleB = dScaleB;
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(
+                handle, matmul, HIPSPARSELT_MATMUL_A_SCALE_POINTER, &_dScaleA, sizeof(void*)),
+            HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(
+                handle, matmul, HIPSPARSELT_MATMUL_B_SCALE_POINTER, &_dScaleB, sizeof(void*)),
+            HIPSPARSE_STATUS_SUCCESS);
+#endif
+        for(size_t i = 0; i < size_alpha_vec; i++)
+            hAlpahVector[i] *= h_scale_ab;
+    }
+
+    // D is quantized with scales, stochastic rounding or maxima, and always when it is 8 bit
+    // and the inputs are 16 bit. Scales that are powers of two keep the scaled results exact.
+    // The residual and the bias gradient are also taken in float, before D is rounded.
+    const bool     stochastic      = arg.d_rounding_mode == HIPSPARSELT_ROUNDING_STOCHASTIC;
+    const uint64_t d_rounding_seed = 0x5eed;
+    const bool     grad_columns    = arg.bias_gradient_mode == HIPSPARSELT_BIAS_GRADIENT_COLUMNS;
+    const bool     quantize_d      = quantized_output<Ti, To> || arg.d_scale_vector || arg.d_amax
+                                || stochastic || arg.residual || arg.bias_gradient;
+    const size_t   size_d_scale    = arg.d_scale_vector ? M : 0;
+    const size_t   size_d_amax     = arg.d_amax ? M * num_batches : 0;
+    const int64_t  grad_len        = grad_columns ? N : M;
+    const size_t   size_bias_grad  = arg.bias_gradient ? grad_len * num_batches : 0;
+
+    device_vector<float> dDScale(size_d_scale, 1, HMM);
+    device_vector<float> dDAmax(size_d_amax, 1, HMM);
+    device_vector<float> dBiasGrad(size_bias_grad, 1, HMM);
+    CHECK_DEVICE_ALLOCATION(dDScale.memcheck());
+    CHECK_DEVICE_ALLOCATION(dDAmax.memcheck());
+    CHECK_DEVICE_ALLOCATION(dBiasGrad.memcheck());
+    host_vector<float> hDScale(size_d_scale);
+    host_vector<float> hDAmax(size_d_amax);
+    host_vector<float> hDAmax_gold(size_d_amax);
+    host_vector<float> hBiasGrad(size_bias_grad);
+    host_vector<float> hBiasGrad_gold(size_bias_grad);
+    if(arg.d_scale_vector)
+    {
+        for(int64_t i = 0; i < M; i++)
+            hDScale[i] = std::ldexp(1.f, -static_cast<int>(i % 4));
+        CHECK_HIP_ERROR(dDScale.transfer_from(hDScale));
+    }
+
+#ifdef __HIP_PLATFORM_AMD__
+    if(arg.pointer_array_batch)
+    {
+        int pointer_array_batch = 1;
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_POINTER_ARRAY_BATCH,
+                                              &pointer_array_batch,
+                                              sizeof(int)),
+            HIPSPARSE_STATUS_SUCCESS);
+    }
+
+    if(arg.gated_epilogue)
+    {
+        int gated_epilogue = 1;
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_GATED_EPILOGUE,
+                                              &gated_epilogue,
+                                              sizeof(int)),
+            HIPSPARSE_STATUS_SUCCESS);
+    }
+
+    if(arg.d_scale_vector)
+    {
+        void* _dDScale = dDScale;
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(
+                handle, matmul, HIPSPARSELT_MATMUL_D_SCALE_POINTER, &_dDScale, sizeof(void*)),
+            HIPSPARSE_STATUS_SUCCESS);
+    }
+
+    if(stochastic)
+    {
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulDescSetAttribute(handle,
+                                                                  matmul,
+                                                                  HIPSPARSELT_MATMUL_D_ROUNDING_MODE,
+                                                                  &arg.d_rounding_mode,
+                                                                  sizeof(int)),
+                                HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulDescSetAttribute(handle,
+                                                                  matmul,
+                                                                  HIPSPARSELT_MATMUL_D_ROUNDING_SEED,
+                                                                  &d_rounding_seed,
+                                                                  sizeof(uint64_t)),
+                                HIPSPARSE_STATUS_SUCCESS);
+    }
+
+    if(arg.d_amax)
+    {
+        void* _dDAmax = dDAmax;
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(
+                handle, matmul, HIPSPARSELT_MATMUL_D_AMAX_POINTER, &_dDAmax, sizeof(void*)),
+            HIPSPARSE_STATUS_SUCCESS);
+    }
+
+    if(arg.bias_gradient)
+    {
+        void* _dBiasGrad = dBiasGrad;
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_BIAS_GRADIENT_POINTER,
+                                              &_dBiasGrad,
+                                              sizeof(void*)),
+            HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle,
+                                              matmul,
+                                              HIPSPARSELT_MATMUL_BIAS_GRADIENT_MODE,
+                                              &arg.bias_gradient_mode,
+                                              sizeof(int)),
+            HIPSPARSE_STATUS_SUCCESS);
+    }
+#endif
+
     hipsparselt_local_matmul_alg_selection alg_sel(handle, matmul, HIPSPARSELT_MATMUL_ALG_DEFAULT);
 
+    // The split-K request changes the workspace, so it is set before the plans
+    if(arg.split_k)
+    {
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulAlgSetAttribute(
+                handle, alg_sel, HIPSPARSELT_MATMUL_SPLIT_K, &arg.split_k, sizeof(int)),
+            HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulAlgSetAttribute(
+                handle, alg_sel, HIPSPARSELT_MATMUL_SPLIT_K_MODE, &arg.split_k_mode, sizeof(int)),
+            HIPSPARSE_STATUS_SUCCESS);
+    }
+
     size_t workspace_size = 0, compressed_size = 0, compress_buffer_size = 0;
 
     {
@@ -631,6 +997,7 @@ void testing_spmm(const Arguments& arg)
     device_vector<Ti>            dB(size_B, 1, HMM);
     device_vector<To>            dC(size_C, 1, HMM);
     device_vector<To>            dD(size_D, 1, HMM);
+    device_vector<To>            dResidual(arg.residual ? size_C : 0, 1, HMM);
     device_vector<unsigned char> d_compressed(compressed_size, 1, HMM);
     device_vector<unsigned char> d_compressBuffer(compress_buffer_size, 1, HMM);
     device_vector<unsigned char> dWorkspace(workspace_size, 1, HMM);
@@ -638,6 +1005,7 @@ void testing_spmm(const Arguments& arg)
     CHECK_DEVICE_ALLOCATION(dB.memcheck());
     CHECK_DEVICE_ALLOCATION(dC.memcheck());
     CHECK_DEVICE_ALLOCATION(dD.memcheck());
+    CHECK_DEVICE_ALLOCATION(dResidual.memcheck());
     CHECK_DEVICE_ALLOCATION(d_compressed.memcheck());
     CHECK_DEVICE_ALLOCATION(dWorkspace.memcheck());
 
@@ -646,8 +1014,10 @@ void testing_spmm(const Arguments& arg)
     host_vector<Ti>     h_pruned(size_pruned_copy);
     host_vector<Ti>     hB(size_B);
     host_vector<To>     hC(size_C);
+    host_vector<To>     hResidual(arg.residual ? size_C : 0);
     host_vector<To>     hD_gold(size_D_copy);
     host_vector<Talpha> hD_gold_act(size_D_copy);
+    host_vector<Talpha> hD_gold_gated(quantize_d && arg.gated_epilogue ? size_D_copy : 0);
     host_vector<To>     hD_1(size_D_copy);
 
     size_t A_row_r, A_col_r, B_row_r, B_col_r, C_row_r, C_col_r, D_row_r, D_col_r;
@@ -705,20 +1075,31 @@ void testing_spmm(const Arguments& arg)
             hipsparselt_init<To>(hC, C_row_r, C_col_r, ldc, stride_c, num_batches);
     }
 
+    // The residual has the layout of C
+    if(arg.residual)
+    {
+        if(arg.initialization == hipsparselt_initialization::trig_float)
+            hipsparselt_init_cos<To>(hResidual, C_row_r, C_col_r, ldc, stride_c, num_batches);
+        else
+            hipsparselt_init<To>(hResidual, C_row_r, C_col_r, ldc, stride_c, num_batches);
+    }
+
     // copy data from CPU to device
     CHECK_HIP_ERROR(dA.transfer_from(hA));
     CHECK_HIP_ERROR(dB.transfer_from(hB));
     CHECK_HIP_ERROR(dC.transfer_from(hC));
+    if(arg.residual)
+        CHECK_HIP_ERROR(dResidual.transfer_from(hResidual));
 
     if(size_D_copy)
     {
-        if(activation_on || arg.bias_vector)
+        if(activation_on || arg.bias_vector || arg.gated_epilogue || quantize_d)
         {
             std::transform(hC.begin(), hC.end(), hD_gold_act.begin(), [](To c) -> Talpha {
                 return static_cast<Talpha>(c);
             });
         }
-        else
+        if(!(activation_on || arg.bias_vector) || arg.gated_epilogue)
         {
             std::copy(hC.begin(), hC.end(), hD_gold.begin());
         }
@@ -743,6 +1124,37 @@ void testing_spmm(const Arguments& arg)
         hB_ = h_pruned;
     }
 
+    // With pointer-array batches the dense matrix, C and D are passed as host arrays of batch
+    // pointers. They point into the strided buffers, so that the results are checked as usual.
+    void*              dC_        = dC;
+    void*              dD_        = dD;
+    void*              dResidual_ = dResidual;
+    std::vector<void*> hDensePtrs, hCPtrs, hDPtrs, hResidualPtrs;
+    if(arg.pointer_array_batch)
+    {
+        void*&  dDense_      = arg.sparse_b ? dA_ : dB_;
+        int64_t stride_dense = arg.sparse_b ? stride_a : stride_b;
+        for(int i = 0; i < num_batches; i++)
+        {
+            hDensePtrs.push_back(static_cast<Ti*>(dDense_) + stride_dense * i);
+            hCPtrs.push_back(static_cast<To*>(dC_) + stride_c * i);
+            hDPtrs.push_back(static_cast<To*>(dD_) + stride_d * i);
+            hResidualPtrs.push_back(static_cast<To*>(dResidual_) + stride_c * i);
+        }
+        dDense_    = hDensePtrs.data();
+        dC_        = hCPtrs.data();
+        dD_        = hDPtrs.data();
+        dResidual_ = hResidualPtrs.data();
+    }
+
+#ifdef __HIP_PLATFORM_AMD__
+    if(arg.residual)
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(
+                handle, matmul, HIPSPARSELT_MATMUL_RESIDUAL_POINTER, &dResidual_, sizeof(void*)),
+            HIPSPARSE_STATUS_SUCCESS);
+#endif
+
     EXPECT_HIPSPARSE_STATUS(
         hipsparseLtSpMMAPrune(handle, matmul, dP, dP, HIPSPARSELT_PRUNE_SPMMA_STRIP, stream),
         HIPSPARSE_STATUS_SUCCESS);
@@ -758,12 +1170,12 @@ void testing_spmm(const Arguments& arg)
                                     arg.alpha_vector_scaling ? dAlpahVector : &h_alpha,
                                     dA_,
                                     dB_,
-                                    &h_beta,
-                                    dC,
-                                    dD,
+                                    arg.beta_vector_scaling ? dBetaVector : &h_beta,
+                                    dC_,
+                                    dD_,
                                     dWorkspace,
-                                    &stream,
-                                    1),
+                                    streams.data(),
+                                    num_streams),
             HIPSPARSE_STATUS_SUCCESS);
     if(arg.unit_check || arg.norm_check)
     {
@@ -775,12 +1187,12 @@ void testing_spmm(const Arguments& arg)
                               arg.alpha_vector_scaling ? dAlpahVector : &h_alpha,
                               dA_,
                               dB_,
-                              &h_beta,
-                              dC,
-                              dD,
+                              arg.beta_vector_scaling ? dBetaVector : &h_beta,
+                              dC_,
+                              dD_,
                               dWorkspace,
-                              &stream,
-                              1),
+                              streams.data(),
+                              num_streams),
             HIPSPARSE_STATUS_SUCCESS);
         // now we can recycle gold matrix for reference purposes
         if(arg.timing)
@@ -822,11 +1234,28 @@ void testing_spmm(const Arguments& arg)
     tM, tN, ldd, hD_gold_act + pos, hD_gold + pos, arg.activation_arg1, arg.activation_arg2
 #define bias_act_param M, N, ldd, hD_gold_act + pos, hD_gold_act + pos, hBias + bias_stride* i
 #define bias_param M, N, ldd, hD_gold_act + pos, hD_gold + pos, hBias + bias_stride* i
+#define gated_param                                                                          \
+    M, N, ldd, !arg.sparse_b, hD_gold_act + pos, hC + stride_c * i, ldc, hD_gold + pos, h_beta, \
+        arg.beta_vector_scaling ? hBetaVector : nullptr, arg.activation_arg1,                  \
+        arg.activation_arg2
+#define gated_quantize_param                                                                  \
+    M, N, ldd, !arg.sparse_b, hD_gold_act + pos, hC + stride_c * i, ldc, hD_gold_gated + pos, \
+        h_beta, arg.beta_vector_scaling ? hBetaVector : nullptr, arg.activation_arg1,         \
+        arg.activation_arg2
+#define quantize_param                                                                     \
+    quantize_m, quantize_n, ldd,                                                           \
+        (arg.gated_epilogue ? hD_gold_gated : hD_gold_act) + pos, hD_gold + pos,           \
+        arg.d_scale_vector ? hDScale : nullptr, stochastic, d_rounding_seed, i,            \
+        arg.d_amax ? hDAmax_gold + M * i : nullptr
+#define residual_gradient_param                                                           \
+    quantize_m, quantize_n, ldd, (arg.gated_epilogue ? hD_gold_gated : hD_gold_act) + pos, \
+        arg.residual ? hResidual + stride_c * i : nullptr, ldc,                           \
+        arg.bias_gradient ? hBiasGrad_gold + grad_len * i : nullptr, grad_columns
 
         for(int i = 0; i < num_batches; i++)
         {
 
-            if(activation_on || arg.bias_vector)
+            if(activation_on || arg.bias_vector || arg.gated_epilogue || quantize_d)
             {
                 cblas_gemm<Ti, Talpha, Talpha>(orderC,
                                                tTransA,
@@ -834,24 +1263,51 @@ void testing_spmm(const Arguments& arg)
                                                tM,
                                                tN,
                                                K,
-                                               h_alpha,
+                                               h_alpha * h_scale_ab,
                                                tA + tStrideA * i,
                                                tLda,
                                                tSizeA,
                                                tB + tStrideB * i,
                                                tLdb,
                                                tSizeB,
-                                               h_beta,
+                                               arg.gated_epilogue ? static_cast<Talpha>(0) : h_beta,
                                                hD_gold_act + stride_d * i,
                                                ldd,
                                                tSizeD,
                                                arg.alpha_vector_scaling ? hAlpahVector : nullptr,
+                                               arg.beta_vector_scaling && !arg.gated_epilogue
+                                                   ? hBetaVector
+                                                   : nullptr,
                                                false);
 
+                // A gated epilogue adds C after combining the gate and up products. D
+                // to be quantized stays in float until it is.
                 auto pos = stride_d * i;
+                auto act = [&](auto& func) {
+                    if(!arg.gated_epilogue && quantize_d)
+                        activation(tM,
+                                   tN,
+                                   ldd,
+                                   hD_gold_act + pos,
+                                   hD_gold_act + pos,
+                                   arg.activation_arg1,
+                                   arg.activation_arg2,
+                                   func);
+                    else if(!arg.gated_epilogue)
+                        activation(activation_param, func);
+                    else if(quantize_d && orderD == HIPSPARSE_ORDER_COL)
+                        gated<Talpha, To, Talpha, HIPSPARSE_ORDER_COL>(gated_quantize_param, func);
+                    else if(quantize_d)
+                        gated<Talpha, To, Talpha, HIPSPARSE_ORDER_ROW>(gated_quantize_param, func);
+                    else if(orderD == HIPSPARSE_ORDER_COL)
+                        gated<Talpha, To, To, HIPSPARSE_ORDER_COL>(gated_param, func);
+                    else
+                        gated<Talpha, To, To, HIPSPARSE_ORDER_ROW>(gated_param, func);
+                };
+
                 if(arg.bias_vector)
                 {
-                    if(activation_on)
+                    if(activation_on || arg.gated_epilogue || quantize_d)
                     {
                         if(orderD == HIPSPARSE_ORDER_COL)
                             bias<Talpha, TBias, Talpha, HIPSPARSE_ORDER_COL>(bias_act_param);
@@ -872,40 +1328,62 @@ void testing_spmm(const Arguments& arg)
                     switch(arg.activation_type)
                     {
                     case hipsparselt_activation_type::clippedrelu:
-                        activation(activation_param, ::_clippedrelu);
+                        act(::_clippedrelu);
                         break;
                     case hipsparselt_activation_type::gelu:
-                        activation(activation_param, ::_gelu);
+                        act(::_gelu);
                         break;
                     case hipsparselt_activation_type::relu:
-                        activation(activation_param, ::_relu);
+                        act(::_relu);
                         break;
                     case hipsparselt_activation_type::abs:
-                        activation(activation_param, ::_abs);
+                        act(::_abs);
                         break;
                     case hipsparselt_activation_type::leakyrelu:
-                        activation(activation_param, ::_leakyrelu);
+                        act(::_leakyrelu);
                         break;
                     case hipsparselt_activation_type::sigmoid:
-                        activation(activation_param, ::_sigmoid);
+                        act(::_sigmoid);
                         break;
                     case hipsparselt_activation_type::tanh:
-                        activation(activation_param, ::_tanh);
+                        act(::_tanh);
+                        break;
+                    case hipsparselt_activation_type::silu:
+                        act(::_silu);
+                        break;
+                    case hipsparselt_activation_type::hardswish:
+                        act(::_hardswish);
                         break;
                     default:
                         continue;
                     }
                 }
+                else if(arg.gated_epilogue)
+                    act(::_identity);
+
+                if(quantize_d)
+                {
+                    int64_t quantize_m = arg.gated_epilogue && !arg.sparse_b ? M / 2 : M;
+                    int64_t quantize_n = arg.gated_epilogue && arg.sparse_b ? N / 2 : N;
+                    if((arg.residual || arg.bias_gradient) && orderD == HIPSPARSE_ORDER_COL)
+                        residual_gradient<To, HIPSPARSE_ORDER_COL>(residual_gradient_param);
+                    else if(arg.residual || arg.bias_gradient)
+                        residual_gradient<To, HIPSPARSE_ORDER_ROW>(residual_gradient_param);
+                    if(orderD == HIPSPARSE_ORDER_COL)
+                        quantize<To, HIPSPARSE_ORDER_COL>(quantize_param);
+                    else
+                        quantize<To, HIPSPARSE_ORDER_ROW>(quantize_param);
+                }
             }
 
-            else
+            else if constexpr(!quantized_output<Ti, To>)
                 cblas_gemm<Ti, To, Talpha>(orderC,
                                            tTransA,
                                            tTransB,
                                            tM,
                                            tN,
                                            K,
-                                           h_alpha,
+                                           h_alpha * h_scale_ab,
                                            tA + tStrideA * i,
                                            tLda,
                                            tSizeA,
@@ -917,15 +1395,29 @@ void testing_spmm(const Arguments& arg)
                                            ldd,
                                            tSizeD,
                                            arg.alpha_vector_scaling ? hAlpahVector : nullptr,
+                                           arg.beta_vector_scaling ? hBetaVector : nullptr,
                                            false);
         }
 #undef activation_param
+#undef gated_param
+#undef gated_quantize_param
+#undef quantize_param
+#undef residual_gradient_param
 
         if(arg.timing)
         {
             cpu_time_used = get_time_us_no_sync() - cpu_time_used;
         }
 
+        // A gated epilogue writes the leading half of D along the structured matrix
+        if(arg.gated_epilogue)
+        {
+            if(!arg.sparse_b)
+                tM /= 2;
+            else
+                tN /= 2;
+        }
+
         // fetch GPU
         CHECK_HIP_ERROR(hipStreamSynchronize(stream));
         CHECK_HIP_ERROR(hD_1.transfer_from(dD));
@@ -946,6 +1438,35 @@ void testing_spmm(const Arguments& arg)
                 norm_check_general<To>('F', tM, tN, ldd, stride_d, hD_gold, hD_1, num_batches));
         }
 
+        // The maxima are taken in float before D is rounded, so they match exactly
+        if(arg.d_amax)
+        {
+            CHECK_HIP_ERROR(hDAmax.transfer_from(dDAmax));
+            if(arg.unit_check)
+                unit_check_general<float>(M, 1, M, M, hDAmax_gold, hDAmax, num_batches);
+        }
+
+        // The sums of the bias gradient are added in another order, so they match to the
+        // rounding of their largest partial sums
+        if(arg.bias_gradient)
+        {
+            CHECK_HIP_ERROR(hBiasGrad.transfer_from(dBiasGrad));
+            double grad_max = 0;
+            for(size_t i = 0; i < size_bias_grad; i++)
+                grad_max = std::max(grad_max, std::abs(double(hBiasGrad_gold[i])));
+            double grad_tol
+                = grad_max * (grad_columns ? M : N) * std::numeric_limits<float>::epsilon();
+            if(arg.unit_check)
+                near_check_general<float>(grad_len,
+                                          1,
+                                          grad_len,
+                                          grad_len,
+                                          hBiasGrad_gold,
+                                          hBiasGrad,
+                                          num_batches,
+                                          grad_tol);
+        }
+
         // Debug
 #if 0
         print_strided_batched("A", &hA_[0], A_row_r, A_col_r, num_batches, 1, lda, stride_a);
@@ -955,6 +1476,8 @@ void testing_spmm(const Arguments& arg)
             print_strided_batched("bias", &hBias[0], M, 1, num_batches, 1, M, bias_stride);
         if(arg.alpha_vector_scaling)
             print_strided_batched("alpha_vec", &hAlpahVector[0], M, 1, 1, 1, M, M);
+        if(arg.beta_vector_scaling)
+            print_strided_batched("beta_vec", &hBetaVector[0], M, 1, 1, 1, M, M);
         print_strided_batched("hD_gold", &hD_gold[0], tM, tN, num_batches, 1, ldd, stride_d);
         print_strided_batched("hD1", &hD_1[0], tM, tN, num_batches, 1, ldd, stride_d);
 #endif
@@ -972,12 +1495,12 @@ void testing_spmm(const Arguments& arg)
                                   arg.alpha_vector_scaling ? dAlpahVector : &h_alpha,
                                   dA_,
                                   dB_,
-                                  &h_beta,
-                                  dC,
-                                  dD,
+                                  arg.beta_vector_scaling ? dBetaVector : &h_beta,
+                                  dC_,
+                                  dD_,
                                   dWorkspace,
-                                  &stream,
-                                  1),
+                                  streams.data(),
+                                  num_streams),
                 HIPSPARSE_STATUS_SUCCESS);
         }
 
@@ -991,12 +1514,12 @@ void testing_spmm(const Arguments& arg)
                                   arg.alpha_vector_scaling ? dAlpahVector : &h_alpha,
                                   dA_,
                                   dB_,
-                                  &h_beta,
-                                  dC,
-                                  dD,
+                                  arg.beta_vector_scaling ? dBetaVector : &h_beta,
+                                  dC_,
+                                  dD_,
                                   dWorkspace,
-                                  &stream,
-                                  1),
+                                  streams.data(),
+                                  num_streams),
                 HIPSPARSE_STATUS_SUCCESS);
         }
         CHECK_HIP_ERROR(hipStreamSynchronize(stream));
@@ -1025,6 +1548,12 @@ void testing_spmm(const Arguments& arg)
         case hipsparselt_activation_type::tanh:
             flops += tanh_gflop_count<float>(M, N);
             break;
+        case hipsparselt_activation_type::silu:
+            flops += silu_gflop_count<float>(M, N);
+            break;
+        case hipsparselt_activation_type::hardswish:
+            flops += hardswish_gflop_count<float>(M, N);
+            break;
         default:
             break;
         }
@@ -1050,70 +1579,812 @@ void testing_spmm(const Arguments& arg)
                                                                cpu_time_used,
                                                                hipsparselt_error);
     }
+    for(int32_t i = 1; i < num_streams; i++)
+        CHECK_HIP_ERROR(hipStreamDestroy(streams[i]));
     CHECK_HIP_ERROR(hipStreamDestroy(stream));
 }
 
-template <typename Ti,
-          typename To,
-          typename Tc,
-          hipsparselt_batch_type btype = hipsparselt_batch_type::none>
-void testing_aux_plan_assign(const Arguments& arg)
+// Runs arg.group_count problems of different shapes in one hipsparseLtMatmulGrouped call and
+// checks every D against its own reference. Group g multiplies an M x K matrix by a K x N
+// matrix, where M, N and K are arg.M, arg.N and arg.K times 1 to 3, 1 to 2 and 1 to 2, so
+// neighbouring groups differ in every dimension. All groups take the transposes, the bias,
+// the ReLU activation and the split-K request of arg, and keep their matrices column major
+// in shared buffers.
+template <typename Ti, typename To, typename Tc, typename TBias = Ti>
+void testing_spmm_grouped(const Arguments& arg)
 {
     hipsparseOperation_t transA = char_to_hipsparselt_operation(arg.transA);
     hipsparseOperation_t transB = char_to_hipsparselt_operation(arg.transB);
 
     using Talpha = float;
 
-    int64_t M       = arg.M;
-    int64_t N       = arg.N;
-    int64_t K       = arg.K;
-    Talpha  h_alpha = arg.get_alpha<Talpha>();
-    Talpha  h_beta  = arg.get_beta<Talpha>();
-    int64_t lda     = arg.lda;
-    int64_t ldb     = arg.ldb;
-    int64_t ldc     = arg.ldc;
-    int64_t ldd     = arg.ldd;
+    Talpha h_alpha = arg.get_alpha<Talpha>();
+    Talpha h_beta  = arg.get_beta<Talpha>();
 
-    double gpu_time_used, cpu_time_used;
-    gpu_time_used = cpu_time_used              = 0.0;
-    double                   hipsparselt_error = 0.0;
-    bool                     HMM               = arg.HMM;
+    bool                     HMM = arg.HMM || arg.host_backend;
     hipsparselt_local_handle handle{arg};
     hipStream_t              stream;
     CHECK_HIP_ERROR(hipStreamCreate(&stream));
 
-    hipsparseOrder_t orderA = char_to_hipsparselt_order(arg.orderA);
-    hipsparseOrder_t orderB = char_to_hipsparselt_order(arg.orderB);
-    hipsparseOrder_t orderC = char_to_hipsparselt_order(arg.orderC);
-    hipsparseOrder_t orderD = char_to_hipsparselt_order(arg.orderD);
-
-    int64_t A_row = transA == HIPSPARSE_OPERATION_NON_TRANSPOSE ? M : K;
-    int64_t A_col = transA == HIPSPARSE_OPERATION_NON_TRANSPOSE ? K : M;
-    int64_t B_row = transB == HIPSPARSE_OPERATION_NON_TRANSPOSE ? K : N;
-    int64_t B_col = transB == HIPSPARSE_OPERATION_NON_TRANSPOSE ? N : K;
+    const int32_t group_count = std::max(arg.group_count, 1);
+    hipDataType   bias_type   = arg.bias_type;
 
-    int64_t stride_1_a = transA == HIPSPARSE_OPERATION_NON_TRANSPOSE ? 1 : lda;
-    int64_t stride_2_a = transA == HIPSPARSE_OPERATION_NON_TRANSPOSE ? lda : 1;
+    // Offsets of the groups in the shared buffers are kept 256 byte aligned
+    auto align = [](size_t offset, size_t size) {
+        size_t elements = 256 / size;
+        return (offset + elements - 1) / elements * elements;
+    };
 
-    constexpr bool do_batched         = (btype == hipsparselt_batch_type::batched);
-    constexpr bool do_strided_batched = (btype == hipsparselt_batch_type::strided_batched);
-    int            num_batches        = 5;
-    int64_t        stride_a           = lda * A_col;
-    int64_t        stride_b           = ldb * B_col;
-    int64_t        stride_c           = ldc * N;
-    int64_t        stride_d           = ldd * N;
+    std::vector<int64_t> Ms(group_count), Ns(group_count), Ks(group_count);
+    std::vector<size_t>  off_A(group_count + 1), off_B(group_count + 1), off_C(group_count + 1),
+        off_bias(group_count + 1), off_compressed(group_count + 1);
 
-    hipsparselt_local_mat_descr matA(
-        hipsparselt_matrix_type_structured, handle, A_row, A_col, lda, arg.a_type, orderA);
-    hipsparselt_local_mat_descr matB(
-        hipsparselt_matrix_type_dense, handle, B_row, B_col, ldb, arg.b_type, orderB);
-    hipsparselt_local_mat_descr matC(
-        hipsparselt_matrix_type_dense, handle, M, N, ldc, arg.c_type, orderC);
-    hipsparselt_local_mat_descr matD(
-        hipsparselt_matrix_type_dense, handle, M, N, ldc, arg.d_type, orderD);
+    std::vector<std::unique_ptr<hipsparselt_local_mat_descr>>            matA(group_count),
+        matB(group_count), matC(group_count), matD(group_count);
+    std::vector<std::unique_ptr<hipsparselt_local_matmul_descr>>         matmul(group_count);
+    std::vector<std::unique_ptr<hipsparselt_local_matmul_alg_selection>> alg_sel(group_count);
+    std::vector<std::unique_ptr<hipsparselt_local_matmul_plan>>          plan(group_count);
 
-    hipsparseStatus_t eStatus = expected_hipsparse_status_of_matrix_size(
-        arg.a_type, A_row, A_col, lda, orderA, !arg.sparse_b);
+    size_t compress_buffer_size = 0;
+    for(int32_t g = 0; g < group_count; g++)
+    {
+        int64_t M = Ms[g] = arg.M * (g % 3 + 1);
+        int64_t N = Ns[g] = arg.N * ((g + 1) % 2 + 1);
+        int64_t K = Ks[g] = arg.K * (g % 2 + 1);
+
+        int64_t A_row = transA == HIPSPARSE_OPERATION_NON_TRANSPOSE ? M : K;
+        int64_t A_col = transA == HIPSPARSE_OPERATION_NON_TRANSPOSE ? K : M;
+        int64_t B_row = transB == HIPSPARSE_OPERATION_NON_TRANSPOSE ? K : N;
+        int64_t B_col = transB == HIPSPARSE_OPERATION_NON_TRANSPOSE ? N : K;
+
+        off_A[g + 1]    = align(off_A[g] + A_row * A_col, sizeof(Ti));
+        off_B[g + 1]    = align(off_B[g] + B_row * B_col, sizeof(Ti));
+        off_C[g + 1]    = align(off_C[g] + M * N, sizeof(To));
+        off_bias[g + 1] = align(off_bias[g] + (arg.bias_vector ? M : 0), sizeof(TBias));
+
+        matA[g] = std::make_unique<hipsparselt_local_mat_descr>(
+            arg.sparse_b ? hipsparselt_matrix_type_dense : hipsparselt_matrix_type_structured,
+            handle,
+            A_row,
+            A_col,
+            A_row,
+            arg.a_type,
+            HIPSPARSE_ORDER_COL);
+        matB[g] = std::make_unique<hipsparselt_local_mat_descr>(
+            arg.sparse_b ? hipsparselt_matrix_type_structured : hipsparselt_matrix_type_dense,
+            handle,
+            B_row,
+            B_col,
+            B_row,
+            arg.b_type,
+            HIPSPARSE_ORDER_COL);
+        matC[g] = std::make_unique<hipsparselt_local_mat_descr>(
+            hipsparselt_matrix_type_dense, handle, M, N, M, arg.c_type, HIPSPARSE_ORDER_COL);
+        matD[g] = std::make_unique<hipsparselt_local_mat_descr>(
+            hipsparselt_matrix_type_dense, handle, M, N, M, arg.d_type, HIPSPARSE_ORDER_COL);
+
+        hipsparseStatus_t eStatus = expected_hipsparse_status_of_matrix_size(
+            arg.a_type, A_row, A_col, A_row, HIPSPARSE_ORDER_COL, !arg.sparse_b);
+        EXPECT_HIPSPARSE_STATUS(matA[g]->status(), eStatus);
+        if(eStatus != HIPSPARSE_STATUS_SUCCESS)
+            return;
+        eStatus = expected_hipsparse_status_of_matrix_size(
+            arg.b_type, B_row, B_col, B_row, HIPSPARSE_ORDER_COL, arg.sparse_b);
+        EXPECT_HIPSPARSE_STATUS(matB[g]->status(), eStatus);
+        if(eStatus != HIPSPARSE_STATUS_SUCCESS)
+            return;
+        EXPECT_HIPSPARSE_STATUS(matC[g]->status(), HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(matD[g]->status(), HIPSPARSE_STATUS_SUCCESS);
+
+        matmul[g] = std::make_unique<hipsparselt_local_matmul_descr>(
+            handle, transA, transB, *matA[g], *matB[g], *matC[g], *matD[g], arg.compute_type);
+        EXPECT_HIPSPARSE_STATUS(matmul[g]->status(), HIPSPARSE_STATUS_SUCCESS);
+        if(matmul[g]->status() != HIPSPARSE_STATUS_SUCCESS)
+            return;
+
+        if(arg.activation_type == hipsparselt_activation_type::relu)
+        {
+            int activation_on = 1;
+            EXPECT_HIPSPARSE_STATUS(
+                hipsparseLtMatmulDescSetAttribute(handle,
+                                                  *matmul[g],
+                                                  HIPSPARSELT_MATMUL_ACTIVATION_RELU,
+                                                  &activation_on,
+                                                  sizeof(activation_on)),
+                HIPSPARSE_STATUS_SUCCESS);
+        }
+
+        alg_sel[g] = std::make_unique<hipsparselt_local_matmul_alg_selection>(
+            handle, *matmul[g], HIPSPARSELT_MATMUL_ALG_DEFAULT);
+        if(arg.split_k)
+        {
+            EXPECT_HIPSPARSE_STATUS(
+                hipsparseLtMatmulAlgSetAttribute(
+                    handle, *alg_sel[g], HIPSPARSELT_MATMUL_SPLIT_K, &arg.split_k, sizeof(int)),
+                HIPSPARSE_STATUS_SUCCESS);
+            EXPECT_HIPSPARSE_STATUS(
+                hipsparseLtMatmulAlgSetAttribute(handle,
+                                                 *alg_sel[g],
+                                                 HIPSPARSELT_MATMUL_SPLIT_K_MODE,
+                                                 &arg.split_k_mode,
+                                                 sizeof(int)),
+                HIPSPARSE_STATUS_SUCCESS);
+        }
+    }
+
+    // The bias pointers are set before the plans, which copy the descriptors
+    const size_t         size_bias = off_bias[group_count];
+    device_vector<TBias> dBias(size_bias, 1, HMM);
+    host_vector<TBias>   hBias(size_bias);
+    CHECK_DEVICE_ALLOCATION(dBias.memcheck());
+    hipsparselt_seedrand();
+    if(arg.bias_vector)
+    {
+        hipsparselt_init<TBias>(hBias, size_bias, 1, size_bias);
+        CHECK_HIP_ERROR(dBias.transfer_from(hBias));
+        for(int32_t g = 0; g < group_count; g++)
+        {
+            void* _dBias = static_cast<TBias*>(dBias) + off_bias[g];
+            EXPECT_HIPSPARSE_STATUS(
+                hipsparseLtMatmulDescSetAttribute(
+                    handle, *matmul[g], HIPSPARSELT_MATMUL_BIAS_POINTER, &_dBias, sizeof(void*)),
+                HIPSPARSE_STATUS_SUCCESS);
+#ifdef __HIP_PLATFORM_AMD__
+            EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulDescSetAttribute(handle,
+                                                                      *matmul[g],
+                                                                      HIPSPARSELT_MATMUL_BIAS_TYPE,
+                                                                      &bias_type,
+                                                                      sizeof(hipDataType)),
+                                    HIPSPARSE_STATUS_SUCCESS);
+#endif
+        }
+    }
+
+    for(int32_t g = 0; g < group_count; g++)
+    {
+        plan[g] = std::make_unique<hipsparselt_local_matmul_plan>(handle, *matmul[g], *alg_sel[g]);
+        EXPECT_HIPSPARSE_STATUS(plan[g]->status(), HIPSPARSE_STATUS_SUCCESS);
+        if(plan[g]->status() != HIPSPARSE_STATUS_SUCCESS)
+            return;
+
+        size_t compressed_size = 0, buffer_size = 0;
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtSpMMACompressedSize(handle, *plan[g], &compressed_size, &buffer_size),
+            HIPSPARSE_STATUS_SUCCESS);
+        off_compressed[g + 1] = align(off_compressed[g] + compressed_size, 1);
+        compress_buffer_size  = std::max(compress_buffer_size, buffer_size);
+    }
+
+    std::vector<hipsparseLtMatmulGroup_t> groups(group_count);
+    for(int32_t g = 0; g < group_count; g++)
+        groups[g].plan = *plan[g];
+
+    size_t workspace_size = 0;
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulGroupedGetWorkspace(handle, groups.data(), group_count, &workspace_size),
+        HIPSPARSE_STATUS_SUCCESS);
+
+    const size_t size_A = off_A[group_count];
+    const size_t size_B = off_B[group_count];
+    const size_t size_C = off_C[group_count];
+
+    device_vector<Ti>            dA(size_A, 1, HMM);
+    device_vector<Ti>            dB(size_B, 1, HMM);
+    device_vector<To>            dC(size_C, 1, HMM);
+    device_vector<To>            dD(size_C, 1, HMM);
+    device_vector<unsigned char> d_compressed(off_compressed[group_count], 1, HMM);
+    device_vector<unsigned char> d_compressBuffer(compress_buffer_size, 1, HMM);
+    device_vector<unsigned char> dWorkspace(workspace_size, 1, HMM);
+    CHECK_DEVICE_ALLOCATION(dA.memcheck());
+    CHECK_DEVICE_ALLOCATION(dB.memcheck());
+    CHECK_DEVICE_ALLOCATION(dC.memcheck());
+    CHECK_DEVICE_ALLOCATION(dD.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_compressed.memcheck());
+    CHECK_DEVICE_ALLOCATION(dWorkspace.memcheck());
+
+    host_vector<Ti>     hA(size_A);
+    host_vector<Ti>     hB(size_B);
+    host_vector<To>     hC(size_C);
+    host_vector<To>     hD_gold(size_C);
+    host_vector<Talpha> hD_gold_act(size_C);
+    host_vector<To>     hD_1(size_C);
+
+    hipsparselt_init<Ti>(hA, size_A, 1, size_A);
+    hipsparselt_init_alternating_sign<Ti>(hB, size_B, 1, size_B);
+    hipsparselt_init<To>(hC, size_C, 1, size_C);
+    std::copy(hC.begin(), hC.end(), hD_gold.begin());
+    CHECK_HIP_ERROR(dA.transfer_from(hA));
+    CHECK_HIP_ERROR(dB.transfer_from(hB));
+    CHECK_HIP_ERROR(dC.transfer_from(hC));
+
+    // Prune and compress the structured matrix of every group in place
+    for(int32_t g = 0; g < group_count; g++)
+    {
+        void* dP = arg.sparse_b ? static_cast<void*>(static_cast<Ti*>(dB) + off_B[g])
+                                : static_cast<void*>(static_cast<Ti*>(dA) + off_A[g]);
+        void* dCompressed = static_cast<unsigned char*>(d_compressed) + off_compressed[g];
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtSpMMAPrune(
+                handle, *matmul[g], dP, dP, HIPSPARSELT_PRUNE_SPMMA_STRIP, stream),
+            HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtSpMMACompress(handle, *plan[g], dP, dCompressed, d_compressBuffer, stream),
+            HIPSPARSE_STATUS_SUCCESS);
+
+        groups[g].alpha = &h_alpha;
+        groups[g].beta  = &h_beta;
+        groups[g].d_A   = arg.sparse_b ? static_cast<const void*>(static_cast<Ti*>(dA) + off_A[g])
+                                       : dCompressed;
+        groups[g].d_B   = arg.sparse_b ? dCompressed
+                                       : static_cast<const void*>(static_cast<Ti*>(dB) + off_B[g]);
+        groups[g].d_C   = static_cast<To*>(dC) + off_C[g];
+        groups[g].d_D   = static_cast<To*>(dD) + off_C[g];
+    }
+
+    CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+    if(arg.sparse_b)
+        CHECK_HIP_ERROR(hB.transfer_from(dB));
+    else
+        CHECK_HIP_ERROR(hA.transfer_from(dA));
+
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulGrouped(handle, groups.data(), group_count, dWorkspace, &stream, 1),
+        HIPSPARSE_STATUS_SUCCESS);
+
+    if(arg.unit_check)
+    {
+        const bool relu     = arg.activation_type == hipsparselt_activation_type::relu;
+        const bool epilogue = arg.bias_vector || relu;
+        for(int32_t g = 0; g < group_count; g++)
+        {
+            int64_t M = Ms[g], N = Ns[g], K = Ks[g];
+            int64_t lda   = transA == HIPSPARSE_OPERATION_NON_TRANSPOSE ? M : K;
+            int64_t ldb   = transB == HIPSPARSE_OPERATION_NON_TRANSPOSE ? K : N;
+            int64_t pos   = off_C[g];
+            int64_t sizeA = off_A[g + 1] - off_A[g];
+            int64_t sizeB = off_B[g + 1] - off_B[g];
+
+            if(epilogue)
+            {
+                std::transform(hC + pos, hC + pos + M * N, hD_gold_act + pos, [](To c) -> Talpha {
+                    return static_cast<Talpha>(c);
+                });
+                cblas_gemm<Ti, Talpha, Talpha>(HIPSPARSE_ORDER_COL,
+                                               transA,
+                                               transB,
+                                               M,
+                                               N,
+                                               K,
+                                               h_alpha,
+                                               hA + off_A[g],
+                                               lda,
+                                               sizeA,
+                                               hB + off_B[g],
+                                               ldb,
+                                               sizeB,
+                                               h_beta,
+                                               hD_gold_act + pos,
+                                               M,
+                                               M * N,
+                                               nullptr,
+                                               nullptr,
+                                               false);
+                if(arg.bias_vector)
+                    bias<Talpha, TBias, Talpha, HIPSPARSE_ORDER_COL>(
+                        M, N, M, hD_gold_act + pos, hD_gold_act + pos, hBias + off_bias[g]);
+                if(relu)
+                    activation(M,
+                               N,
+                               M,
+                               hD_gold_act + pos,
+                               hD_gold + pos,
+                               arg.activation_arg1,
+                               arg.activation_arg2,
+                               ::_relu);
+                else
+                    std::transform(hD_gold_act + pos,
+                                   hD_gold_act + pos + M * N,
+                                   hD_gold + pos,
+                                   [](Talpha d) -> To { return static_cast<To>(d); });
+            }
+            else if constexpr(!quantized_output<Ti, To>)
+                cblas_gemm<Ti, To, Talpha>(HIPSPARSE_ORDER_COL,
+                                           transA,
+                                           transB,
+                                           M,
+                                           N,
+                                           K,
+                                           h_alpha,
+                                           hA + off_A[g],
+                                           lda,
+                                           sizeA,
+                                           hB + off_B[g],
+                                           ldb,
+                                           sizeB,
+                                           h_beta,
+                                           hD_gold + pos,
+                                           M,
+                                           M * N,
+                                           nullptr,
+                                           nullptr,
+                                           false);
+        }
+
+        CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+        CHECK_HIP_ERROR(hD_1.transfer_from(dD));
+
+        for(int32_t g = 0; g < group_count; g++)
+            unit_check_general<To>(Ms[g], Ns[g], Ms[g], 0, hD_gold + off_C[g], hD_1 + off_C[g], 1);
+    }
+
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+}
+
+// The structured matrix holds int8 or packed int4 weights of arg.weight_bits, while the types of
+// A and B in the arguments are that of the dense matrix
+template <typename Ti, typename To, typename Tc>
+void testing_spmm_weight_only(const Arguments& arg)
+{
+    hipsparseOperation_t transA = char_to_hipsparselt_operation(arg.transA);
+    hipsparseOperation_t transB = char_to_hipsparselt_operation(arg.transB);
+
+    using Talpha = float;
+
+    Talpha h_alpha = arg.get_alpha<Talpha>();
+    Talpha h_beta  = arg.get_beta<Talpha>();
+
+    int64_t M = arg.M;
+    int64_t N = arg.N;
+    int64_t K = arg.K;
+
+    bool                     HMM = arg.HMM || arg.host_backend;
+    hipsparselt_local_handle handle{arg};
+    hipStream_t              stream;
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+
+    const bool        int4   = arg.weight_bits == 4;
+    const hipDataType w_type = int4 ? HIP_R_4I : HIP_R_8I;
+
+    int64_t A_row = transA == HIPSPARSE_OPERATION_NON_TRANSPOSE ? M : K;
+    int64_t A_col = transA == HIPSPARSE_OPERATION_NON_TRANSPOSE ? K : M;
+    int64_t B_row = transB == HIPSPARSE_OPERATION_NON_TRANSPOSE ? K : N;
+    int64_t B_col = transB == HIPSPARSE_OPERATION_NON_TRANSPOSE ? N : K;
+    int64_t W_row = arg.sparse_b ? B_row : A_row;
+    int64_t W_col = arg.sparse_b ? B_col : A_col;
+    int64_t X_row = arg.sparse_b ? A_row : B_row;
+    int64_t X_col = arg.sparse_b ? A_col : B_col;
+
+    hipsparselt_local_mat_descr matA(arg.sparse_b ? hipsparselt_matrix_type_dense
+                                                  : hipsparselt_matrix_type_structured,
+                                     handle,
+                                     A_row,
+                                     A_col,
+                                     A_row,
+                                     arg.sparse_b ? arg.a_type : w_type,
+                                     HIPSPARSE_ORDER_COL);
+    hipsparselt_local_mat_descr matB(arg.sparse_b ? hipsparselt_matrix_type_structured
+                                                  : hipsparselt_matrix_type_dense,
+                                     handle,
+                                     B_row,
+                                     B_col,
+                                     B_row,
+                                     arg.sparse_b ? w_type : arg.b_type,
+                                     HIPSPARSE_ORDER_COL);
+    hipsparselt_local_mat_descr matC(
+        hipsparselt_matrix_type_dense, handle, M, N, M, arg.c_type, HIPSPARSE_ORDER_COL);
+    hipsparselt_local_mat_descr matD(
+        hipsparselt_matrix_type_dense, handle, M, N, M, arg.d_type, HIPSPARSE_ORDER_COL);
+    EXPECT_HIPSPARSE_STATUS(matA.status(), HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(matB.status(), HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(matC.status(), HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(matD.status(), HIPSPARSE_STATUS_SUCCESS);
+    if(matA.status() != HIPSPARSE_STATUS_SUCCESS || matB.status() != HIPSPARSE_STATUS_SUCCESS)
+        return;
+
+    hipsparselt_local_matmul_descr matmul(
+        handle, transA, transB, matA, matB, matC, matD, arg.compute_type);
+    EXPECT_HIPSPARSE_STATUS(matmul.status(), HIPSPARSE_STATUS_SUCCESS);
+    if(matmul.status() != HIPSPARSE_STATUS_SUCCESS)
+        return;
+
+    // Group g of row r of the structured matrix, along M for A and along N for B, has the scale
+    // and zero point at r * groups + g. Integer weights and zero points and dense values, with
+    // scales that are powers of two, keep every product and sum of the reference exact.
+    const int64_t w_rows  = arg.sparse_b ? N : M;
+    const int64_t group_k = arg.weight_group > 0 ? arg.weight_group : K;
+    const int64_t groups  = (K + group_k - 1) / group_k;
+    const size_t  size_w_scale = w_rows * groups;
+
+    device_vector<float> dScale(size_w_scale, 1, HMM);
+    device_vector<float> dZero(arg.weight_zero ? size_w_scale : 0, 1, HMM);
+    CHECK_DEVICE_ALLOCATION(dScale.memcheck());
+    CHECK_DEVICE_ALLOCATION(dZero.memcheck());
+    host_vector<float> hScale(size_w_scale);
+    host_vector<float> hZero(arg.weight_zero ? size_w_scale : 0);
+    for(size_t i = 0; i < size_w_scale; i++)
+        hScale[i] = std::ldexp(1.f, -static_cast<int>(i % 3));
+    for(size_t i = 0; i < hZero.size(); i++)
+        hZero[i] = static_cast<float>(i % 3) - 1.f;
+    CHECK_HIP_ERROR(dScale.transfer_from(hScale));
+
+    void* _dScale = dScale;
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescSetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_WEIGHT_SCALE_POINTER, &_dScale, sizeof(void*)),
+        HIPSPARSE_STATUS_SUCCESS);
+    if(arg.weight_zero)
+    {
+        CHECK_HIP_ERROR(dZero.transfer_from(hZero));
+        void* _dZero = dZero;
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(
+                handle, matmul, HIPSPARSELT_MATMUL_WEIGHT_ZERO_POINTER, &_dZero, sizeof(void*)),
+            HIPSPARSE_STATUS_SUCCESS);
+    }
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulDescSetAttribute(handle,
+                                                              matmul,
+                                                              HIPSPARSELT_MATMUL_WEIGHT_GROUP_SIZE,
+                                                              &arg.weight_group,
+                                                              sizeof(int)),
+                            HIPSPARSE_STATUS_SUCCESS);
+
+    hipsparselt_local_matmul_alg_selection alg_sel(handle, matmul, HIPSPARSELT_MATMUL_ALG_DEFAULT);
+    EXPECT_HIPSPARSE_STATUS(alg_sel.status(), HIPSPARSE_STATUS_SUCCESS);
+    if(alg_sel.status() != HIPSPARSE_STATUS_SUCCESS)
+        return;
+
+    hipsparselt_local_matmul_plan plan(handle, matmul, alg_sel);
+    EXPECT_HIPSPARSE_STATUS(plan.status(), HIPSPARSE_STATUS_SUCCESS);
+    if(plan.status() != HIPSPARSE_STATUS_SUCCESS)
+        return;
+
+    size_t compressed_size = 0, compress_buffer_size = 0, workspace_size = 0;
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtSpMMACompressedSize(handle, plan, &compressed_size, &compress_buffer_size),
+        HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulGetWorkspace(handle, plan, &workspace_size),
+                            HIPSPARSE_STATUS_SUCCESS);
+
+    // int4 weights are packed two to a byte
+    const size_t size_W       = W_row * W_col;
+    const size_t size_W_bytes = int4 ? (size_W + 1) / 2 : size_W;
+    const size_t size_X       = X_row * X_col;
+    const size_t size_C       = M * N;
+
+    device_vector<int8_t>        dW(size_W_bytes, 1, HMM);
+    device_vector<Ti>            dX(size_X, 1, HMM);
+    device_vector<To>            dC(size_C, 1, HMM);
+    device_vector<To>            dD(size_C, 1, HMM);
+    device_vector<unsigned char> d_compressed(compressed_size, 1, HMM);
+    device_vector<unsigned char> d_compressBuffer(compress_buffer_size, 1, HMM);
+    device_vector<unsigned char> dWorkspace(workspace_size, 1, HMM);
+    CHECK_DEVICE_ALLOCATION(dW.memcheck());
+    CHECK_DEVICE_ALLOCATION(dX.memcheck());
+    CHECK_DEVICE_ALLOCATION(dC.memcheck());
+    CHECK_DEVICE_ALLOCATION(dD.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_compressed.memcheck());
+    CHECK_DEVICE_ALLOCATION(dWorkspace.memcheck());
+
+    host_vector<int8_t> hW(size_W);
+    host_vector<int8_t> hW_bytes(size_W_bytes);
+    host_vector<Ti>     hX(size_X);
+    host_vector<To>     hC(size_C);
+    host_vector<To>     hD_gold(size_C);
+    host_vector<To>     hD_1(size_C);
+
+    // Weights of -3 to 3 fit both widths. Element e of an int4 matrix is the low nibble of byte
+    // e / 2 when e is even and the high nibble when it is odd.
+    hipsparselt_seedrand();
+    hipsparselt_init_alternating_sign<int8_t>(hW, W_row, W_col, W_row);
+    hipsparselt_init<Ti>(hX, X_row, X_col, X_row);
+    hipsparselt_init<To>(hC, M, N, M);
+    if(int4)
+    {
+        std::fill(hW_bytes.begin(), hW_bytes.end(), 0);
+        for(size_t e = 0; e < size_W; e++)
+            hW_bytes[e / 2] |= (hW[e] & 0xf) << (e % 2 * 4);
+    }
+    else
+        std::copy(hW.begin(), hW.end(), hW_bytes.begin());
+    CHECK_HIP_ERROR(dW.transfer_from(hW_bytes));
+    CHECK_HIP_ERROR(dX.transfer_from(hX));
+    CHECK_HIP_ERROR(dC.transfer_from(hC));
+
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtSpMMAPrune(handle, matmul, dW, dW, HIPSPARSELT_PRUNE_SPMMA_STRIP, stream),
+        HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtSpMMACompress(handle, plan, dW, d_compressed, d_compressBuffer, stream),
+        HIPSPARSE_STATUS_SUCCESS);
+
+    const void* dA_ = arg.sparse_b ? static_cast<const void*>(dX) : d_compressed;
+    const void* dB_ = arg.sparse_b ? d_compressed : static_cast<const void*>(dX);
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmul(
+            handle, plan, &h_alpha, dA_, dB_, &h_beta, dC, dD, dWorkspace, &stream, 1),
+        HIPSPARSE_STATUS_SUCCESS);
+
+    if(arg.unit_check)
+    {
+        CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+        CHECK_HIP_ERROR(hW_bytes.transfer_from(dW));
+        for(size_t e = 0; e < size_W; e++)
+            hW[e] = int4 ? static_cast<int8_t>(static_cast<uint8_t>(hW_bytes[e / 2])
+                                               << (4 - e % 2 * 4))
+                               >> 4
+                         : hW_bytes[e];
+
+        // The pruned weight of row r and dense K k, where a 0 stays 0 after the dequantization,
+        // and the dense value of column c of the other operand and dense K k
+        const bool w_r_rows = arg.sparse_b ? transB == HIPSPARSE_OPERATION_TRANSPOSE
+                                           : transA == HIPSPARSE_OPERATION_NON_TRANSPOSE;
+        const bool x_c_rows = arg.sparse_b ? transA == HIPSPARSE_OPERATION_NON_TRANSPOSE
+                                           : transB == HIPSPARSE_OPERATION_TRANSPOSE;
+        auto       w_at     = [&](int64_t r, int64_t k) -> float {
+            float   q = hW[w_r_rows ? r + k * W_row : k + r * W_row];
+            int64_t i = r * groups + k / group_k;
+            return q != 0.f ? hScale[i] * (q - (arg.weight_zero ? hZero[i] : 0.f)) : 0.f;
+        };
+        auto x_at = [&](int64_t c, int64_t k) -> float {
+            return static_cast<float>(hX[x_c_rows ? c + k * X_row : k + c * X_row]);
+        };
+
+        for(int64_t n = 0; n < N; n++)
+            for(int64_t m = 0; m < M; m++)
+            {
+                int64_t r = arg.sparse_b ? n : m;
+                int64_t c = arg.sparse_b ? m : n;
+                float   acc = 0.f;
+                for(int64_t k = 0; k < K; k++)
+                    acc += w_at(r, k) * x_at(c, k);
+                hD_gold[m + n * M] = static_cast<To>(
+                    h_alpha * acc + h_beta * static_cast<float>(hC[m + n * M]));
+            }
+
+        CHECK_HIP_ERROR(hD_1.transfer_from(dD));
+        unit_check_general<To>(M, N, M, 0, hD_gold, hD_1, 1);
+    }
+
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+}
+
+// One dynamic-M plan, with a structured B, runs at M / 2, then at M and at M / 2 again, so the
+// launch state of the plan has to follow M in both directions. The rows of D past each M keep
+// what they held before the call.
+template <typename Ti, typename To, typename Tc>
+void testing_spmm_dynamic_m(const Arguments& arg)
+{
+    hipsparseOperation_t transA = char_to_hipsparselt_operation(arg.transA);
+    hipsparseOperation_t transB = char_to_hipsparselt_operation(arg.transB);
+
+    using Talpha = float;
+
+    Talpha h_alpha = arg.get_alpha<Talpha>();
+    Talpha h_beta  = arg.get_beta<Talpha>();
+
+    int64_t M = arg.M;
+    int64_t N = arg.N;
+    int64_t K = arg.K;
+
+    bool                     HMM = arg.HMM || arg.host_backend;
+    hipsparselt_local_handle handle{arg};
+    hipStream_t              stream;
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+
+    int64_t A_row = transA == HIPSPARSE_OPERATION_NON_TRANSPOSE ? M : K;
+    int64_t A_col = transA == HIPSPARSE_OPERATION_NON_TRANSPOSE ? K : M;
+    int64_t B_row = transB == HIPSPARSE_OPERATION_NON_TRANSPOSE ? K : N;
+    int64_t B_col = transB == HIPSPARSE_OPERATION_NON_TRANSPOSE ? N : K;
+
+    hipsparselt_local_mat_descr matA(
+        hipsparselt_matrix_type_dense, handle, A_row, A_col, A_row, arg.a_type, HIPSPARSE_ORDER_COL);
+    hipsparselt_local_mat_descr matB(hipsparselt_matrix_type_structured,
+                                     handle,
+                                     B_row,
+                                     B_col,
+                                     B_row,
+                                     arg.b_type,
+                                     HIPSPARSE_ORDER_COL);
+    hipsparselt_local_mat_descr matC(
+        hipsparselt_matrix_type_dense, handle, M, N, M, arg.c_type, HIPSPARSE_ORDER_COL);
+    hipsparselt_local_mat_descr matD(
+        hipsparselt_matrix_type_dense, handle, M, N, M, arg.d_type, HIPSPARSE_ORDER_COL);
+    EXPECT_HIPSPARSE_STATUS(matA.status(), HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(matB.status(), HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(matC.status(), HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(matD.status(), HIPSPARSE_STATUS_SUCCESS);
+    if(matA.status() != HIPSPARSE_STATUS_SUCCESS || matB.status() != HIPSPARSE_STATUS_SUCCESS)
+        return;
+
+    hipsparselt_local_matmul_descr matmul(
+        handle, transA, transB, matA, matB, matC, matD, arg.compute_type);
+    EXPECT_HIPSPARSE_STATUS(matmul.status(), HIPSPARSE_STATUS_SUCCESS);
+    if(matmul.status() != HIPSPARSE_STATUS_SUCCESS)
+        return;
+
+    const int64_t ms[]          = {M / 2, M, M / 2};
+    int64_t       dynamic_m_min = M / 2;
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulDescSetAttribute(handle,
+                                                              matmul,
+                                                              HIPSPARSELT_MATMUL_DYNAMIC_M_MIN,
+                                                              &dynamic_m_min,
+                                                              sizeof(dynamic_m_min)),
+                            HIPSPARSE_STATUS_SUCCESS);
+
+    hipsparselt_local_matmul_alg_selection alg_sel(handle, matmul, HIPSPARSELT_MATMUL_ALG_DEFAULT);
+    EXPECT_HIPSPARSE_STATUS(alg_sel.status(), HIPSPARSE_STATUS_SUCCESS);
+    if(alg_sel.status() != HIPSPARSE_STATUS_SUCCESS)
+        return;
+
+    hipsparselt_local_matmul_plan plan(handle, matmul, alg_sel);
+    EXPECT_HIPSPARSE_STATUS(plan.status(), HIPSPARSE_STATUS_SUCCESS);
+    if(plan.status() != HIPSPARSE_STATUS_SUCCESS)
+        return;
+
+    size_t compressed_size = 0, compress_buffer_size = 0, workspace_size = 0;
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtSpMMACompressedSize(handle, plan, &compressed_size, &compress_buffer_size),
+        HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulGetWorkspace(handle, plan, &workspace_size),
+                            HIPSPARSE_STATUS_SUCCESS);
+
+    const size_t size_A = A_row * A_col;
+    const size_t size_B = B_row * B_col;
+    const size_t size_C = M * N;
+
+    device_vector<Ti>            dA(size_A, 1, HMM);
+    device_vector<Ti>            dB(size_B, 1, HMM);
+    device_vector<To>            dC(size_C, 1, HMM);
+    device_vector<To>            dD(size_C, 1, HMM);
+    device_vector<unsigned char> d_compressed(compressed_size, 1, HMM);
+    device_vector<unsigned char> d_compressBuffer(compress_buffer_size, 1, HMM);
+    device_vector<unsigned char> dWorkspace(workspace_size, 1, HMM);
+    CHECK_DEVICE_ALLOCATION(dA.memcheck());
+    CHECK_DEVICE_ALLOCATION(dB.memcheck());
+    CHECK_DEVICE_ALLOCATION(dC.memcheck());
+    CHECK_DEVICE_ALLOCATION(dD.memcheck());
+    CHECK_DEVICE_ALLOCATION(d_compressed.memcheck());
+    CHECK_DEVICE_ALLOCATION(dWorkspace.memcheck());
+
+    host_vector<Ti> hA(size_A);
+    host_vector<Ti> hB(size_B);
+    host_vector<To> hC(size_C);
+    host_vector<To> hD_init(size_C);
+    host_vector<To> hD_gold(size_C);
+    host_vector<To> hD_1(size_C);
+
+    hipsparselt_seedrand();
+    hipsparselt_init<Ti>(hA, A_row, A_col, A_row);
+    hipsparselt_init_alternating_sign<Ti>(hB, B_row, B_col, B_row);
+    hipsparselt_init<To>(hC, M, N, M);
+    hipsparselt_init<To>(hD_init, M, N, M);
+    CHECK_HIP_ERROR(dA.transfer_from(hA));
+    CHECK_HIP_ERROR(dB.transfer_from(hB));
+    CHECK_HIP_ERROR(dC.transfer_from(hC));
+
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtSpMMAPrune(handle, matmul, dB, dB, HIPSPARSELT_PRUNE_SPMMA_STRIP, stream),
+        HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtSpMMACompress(handle, plan, dB, d_compressed, d_compressBuffer, stream),
+        HIPSPARSE_STATUS_SUCCESS);
+    CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+    CHECK_HIP_ERROR(hB.transfer_from(dB));
+
+    for(int64_t m : ms)
+    {
+        CHECK_HIP_ERROR(dD.transfer_from(hD_init));
+        EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulDynamicM(handle,
+                                                          plan,
+                                                          m,
+                                                          &h_alpha,
+                                                          dA,
+                                                          d_compressed,
+                                                          &h_beta,
+                                                          dC,
+                                                          dD,
+                                                          dWorkspace,
+                                                          &stream,
+                                                          1),
+                                HIPSPARSE_STATUS_SUCCESS);
+
+        if(arg.unit_check)
+        {
+            // The first m rows of op(A), C and D keep the leading dimensions of M rows
+            std::copy(hD_init.begin(), hD_init.end(), hD_gold.begin());
+            for(int64_t j = 0; j < N; j++)
+                std::copy(hC + j * M, hC + j * M + m, hD_gold + j * M);
+            cblas_gemm<Ti, To, Talpha>(HIPSPARSE_ORDER_COL,
+                                       transA,
+                                       transB,
+                                       m,
+                                       N,
+                                       K,
+                                       h_alpha,
+                                       hA,
+                                       A_row,
+                                       size_A,
+                                       hB,
+                                       B_row,
+                                       size_B,
+                                       h_beta,
+                                       hD_gold,
+                                       M,
+                                       size_C,
+                                       nullptr,
+                                       nullptr,
+                                       false);
+
+            CHECK_HIP_ERROR(hipStreamSynchronize(stream));
+            CHECK_HIP_ERROR(hD_1.transfer_from(dD));
+            unit_check_general<To>(M, N, M, 0, hD_gold, hD_1, 1);
+        }
+    }
+
+    CHECK_HIP_ERROR(hipStreamDestroy(stream));
+}
+
+template <typename Ti,
+          typename To,
+          typename Tc,
+          hipsparselt_batch_type btype = hipsparselt_batch_type::none>
+void testing_aux_plan_assign(const Arguments& arg)
+{
+    hipsparseOperation_t transA = char_to_hipsparselt_operation(arg.transA);
+    hipsparseOperation_t transB = char_to_hipsparselt_operation(arg.transB);
+
+    using Talpha = float;
+
+    int64_t M       = arg.M;
+    int64_t N       = arg.N;
+    int64_t K       = arg.K;
+    Talpha  h_alpha = arg.get_alpha<Talpha>();
+    Talpha  h_beta  = arg.get_beta<Talpha>();
+    int64_t lda     = arg.lda;
+    int64_t ldb     = arg.ldb;
+    int64_t ldc     = arg.ldc;
+    int64_t ldd     = arg.ldd;
+
+    double gpu_time_used, cpu_time_used;
+    gpu_time_used = cpu_time_used              = 0.0;
+    double                   hipsparselt_error = 0.0;
+    bool                     HMM               = arg.HMM || arg.host_backend;
+    hipsparselt_local_handle handle{arg};
+    hipStream_t              stream;
+    CHECK_HIP_ERROR(hipStreamCreate(&stream));
+
+    hipsparseOrder_t orderA = char_to_hipsparselt_order(arg.orderA);
+    hipsparseOrder_t orderB = char_to_hipsparselt_order(arg.orderB);
+    hipsparseOrder_t orderC = char_to_hipsparselt_order(arg.orderC);
+    hipsparseOrder_t orderD = char_to_hipsparselt_order(arg.orderD);
+
+    int64_t A_row = transA == HIPSPARSE_OPERATION_NON_TRANSPOSE ? M : K;
+    int64_t A_col = transA == HIPSPARSE_OPERATION_NON_TRANSPOSE ? K : M;
+    int64_t B_row = transB == HIPSPARSE_OPERATION_NON_TRANSPOSE ? K : N;
+    int64_t B_col = transB == HIPSPARSE_OPERATION_NON_TRANSPOSE ? N : K;
+
+    int64_t stride_1_a = transA == HIPSPARSE_OPERATION_NON_TRANSPOSE ? 1 : lda;
+    int64_t stride_2_a = transA == HIPSPARSE_OPERATION_NON_TRANSPOSE ? lda : 1;
+
+    constexpr bool do_batched         = (btype == hipsparselt_batch_type::batched);
+    constexpr bool do_strided_batched = (btype == hipsparselt_batch_type::strided_batched);
+    int            num_batches        = 5;
+    int64_t        stride_a           = lda * A_col;
+    int64_t        stride_b           = ldb * B_col;
+    int64_t        stride_c           = ldc * N;
+    int64_t        stride_d           = ldd * N;
+
+    hipsparselt_local_mat_descr matA(
+        hipsparselt_matrix_type_structured, handle, A_row, A_col, lda, arg.a_type, orderA);
+    hipsparselt_local_mat_descr matB(
+        hipsparselt_matrix_type_dense, handle, B_row, B_col, ldb, arg.b_type, orderB);
+    hipsparselt_local_mat_descr matC(
+        hipsparselt_matrix_type_dense, handle, M, N, ldc, arg.c_type, orderC);
+    hipsparselt_local_mat_descr matD(
+        hipsparselt_matrix_type_dense, handle, M, N, ldc, arg.d_type, orderD);
+
+    hipsparseStatus_t eStatus = expected_hipsparse_status_of_matrix_size(
+        arg.a_type, A_row, A_col, lda, orderA, !arg.sparse_b);
     EXPECT_HIPSPARSE_STATUS(matA.status(), eStatus);
     if(eStatus != HIPSPARSE_STATUS_SUCCESS)
         return;
@@ -1380,6 +2651,7 @@ void testing_aux_plan_assign(const Arguments& arg)
                                                          ldd,
                                                          ldd * N,
                                                          nullptr,
+                                                         nullptr,
                                                          false);
 
                           auto pos = stride_d * i;
@@ -1405,6 +2677,7 @@ void testing_aux_plan_assign(const Arguments& arg)
                                                      ldd,
                                                      ldd * N,
                                                      nullptr,
+                                                     nullptr,
                                                      false);
                   }
 #undef activation_param
@@ -37,6 +37,10 @@
 #include "utility.hpp"
 #include <hipsparselt/hipsparselt.h>
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 void testing_aux_handle_init_bad_arg(const Arguments& arg)
 {
     EXPECT_HIPSPARSE_STATUS(hipsparseLtInit(nullptr), HIPSPARSE_STATUS_INVALID_VALUE);
@@ -56,6 +60,36 @@ void testing_aux_handle(const Arguments& arg)
     EXPECT_HIPSPARSE_STATUS(hipsparseLtDestroy(&handle), HIPSPARSE_STATUS_SUCCESS);
 }
 
+void testing_aux_handle_backend(const Arguments& arg)
+{
+    hipsparselt_local_handle handle{arg};
+    hipsparseLtBackend_t     backend = HIPSPARSELT_BACKEND_HOST;
+
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtGetBackend(nullptr, &backend),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtGetBackend(handle, nullptr),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtSetBackend(nullptr, HIPSPARSELT_BACKEND_DEVICE),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtSetBackend(handle, static_cast<hipsparseLtBackend_t>(2)),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtSetBackend(handle, HIPSPARSELT_BACKEND_DEVICE),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtGetBackend(handle, &backend), HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_EQ(backend, HIPSPARSELT_BACKEND_DEVICE);
+
+#ifdef __HIP_PLATFORM_AMD__
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtSetBackend(handle, HIPSPARSELT_BACKEND_HOST),
+                            HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtGetBackend(handle, &backend), HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_EQ(backend, HIPSPARSELT_BACKEND_HOST);
+#else
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtSetBackend(handle, HIPSPARSELT_BACKEND_HOST),
+                            HIPSPARSE_STATUS_NOT_SUPPORTED);
+#endif
+}
+
 void testing_aux_mat_init_dense_bad_arg(const Arguments& arg)
 {
     const int64_t row = 128;
@@ -241,6 +275,32 @@ void testing_aux_mat_init_structured_bad_arg(const Arguments& arg)
 #endif
 }
 
+// F32 is only a dense output type and I4 only a structured weight type
+void testing_aux_mat_init_type_bad_arg(const Arguments& arg)
+{
+    const int64_t row = 128;
+    const int64_t col = 128;
+    const int64_t ld  = 128;
+
+    hipsparselt_local_handle handle{arg};
+
+    hipsparselt_local_mat_descr structured_f32(
+        hipsparselt_matrix_type_structured, handle, row, col, ld, HIP_R_32F, HIPSPARSE_ORDER_COL);
+    EXPECT_HIPSPARSE_STATUS(structured_f32.status(), HIPSPARSE_STATUS_NOT_SUPPORTED);
+
+    hipsparselt_local_mat_descr dense_i4(
+        hipsparselt_matrix_type_dense, handle, row, col, ld, HIP_R_4I, HIPSPARSE_ORDER_COL);
+    EXPECT_HIPSPARSE_STATUS(dense_i4.status(), HIPSPARSE_STATUS_NOT_SUPPORTED);
+
+    hipsparselt_local_mat_descr dense_f32(
+        hipsparselt_matrix_type_dense, handle, row, col, ld, HIP_R_32F, HIPSPARSE_ORDER_COL);
+    EXPECT_HIPSPARSE_STATUS(dense_f32.status(), HIPSPARSE_STATUS_SUCCESS);
+
+    hipsparselt_local_mat_descr structured_i4(
+        hipsparselt_matrix_type_structured, handle, row, col, ld, HIP_R_4I, HIPSPARSE_ORDER_COL);
+    EXPECT_HIPSPARSE_STATUS(structured_i4.status(), HIPSPARSE_STATUS_SUCCESS);
+}
+
 void testing_aux_mat_dense_init(const Arguments& arg)
 {
     const int64_t row = 128;
@@ -990,6 +1050,175 @@ void testing_aux_matmul_set_get_attr(const Arguments& arg)
             handle, matmul, HIPSPARSELT_MATMUL_ACTIVATION_RELU_UPPERBOUND, &dataf_r, sizeof(dataf)),
         HIPSPARSE_STATUS_SUCCESS);
     ASSERT_TRUE(dataf == dataf_r);
+
+#ifdef __HIP_PLATFORM_AMD__
+    // The scales are kept as pointers, which the matmul reads
+    const float* scale   = &dataf;
+    const float* scale_r = nullptr;
+    for(auto attr : {HIPSPARSELT_MATMUL_A_SCALE_POINTER, HIPSPARSELT_MATMUL_B_SCALE_POINTER})
+    {
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle, matmul, attr, &scale, sizeof(scale)),
+            HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescGetAttribute(handle, matmul, attr, &scale_r, sizeof(scale_r)),
+            HIPSPARSE_STATUS_SUCCESS);
+        ASSERT_TRUE(scale == scale_r);
+        scale_r = nullptr;
+    }
+
+    // SiLU is not available with an int8 D, like sigmoid and tanh
+    const bool int8_d = arg.d_type == HIP_R_8I;
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescSetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_ACTIVATION_SILU, &data, sizeof(data)),
+        int8_d ? HIPSPARSE_STATUS_NOT_SUPPORTED : HIPSPARSE_STATUS_SUCCESS);
+    data_r = -1;
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescGetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_ACTIVATION_SILU, &data_r, sizeof(data)),
+        HIPSPARSE_STATUS_SUCCESS);
+    ASSERT_TRUE(data_r == (int8_d ? 0 : 1));
+
+    dataf = 1.702f;
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescSetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_ACTIVATION_SILU_BETA, &dataf, sizeof(dataf)),
+        HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescGetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_ACTIVATION_SILU_BETA, &dataf_r, sizeof(dataf)),
+        HIPSPARSE_STATUS_SUCCESS);
+    ASSERT_TRUE(dataf == dataf_r);
+
+    // Enabling one activation disables the others
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescSetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_ACTIVATION_HARDSWISH, &data, sizeof(data)),
+        HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescGetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_ACTIVATION_HARDSWISH, &data_r, sizeof(data)),
+        HIPSPARSE_STATUS_SUCCESS);
+    ASSERT_TRUE(data == data_r);
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescGetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_ACTIVATION_SILU, &data_r, sizeof(data)),
+        HIPSPARSE_STATUS_SUCCESS);
+    ASSERT_TRUE(data_r == 0);
+
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescSetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_GATED_EPILOGUE, &data, sizeof(data)),
+        HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescGetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_GATED_EPILOGUE, &data_r, sizeof(data)),
+        HIPSPARSE_STATUS_SUCCESS);
+    ASSERT_TRUE(data == data_r);
+
+    // So are the scales and the maxima of D
+    for(auto attr : {HIPSPARSELT_MATMUL_D_SCALE_POINTER, HIPSPARSELT_MATMUL_D_AMAX_POINTER})
+    {
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle, matmul, attr, &scale, sizeof(scale)),
+            HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescGetAttribute(handle, matmul, attr, &scale_r, sizeof(scale_r)),
+            HIPSPARSE_STATUS_SUCCESS);
+        ASSERT_TRUE(scale == scale_r);
+        scale_r = nullptr;
+    }
+
+    int rounding = HIPSPARSELT_ROUNDING_STOCHASTIC, rounding_r = 0;
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescSetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_D_ROUNDING_MODE, &rounding, sizeof(rounding)),
+        HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescGetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_D_ROUNDING_MODE, &rounding_r, sizeof(rounding)),
+        HIPSPARSE_STATUS_SUCCESS);
+    ASSERT_TRUE(rounding == rounding_r);
+    rounding = 2;
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescSetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_D_ROUNDING_MODE, &rounding, sizeof(rounding)),
+        HIPSPARSE_STATUS_INVALID_VALUE);
+
+    uint64_t seed = 0x0123456789abcdef, seed_r = 0;
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescSetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_D_ROUNDING_SEED, &seed, sizeof(seed)),
+        HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescGetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_D_ROUNDING_SEED, &seed_r, sizeof(seed)),
+        HIPSPARSE_STATUS_SUCCESS);
+    ASSERT_TRUE(seed == seed_r);
+
+    // and the residual and the bias gradient
+    for(auto attr :
+        {HIPSPARSELT_MATMUL_RESIDUAL_POINTER, HIPSPARSELT_MATMUL_BIAS_GRADIENT_POINTER})
+    {
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle, matmul, attr, &scale, sizeof(scale)),
+            HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescGetAttribute(handle, matmul, attr, &scale_r, sizeof(scale_r)),
+            HIPSPARSE_STATUS_SUCCESS);
+        ASSERT_TRUE(scale == scale_r);
+        scale_r = nullptr;
+    }
+
+    int grad_mode = HIPSPARSELT_BIAS_GRADIENT_COLUMNS, grad_mode_r = 0;
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescSetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_BIAS_GRADIENT_MODE, &grad_mode, sizeof(grad_mode)),
+        HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulDescGetAttribute(handle,
+                                                              matmul,
+                                                              HIPSPARSELT_MATMUL_BIAS_GRADIENT_MODE,
+                                                              &grad_mode_r,
+                                                              sizeof(grad_mode)),
+                            HIPSPARSE_STATUS_SUCCESS);
+    ASSERT_TRUE(grad_mode == grad_mode_r);
+    grad_mode = 2;
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescSetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_BIAS_GRADIENT_MODE, &grad_mode, sizeof(grad_mode)),
+        HIPSPARSE_STATUS_INVALID_VALUE);
+
+    // and the dequantization of weight-only matrices
+    for(auto attr :
+        {HIPSPARSELT_MATMUL_WEIGHT_SCALE_POINTER, HIPSPARSELT_MATMUL_WEIGHT_ZERO_POINTER})
+    {
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescSetAttribute(handle, matmul, attr, &scale, sizeof(scale)),
+            HIPSPARSE_STATUS_SUCCESS);
+        EXPECT_HIPSPARSE_STATUS(
+            hipsparseLtMatmulDescGetAttribute(handle, matmul, attr, &scale_r, sizeof(scale_r)),
+            HIPSPARSE_STATUS_SUCCESS);
+        ASSERT_TRUE(scale == scale_r);
+        scale_r = nullptr;
+    }
+
+    int group = 32, group_r = 0;
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescSetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_WEIGHT_GROUP_SIZE, &group, sizeof(group)),
+        HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescGetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_WEIGHT_GROUP_SIZE, &group_r, sizeof(group)),
+        HIPSPARSE_STATUS_SUCCESS);
+    ASSERT_TRUE(group == group_r);
+    group = 12;
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulDescSetAttribute(
+            handle, matmul, HIPSPARSELT_MATMUL_WEIGHT_GROUP_SIZE, &group, sizeof(group)),
+        HIPSPARSE_STATUS_INVALID_VALUE);
+#endif
 }
 
 void testing_aux_matmul_assign(const Arguments& arg)
@@ -1292,10 +1521,38 @@ void testing_aux_matmul_alg_set_attr_bad_arg(const Arguments& arg)
         HIPSPARSE_STATUS_INVALID_VALUE);
 
 #ifdef __HIP_PLATFORM_AMD__
-    //TODO hip backend not support split k yet. Remove this test once hip backend support splitk
     EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulAlgSetAttribute(
                                 handle, alg_sel, HIPSPARSELT_MATMUL_SPLIT_K, &data, sizeof(data)),
-                            HIPSPARSE_STATUS_NOT_SUPPORTED);
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+
+    // split-K buffers are only valid after a split-K factor > 1
+    int split_k_buffers = 1;
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulAlgSetAttribute(handle,
+                                                             alg_sel,
+                                                             HIPSPARSELT_MATMUL_SPLIT_K_BUFFERS,
+                                                             &split_k_buffers,
+                                                             sizeof(split_k_buffers)),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+
+    int split_k_mode = 2;
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulAlgSetAttribute(handle,
+                                                             alg_sel,
+                                                             HIPSPARSELT_MATMUL_SPLIT_K_MODE,
+                                                             &split_k_mode,
+                                                             sizeof(split_k_mode)),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
+
+    int split_k = 1;
+    EXPECT_HIPSPARSE_STATUS(
+        hipsparseLtMatmulAlgSetAttribute(
+            handle, alg_sel, HIPSPARSELT_MATMUL_SPLIT_K, &split_k, sizeof(split_k)),
+        HIPSPARSE_STATUS_SUCCESS);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulAlgSetAttribute(handle,
+                                                             alg_sel,
+                                                             HIPSPARSELT_MATMUL_SPLIT_K_BUFFERS,
+                                                             &split_k_buffers,
+                                                             sizeof(split_k_buffers)),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
 #endif
 
     EXPECT_HIPSPARSE_STATUS(
@@ -1384,6 +1641,9 @@ void testing_aux_matmul_alg_get_attr_bad_arg(const Arguments& arg)
     EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulAlgGetAttribute(
                                 handle, alg_sel, HIPSPARSELT_MATMUL_ALG_CONFIG_ID, &data, 1),
                             HIPSPARSE_STATUS_INVALID_VALUE);
+    EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulAlgGetAttribute(
+                                handle, alg_sel, HIPSPARSELT_MATMUL_SPLIT_K, &data, 1),
+                            HIPSPARSE_STATUS_INVALID_VALUE);
 }
 
 void testing_aux_matmul_plan_init_bad_arg(const Arguments& arg)
@@ -1603,3 +1863,56 @@ void testing_aux_get_workspace_size(const Arguments& arg)
     EXPECT_HIPSPARSE_STATUS(hipsparseLtMatmulGetWorkspace(handle, plan, &workspace_size),
                             HIPSPARSE_STATUS_SUCCESS);
 }
+
+// Checks the 8 bit float conversions against the value of every encoding,
+// computed from its fields, and rounding to nearest even between them.
+template <typename T>
+void testing_aux_float8_conversion_impl()
+{
+    std::vector<float> finite;
+    for(int bits = 0; bits < 256; bits++)
+    {
+        if(bits == T::nan_bits)
+        {
+            ASSERT_TRUE(std::isnan(float(T::from_bits(bits))));
+            continue;
+        }
+        int   sign     = bits & 0x80 ? -1 : 1;
+        int   exponent = (bits >> T::mantissa_bits) & ((1 << T::exponent_bits) - 1);
+        int   mantissa = bits & ((1 << T::mantissa_bits) - 1);
+        float value    = exponent == 0
+                             ? std::ldexp(float(mantissa), 1 - T::bias - T::mantissa_bits)
+                             : std::ldexp(float(mantissa + (1 << T::mantissa_bits)),
+                                       exponent - T::bias - T::mantissa_bits);
+        value *= sign;
+        ASSERT_EQ(float(T::from_bits(bits)), value);
+        if(bits != 0x80)
+        {
+            ASSERT_EQ(T(value).data, bits);
+            finite.push_back(value);
+        }
+    }
+
+    std::sort(finite.begin(), finite.end());
+    finite.erase(std::unique(finite.begin(), finite.end()), finite.end());
+    for(size_t i = 0; i + 1 < finite.size(); i++)
+    {
+        float lo = finite[i], hi = finite[i + 1], mid = lo + (hi - lo) / 2;
+        // Ties go to the even encoding, whose last mantissa bit is clear
+        bool lo_even = (T(lo).data & 1) == 0;
+        ASSERT_EQ(T(mid).data, lo_even ? T(lo).data : T(hi).data);
+        ASSERT_EQ(T(std::nextafter(mid, lo)).data, T(lo).data);
+        ASSERT_EQ(T(std::nextafter(mid, hi)).data, T(hi).data);
+    }
+
+    // Out of range values saturate, and NaN stays NaN
+    ASSERT_EQ(float(T(1e30f)), finite.back());
+    ASSERT_EQ(float(T(-std::numeric_limits<float>::infinity())), finite.front());
+    ASSERT_EQ(T(std::numeric_limits<float>::quiet_NaN()).data, T::nan_bits);
+}
+
+void testing_aux_float8_conversion(const Arguments& arg)
+{
+    testing_aux_float8_conversion_impl<hipsparselt_f8>();
+    testing_aux_float8_conversion_impl<hipsparselt_bf8>();
+}
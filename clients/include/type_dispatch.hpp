@@ -38,6 +38,10 @@ constexpr auto hipsparselt_type2datatype()
         return HIP_R_16BF;
     if(std::is_same<T, char>{})
         return HIP_R_8I;
+    if(std::is_same<T, hipsparselt_f8>{})
+        return HIP_R_8F_E4M3_FNUZ;
+    if(std::is_same<T, hipsparselt_bf8>{})
+        return HIP_R_8F_E5M2_FNUZ;
 
     return HIP_R_16F; // testing purposes we default to f32 ex
 }
@@ -125,6 +129,45 @@ auto hipsparselt_spmm_dispatch(const Arguments& arg)
         {
             return TEST<int8_t, hip_bfloat16, int32_t, float>{}(arg);
         }
+        else if((Ti == HIP_R_8F_E4M3_FNUZ || Ti == HIP_R_8F_E5M2_FNUZ)
+                && Tc == HIPSPARSELT_COMPUTE_32F && TBias == HIP_R_32F)
+        {
+            bool f8 = Ti == HIP_R_8F_E4M3_FNUZ;
+            switch(To)
+            {
+            case HIP_R_16F:
+                return f8 ? TEST<hipsparselt_f8, __half, float, float>{}(arg)
+                          : TEST<hipsparselt_bf8, __half, float, float>{}(arg);
+            case HIP_R_16BF:
+                return f8 ? TEST<hipsparselt_f8, hip_bfloat16, float, float>{}(arg)
+                          : TEST<hipsparselt_bf8, hip_bfloat16, float, float>{}(arg);
+            case HIP_R_32F:
+                return f8 ? TEST<hipsparselt_f8, float, float, float>{}(arg)
+                          : TEST<hipsparselt_bf8, float, float, float>{}(arg);
+            default:
+                break;
+            }
+        }
+        else if((Ti == HIP_R_16F || Ti == HIP_R_16BF) && Tc == HIPSPARSELT_COMPUTE_32F
+                && TBias == HIP_R_32F)
+        {
+            // An 8 bit D of 16 bit inputs is quantized by the epilogue
+            bool f16 = Ti == HIP_R_16F;
+            switch(To)
+            {
+            case HIP_R_8I:
+                return f16 ? TEST<__half, int8_t, float, float>{}(arg)
+                           : TEST<hip_bfloat16, int8_t, float, float>{}(arg);
+            case HIP_R_8F_E4M3_FNUZ:
+                return f16 ? TEST<__half, hipsparselt_f8, float, float>{}(arg)
+                           : TEST<hip_bfloat16, hipsparselt_f8, float, float>{}(arg);
+            case HIP_R_8F_E5M2_FNUZ:
+                return f16 ? TEST<__half, hipsparselt_bf8, float, float>{}(arg)
+                           : TEST<hip_bfloat16, hipsparselt_bf8, float, float>{}(arg);
+            default:
+                break;
+            }
+        }
     }
     return TEST<void>{}(arg);
 }
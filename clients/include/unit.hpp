@@ -131,6 +131,9 @@
             ASSERT_FLOAT_EQ(b, hip_bfloat16(a));                     \
     } while(0)
 
+// The 8 bit floats are exact copies of each other, so their bits must match
+#define ASSERT_F8_EQ(a, b) ASSERT_EQ((a).data, (b).data)
+
 #define ASSERT_FLOAT_COMPLEX_EQ(a, b)                  \
     do                                                 \
     {                                                  \
@@ -297,6 +300,30 @@ inline void unit_check_general(int64_t       M,
     UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, ASSERT_EQ);
 }
 
+template <>
+inline void unit_check_general(int64_t               M,
+                               int64_t               N,
+                               int64_t               lda,
+                               int64_t               strideA,
+                               const hipsparselt_f8* hCPU,
+                               const hipsparselt_f8* hGPU,
+                               int64_t               batch_count)
+{
+    UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, ASSERT_F8_EQ);
+}
+
+template <>
+inline void unit_check_general(int64_t                M,
+                               int64_t                N,
+                               int64_t                lda,
+                               int64_t                strideA,
+                               const hipsparselt_bf8* hCPU,
+                               const hipsparselt_bf8* hGPU,
+                               int64_t                batch_count)
+{
+    UNIT_CHECK(M, N, lda, strideA, hCPU, hGPU, batch_count, ASSERT_F8_EQ);
+}
+
 template <typename T, typename T_hpa = T>
 void unit_check_general(int64_t                                    M,
                         int64_t                                    N,
@@ -236,6 +236,60 @@ typedef enum {
                                                             When Input's datatype is FP16 - Bias type can be FP16 or FP32. (default FP16)
                                                             When Input's datatype is BF16 - Bias type can be BF16 or FP32. (default BF16)
                                                             In other cases - Bias type is FP32.*/
+   HIPSPARSELT_MATMUL_POINTER_ARRAY_BATCH = 17,        /**< Enable/Disable pointer-array batches. HIP backend only,
+                                                            When enabled, the dense matrix, C and D arguments of hipsparseLtMatmul are
+                                                            host arrays of one device pointer per batch, the compressed matrix stays strided.
+                                                            C and D must be the same array or point to distinct matrices.*/
+   HIPSPARSELT_MATMUL_DYNAMIC_M_MIN = 18,              /**< Smallest M (int64_t) of a dynamic-M descriptor. HIP backend only,
+                                                            Plans of the descriptor run any M from it up to the M of the descriptor,
+                                                            passed to hipsparseLtMatmulDynamicM. Matrix A must be dense. 0 (default) fixes M.*/
+   HIPSPARSELT_MATMUL_A_SCALE_POINTER = 19,            /**< Pointer to the float per-tensor scale of matrix A. HIP backend only,
+                                                            The product of A and B is multiplied by it, along with alpha. It is read
+                                                            by hipsparseLtMatmul, from host memory with the host backend and from
+                                                            device memory otherwise. NULL (default) is a scale of 1.*/
+   HIPSPARSELT_MATMUL_B_SCALE_POINTER = 20,            /**< Pointer to the float per-tensor scale of matrix B. HIP backend only,
+                                                            See HIPSPARSELT_MATMUL_A_SCALE_POINTER.*/
+   HIPSPARSELT_MATMUL_ACTIVATION_SILU = 21,            /**< SiLU (Swish) activation function, x * sigmoid(beta * x). HIP backend only */
+   HIPSPARSELT_MATMUL_ACTIVATION_SILU_BETA = 22,       /**< Beta value of the SiLU activation function. HIP backend only */
+   HIPSPARSELT_MATMUL_ACTIVATION_HARDSWISH = 23,       /**< HardSwish activation function, x * min(max(x + 3, 0), 6) / 6. HIP backend only */
+   HIPSPARSELT_MATMUL_GATED_EPILOGUE = 24,             /**< Enable/Disable the gated (GLU) epilogue. HIP backend only,
+                                                            The structured matrix interleaves gate and up projections along M (A structured)
+                                                            or N (B structured), which must be even: products 2i and 2i+1 give output i,
+                                                            act(alpha * gate + bias) * (alpha * up + bias) + beta * C, with the activation of
+                                                            the descriptor (SiLU for SwiGLU, GeLU for GeGLU). C and D keep the shape of their
+                                                            descriptors, and only their leading M / 2 rows or N / 2 columns are read and written.*/
+   HIPSPARSELT_MATMUL_D_SCALE_POINTER = 25,            /**< Pointer to a vector of M float per-row scales of D. HIP backend only,
+                                                            The result of the epilogue, after the activation, is multiplied by the scale of
+                                                            its row before it is rounded and saturated to the type of D. It is read by
+                                                            hipsparseLtMatmul, like HIPSPARSELT_MATMUL_A_SCALE_POINTER. NULL (default) is a scale of 1.*/
+   HIPSPARSELT_MATMUL_D_ROUNDING_MODE = 26,            /**< Rounding of D to INT8, FP8 or BF8, a \ref hipsparseLtRoundingMode_t. HIP backend only,
+                                                            HIPSPARSELT_ROUNDING_NEAREST_EVEN (default) or HIPSPARSELT_ROUNDING_STOCHASTIC.*/
+   HIPSPARSELT_MATMUL_D_ROUNDING_SEED = 27,            /**< Seed (uint64_t) of stochastic rounding. HIP backend only,
+                                                            The random number of each element of D depends on the seed, the batch, and its
+                                                            row and column only, so that results are reproducible. 0 by default.*/
+   HIPSPARSELT_MATMUL_D_AMAX_POINTER = 28,             /**< Pointer to a vector of batches * M floats that receives the absolute maximum of
+                                                            each row of D, before the scale of D. HIP backend only,
+                                                            The maximum of row i of batch b is at b * M + i, for the dynamic quantization of
+                                                            the next layer. It is written by hipsparseLtMatmul. NULL (default) disables it.*/
+   HIPSPARSELT_MATMUL_RESIDUAL_POINTER = 29,           /**< Pointer to a residual matrix R with the type, leading dimension and batch stride of C. HIP backend only,
+                                                            It is added to D after the activation: D = act(alpha * A * B + beta * C + bias) + R.
+                                                            With HIPSPARSELT_MATMUL_POINTER_ARRAY_BATCH it is an array of batch pointers like C.
+                                                            It is read by hipsparseLtMatmul. NULL (default) disables it.*/
+   HIPSPARSELT_MATMUL_BIAS_GRADIENT_POINTER = 30,      /**< Pointer to a vector of floats that receives the sums of the rows or columns of D, as
+                                                            set by HIPSPARSELT_MATMUL_BIAS_GRADIENT_MODE, for the bias gradient of training. HIP backend only,
+                                                            The sums of batch b are at b * M (rows) or b * N (columns), and are taken before the scale of D.
+                                                            It is written by hipsparseLtMatmul. NULL (default) disables it.*/
+   HIPSPARSELT_MATMUL_BIAS_GRADIENT_MODE = 31,         /**< Sums of HIPSPARSELT_MATMUL_BIAS_GRADIENT_POINTER, a \ref hipsparseLtBiasGradientMode_t. HIP backend only,
+                                                            HIPSPARSELT_BIAS_GRADIENT_ROWS (default) or HIPSPARSELT_BIAS_GRADIENT_COLUMNS.*/
+   HIPSPARSELT_MATMUL_WEIGHT_SCALE_POINTER = 32,       /**< Pointer to the float scales of a weight-only quantized structured matrix, HIP_R_8I or HIP_R_4I with a
+                                                            HIP_R_16F or HIP_R_16BF dense matrix. HIP backend only, The scale of group g of row r of the structured
+                                                            matrix, in its batch b if it is batched, is at (b * rows + r) * groups + g. A weight q is dequantized to
+                                                            scale * (q - zero), but a q of 0 is a pruned weight and stays 0.
+                                                            It is read by hipsparseLtMatmul, and required by weight-only quantized matrices.*/
+   HIPSPARSELT_MATMUL_WEIGHT_ZERO_POINTER = 33,        /**< Pointer to the float zero points of a weight-only quantized structured matrix, laid out like
+                                                            HIPSPARSELT_MATMUL_WEIGHT_SCALE_POINTER. HIP backend only, NULL (default) means zero points of 0.*/
+   HIPSPARSELT_MATMUL_WEIGHT_GROUP_SIZE = 34,          /**< Number of consecutive elements along K that share a scale and zero point, a multiple of 8.
+                                                            HIP backend only, 0 (default) makes the whole of K one group.*/
 } hipsparseLtMatmulDescAttribute_t;
 
 /*! \ingroup types_module
@@ -259,9 +313,9 @@ typedef enum {
    HIPSPARSELT_MATMUL_ALG_CONFIG_ID = 0,     // READ/WRITE
    HIPSPARSELT_MATMUL_ALG_CONFIG_MAX_ID = 1, // READ-ONLY
    HIPSPARSELT_MATMUL_SEARCH_ITERATIONS = 2,  // READ/WRITE
-   HIPSPARSELT_MATMUL_SPLIT_K = 3,
-   HIPSPARSELT_MATMUL_SPLIT_K_MODE = 4,
-   HIPSPARSELT_MATMUL_SPLIT_K_BUFFERS = 5,
+   HIPSPARSELT_MATMUL_SPLIT_K = 3,           // READ/WRITE
+   HIPSPARSELT_MATMUL_SPLIT_K_MODE = 4,      // READ/WRITE
+   HIPSPARSELT_MATMUL_SPLIT_K_BUFFERS = 5,   // READ/WRITE
 } hipsparseLtMatmulAlgAttribute_t;
 
 /*! \ingroup types_module
@@ -286,6 +340,78 @@ typedef enum {
    HIPSPARSELT_SPLIT_K_MODE_TWO_KERNELS = 1, /**< Use another kernel to do the final reduction */
 } hipsparseLtSplitKMode_t;
 
+/*! \ingroup types_module
+ *  \brief Specify how D is rounded to an 8 bit type.
+ *
+ *  \details
+ *  The \ref hipsparseLtRoundingMode_t is used by HIPSPARSELT_MATMUL_D_ROUNDING_MODE attribute in \ref hipsparseLtMatmulDescAttribute_t.
+ *  Values beyond the range of D saturate to its largest finite value in either mode.
+ */
+typedef enum {
+   HIPSPARSELT_ROUNDING_NEAREST_EVEN = 0, /**< Round to the nearest value, ties to even */
+   HIPSPARSELT_ROUNDING_STOCHASTIC = 1,   /**< Round up with a probability of the distance to the value below */
+} hipsparseLtRoundingMode_t;
+
+/*! \ingroup types_module
+ *  \brief Specify which sums of D give the bias gradient.
+ *
+ *  \details
+ *  The \ref hipsparseLtBiasGradientMode_t is used by HIPSPARSELT_MATMUL_BIAS_GRADIENT_MODE attribute in \ref hipsparseLtMatmulDescAttribute_t.
+ */
+typedef enum {
+   HIPSPARSELT_BIAS_GRADIENT_ROWS = 0,    /**< Sum each row of D, M values per batch, the gradient of a bias per row like HIPSPARSELT_MATMUL_BIAS_POINTER */
+   HIPSPARSELT_BIAS_GRADIENT_COLUMNS = 1, /**< Sum each column of D, N values per batch */
+} hipsparseLtBiasGradientMode_t;
+
+/*! \ingroup types_module
+ *  \brief Specify where a handle runs matmul, prune and compress.
+ *
+ *  \details
+ *  The \ref hipsparseLtBackend_t is used in the \ref hipsparseLtSetBackend and \ref hipsparseLtGetBackend functions.
+ *  The host backend expects all matrices, metadata, bias and scaling vectors and the workspace in host memory.
+ */
+typedef enum {
+   HIPSPARSELT_BACKEND_DEVICE = 0, /**< Run on the HIP device. */
+   HIPSPARSELT_BACKEND_HOST = 1,   /**< Run on the host CPU. Only supported by the rocSPARSELt backend. */
+} hipsparseLtBackend_t;
+
+/*! \ingroup types_module
+ *  \brief Reads part of the dense matrix for \ref hipsparseLtSpMMACompressStream.
+ *
+ *  \details
+ *  Copies \p size bytes, starting \p offset bytes into the dense matrix, into \p buffer.
+ *  Offsets address the dense matrix as \ref hipsparseLtSpMMACompress2 would read it from memory.
+ *  Returns 0 on success; any other value stops the compression.
+ */
+typedef int (*hipsparseLtStreamReadFn_t)(void* userData, size_t offset, size_t size, void* buffer);
+
+/*! \ingroup types_module
+ *  \brief Writes part of the compressed matrix for \ref hipsparseLtSpMMACompressStream.
+ *
+ *  \details
+ *  Stores \p size bytes from \p buffer, starting \p offset bytes into the compressed matrix
+ *  whose size \ref hipsparseLtSpMMACompressedSize2 reports.
+ *  Returns 0 on success; any other value stops the compression.
+ */
+typedef int (*hipsparseLtStreamWriteFn_t)(void* userData, size_t offset, size_t size, const void* buffer);
+
+/*! \ingroup types_module
+ *  \brief One matrix multiplication of \ref hipsparseLtMatmulGrouped.
+ *
+ *  \details
+ *  \p plan fixes the shape, data types and epilogue of the multiplication, and the other
+ *  members are the arguments of the same name of \ref hipsparseLtMatmul.
+ */
+typedef struct {
+    const hipsparseLtMatmulPlan_t* plan;
+    const void*                    alpha;
+    const void*                    d_A;
+    const void*                    d_B;
+    const void*                    beta;
+    const void*                    d_C;
+    void*                          d_D;
+} hipsparseLtMatmulGroup_t;
+
 // clang-format on
 
 #ifdef __cplusplus
@@ -377,6 +503,43 @@ hipsparseStatus_t hipsparseLtInit(hipsparseLtHandle_t* handle);
 HIPSPARSELT_EXPORT
 hipsparseStatus_t hipsparseLtDestroy(const hipsparseLtHandle_t* handle);
 
+/*! \ingroup library_module
+ *  \brief Select the execution backend of a hipsparselt handle
+ *
+ *  \details
+ *  \p hipsparseLtSetBackend selects where the matmul, prune and compress functions called
+ *  with \p handle run. A handle starts with the backend that the HIPSPARSELT_BACKEND
+ *  environment variable names, or \ref HIPSPARSELT_BACKEND_DEVICE. The backend should be
+ *  set before any descriptor is initialized with \p handle.
+ *
+ *  @param[in]
+ *  handle  hipsparselt library handle
+ *  @param[in]
+ *  backend the \ref hipsparseLtBackend_t to use
+ *
+ *  \retval HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval HIPSPARSE_STATUS_INVALID_VALUE \p handle or \p backend is invalid, or \p backend
+ *           is \ref HIPSPARSELT_BACKEND_DEVICE and the handle has no HIP device.
+ *  \retval HIPSPARSE_STATUS_NOT_SUPPORTED \p backend is not supported by the backend library.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtSetBackend(hipsparseLtHandle_t* handle, hipsparseLtBackend_t backend);
+
+/*! \ingroup library_module
+ *  \brief Get the execution backend of a hipsparselt handle
+ *
+ *  @param[in]
+ *  handle  hipsparselt library handle
+ *  @param[out]
+ *  backend the \ref hipsparseLtBackend_t of \p handle
+ *
+ *  \retval HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval HIPSPARSE_STATUS_INVALID_VALUE \p handle is invalid or \p backend is a NULL pointer.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtGetBackend(const hipsparseLtHandle_t* handle,
+                                        hipsparseLtBackend_t*      backend);
+
 /* matrix descriptor */
 /*! \ingroup matrix_desc_module
  *  \brief Create a descriptor for dense matrix
@@ -646,6 +809,10 @@ hipsparseStatus_t
  *
  *  \retval HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
  *  \retval HIPSPARSE_STATUS_INVALID_VALUE \p handle , \p matmulDescr or \p algSelection is invalid.
+ *  \retval HIPSPARSE_STATUS_NOT_SUPPORTED \p matmulDescr has no solutions, or uses an epilogue
+ *  that only the host backend implements: a beta vector, scales of A and B, the SiLU or HardSwish
+ *  activation, a gated epilogue, the quantization of D, a residual, a bias gradient, or weight-only
+ *  quantization.
  */
 HIPSPARSELT_EXPORT
 hipsparseStatus_t
@@ -792,6 +959,18 @@ hipsparseStatus_t hipsparseLtMatmulPlanDestroy(const hipsparseLtMatmulPlan_t* pl
  *  It may return before the actual computation has finished.
  *
  *  \note
+ *  With more than one stream, the rocSPARSELt backend may split the problem by batch
+ *  or by output tiles and run one part on each stream. The parts start after the work
+ *  already queued on streams[0], and streams[0] waits for all of them, so D is complete
+ *  once the work on streams[0] is.
+ *
+ *  \note
+ *  With HIPSPARSELT_MATMUL_POINTER_ARRAY_BATCH, the dense matrix, \p d_C and \p d_D
+ *  are host arrays of one pointer per batch, read before the function returns. The
+ *  rocSPARSELt backend launches the batches one by one, spread over the streams, and
+ *  hipsparseLtMatmulSearch times the first batch only.
+ *
+ *  \note
  *  Currently, only supports the case where D has the same shape of C.
  *
  *  @param[in]
@@ -902,6 +1081,145 @@ hipsparseStatus_t hipsparseLtMatmulSearch(const hipsparseLtHandle_t* handle,
                                           hipStream_t*               streams,
                                           int32_t                    numStreams);
 
+/*! \ingroup matmul_module
+ *  \brief Sparse matrix dense matrix multiplication with the M given per call
+ *
+ *  \details
+ *  \p hipsparseLtMatmulDynamicM computes the matrix multiplication of \p plan as
+ *  \ref hipsparseLtMatmul does, but with \p m rows of A, C and D instead of the M of the
+ *  matrix descriptors. The plan must come from a descriptor with HIPSPARSELT_MATMUL_DYNAMIC_M_MIN
+ *  set, and \p m must lie between that minimum and the M of the descriptor. The matrices keep
+ *  the leading dimensions and batch strides of their descriptors.
+ *
+ *  \note
+ *  The rocSPARSELt backend rounds \p m up to a power of two and runs the best config found
+ *  for that size by hipsparseLtMatmulAlgSelectionInit, so the plan is not rebuilt when M
+ *  changes. A config set with HIPSPARSELT_MATMUL_ALG_CONFIG_ID or HIPSPARSELT_MATMUL_SPLIT_K
+ *  is used for every \p m instead.
+ *
+ *  \note
+ *  This function is non blocking and executed asynchronously with respect to the host.
+ *  It may return before the actual computation has finished.
+ *
+ *  @param[in]
+ *  handle      hipsparselt library handle
+ *  @param[in]
+ *  plan        Matrix multiplication plan
+ *  @param[in]
+ *  m           Number of rows of op(A), C and D
+ *  @param[in]
+ *  alpha       scalar \f$\alpha\f$. (float)
+ *  @param[in]
+ *  d_A         Pointer to the dense matrix A
+ *  @param[in]
+ *  d_B         Pointer to the structured matrix B
+ *  @param[in]
+ *  beta        scalar \f$\beta\f$. (float)
+ *  @param[in]
+ *  d_C         Pointer to the dense matrix C
+ *  @param[out]
+ *  d_D         Pointer to the dense matrix D
+ *  @param[in]
+ *  workspace   Pointer to the workspace, of the size \ref hipsparseLtMatmulGetWorkspace returns
+ *  @param[in]
+ *  streams     Pointer to HIP stream array for the computation
+ *  @param[in]
+ *  numStreams  Number of HIP streams in \p streams
+ *
+ *  \retval     HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval     HIPSPARSE_STATUS_NOT_INITIALIZED \p handle or \p plan is invalid.
+ *  \retval     HIPSPARSE_STATUS_INVALID_VALUE \p m is out of the range of the plan, or \p alpha, \p d_A, \p d_B, \p beta, \p d_C , \p d_D , \p workspace \p streams or \p numStreams is invalid.
+ *  \retval     HIPSPARSE_STATUS_NOT_SUPPORTED the problem is not supported.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtMatmulDynamicM(const hipsparseLtHandle_t*     handle,
+                                            const hipsparseLtMatmulPlan_t* plan,
+                                            int64_t                        m,
+                                            const void*                    alpha,
+                                            const void*                    d_A,
+                                            const void*                    d_B,
+                                            const void*                    beta,
+                                            const void*                    d_C,
+                                            void*                          d_D,
+                                            void*                          workspace,
+                                            hipStream_t*                   streams,
+                                            int32_t                        numStreams);
+
+/*! \ingroup matmul_module
+ *  \brief Determines the required workspace size of a grouped matrix multiplication.
+ *
+ *  \details
+ *  \p hipsparseLtMatmulGroupedGetWorkspace returns the workspace that
+ *  \ref hipsparseLtMatmulGrouped needs for \p groups: the workspace of each plan, rounded
+ *  up to 256 bytes, so that groups running concurrently never share it.
+ *  Only the plans of \p groups are read.
+ *
+ *  @param[in]
+ *  handle          hipsparselt library handle
+ *  @param[in]
+ *  groups          array of \p groupCount groups
+ *  @param[in]
+ *  groupCount      number of groups
+ *  @param[out]
+ *  workspaceSize   Workspace size in bytes
+ *
+ *  \retval HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval HIPSPARSE_STATUS_INVALID_VALUE \p handle, \p groups, \p groupCount or \p workspaceSize is invalid.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtMatmulGroupedGetWorkspace(const hipsparseLtHandle_t*      handle,
+                                                       const hipsparseLtMatmulGroup_t* groups,
+                                                       int32_t                         groupCount,
+                                                       size_t* workspaceSize);
+
+/*! \ingroup matmul_module
+ *  \brief Grouped sparse matrix dense matrix multiplication
+ *
+ *  \details
+ *  \p hipsparseLtMatmulGrouped computes the \p groupCount matrix multiplications described
+ *  by \p groups, which may all have different shapes, in one call. Each group is computed as
+ *  \ref hipsparseLtMatmul would with its plan and arguments.
+ *
+ *  \note
+ *  This function is non blocking and executed asynchronously with respect to the host.
+ *  It may return before the actual computation has finished.
+ *
+ *  \note
+ *  The arguments of all groups are checked before any group is launched. The rocSPARSELt
+ *  backend spreads the groups over \p streams so that the estimated work of each stream
+ *  is balanced; the parts start after the work already queued on streams[0], and streams[0]
+ *  waits for all of them. The host backend (HIPSPARSELT_BACKEND=host) runs the output tiles
+ *  of all groups on one pool of threads.
+ *
+ *  \note
+ *  The D matrices of different groups must not overlap.
+ *
+ *  @param[in]
+ *  handle      hipsparselt library handle
+ *  @param[in]
+ *  groups      array of \p groupCount groups
+ *  @param[in]
+ *  groupCount  number of groups
+ *  @param[in]
+ *  workspace   Pointer to the workspace, of the size \ref hipsparseLtMatmulGroupedGetWorkspace returns
+ *  @param[in]
+ *  streams     Pointer to HIP stream array for the computation
+ *  @param[in]
+ *  numStreams  Number of HIP streams in \p streams
+ *
+ *  \retval     HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval     HIPSPARSE_STATUS_NOT_INITIALIZED \p handle or the plan of a group is invalid.
+ *  \retval     HIPSPARSE_STATUS_INVALID_VALUE \p groups, \p groupCount, a pointer of a group, \p workspace, \p streams or \p numStreams is invalid.
+ *  \retval     HIPSPARSE_STATUS_NOT_SUPPORTED the problem of a group is not supported.
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtMatmulGrouped(const hipsparseLtHandle_t*      handle,
+                                           const hipsparseLtMatmulGroup_t* groups,
+                                           int32_t                         groupCount,
+                                           void*                           workspace,
+                                           hipStream_t*                    streams,
+                                           int32_t                         numStreams);
+
 /* helper */
 // prune
 /*! \ingroup helper_module
@@ -1173,6 +1491,103 @@ hipsparseStatus_t hipsparseLtSpMMACompress2(const hipsparseLtHandle_t*        ha
                                             void*                             d_compressBuffer,
                                             hipStream_t                       stream);
 
+/*! \ingroup helper_module
+ *  \brief compresses a dense matrix that is streamed through callbacks.
+ *
+ *  \details
+ *  \p hipsparseLtSpMMACompressStream produces the same compressed matrix as
+ *  \ref hipsparseLtSpMMACompress2, for dense matrices that do not fit in memory.
+ *  The dense matrix is read with \p readDense in panels of consecutive columns (or rows,
+ *  whichever is contiguous in memory) and each panel is optionally pruned, compressed on
+ *  the host and handed to \p writeCompressed at its final offset in the compressed matrix.
+ *  At most two panels, and when the panels are columns the metadata of one batch, are
+ *  held in host memory. Compressing a panel on the calling thread overlaps with writing
+ *  the previous panel and reading the next on one I/O thread, so the callbacks are never
+ *  called concurrently. The call returns once the last panel is written.
+ *
+ *  @param[in]
+ *  handle             handle to the hipsparselt library context queue.
+ *  @param[in]
+ *  sparseMatDescr     structured(sparse) matrix descriptor.
+ *  @param[in]
+ *  isSparseA          specify if the structured (sparse) matrix is in the first position (matA or matB)
+ *  @param[in]
+ *  op                 operation that will be applied to the structured (sparse) matrix in the multiplication
+ *  @param[in]
+ *  pruneAlg           if not NULL, each panel is pruned with this algorithm before it is compressed.
+ *  @param[in]
+ *  readDense          reads a range of the dense matrix.
+ *  @param[in]
+ *  writeCompressed    writes a range of the compressed matrix.
+ *  @param[in]
+ *  userData           passed to \p readDense and \p writeCompressed.
+ *  @param[in]
+ *  panelBytes         upper bound on the dense bytes per panel, 0 selects a default. A panel holds at least eight columns (rows).
+ *
+ *  \retval     HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval     HIPSPARSE_STATUS_INVALID_VALUE \p handle , \p sparseMatDescr , \p op , \p pruneAlg , \p readDense or \p writeCompressed is invalid.
+ *  \retval     HIPSPARSE_STATUS_ALLOC_FAILED a panel buffer or thread could not be allocated.
+ *  \retval     HIPSPARSE_STATUS_INTERNAL_ERROR \p readDense or \p writeCompressed failed.
+ *  \retval     HIPSPARSE_STATUS_NOT_SUPPORTED the problem is not support
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtSpMMACompressStream(const hipsparseLtHandle_t*        handle,
+                                                 const hipsparseLtMatDescriptor_t* sparseMatDescr,
+                                                 int                               isSparseA,
+                                                 hipsparseOperation_t              op,
+                                                 const hipsparseLtPruneAlg_t*      pruneAlg,
+                                                 hipsparseLtStreamReadFn_t         readDense,
+                                                 hipsparseLtStreamWriteFn_t        writeCompressed,
+                                                 void*                             userData,
+                                                 size_t                            panelBytes);
+
+/*! \ingroup helper_module
+ *  \brief compresses a dense matrix from one file into another.
+ *
+ *  \details
+ *  \p hipsparseLtSpMMACompressFile runs \ref hipsparseLtSpMMACompressStream with the dense
+ *  matrix read from \p denseFd at \p denseOffset and the compressed matrix written to
+ *  \p compressedFd at \p compressedOffset.
+ *
+ *  @param[in]
+ *  handle             handle to the hipsparselt library context queue.
+ *  @param[in]
+ *  sparseMatDescr     structured(sparse) matrix descriptor.
+ *  @param[in]
+ *  isSparseA          specify if the structured (sparse) matrix is in the first position (matA or matB)
+ *  @param[in]
+ *  op                 operation that will be applied to the structured (sparse) matrix in the multiplication
+ *  @param[in]
+ *  pruneAlg           if not NULL, each panel is pruned with this algorithm before it is compressed.
+ *  @param[in]
+ *  denseFd            file descriptor of the dense matrix, open for reading.
+ *  @param[in]
+ *  denseOffset        byte offset of the dense matrix in \p denseFd.
+ *  @param[in]
+ *  compressedFd       file descriptor for the compressed matrix, open for writing.
+ *  @param[in]
+ *  compressedOffset   byte offset of the compressed matrix in \p compressedFd.
+ *  @param[in]
+ *  panelBytes         upper bound on the dense bytes per panel, 0 selects a default.
+ *
+ *  \retval     HIPSPARSE_STATUS_SUCCESS the operation completed successfully.
+ *  \retval     HIPSPARSE_STATUS_INVALID_VALUE \p handle , \p sparseMatDescr , \p op , \p pruneAlg , a file descriptor or an offset is invalid.
+ *  \retval     HIPSPARSE_STATUS_ALLOC_FAILED a panel buffer or thread could not be allocated.
+ *  \retval     HIPSPARSE_STATUS_INTERNAL_ERROR reading or writing a file failed.
+ *  \retval     HIPSPARSE_STATUS_NOT_SUPPORTED the problem is not support
+ */
+HIPSPARSELT_EXPORT
+hipsparseStatus_t hipsparseLtSpMMACompressFile(const hipsparseLtHandle_t*        handle,
+                                               const hipsparseLtMatDescriptor_t* sparseMatDescr,
+                                               int                               isSparseA,
+                                               hipsparseOperation_t              op,
+                                               const hipsparseLtPruneAlg_t*      pruneAlg,
+                                               int                               denseFd,
+                                               int64_t                           denseOffset,
+                                               int                               compressedFd,
+                                               int64_t                           compressedOffset,
+                                               size_t                            panelBytes);
+
 #ifdef __cplusplus
 }
 #endif
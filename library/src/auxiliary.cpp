@@ -73,6 +73,8 @@ const hipsparselt_activation_type string_to_hipsparselt_activation_type(const st
            : value == "tanh"        ? hipsparselt_activation_type::tanh
            : value == "all"         ? hipsparselt_activation_type::all
            : value == "exp"         ? hipsparselt_activation_type::exp
+           : value == "silu"        ? hipsparselt_activation_type::silu
+           : value == "hardswish"   ? hipsparselt_activation_type::hardswish
                                     : static_cast<hipsparselt_activation_type>(-1);
 }
 
@@ -97,6 +99,10 @@ const char* hipsparselt_activation_type_to_string(hipsparselt_activation_type ty
         return "sigmoid";
     case hipsparselt_activation_type::tanh:
         return "tanh";
+    case hipsparselt_activation_type::silu:
+        return "silu";
+    case hipsparselt_activation_type::hardswish:
+        return "hardswish";
     case hipsparselt_activation_type::all:
         return "all";
     case hipsparselt_activation_type::none:
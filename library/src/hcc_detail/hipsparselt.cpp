@@ -253,6 +253,42 @@ rocsparselt_matmul_descr_attribute_
         return rocsparselt_matmul_activation_tanh_beta;
     case HIPSPARSELT_MATMUL_BIAS_TYPE:
         return rocsparselt_matmul_bias_type;
+    case HIPSPARSELT_MATMUL_POINTER_ARRAY_BATCH:
+        return rocsparselt_matmul_pointer_array_batch;
+    case HIPSPARSELT_MATMUL_DYNAMIC_M_MIN:
+        return rocsparselt_matmul_dynamic_m_min;
+    case HIPSPARSELT_MATMUL_A_SCALE_POINTER:
+        return rocsparselt_matmul_a_scale_pointer;
+    case HIPSPARSELT_MATMUL_B_SCALE_POINTER:
+        return rocsparselt_matmul_b_scale_pointer;
+    case HIPSPARSELT_MATMUL_ACTIVATION_SILU:
+        return rocsparselt_matmul_activation_silu;
+    case HIPSPARSELT_MATMUL_ACTIVATION_SILU_BETA:
+        return rocsparselt_matmul_activation_silu_beta;
+    case HIPSPARSELT_MATMUL_ACTIVATION_HARDSWISH:
+        return rocsparselt_matmul_activation_hardswish;
+    case HIPSPARSELT_MATMUL_GATED_EPILOGUE:
+        return rocsparselt_matmul_gated_epilogue;
+    case HIPSPARSELT_MATMUL_D_SCALE_POINTER:
+        return rocsparselt_matmul_d_scale_pointer;
+    case HIPSPARSELT_MATMUL_D_ROUNDING_MODE:
+        return rocsparselt_matmul_d_rounding_mode;
+    case HIPSPARSELT_MATMUL_D_ROUNDING_SEED:
+        return rocsparselt_matmul_d_rounding_seed;
+    case HIPSPARSELT_MATMUL_D_AMAX_POINTER:
+        return rocsparselt_matmul_d_amax_pointer;
+    case HIPSPARSELT_MATMUL_RESIDUAL_POINTER:
+        return rocsparselt_matmul_residual_pointer;
+    case HIPSPARSELT_MATMUL_BIAS_GRADIENT_POINTER:
+        return rocsparselt_matmul_bias_gradient_pointer;
+    case HIPSPARSELT_MATMUL_BIAS_GRADIENT_MODE:
+        return rocsparselt_matmul_bias_gradient_mode;
+    case HIPSPARSELT_MATMUL_WEIGHT_SCALE_POINTER:
+        return rocsparselt_matmul_weight_scale_pointer;
+    case HIPSPARSELT_MATMUL_WEIGHT_ZERO_POINTER:
+        return rocsparselt_matmul_weight_zero_pointer;
+    case HIPSPARSELT_MATMUL_WEIGHT_GROUP_SIZE:
+        return rocsparselt_matmul_weight_group_size;
     default:
         throw HIPSPARSE_STATUS_NOT_SUPPORTED;
     }
@@ -297,6 +333,42 @@ hipsparseLtMatmulDescAttribute_t
         return HIPSPARSELT_MATMUL_ACTIVATION_TANH_BETA;
     case rocsparselt_matmul_bias_type:
         return HIPSPARSELT_MATMUL_BIAS_TYPE;
+    case rocsparselt_matmul_pointer_array_batch:
+        return HIPSPARSELT_MATMUL_POINTER_ARRAY_BATCH;
+    case rocsparselt_matmul_dynamic_m_min:
+        return HIPSPARSELT_MATMUL_DYNAMIC_M_MIN;
+    case rocsparselt_matmul_a_scale_pointer:
+        return HIPSPARSELT_MATMUL_A_SCALE_POINTER;
+    case rocsparselt_matmul_b_scale_pointer:
+        return HIPSPARSELT_MATMUL_B_SCALE_POINTER;
+    case rocsparselt_matmul_activation_silu:
+        return HIPSPARSELT_MATMUL_ACTIVATION_SILU;
+    case rocsparselt_matmul_activation_silu_beta:
+        return HIPSPARSELT_MATMUL_ACTIVATION_SILU_BETA;
+    case rocsparselt_matmul_activation_hardswish:
+        return HIPSPARSELT_MATMUL_ACTIVATION_HARDSWISH;
+    case rocsparselt_matmul_gated_epilogue:
+        return HIPSPARSELT_MATMUL_GATED_EPILOGUE;
+    case rocsparselt_matmul_d_scale_pointer:
+        return HIPSPARSELT_MATMUL_D_SCALE_POINTER;
+    case rocsparselt_matmul_d_rounding_mode:
+        return HIPSPARSELT_MATMUL_D_ROUNDING_MODE;
+    case rocsparselt_matmul_d_rounding_seed:
+        return HIPSPARSELT_MATMUL_D_ROUNDING_SEED;
+    case rocsparselt_matmul_d_amax_pointer:
+        return HIPSPARSELT_MATMUL_D_AMAX_POINTER;
+    case rocsparselt_matmul_residual_pointer:
+        return HIPSPARSELT_MATMUL_RESIDUAL_POINTER;
+    case rocsparselt_matmul_bias_gradient_pointer:
+        return HIPSPARSELT_MATMUL_BIAS_GRADIENT_POINTER;
+    case rocsparselt_matmul_bias_gradient_mode:
+        return HIPSPARSELT_MATMUL_BIAS_GRADIENT_MODE;
+    case rocsparselt_matmul_weight_scale_pointer:
+        return HIPSPARSELT_MATMUL_WEIGHT_SCALE_POINTER;
+    case rocsparselt_matmul_weight_zero_pointer:
+        return HIPSPARSELT_MATMUL_WEIGHT_ZERO_POINTER;
+    case rocsparselt_matmul_weight_group_size:
+        return HIPSPARSELT_MATMUL_WEIGHT_GROUP_SIZE;
     default:
         throw HIPSPARSE_STATUS_NOT_SUPPORTED;
     }
@@ -483,6 +555,33 @@ catch(...)
     return exception_to_hipsparselt_status();
 }
 
+hipsparseStatus_t hipsparseLtSetBackend(hipsparseLtHandle_t* handle, hipsparseLtBackend_t backend)
+try
+{
+    return RocSparseLtStatusToHIPStatus(rocsparselt_set_backend(
+        (rocsparselt_handle*)handle, static_cast<rocsparselt_backend>(backend)));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+hipsparseStatus_t hipsparseLtGetBackend(const hipsparseLtHandle_t* handle,
+                                        hipsparseLtBackend_t*      backend)
+try
+{
+    rocsparselt_backend rocBackend;
+    auto                status = rocsparselt_get_backend((const rocsparselt_handle*)handle,
+                                          backend != nullptr ? &rocBackend : nullptr);
+    if(status == rocsparselt_status_success)
+        *backend = static_cast<hipsparseLtBackend_t>(rocBackend);
+    return RocSparseLtStatusToHIPStatus(status);
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
 /* matrix descriptor */
 // dense matrix
 hipsparseStatus_t hipsparseLtDenseDescriptorInit(const hipsparseLtHandle_t*  handle,
@@ -816,6 +915,80 @@ catch(...)
     return exception_to_hipsparselt_status();
 }
 
+hipsparseStatus_t hipsparseLtMatmulDynamicM(const hipsparseLtHandle_t*     handle,
+                                            const hipsparseLtMatmulPlan_t* plan,
+                                            int64_t                        m,
+                                            const void*                    alpha,
+                                            const void*                    d_A,
+                                            const void*                    d_B,
+                                            const void*                    beta,
+                                            const void*                    d_C,
+                                            void*                          d_D,
+                                            void*                          workspace,
+                                            hipStream_t*                   streams,
+                                            int32_t                        numStreams)
+try
+{
+    return RocSparseLtStatusToHIPStatus(
+        rocsparselt_matmul_dynamic_m((const rocsparselt_handle*)handle,
+                                     (const rocsparselt_matmul_plan*)plan,
+                                     m,
+                                     alpha,
+                                     d_A,
+                                     d_B,
+                                     beta,
+                                     d_C,
+                                     d_D,
+                                     workspace,
+                                     streams,
+                                     numStreams));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+static_assert(sizeof(hipsparseLtMatmulGroup_t) == sizeof(rocsparselt_matmul_group),
+              "hipsparseLtMatmulGroup_t and rocsparselt_matmul_group must match");
+
+hipsparseStatus_t hipsparseLtMatmulGroupedGetWorkspace(const hipsparseLtHandle_t*      handle,
+                                                       const hipsparseLtMatmulGroup_t* groups,
+                                                       int32_t                         groupCount,
+                                                       size_t* workspaceSize)
+try
+{
+    return RocSparseLtStatusToHIPStatus(
+        rocsparselt_matmul_grouped_get_workspace((const rocsparselt_handle*)handle,
+                                                 (const rocsparselt_matmul_group*)groups,
+                                                 groupCount,
+                                                 workspaceSize));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+hipsparseStatus_t hipsparseLtMatmulGrouped(const hipsparseLtHandle_t*      handle,
+                                           const hipsparseLtMatmulGroup_t* groups,
+                                           int32_t                         groupCount,
+                                           void*                           workspace,
+                                           hipStream_t*                    streams,
+                                           int32_t                         numStreams)
+try
+{
+    return RocSparseLtStatusToHIPStatus(
+        rocsparselt_matmul_grouped((const rocsparselt_handle*)handle,
+                                   (const rocsparselt_matmul_group*)groups,
+                                   groupCount,
+                                   workspace,
+                                   streams,
+                                   numStreams));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
 /* helper */
 // prune
 hipsparseStatus_t hipsparseLtSpMMAPrune(const hipsparseLtHandle_t*           handle,
@@ -987,6 +1160,68 @@ catch(...)
     return exception_to_hipsparselt_status();
 }
 
+hipsparseStatus_t hipsparseLtSpMMACompressStream(const hipsparseLtHandle_t*        handle,
+                                                 const hipsparseLtMatDescriptor_t* sparseMatDescr,
+                                                 int                               isSparseA,
+                                                 hipsparseOperation_t              op,
+                                                 const hipsparseLtPruneAlg_t*      pruneAlg,
+                                                 hipsparseLtStreamReadFn_t         readDense,
+                                                 hipsparseLtStreamWriteFn_t        writeCompressed,
+                                                 void*                             userData,
+                                                 size_t                            panelBytes)
+try
+{
+    rocsparselt_prune_alg alg;
+    if(pruneAlg != nullptr)
+        alg = HIPPruneAlgToRocSparseLtPruneAlg(*pruneAlg);
+    return RocSparseLtStatusToHIPStatus(
+        rocsparselt_smfmac_compress_stream((const rocsparselt_handle*)handle,
+                                           (const rocsparselt_mat_descr*)sparseMatDescr,
+                                           isSparseA,
+                                           HIPOperationToHCCOperation(op),
+                                           pruneAlg != nullptr ? &alg : nullptr,
+                                           readDense,
+                                           writeCompressed,
+                                           userData,
+                                           panelBytes));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
+hipsparseStatus_t hipsparseLtSpMMACompressFile(const hipsparseLtHandle_t*        handle,
+                                               const hipsparseLtMatDescriptor_t* sparseMatDescr,
+                                               int                               isSparseA,
+                                               hipsparseOperation_t              op,
+                                               const hipsparseLtPruneAlg_t*      pruneAlg,
+                                               int                               denseFd,
+                                               int64_t                           denseOffset,
+                                               int                               compressedFd,
+                                               int64_t                           compressedOffset,
+                                               size_t                            panelBytes)
+try
+{
+    rocsparselt_prune_alg alg;
+    if(pruneAlg != nullptr)
+        alg = HIPPruneAlgToRocSparseLtPruneAlg(*pruneAlg);
+    return RocSparseLtStatusToHIPStatus(
+        rocsparselt_smfmac_compress_file((const rocsparselt_handle*)handle,
+                                         (const rocsparselt_mat_descr*)sparseMatDescr,
+                                         isSparseA,
+                                         HIPOperationToHCCOperation(op),
+                                         pruneAlg != nullptr ? &alg : nullptr,
+                                         denseFd,
+                                         denseOffset,
+                                         compressedFd,
+                                         compressedOffset,
+                                         panelBytes));
+}
+catch(...)
+{
+    return exception_to_hipsparselt_status();
+}
+
 void hipsparseLtInitialize()
 {
     rocsparselt_initialize();
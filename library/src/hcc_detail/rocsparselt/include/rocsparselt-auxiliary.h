@@ -71,6 +71,42 @@ rocsparselt_status rocsparselt_init(rocsparselt_handle* handle);
  */
 rocsparselt_status rocsparselt_destroy(const rocsparselt_handle* handle);
 
+/*! \ingroup aux_module
+ *  \brief Select the execution backend of a rocsparselt handle
+ *
+ *  \details
+ *  \p rocsparselt_set_backend selects where the matmul, prune and compress functions
+ *  called with \p handle run. It should be called before any descriptor is initialized
+ *  with \p handle, since algorithm selections and plans are set up for the backend of
+ *  their time.
+ *
+ *  @param[in]
+ *  handle  rocsparselt library handle
+ *  @param[in]
+ *  backend the \ref rocsparselt_backend to use
+ *
+ *  \retval rocsparselt_status_success the operation completed successfully.
+ *  \retval rocsparselt_status_invalid_handle \p handle is invalid.
+ *  \retval rocsparselt_status_invalid_value \p backend is invalid, or is
+ *           \ref rocsparselt_backend_device and the handle has no HIP device.
+ */
+rocsparselt_status rocsparselt_set_backend(rocsparselt_handle* handle, rocsparselt_backend backend);
+
+/*! \ingroup aux_module
+ *  \brief Get the execution backend of a rocsparselt handle
+ *
+ *  @param[in]
+ *  handle  rocsparselt library handle
+ *  @param[out]
+ *  backend the \ref rocsparselt_backend of \p handle
+ *
+ *  \retval rocsparselt_status_success the operation completed successfully.
+ *  \retval rocsparselt_status_invalid_handle \p handle is invalid.
+ *  \retval rocsparselt_status_invalid_pointer \p backend is a NULL pointer.
+ */
+rocsparselt_status rocsparselt_get_backend(const rocsparselt_handle* handle,
+                                           rocsparselt_backend*      backend);
+
 /*! \ingroup aux_module
  *  \brief Create a descriptor for dense matrix
  *  \details
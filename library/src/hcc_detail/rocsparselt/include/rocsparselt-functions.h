@@ -183,6 +183,133 @@ rocsparselt_status rocsparselt_matmul_search(const rocsparselt_handle* handle,
                                              hipStream_t*              streams,
                                              int32_t                   numStreams);
 
+/*! \ingroup spmm_module
+ *  \brief Sparse matrix dense matrix multiplication with the M given per call
+ *
+ *  \details
+ *  \p rocsparselt_matmul_dynamic_m computes the matrix multiplication of \p plan as
+ *  rocsparselt_matmul() does, but with \p m rows of A, C and D instead of the M of
+ *  the matrix descriptors. The plan must come from a descriptor with
+ *  rocsparselt_matmul_dynamic_m_min set, and \p m must lie between that minimum and
+ *  the M of the descriptor.
+ *
+ *  rocsparselt_matmul_alg_selection_init() finds the best config for each power of
+ *  two in that range; the config of the smallest one not below \p m is run, unless
+ *  the config was set with rocsparselt_matmul_alg_config_id or a split-K factor was
+ *  requested.
+ *
+ *  \note
+ *  This function is non blocking and executed asynchronously with respect to the host.
+ *  It may return before the actual computation has finished.
+ *
+ *  @param[in]
+ *  handle      rocsparselt library handle
+ *  plan        Matrix multiplication plan
+ *  m           Number of rows of op(A), C and D
+ *  alpha       scalar \f$\alpha\f$. (float)
+ *  d_A         Pointer to the dense matrix A
+ *  d_B         Pointer to the structured matrix B
+ *  beta        scalar \f$\beta\f$. (float)
+ *  d_C         Pointer to the dense matrix C
+ *  d_D         Pointer to the dense matrix D
+ *  workspace   Pointor to the worksapce
+ *  streams     Pointer to HIP stream array for the computation
+ *  numStreams  Number of HIP streams in \p streams
+ *
+ *  \retval     rocsparselt_status_success the operation completed successfully.
+ *  \retval     rocsparselt_status_invalid_handle \p handle or \p plan is invalid.
+ *  \retval     rocsparselt_status_invalid_pointer \p alpha, \p A, \p B, \p beta, \p C or \p D
+ *              pointer is invalid.
+ *  \retval     rocsparselt_status_invalid_size \p m is out of the range of the plan.
+ *  \retval     rocsparselt_status_invalid_value the plan has a fixed M, workspace is invalid or
+ *              streams and numStreams are invalid
+ *  \retval     rocsparselt_status_not_implemented the problme is not supported
+ */
+rocsparselt_status rocsparselt_matmul_dynamic_m(const rocsparselt_handle*      handle,
+                                                const rocsparselt_matmul_plan* plan,
+                                                int64_t                        m,
+                                                const void*                    alpha,
+                                                const void*                    d_A,
+                                                const void*                    d_B,
+                                                const void*                    beta,
+                                                const void*                    d_C,
+                                                void*                          d_D,
+                                                void*                          workspace,
+                                                hipStream_t*                   streams,
+                                                int32_t                        numStreams);
+
+/*! \ingroup spmm_module
+ *  \brief Workspace size of a grouped matrix multiplication
+ *
+ *  \details
+ *  \p rocsparselt_matmul_grouped_get_workspace returns the workspace that
+ *  rocsparselt_matmul_grouped() needs for \p groups: the workspace of each plan,
+ *  rounded up to 256 bytes, so that groups running concurrently never share it.
+ *  Only the plans of \p groups are read.
+ *
+ *  @param[out]
+ *  workspaceSize  Workspace size in bytes
+ *
+ *  @param[in]
+ *  handle      rocsparselt library handle
+ *  groups      Array of \p groupCount groups
+ *  groupCount  Number of groups
+ *
+ *  \retval rocsparselt_status_success the operation completed successfully.
+ *  \retval rocsparselt_status_invalid_handle \p handle or the plan of a group is invalid.
+ *  \retval rocsparselt_status_invalid_pointer \p groups or \p workspaceSize pointer is invalid.
+ *  \retval rocsparselt_status_invalid_size \p groupCount is negative.
+ */
+rocsparselt_status rocsparselt_matmul_grouped_get_workspace(const rocsparselt_handle*       handle,
+                                                            const rocsparselt_matmul_group* groups,
+                                                            int32_t groupCount,
+                                                            size_t* workspaceSize);
+
+/*! \ingroup spmm_module
+ *  \brief Grouped sparse matrix dense matrix multiplication
+ *
+ *  \details
+ *  \p rocsparselt_matmul_grouped computes the \p groupCount matrix multiplications
+ *  described by \p groups, which may all have different shapes, in one call. Each
+ *  group is computed as rocsparselt_matmul() would with its plan and arguments.
+ *
+ *  All groups are checked before any of them is launched. With the host backend,
+ *  the output tiles of all groups are spread over one pool of threads. With the
+ *  device backend, each group is launched once with the config selected in its
+ *  plan, and the groups are spread over \p streams so that the estimated work on
+ *  each stream is balanced; the other streams are forked from and joined back
+ *  onto streams[0] with events.
+ *
+ *  \note
+ *  This function is non blocking and executed asynchronously with respect to the host.
+ *  It may return before the actual computation has finished.
+ *
+ *  \note
+ *  The D matrices of different groups must not overlap.
+ *
+ *  @param[in]
+ *  handle      rocsparselt library handle
+ *  groups      Array of \p groupCount groups
+ *  groupCount  Number of groups
+ *  workspace   Workspace of the size rocsparselt_matmul_grouped_get_workspace() returns
+ *  streams     Pointer to HIP stream array for the computation
+ *  numStreams  Number of HIP streams in \p streams
+ *
+ *  \retval     rocsparselt_status_success the operation completed successfully.
+ *  \retval     rocsparselt_status_invalid_handle \p handle or the plan of a group is invalid.
+ *  \retval     rocsparselt_status_invalid_pointer \p groups, or a pointer of a group, is
+ *              invalid.
+ *  \retval     rocsparselt_status_invalid_size \p groupCount is negative.
+ *  \retval     rocsparselt_status_invalid_value workspace is invalide or streams and numStreams are invalid
+ *  \retval     rocsparselt_status_not_implemented the problem of a group is not supported
+ */
+rocsparselt_status rocsparselt_matmul_grouped(const rocsparselt_handle*       handle,
+                                              const rocsparselt_matmul_group* groups,
+                                              int32_t                         groupCount,
+                                              void*                           workspace,
+                                              hipStream_t*                    streams,
+                                              int32_t                         numStreams);
+
 /*! \ingroup spmm_module
  *  \brief Purnes a dense matrix.
  *
@@ -439,6 +566,91 @@ rocsparselt_status rocsparselt_smfmac_compress2(const rocsparselt_handle*    han
                                                 void*                        d_compressBuffer,
                                                 hipStream_t                  stream);
 
+/*! \ingroup spmm_module
+ *  \brief compresses a dense matrix that is streamed through callbacks.
+ *
+ *  \details
+ *  \p rocsparselt_smfmac_compress_stream produces the same compressed matrix as
+ *  rocsparselt_smfmac_compress2, but the dense matrix is read with \p read in panels
+ *  of consecutive columns (or rows, whichever is contiguous in memory) and the
+ *  compressed values and metadata of each panel are handed to \p write at their
+ *  final offsets. At most two panels are held in host memory, so matrices larger
+ *  than host memory can be compressed; when the panels are columns, the metadata
+ *  of one batch is also gathered and written in one piece. Consecutive panels are
+ *  read, pruned and compressed, and written at the same time: the calling thread
+ *  compresses while one I/O thread writes the previous panel and then reads the
+ *  next, so \p read and \p write are never called concurrently.
+ *
+ *  The work runs on the host and the call returns once the last panel is written.
+ *
+ *  @param[in]
+ *  handle         handle to the rocsparselt library context queue.
+ *  sparseMatDescr structured(sparse) matrix descriptor.
+ *  isSparseA      specify if the structured (sparse) matrix is in the first position (matA or matB)
+ *  op             operation that will be applied to the structured (sparse) matrix in the multiplication
+ *  pruneAlg       if not NULL, each panel is pruned with this algorithm before it is compressed.
+ *  read           reads a range of the dense matrix.
+ *  write          writes a range of the compressed matrix.
+ *  user_data      passed to \p read and \p write.
+ *  panelBytes     upper bound on the dense bytes per panel, 0 selects a default.
+ *                 A panel always holds at least eight columns (rows).
+ *
+ *  \retval     rocsparselt_status_success the operation completed successfully.
+ *  \retval     rocsparselt_status_invalid_handle \p handle or \p sparseMatDescr is invalid.
+ *  \retval     rocsparselt_status_invalid_pointer \p read or \p write pointer is invalid.
+ *  \retval     rocsparselt_status_invalid_value \p op or \p pruneAlg is invalid.
+ *  \retval     rocsparselt_status_memory_error a panel buffer or thread could not be allocated.
+ *  \retval     rocsparselt_status_internal_error \p read or \p write failed.
+ *  \retval     rocsparselt_status_not_implemented the problem is not support
+ */
+rocsparselt_status rocsparselt_smfmac_compress_stream(const rocsparselt_handle*    handle,
+                                                      const rocsparselt_mat_descr* sparseMatDescr,
+                                                      int                          isSparseA,
+                                                      rocsparselt_operation        op,
+                                                      const rocsparselt_prune_alg* pruneAlg,
+                                                      rocsparselt_stream_read_fn   read,
+                                                      rocsparselt_stream_write_fn  write,
+                                                      void*                        user_data,
+                                                      size_t                       panelBytes);
+
+/*! \ingroup spmm_module
+ *  \brief compresses a dense matrix from one file into another.
+ *
+ *  \details
+ *  \p rocsparselt_smfmac_compress_file runs rocsparselt_smfmac_compress_stream with
+ *  the dense matrix read from \p denseFd at \p denseOffset and the compressed
+ *  matrix written to \p compressedFd at \p compressedOffset, using pread and pwrite.
+ *
+ *  @param[in]
+ *  handle           handle to the rocsparselt library context queue.
+ *  sparseMatDescr   structured(sparse) matrix descriptor.
+ *  isSparseA        specify if the structured (sparse) matrix is in the first position (matA or matB)
+ *  op               operation that will be applied to the structured (sparse) matrix in the multiplication
+ *  pruneAlg         if not NULL, each panel is pruned with this algorithm before it is compressed.
+ *  denseFd          file descriptor open for reading.
+ *  denseOffset      byte offset of the dense matrix in \p denseFd.
+ *  compressedFd     file descriptor open for writing.
+ *  compressedOffset byte offset of the compressed matrix in \p compressedFd.
+ *  panelBytes       upper bound on the dense bytes per panel, 0 selects a default.
+ *
+ *  \retval     rocsparselt_status_success the operation completed successfully.
+ *  \retval     rocsparselt_status_invalid_handle \p handle or \p sparseMatDescr is invalid.
+ *  \retval     rocsparselt_status_invalid_value \p op, \p pruneAlg, a file descriptor or an offset is invalid.
+ *  \retval     rocsparselt_status_memory_error a panel buffer or thread could not be allocated.
+ *  \retval     rocsparselt_status_internal_error reading or writing a file failed.
+ *  \retval     rocsparselt_status_not_implemented the problem is not support
+ */
+rocsparselt_status rocsparselt_smfmac_compress_file(const rocsparselt_handle*    handle,
+                                                    const rocsparselt_mat_descr* sparseMatDescr,
+                                                    int                          isSparseA,
+                                                    rocsparselt_operation        op,
+                                                    const rocsparselt_prune_alg* pruneAlg,
+                                                    int                          denseFd,
+                                                    int64_t                      denseOffset,
+                                                    int                          compressedFd,
+                                                    int64_t                      compressedOffset,
+                                                    size_t                       panelBytes);
+
 #ifdef __cplusplus
 }
 #endif
@@ -174,6 +174,22 @@ typedef enum rocsparselt_pointer_mode_
     rocsparselt_pointer_mode_device = 1 /**< scalar pointers are in device memory. */
 } rocsparselt_pointer_mode;
 
+/*! \ingroup types_module
+ *  \brief Indicates where matmul is executed.
+ *
+ *  \details
+ *  The \ref rocsparselt_backend of a handle is taken from the HIPSPARSELT_BACKEND
+ *  environment variable when the handle is initialized, and can be changed with
+ *  \ref rocsparselt_set_backend. The host backend runs matmul on the CPU
+ *  and expects all matrices, metadata, bias and scaling vectors and the
+ *  workspace in host memory.
+ */
+typedef enum rocsparselt_backend_
+{
+    rocsparselt_backend_device = 0, /**< matmul runs on the HIP device. */
+    rocsparselt_backend_host   = 1 /**< matmul runs on the host CPU. */
+} rocsparselt_backend;
+
 /*! \ingroup types_module
  *  \brief Indicates if layer is active with bitmask.
  *
@@ -294,6 +310,39 @@ typedef enum rocsparselt_matmul_descr_attribute_
     = 15, /**< Beta value of the Tanh activation function. */
     rocsparselt_matmul_bias_type = 16, /**< Precision of bias >*/
     rocsparselt_matmul_activation_none, /**< activation function is disabled. */
+    rocsparselt_matmul_pointer_array_batch
+    = 18, /**< Enable/Disable pointer-array batches: the dense matrix, C and D are host arrays of one pointer per batch. */
+    rocsparselt_matmul_dynamic_m_min
+    = 19, /**< Smallest M (int64_t) of a dynamic-M descriptor, whose plans run any M from it up to the M of the descriptor. 0 (default) fixes M. */
+    rocsparselt_matmul_a_scale_pointer
+    = 20, /**< Pointer to the float per-tensor scale of A, which multiplies the product of A and B along with alpha. NULL (default) is a scale of 1. */
+    rocsparselt_matmul_b_scale_pointer
+    = 21, /**< Pointer to the float per-tensor scale of B, see rocsparselt_matmul_a_scale_pointer. */
+    rocsparselt_matmul_activation_silu = 22, /**< SiLU (Swish) activation function. */
+    rocsparselt_matmul_activation_silu_beta
+    = 23, /**< Beta value of the SiLU activation function. */
+    rocsparselt_matmul_activation_hardswish = 24, /**< HardSwish activation function. */
+    rocsparselt_matmul_gated_epilogue
+    = 25, /**< Enable/Disable the gated epilogue: rows 2i and 2i+1 of the structured matrix give the gate and the up projection of output i, which is act(gate) * up. */
+    rocsparselt_matmul_d_scale_pointer
+    = 26, /**< Pointer to a vector of M float per-row scales of D, applied after the activation and before D is rounded. NULL (default) is a scale of 1. */
+    rocsparselt_matmul_d_rounding_mode
+    = 27, /**< Rounding of D to an 8 bit type. Values are specified in rocsparselt_rounding_mode. */
+    rocsparselt_matmul_d_rounding_seed = 28, /**< Seed (uint64_t) of stochastic rounding, 0 by default. */
+    rocsparselt_matmul_d_amax_pointer
+    = 29, /**< Pointer to a vector of batches * M floats that receives the absolute maximum of each row of D before its scale. NULL (default) disables it. */
+    rocsparselt_matmul_residual_pointer
+    = 30, /**< Pointer to a residual matrix with the type and layout of C, added to D after the activation. NULL (default) disables it. */
+    rocsparselt_matmul_bias_gradient_pointer
+    = 31, /**< Pointer to a vector of floats that receives the sums of the rows or columns of D before its scale. NULL (default) disables it. */
+    rocsparselt_matmul_bias_gradient_mode
+    = 32, /**< Sums of the bias gradient. Values are specified in rocsparselt_bias_gradient_mode. */
+    rocsparselt_matmul_weight_scale_pointer
+    = 33, /**< Pointer to the float scales of each group of each row of a weight-only quantized structured matrix. */
+    rocsparselt_matmul_weight_zero_pointer
+    = 34, /**< Pointer to the float zero points of a weight-only quantized structured matrix. NULL (default) means 0. */
+    rocsparselt_matmul_weight_group_size
+    = 35, /**< Number of elements along K that share a scale and zero point, a multiple of 8. 0 (default) means all of K. */
 } rocsparselt_matmul_descr_attribute;
 
 /*! \ingroup types_module
@@ -342,6 +391,52 @@ typedef enum rocsparselt_prune_alg_
     = 1, /**< - Zero-out two values in a 1x4 strip to maximize the L1-norm of the resulting strip. */
 } rocsparselt_prune_alg;
 
+/*! \ingroup types_module
+ *  \brief Reads part of the dense matrix for \ref rocsparselt_smfmac_compress_stream.
+ *
+ *  \details
+ *  Copies \p size bytes, starting \p offset bytes into the dense matrix, into
+ *  \p buffer. Offsets address the dense matrix as \ref rocsparselt_smfmac_compress2
+ *  would read it from memory. Returns 0 on success; any other value stops the
+ *  compression.
+ */
+typedef int (*rocsparselt_stream_read_fn)(void*  user_data,
+                                          size_t offset,
+                                          size_t size,
+                                          void*  buffer);
+
+/*! \ingroup types_module
+ *  \brief Writes part of the compressed matrix for \ref rocsparselt_smfmac_compress_stream.
+ *
+ *  \details
+ *  Stores \p size bytes from \p buffer, starting \p offset bytes into the
+ *  compressed matrix whose size \ref rocsparselt_smfmac_compressed_size2 reports.
+ *  Returns 0 on success; any other value stops the compression.
+ */
+typedef int (*rocsparselt_stream_write_fn)(void*       user_data,
+                                           size_t      offset,
+                                           size_t      size,
+                                           const void* buffer);
+
+/*! \ingroup types_module
+ *  \brief One matrix multiplication of a grouped matrix multiplication.
+ *
+ *  \details
+ *  The \ref rocsparselt_matmul_group is used in the \ref rocsparselt_matmul_grouped
+ *  function. \p plan fixes the shape, data types and epilogue of the multiplication,
+ *  and the other members are the arguments of the same name of rocsparselt_matmul().
+ */
+typedef struct rocsparselt_matmul_group_
+{
+    const rocsparselt_matmul_plan* plan;
+    const void*                    alpha;
+    const void*                    d_A;
+    const void*                    d_B;
+    const void*                    beta;
+    const void*                    d_C;
+    void*                          d_D;
+} rocsparselt_matmul_group;
+
 /*! \brief Indicates if atomics operations are allowed. Not allowing atomic operations
 *    may generally improve determinism and repeatability of results at a cost of performance */
 typedef enum rocsparselt_atomics_mode_
@@ -359,6 +454,19 @@ typedef enum rocsparselt_split_k_mode_
     rocsparselt_split_k_mode_two_kernels = 1, /**< Use anoghter kernel to do the final reduction */
 } rocsparselt_split_k_mode;
 
+typedef enum rocsparselt_rounding_mode_
+{
+    rocsparselt_rounding_nearest_even = 0, /**< Round to nearest, ties to even */
+    rocsparselt_rounding_stochastic
+    = 1, /**< Round up with a probability of the distance to the value below */
+} rocsparselt_rounding_mode;
+
+typedef enum rocsparselt_bias_gradient_mode_
+{
+    rocsparselt_bias_gradient_rows    = 0, /**< Sum each row of D */
+    rocsparselt_bias_gradient_columns = 1, /**< Sum each column of D */
+} rocsparselt_bias_gradient_mode;
+
 #ifdef __cplusplus
 }
 #endif
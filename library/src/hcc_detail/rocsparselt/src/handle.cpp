@@ -30,6 +30,7 @@
 #include "status.h"
 #include "utility.hpp"
 
+#include <cstring>
 #include <hip/hip_runtime.h>
 
 ROCSPARSELT_KERNEL void init_kernel(){};
@@ -88,6 +89,25 @@ void _rocsparselt_handle::init()
         open_log_stream(&log_bench_os, log_bench_ofs, "HIPSPARSELT_LOG_BENCH_FILE");
     }
 
+    search_options = rocsparselt_search_options_from_env();
+
+    // Execution backend
+    if((str_layer_mode = getenv("HIPSPARSELT_BACKEND")) != NULL
+       && strcmp(str_layer_mode, "host") == 0)
+        backend = rocsparselt_backend_host;
+
+    // The host backend does not require a usable device
+    if(backend == rocsparselt_backend_host && hipGetDevice(&device) != hipSuccess)
+    {
+        log_trace(this, "handle::init", "host backend without device");
+        device = -1;
+        memset(&properties, 0, sizeof(properties));
+        wavefront_size = 0;
+        asic_rev       = 0;
+        is_init        = (uintptr_t)(this);
+        return;
+    }
+
     // Default device is active device
     THROW_IF_HIP_ERROR(hipGetDevice(&device));
     log_trace(this, "handle::init", "hipGetDevice");
@@ -98,6 +118,9 @@ void _rocsparselt_handle::init()
     // Device wavefront size
     wavefront_size = properties.warpSize;
 
+    THROW_IF_HIP_ERROR(hipEventCreate(&search_start));
+    THROW_IF_HIP_ERROR(hipEventCreate(&search_stop));
+
 #if HIP_VERSION >= 307
     // ASIC revision
     asic_rev = properties.asicRevision;
@@ -111,6 +134,12 @@ void _rocsparselt_handle::init()
 void _rocsparselt_handle::destroy()
 {
     is_init = 0;
+    if(search_start)
+        (void)hipEventDestroy(search_start);
+    if(search_stop)
+        (void)hipEventDestroy(search_stop);
+    search_start = search_stop = nullptr;
+
     // Close log files
     if(log_trace_ofs)
     {
@@ -158,9 +187,27 @@ std::ostream& operator<<(std::ostream& stream, const _rocsparselt_matmul_descr&
            << ", activation_tanh_alpha=" << t.activation_tanh_alpha
            << ", activation_tanh_beta=" << t.activation_tanh_beta
            << ", activation_gelu_scaling=" << t.activation_gelu_scaling
+           << ", activation_silu_beta=" << t.activation_silu_beta
            << ", bias_pointer=" << t.bias_pointer << ", bias_stride=" << t.bias_stride
-           << ", bias_type=" << hipDataType_to_string(t.bias_type) << ", m=" << t.m << ", n=" << t.n
-           << ", k=" << t.k << ", is_sparse_a=" << t.is_sparse_a << "}";
+           << ", bias_type=" << hipDataType_to_string(t.bias_type)
+           << ", alpha_vector_scaling=" << t.alpha_vector_scaling
+           << ", beta_vector_scaling=" << t.beta_vector_scaling
+           << ", pointer_array_batch=" << t.pointer_array_batch
+           << ", dynamic_m_min=" << t.dynamic_m_min
+           << ", gated_epilogue=" << t.gated_epilogue << ", m=" << t.m << ", n=" << t.n
+           << ", k=" << t.k << ", is_sparse_a=" << t.is_sparse_a
+           << ", a_scale_pointer=" << t.a_scale_pointer
+           << ", b_scale_pointer=" << t.b_scale_pointer
+           << ", d_scale_pointer=" << t.d_scale_pointer
+           << ", d_rounding_mode=" << t.d_rounding_mode
+           << ", d_rounding_seed=" << t.d_rounding_seed
+           << ", d_amax_pointer=" << t.d_amax_pointer
+           << ", residual_pointer=" << t.residual_pointer
+           << ", bias_gradient_pointer=" << t.bias_gradient_pointer
+           << ", bias_gradient_mode=" << t.bias_gradient_mode
+           << ", weight_scale_pointer=" << t.weight_scale_pointer
+           << ", weight_zero_pointer=" << t.weight_zero_pointer
+           << ", weight_group_size=" << t.weight_group_size << "}";
     return stream;
 }
 
@@ -169,7 +216,9 @@ std::ostream& operator<<(std::ostream& stream, const _rocsparselt_matmul_alg_sel
     stream << "{"
            << "ptr=" << (&t) << ", alg=" << t.alg << ", config_id=" << t.config_id
            << ", config_max_id=" << t.config_max_id << ", search_iterations=" << t.search_iterations
-           << "}";
+           << ", split_k=" << t.split_k << ", split_k_mode=" << t.split_k_mode
+           << ", split_k_buffers=" << t.split_k_buffers << ", dynamic_m=[" << t.dynamic_m_min
+           << ", " << t.dynamic_m_max << "]}";
     return stream;
 }
 
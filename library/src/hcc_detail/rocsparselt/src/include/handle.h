@@ -27,11 +27,13 @@
 #define HANDLE_H
 
 #include "rocsparselt.h"
+#include "search_strategy.hpp"
 
 #include <fstream>
 #include <hip/hip_runtime_api.h>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 /********************************************************************************
@@ -67,10 +69,17 @@ struct _rocsparselt_handle
 
     // pointer mode ; default mode is host
     rocsparselt_pointer_mode pointer_mode = rocsparselt_pointer_mode_host;
+    // execution backend ; default backend is device
+    rocsparselt_backend backend = rocsparselt_backend_device;
     // logging mode
     int  layer_mode;
     bool log_bench = false;
 
+    // rocsparselt_matmul_search() strategy and the events it times configs with
+    RocsparseltSearchOptions search_options;
+    hipEvent_t               search_start = nullptr;
+    hipEvent_t               search_stop  = nullptr;
+
     // device buffer
     size_t    buffer_size;
     void*     buffer;
@@ -208,14 +217,31 @@ struct _rocsparselt_matmul_descr
         , activation_tanh_alpha(rhs.activation_tanh_alpha)
         , activation_tanh_beta(rhs.activation_tanh_beta)
         , activation_gelu_scaling(rhs.activation_gelu_scaling)
+        , activation_silu_beta(rhs.activation_silu_beta)
         , bias_pointer(rhs.bias_pointer)
         , bias_stride(rhs.bias_stride)
         , bias_type(rhs.bias_type)
         , alpha_vector_scaling(rhs.alpha_vector_scaling)
+        , beta_vector_scaling(rhs.beta_vector_scaling)
+        , pointer_array_batch(rhs.pointer_array_batch)
+        , dynamic_m_min(rhs.dynamic_m_min)
+        , gated_epilogue(rhs.gated_epilogue)
         , m(rhs.m)
         , n(rhs.n)
         , k(rhs.k)
         , is_sparse_a(rhs.is_sparse_a)
+        , a_scale_pointer(rhs.a_scale_pointer)
+        , b_scale_pointer(rhs.b_scale_pointer)
+        , d_scale_pointer(rhs.d_scale_pointer)
+        , d_rounding_mode(rhs.d_rounding_mode)
+        , d_rounding_seed(rhs.d_rounding_seed)
+        , d_amax_pointer(rhs.d_amax_pointer)
+        , residual_pointer(rhs.residual_pointer)
+        , bias_gradient_pointer(rhs.bias_gradient_pointer)
+        , bias_gradient_mode(rhs.bias_gradient_mode)
+        , weight_scale_pointer(rhs.weight_scale_pointer)
+        , weight_zero_pointer(rhs.weight_zero_pointer)
+        , weight_group_size(rhs.weight_group_size)
         , _op_A(rhs._op_A)
         , _op_B(rhs._op_B)
         , _m(rhs._m)
@@ -253,6 +279,22 @@ struct _rocsparselt_matmul_descr
         return is_init != 0 && is_init == (uintptr_t)handle;
     }
 
+    // type of the dense matrix, which is the input type of the problem
+    hipDataType input_type() const
+    {
+        return is_sparse_a ? matrix_B->type : matrix_A->type;
+    }
+
+    // whether the structured matrix holds int8 or int4 weights that are
+    // dequantized by group and multiplied with a 16 bit dense matrix
+    bool is_weight_only() const
+    {
+        hipDataType w_type = is_sparse_a ? matrix_A->type : matrix_B->type;
+        hipDataType i_type = input_type();
+        return (w_type == HIP_R_8I || w_type == HIP_R_4I)
+               && (i_type == HIP_R_16F || i_type == HIP_R_16BF);
+    }
+
     friend std::ostream& operator<<(std::ostream& stream, const _rocsparselt_matmul_descr& t);
 
     const _rocsparselt_handle* handle = nullptr;
@@ -279,15 +321,43 @@ struct _rocsparselt_matmul_descr
     float       activation_tanh_alpha             = 1.0f;
     float       activation_tanh_beta              = 1.0f;
     float       activation_gelu_scaling           = 1.0f;
+    float       activation_silu_beta              = 1.0f;
     float*      bias_pointer                      = nullptr;
     int64_t     bias_stride                       = 0;
     hipDataType bias_type;
     int         alpha_vector_scaling = 0;
+    int         beta_vector_scaling  = 0;
+    int         pointer_array_batch  = 0;
+    int64_t     dynamic_m_min        = 0; // 0: M is fixed, else plans run any M in [min, m]
+    int         gated_epilogue       = 0;
     int64_t     m                    = 0;
     int64_t     n                    = 0;
     int64_t     k                    = 0;
     bool        is_sparse_a          = true;
 
+    // Per-tensor scales of A and B, nullptr for none. They point to device
+    // memory, or host memory with the host backend, and are read at run time.
+    const float* a_scale_pointer = nullptr;
+    const float* b_scale_pointer = nullptr;
+
+    // Per-row scales of D, its rounding to 8 bit types and the per-row absolute
+    // maxima it returns, read and written at run time like the scales of A and B.
+    const float*              d_scale_pointer = nullptr;
+    rocsparselt_rounding_mode d_rounding_mode = rocsparselt_rounding_nearest_even;
+    uint64_t                  d_rounding_seed = 0;
+    float*                    d_amax_pointer  = nullptr;
+
+    // The residual added to D and the sums of D for the bias gradient of training
+    const void*                    residual_pointer      = nullptr;
+    float*                         bias_gradient_pointer = nullptr;
+    rocsparselt_bias_gradient_mode bias_gradient_mode    = rocsparselt_bias_gradient_rows;
+
+    // Group-wise scales and zero points of a weight-only quantized structured
+    // matrix, read at run time. A group size of 0 makes all of K one group.
+    const float* weight_scale_pointer = nullptr;
+    const float* weight_zero_pointer  = nullptr;
+    int          weight_group_size    = 0;
+
     rocsparselt_operation _op_A;
     rocsparselt_operation _op_B;
     int64_t               _m           = 0;
@@ -306,6 +376,34 @@ private:
     uintptr_t is_init      = 0;
 };
 
+/********************************************************************************
+ * \brief Whether a kernel that splits K kernel_split_k ways, reducing the partial
+ * results in a second kernel when global_accumulation is set, runs the split-K
+ * request of an alg selection. A split_k of 0 is no request, and a kernel_split_k
+ * of 0 is a kernel that takes the split factor at launch time.
+ *******************************************************************************/
+inline bool rocsparselt_split_k_matches(int                      split_k,
+                                        rocsparselt_split_k_mode split_k_mode,
+                                        int                      kernel_split_k,
+                                        bool                     global_accumulation)
+{
+    if(split_k == 0 || kernel_split_k == 0)
+        return true;
+    if(split_k != kernel_split_k)
+        return false;
+    return split_k == 1
+           || global_accumulation == (split_k_mode == rocsparselt_split_k_mode_two_kernels);
+}
+
+/********************************************************************************
+ * \brief M bucket of a dynamic-M plan. Bucket b holds the M in (2^(b-1), 2^b],
+ * so it is given by the bit width of M - 1.
+ *******************************************************************************/
+inline int rocsparselt_dynamic_m_bucket(int64_t m)
+{
+    return m <= 1 ? 0 : 64 - __builtin_clzll(static_cast<uint64_t>(m - 1));
+}
+
 struct __attribute__((packed, aligned(8))) _rocsparselt_matmul_config
 {
     _rocsparselt_matmul_config() {}
@@ -314,13 +412,25 @@ struct __attribute__((packed, aligned(8))) _rocsparselt_matmul_config
     _rocsparselt_matmul_config(const _rocsparselt_matmul_config& rhs)
     {
         this->index               = rhs.index;
+        this->use_bias            = rhs.use_bias;
+        this->use_scale_alpha_vec = rhs.use_scale_alpha_vec;
         this->max_workspace_bytes = rhs.max_workspace_bytes;
+        this->split_k             = rhs.split_k;
+        this->global_accumulation = rhs.global_accumulation;
+    }
+
+    bool matches_split_k(int split_k, rocsparselt_split_k_mode split_k_mode) const
+    {
+        return rocsparselt_split_k_matches(
+            split_k, split_k_mode, this->split_k, this->global_accumulation != 0);
     }
 
     int    index;
     int    use_bias            = 0;
     int    use_scale_alpha_vec = 0;
     size_t max_workspace_bytes = 0;
+    int    split_k             = 1; // GlobalSplitU of the kernel, 0 if chosen at launch time
+    int    global_accumulation = 0; // partial results are reduced by a second kernel
 };
 
 /********************************************************************************
@@ -348,6 +458,18 @@ struct _rocsparselt_matmul_alg_selection
         return is_init != 0 && is_init == (uintptr_t)handle;
     }
 
+    // The current config if it runs the split-K request, else the first config
+    // that does, or -1 if there is none.
+    int find_split_k_config(int split_k, rocsparselt_split_k_mode split_k_mode) const
+    {
+        if(config_id < config_max_id && configs[config_id].matches_split_k(split_k, split_k_mode))
+            return config_id;
+        for(int i = 0; i < config_max_id; i++)
+            if(configs[i].matches_split_k(split_k, split_k_mode))
+                return i;
+        return -1;
+    }
+
     friend std::ostream& operator<<(std::ostream&                            stream,
                                     const _rocsparselt_matmul_alg_selection& t);
 
@@ -358,10 +480,43 @@ struct _rocsparselt_matmul_alg_selection
 
     rocsparselt_matmul_alg alg;
     //data of rocsparselt_matmul_alg_attribute
-    int       config_id         = 0;
-    int       config_max_id     = 0;
-    int       search_iterations = 10;
-    uintptr_t is_init           = 0;
+    int                      config_id         = 0;
+    int                      config_max_id     = 0;
+    int                      search_iterations = 10;
+    int                      split_k           = 0; // 0: not set, any split factor
+    rocsparselt_split_k_mode split_k_mode      = rocsparselt_split_k_mode_two_kernels;
+    int                      split_k_buffers   = 0; // 0: split_k - 1 buffers
+    bool                     user_config_id    = false; // set by the user, skip the tuning db
+
+    // Best config of each M bucket of a dynamic-M descriptor, indexed by
+    // rocsparselt_dynamic_m_bucket(). Only the buckets of [dynamic_m_min,
+    // dynamic_m_max] are set; both are 0 for a fixed M.
+    _rocsparselt_matmul_config dynamic_m_configs[64];
+    int64_t                    dynamic_m_min = 0;
+    int64_t                    dynamic_m_max = 0;
+
+    uintptr_t is_init = 0;
+};
+
+/********************************************************************************
+ * \brief _rocsparselt_matmul_launch_cache holds the backend launch state of a
+ * matrix multiplication plan (problem descriptor, selected solution, hardware).
+ * It is created by rocsparselt_matmul_plan_init() and filled by the first
+ * rocsparselt_matmul() call, so later calls only update pointers and scalars.
+ * It also owns the events that fork and join the streams of a multi-stream
+ * launch; they are only used with the mutex held.
+ *******************************************************************************/
+struct _rocsparselt_matmul_launch_cache
+{
+    ~_rocsparselt_matmul_launch_cache()
+    {
+        for(auto event : events)
+            (void)hipEventDestroy(event);
+    }
+
+    std::mutex                  mutex;
+    std::shared_ptr<const void> state;
+    std::vector<hipEvent_t>     events;
 };
 
 /********************************************************************************
@@ -394,8 +549,10 @@ struct _rocsparselt_matmul_plan
     void clear()
     {
         delete matmul_descr;
+        delete launch_cache;
         matmul_descr  = nullptr;
         alg_selection = nullptr;
+        launch_cache  = nullptr;
         is_init       = 0;
     }
 
@@ -406,6 +563,8 @@ struct _rocsparselt_matmul_plan
     _rocsparselt_matmul_descr* matmul_descr = nullptr;
     //
     _rocsparselt_matmul_alg_selection* alg_selection = nullptr;
+    // cached launch state, see _rocsparselt_matmul_launch_cache
+    _rocsparselt_matmul_launch_cache* launch_cache = nullptr;
 
     //
     uintptr_t is_init = 0;
@@ -30,7 +30,9 @@
 #include "kernel_arguments.hpp"
 #include <hip/hip_runtime.h>
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 
 class SolutionAdapter
@@ -58,6 +60,13 @@ public:
                                hipEvent_t                 startEvent,
                                hipEvent_t                 stopEvent,
                                int                        iter = 1);
+    hipError_t    launchKernel(const _rocsparselt_handle*    handle,
+                               PackedKernelInvocation const& kernel,
+                               PackedKernelArguments const&  args,
+                               hipStream_t                   stream,
+                               hipEvent_t                    startEvent,
+                               hipEvent_t                    stopEvent,
+                               int                           iter = 1);
     hipError_t    launchKernels(const _rocsparselt_handle*           handle,
                                 std::vector<KernelInvocation> const& kernels);
     hipError_t    launchKernels(const _rocsparselt_handle*           handle,
@@ -78,6 +87,21 @@ private:
     using function_table = std::map<std::string, void*>;
 
     hipError_t getKernel(hipFunction_t& rv, std::string const& name);
+    hipError_t resolveKernel(const _rocsparselt_handle* handle,
+                             std::string const&         name,
+                             int                        id,
+                             hipFunction_t&             rv);
+    hipError_t launchFunction(const _rocsparselt_handle* handle,
+                              hipFunction_t              function,
+                              dim3 const&                numWorkItems,
+                              dim3 const&                workGroupSize,
+                              size_t                     sharedMemBytes,
+                              void const*                args,
+                              size_t                     argsSize,
+                              hipStream_t                stream,
+                              hipEvent_t                 startEvent,
+                              hipEvent_t                 stopEvent,
+                              int                        iter);
     std::mutex m_access;
     std::unordered_map<std::string, hipModule_t>   m_modules;
     std::unordered_map<std::string, hipFunction_t> m_kernels;
@@ -86,6 +110,13 @@ private:
     std::vector<void*>                             m_lib_handles;
     std::vector<function_table>                    m_lib_functions;
     std::vector<std::string>                       m_loadedLibNames;
+
+    // Resolved functions indexed by KernelParams::KernelId. The table is
+    // sized when the kernel library is loaded and never reallocated, so
+    // launches read it without taking m_access. m_functionCount is written
+    // under m_access with release and read by launches with acquire.
+    std::unique_ptr<std::atomic<hipFunction_t>[]> m_functions;
+    std::atomic<size_t>                            m_functionCount{0};
     friend std::ostream& operator<<(std::ostream& stream, SolutionAdapter const& adapter);
 };
 std::ostream& operator<<(std::ostream& stream, SolutionAdapter const& adapter);
@@ -0,0 +1,326 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+#ifndef ROCSPARSELT_HOST_SPMM_HPP
+#define ROCSPARSELT_HOST_SPMM_HPP
+
+#include "handle.h"
+#if BUILD_WITH_TENSILE
+#include "tensile_host.hpp"
+#else
+#include "kernel_launcher.hpp"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/*******************************************************************************
+ * The host backend runs rocsparselt_matmul() on the CPU for handles created
+ * with HIPSPARSELT_BACKEND=host. All matrices, the metadata produced by
+ * rocsparselt_smfmac_compress() and the alpha/beta/bias vectors must be in
+ * host memory.
+ *
+ * The kernel walks the compressed operand directly. It only multiplies the K/2
+ * kept values of each 2:4 group with the rows of the dense operand that the
+ * metadata selects, and accumulates in float. The work is cache-blocked, split
+ * across std::thread workers, and vectorized for AVX-512 or AVX2 when the CPU
+ * supports them. Alpha and beta vector scaling, bias and activation are
+ * applied in the same pass that writes D.
+ *
+ * When there are fewer output tiles than threads, or rocsparselt_matmul_split_k
+ * asks for it, K is split into slices of whole metadata groups. The partial
+ * results are summed per tile under a lock (one kernel mode), or kept in
+ * split_k_buffers + 1 buffers that a second pass sums in a fixed order (two
+ * kernels mode, the default). The partial results are kept in the workspace,
+ * see getHostSpmmWorkspaceSize().
+ *
+ * The call is synchronous; streams are ignored.
+ ******************************************************************************/
+template <typename Ti, typename To, typename Tc>
+rocsparselt_status runContractionProblemHost(const RocsparseltContractionProblem<Ti, To, Tc>& prob);
+
+/*******************************************************************************
+ * Bytes of the split-K buffers of the plan's problem, for any M of a
+ * dynamic-M plan. This is the workspace that rocsparselt_matmul_get_workspace()
+ * reports for the host backend, and it must be in host memory.
+ ******************************************************************************/
+size_t getHostSpmmWorkspaceSize(const _rocsparselt_matmul_descr*         matmul_descr,
+                                const _rocsparselt_matmul_alg_selection* alg_selection);
+
+/*******************************************************************************
+ * Grouped matmul on the host. Each problem of a rocsparselt_matmul_grouped()
+ * call is wrapped in a HostSpmmGroup, and runGroupedContractionProblemsHost()
+ * hands the output tiles of all groups to one pool of threads, groups with the
+ * most work per tile first, so small groups fill in behind large ones instead
+ * of each group waiting for its own threads to start.
+ *
+ * Groups are not split along K unless their plan asks for it; those run one
+ * after the other once the shared tiles are done.
+ ******************************************************************************/
+struct HostSpmmScratch;
+
+class HostSpmmGroup
+{
+public:
+    virtual ~HostSpmmGroup() = default;
+
+    // Output tiles run by the shared pool, 0 when the group splits K
+    virtual int64_t pooled_tiles() const = 0;
+    // Multiply-adds per tile
+    virtual int64_t tile_cost() const = 0;
+    virtual void    run_tile(int64_t tile, HostSpmmScratch& scratch) const = 0;
+    // Runs the whole problem
+    virtual rocsparselt_status run() const = 0;
+};
+
+using HostSpmmGroups = std::vector<std::unique_ptr<HostSpmmGroup>>;
+
+template <typename Ti, typename To, typename Tc>
+rocsparselt_status appendHostSpmmGroup(HostSpmmGroups&                                  groups,
+                                       const RocsparseltContractionProblem<Ti, To, Tc>& prob);
+
+rocsparselt_status runGroupedContractionProblemsHost(const _rocsparselt_handle* handle,
+                                                     const HostSpmmGroups&      groups);
+
+/*******************************************************************************
+ * Host versions of the prune, prune check and compress kernels. They take the
+ * same sizes and strides as the kernel launchers in rocsparselt_prune.cpp and
+ * rocsparselt_compress.cpp and produce bit-identical results: the same kept
+ * elements, the same compressed values and the same metadata bytes.
+ ******************************************************************************/
+template <typename Ti, typename Tc>
+rocsparselt_status rocsparselt_smfmac_prune_host(const _rocsparselt_handle* handle,
+                                                 int64_t                    m,
+                                                 int64_t                    n,
+                                                 int64_t                    stride0,
+                                                 int64_t                    stride1,
+                                                 int                        num_batches,
+                                                 int64_t                    batch_stride,
+                                                 const Ti*                  in,
+                                                 Ti*                        out,
+                                                 rocsparselt_prune_alg      pruneAlg);
+
+template <typename Ti>
+rocsparselt_status rocsparselt_smfmac_prune_check_host(const _rocsparselt_handle* handle,
+                                                       int64_t                    m,
+                                                       int64_t                    n,
+                                                       int64_t                    stride0,
+                                                       int64_t                    stride1,
+                                                       int                        num_batches,
+                                                       int64_t                    batch_stride,
+                                                       const Ti*                  in,
+                                                       int*                       out);
+
+template <typename Ti>
+rocsparselt_status rocsparselt_smfmac_compress_host(const _rocsparselt_handle* handle,
+                                                    int64_t                    m,
+                                                    int64_t                    n,
+                                                    int64_t                    stride0,
+                                                    int64_t                    stride1,
+                                                    int64_t                    batch_stride,
+                                                    int64_t                    c_stride0,
+                                                    int64_t                    c_stride1,
+                                                    int64_t                    c_batch_stride,
+                                                    int64_t                    m_stride0,
+                                                    int64_t                    m_stride1,
+                                                    int64_t                    m_batch_stride,
+                                                    int                        num_batches,
+                                                    const Ti*                  in,
+                                                    Ti*                        out,
+                                                    unsigned char*             metadata);
+
+/*******************************************************************************
+ * The I4 versions run the I8 kernels above on an unpacked copy of the matrix,
+ * and pack the results back, leaving the elements outside the matrix as they
+ * were.
+ ******************************************************************************/
+rocsparselt_status rocsparselt_smfmac_prune_host_i4(const _rocsparselt_handle* handle,
+                                                    int64_t                    m,
+                                                    int64_t                    n,
+                                                    int64_t                    stride0,
+                                                    int64_t                    stride1,
+                                                    int                        num_batches,
+                                                    int64_t                    batch_stride,
+                                                    const void*                in,
+                                                    void*                      out,
+                                                    rocsparselt_prune_alg      pruneAlg);
+
+rocsparselt_status rocsparselt_smfmac_prune_check_host_i4(const _rocsparselt_handle* handle,
+                                                          int64_t                    m,
+                                                          int64_t                    n,
+                                                          int64_t                    stride0,
+                                                          int64_t                    stride1,
+                                                          int                        num_batches,
+                                                          int64_t                    batch_stride,
+                                                          const void*                in,
+                                                          int*                       out);
+
+rocsparselt_status rocsparselt_smfmac_compress_host_i4(const _rocsparselt_handle* handle,
+                                                       int64_t                    m,
+                                                       int64_t                    n,
+                                                       int64_t                    stride0,
+                                                       int64_t                    stride1,
+                                                       int64_t                    batch_stride,
+                                                       int64_t                    c_stride0,
+                                                       int64_t                    c_stride1,
+                                                       int64_t                    c_batch_stride,
+                                                       int64_t                    m_stride0,
+                                                       int64_t                    m_stride1,
+                                                       int64_t                    m_batch_stride,
+                                                       int                        num_batches,
+                                                       const void*                in,
+                                                       void*                      out,
+                                                       unsigned char*             metadata);
+
+/*******************************************************************************
+ * Streaming compression for rocsparselt_smfmac_compress_stream() and
+ * rocsparselt_smfmac_compress_file(). m, n and the strides are those of
+ * get_compress_matrix_size(); the compressed layout is taken from matrix, which
+ * must already be set up by initSparseMatrixLayout(). Runs on the host for
+ * either backend.
+ ******************************************************************************/
+rocsparselt_status rocsparselt_smfmac_compress_stream_host(const _rocsparselt_handle*    handle,
+                                                           const _rocsparselt_mat_descr* matrix,
+                                                           int64_t                       m,
+                                                           int64_t                       n,
+                                                           int64_t                       stride0,
+                                                           int64_t                       stride1,
+                                                           const rocsparselt_prune_alg*  pruneAlg,
+                                                           rocsparselt_stream_read_fn    read,
+                                                           rocsparselt_stream_write_fn   write,
+                                                           void*                         user_data,
+                                                           size_t panelBytes);
+
+rocsparselt_status rocsparselt_smfmac_compress_file_host(const _rocsparselt_handle*    handle,
+                                                         const _rocsparselt_mat_descr* matrix,
+                                                         int64_t                       m,
+                                                         int64_t                       n,
+                                                         int64_t                       stride0,
+                                                         int64_t                       stride1,
+                                                         const rocsparselt_prune_alg*  pruneAlg,
+                                                         int                           denseFd,
+                                                         int64_t                       denseOffset,
+                                                         int                           compressedFd,
+                                                         int64_t compressedOffset,
+                                                         size_t  panelBytes);
+
+/*******************************************************************************
+ * runHostWorkers calls worker() on num_threads threads, the calling thread
+ * included, and waits for all of them. Workers share work through their own
+ * atomic task counter. Returns rocsparselt_status_memory_error if a thread
+ * could not be started or a worker threw.
+ ******************************************************************************/
+template <typename Worker>
+rocsparselt_status runHostWorkers(int64_t num_threads, const Worker& worker)
+{
+    std::atomic<bool> failed{false};
+
+    auto run = [&] {
+        try
+        {
+            worker();
+        }
+        catch(...)
+        {
+            failed = true;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    try
+    {
+        for(int64_t i = 1; i < num_threads; i++)
+            pool.emplace_back(run);
+    }
+    catch(...)
+    {
+        failed = true;
+    }
+    run();
+    for(auto& t : pool)
+        t.join();
+
+    return failed ? rocsparselt_status_memory_error : rocsparselt_status_success;
+}
+
+/*******************************************************************************
+ * HIP_R_4I matrices pack two signed values to a byte: element e is the low
+ * nibble of byte e / 2 when e is even and the high nibble when it is odd.
+ ******************************************************************************/
+inline int8_t load_int4(const void* data, int64_t e)
+{
+    uint8_t byte = static_cast<const uint8_t*>(data)[e >> 1];
+    uint8_t bits = (e & 1) ? byte >> 4 : byte & 0xf;
+    return static_cast<int8_t>(bits << 4) >> 4;
+}
+
+inline void store_int4(void* data, int64_t e, int8_t value)
+{
+    uint8_t& byte = static_cast<uint8_t*>(data)[e >> 1];
+    uint8_t  bits = value & 0xf;
+    byte          = (e & 1) ? (byte & 0x0f) | (bits << 4) : (byte & 0xf0) | bits;
+}
+
+inline void unpack_int4(const void* data, int64_t count, int8_t* values)
+{
+    for(int64_t e = 0; e < count; e++)
+        values[e] = load_int4(data, e);
+}
+
+inline void pack_int4(const int8_t* values, int64_t count, void* data)
+{
+    for(int64_t e = 0; e < count; e++)
+        store_int4(data, e, values[e]);
+}
+
+// Number of elements from the first to the last one of a batched m x n matrix
+inline int64_t stridedExtent(int64_t m,
+                             int64_t n,
+                             int64_t stride0,
+                             int64_t stride1,
+                             int     num_batches,
+                             int64_t batch_stride)
+{
+    return (num_batches - 1) * batch_stride + (m - 1) * stride0 + (n - 1) * stride1 + 1;
+}
+
+// Upper bound on the number of host threads
+inline int64_t hostThreadLimit()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Number of host threads for num_tasks independent tasks
+inline int64_t hostThreadCount(int64_t num_tasks)
+{
+    return std::max<int64_t>(1, std::min(hostThreadLimit(), num_tasks));
+}
+
+#endif // ROCSPARSELT_HOST_SPMM_HPP
@@ -27,6 +27,7 @@
 #pragma once
 
 #include "hipsparselt_ostream.hpp"
+#include <cassert>
 #include <cstring>
 #include <hip/hip_runtime_api.h>
 #include <sstream>
@@ -249,6 +250,120 @@ KernelArguments::const_iterator::operator T() const
     return *reinterpret_cast<T*>(const_cast<void*>(m_value.first));
 }
 
+/**
+ * \ingroup Launching
+ * Fixed-offset layout of the arguments of a kernel. Offsets follow the same
+ * alignment rules as KernelArguments::append(), so the layout only has to be
+ * computed once per kernel; afterwards a PackedKernelArguments buffer can be
+ * refilled without argument names or heap allocations.
+ */
+class KernelArgumentsLayout
+{
+public:
+    template <typename T>
+    size_t append(std::string const& name);
+
+    size_t offset(std::string const& name) const;
+    size_t size() const;
+
+    void print(std::ostream& stream, void const* data) const;
+
+private:
+    struct Record
+    {
+        std::string name;
+        size_t      offset;
+        size_t      size;
+    };
+
+    std::vector<Record> m_records;
+    size_t              m_size = 0;
+};
+
+/**
+ * \ingroup Launching
+ * Preallocated, aligned buffer holding kernel arguments at the offsets of a
+ * KernelArgumentsLayout. Copies only touch the bytes in use.
+ */
+class PackedKernelArguments
+{
+public:
+    static constexpr size_t MaxBytes = 1024;
+
+    PackedKernelArguments() = default;
+    PackedKernelArguments(PackedKernelArguments const& other);
+    PackedKernelArguments& operator=(PackedKernelArguments const& other);
+
+    void resize(size_t bytes);
+
+    template <typename T>
+    void write(size_t offset, T value);
+
+    void const* data() const;
+    size_t      size() const;
+
+private:
+    alignas(16) uint8_t m_data[MaxBytes];
+    size_t m_size = 0;
+};
+
+template <typename T>
+inline size_t KernelArgumentsLayout::append(std::string const& name)
+{
+    size_t offset = (m_size + alignof(T) - 1) / alignof(T) * alignof(T);
+    m_records.push_back({name, offset, sizeof(T)});
+    m_size = offset + sizeof(T);
+    return offset;
+}
+
+inline size_t KernelArgumentsLayout::size() const
+{
+    return m_size;
+}
+
+inline PackedKernelArguments::PackedKernelArguments(PackedKernelArguments const& other)
+    : m_size(other.m_size)
+{
+    std::memcpy(m_data, other.m_data, m_size);
+}
+
+inline PackedKernelArguments& PackedKernelArguments::operator=(PackedKernelArguments const& other)
+{
+    m_size = other.m_size;
+    std::memcpy(m_data, other.m_data, m_size);
+    return *this;
+}
+
+inline void PackedKernelArguments::resize(size_t bytes)
+{
+    if(bytes > MaxBytes)
+    {
+        throw std::runtime_error("Packed kernel arguments exceed " + std::to_string(MaxBytes)
+                                 + " bytes.");
+    }
+
+    if(bytes > m_size)
+        std::memset(m_data + m_size, 0, bytes - m_size);
+    m_size = bytes;
+}
+
+template <typename T>
+inline void PackedKernelArguments::write(size_t offset, T value)
+{
+    assert(offset + sizeof(T) <= m_size && offset % alignof(T) == 0);
+    std::memcpy(m_data + offset, &value, sizeof(T));
+}
+
+inline void const* PackedKernelArguments::data() const
+{
+    return m_data;
+}
+
+inline size_t PackedKernelArguments::size() const
+{
+    return m_size;
+}
+
 /**
  * \ingroup Launching
  * Describes a single kernel invocation including kernel name, launch
@@ -258,6 +373,7 @@ struct KernelInvocation
 {
 public:
     std::string kernelName;
+    int         kernelId = -1;
 
     dim3   workGroupSize;
     dim3   numWorkGroups;
@@ -267,6 +383,27 @@ public:
     KernelArguments args;
 };
 
+/**
+ * \ingroup Launching
+ * KernelInvocation counterpart with a fixed-offset argument layout. args
+ * holds the argument values the invocation was constructed with; launches
+ * pass a copy of it with the per-call values rewritten.
+ */
+struct PackedKernelInvocation
+{
+public:
+    std::string kernelName;
+    int         kernelId = -1;
+
+    dim3   workGroupSize;
+    dim3   numWorkGroups;
+    dim3   numWorkItems;
+    size_t sharedMemBytes = 0;
+
+    KernelArgumentsLayout layout;
+    PackedKernelArguments args;
+};
+
 struct KernelParams
 {
     char         SolutionNameMin[256];
@@ -291,4 +428,5 @@ struct KernelParams
     bool         Activation;
     bool         ActivationHPA;
     char         ActivationType[32];
+    int          KernelId;
 };
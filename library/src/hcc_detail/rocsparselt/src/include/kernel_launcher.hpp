@@ -169,6 +169,40 @@ struct RocsparseltContractionProblem
     hipStream_t* streams;
     int32_t      numStreams;
 
+    bool beta_vector_scaling = false;
+
+    // split-K request of the alg selection, see rocsparselt_matmul_split_k
+    int                      split_k         = 0;
+    rocsparselt_split_k_mode split_k_mode    = rocsparselt_split_k_mode_two_kernels;
+    int                      split_k_buffers = 0;
+
+    // Per-tensor scales of A and B, see rocsparselt_matmul_a_scale_pointer
+    const float* scale_a = nullptr;
+    const float* scale_b = nullptr;
+
+    // Gated epilogue, see rocsparselt_matmul_gated_epilogue
+    bool gated = false;
+
+    // Quantization of D, see rocsparselt_matmul_d_scale_pointer
+    const float*              scale_d       = nullptr;
+    rocsparselt_rounding_mode rounding      = rocsparselt_rounding_nearest_even;
+    uint64_t                  rounding_seed = 0;
+    float*                    amax_d        = nullptr;
+
+    // Residual and bias gradient, see rocsparselt_matmul_residual_pointer. The residual has
+    // the layout of C, and with pointer-array batches one pointer per batch like it
+    const To*                      residual       = nullptr;
+    const To* const*               batch_residual = nullptr;
+    float*                         bias_grad      = nullptr;
+    rocsparselt_bias_gradient_mode bias_grad_mode = rocsparselt_bias_gradient_rows;
+
+    // Weight-only quantization, see rocsparselt_matmul_weight_scale_pointer. The sparse
+    // operand then holds int8 or packed int4 weights of weight_bits bits, not Ti values
+    int          weight_bits  = 0;
+    const float* weight_scale = nullptr;
+    const float* weight_zero  = nullptr;
+    int64_t      weight_group = 0;
+
     // gemm
     // gemm_strided_batched
     RocsparseltContractionProblem(const _rocsparselt_handle*  handle,
@@ -504,6 +538,7 @@ struct RocsparseltContractionProblem
 
 template <typename Ti, typename To, typename Tc>
 rocsparselt_status runContractionProblem(RocsparseltContractionProblem<Ti, To, Tc> const& problem,
+                                         _rocsparselt_matmul_launch_cache* launch_cache,
                                          int*                                             config_id,
                                          const int config_max_id,
                                          const int search_iterations);
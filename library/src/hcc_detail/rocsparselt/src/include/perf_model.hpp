@@ -0,0 +1,135 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+#ifndef ROCSPARSELT_PERF_MODEL_HPP
+#define ROCSPARSELT_PERF_MODEL_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*******************************************************************************
+ * Analytic cost model of a structured-sparse GEMM kernel. It predicts the run
+ * time of a solution on a device from the shape of the problem and the
+ * solution's tiling alone, so that candidates can be ranked without launching
+ * anything. The model is host-only; tensile_host.cpp fills it in from the
+ * solution metadata and hipDeviceProp_t.
+ *
+ * A kernel runs ceil(M / MT0) * ceil(N / MT1) * batch * GlobalSplitU work
+ * groups. As many as fit on the device at once, by the LDS a work group needs
+ * and the threads a CU holds, run as one wave. Each wave takes the longer of
+ * its math, at the matrix core peak of the CUs it occupies, and its memory
+ * traffic, at the device bandwidth; K is padded to DepthU per split, so both
+ * include the tile quantization in all three dimensions. Work groups of a
+ * wave that share a row or column of tiles read it from memory once. Split-K adds a pass
+ * over the partial results and D, by a reduction kernel or by atomics, and
+ * one more kernel. Every kernel pays a launch overhead.
+ *
+ * WorkGroupMapping, StaggerU and reuse across waves are not modeled. Ties keep the
+ * given order, so the order of the solution library breaks them.
+ ******************************************************************************/
+struct RocsparseltModelProblem
+{
+    int64_t m;
+    int64_t n;
+    int64_t k;
+    int64_t batch;
+    int32_t a_bytes; // bytes per element of A and B, before compression
+    int32_t b_bytes;
+    int32_t c_bytes; // bytes per element of C and D
+    int32_t partial_bytes; // bytes per element of split-K partial results
+    bool    sparse_a; // the compressed operand is A, else B
+    bool    int8; // integer matrix cores, twice the rate of FP16
+};
+
+struct RocsparseltModelKernel
+{
+    int64_t macro_tile_m;
+    int64_t macro_tile_n;
+    int64_t depth_u;
+    int64_t global_split_u;
+    int32_t workgroup_size;
+};
+
+struct RocsparseltModelDevice
+{
+    int32_t cu_count;
+    int64_t lds_bytes_per_cu;
+    int32_t max_threads_per_cu;
+    double  clock_ghz;
+    double  bandwidth_gbs;
+    double  flops_per_clock_per_cu; // dense FP16 matrix core peak
+    double  launch_us;
+};
+
+/*******************************************************************************
+ * Device parameters from the numbers hipDeviceProp_t reports. The clocks are
+ * in kHz, as hipDeviceProp_t has them; the matrix core rate is looked up by
+ * architecture name (e.g. "gfx942:sramecc+:xnack-").
+ ******************************************************************************/
+RocsparseltModelDevice rocsparselt_model_device(const std::string& arch,
+                                                int32_t            cu_count,
+                                                int64_t            lds_bytes_per_cu,
+                                                int32_t            max_threads_per_cu,
+                                                int64_t            clock_khz,
+                                                int64_t            memory_clock_khz,
+                                                int32_t            memory_bus_bits);
+
+// Predicted run time in microseconds
+double rocsparselt_model_time_us(const RocsparseltModelProblem& problem,
+                                 const RocsparseltModelKernel&  kernel,
+                                 const RocsparseltModelDevice&  device);
+
+// Indices of kernels, fastest predicted first
+std::vector<int> rocsparselt_model_rank(const RocsparseltModelProblem&             problem,
+                                        const std::vector<RocsparseltModelKernel>& kernels,
+                                        const RocsparseltModelDevice&              device);
+
+/*******************************************************************************
+ * Agreement of predicted and measured times of the same candidates, used to
+ * validate the model against recorded timings. spearman and kendall are rank
+ * correlations in [-1, 1]; regret is how much slower, as a fraction, the
+ * candidate the model ranks first measured than the fastest one.
+ ******************************************************************************/
+struct RocsparseltModelAgreement
+{
+    double spearman;
+    double kendall;
+    double regret;
+};
+
+RocsparseltModelAgreement rocsparselt_model_agreement(const std::vector<double>& predicted,
+                                                      const std::vector<double>& measured);
+
+/*******************************************************************************
+ * Whether getBestSolutions() ranks the solutions by the model instead of by
+ * Tensile's findTopSolutions, set by HIPSPARSELT_SOLUTION_RANKING ("model" or
+ * "tensile", the default).
+ ******************************************************************************/
+bool rocsparselt_model_ranking_from_env();
+
+#endif // ROCSPARSELT_PERF_MODEL_HPP
@@ -35,6 +35,7 @@
 #include "kernel_launcher.hpp"
 #endif
 #include <cxxabi.h>
+#include <optional>
 
 inline rocsparselt_status getOriginalSizes(rocsparselt_operation opA,
                                            rocsparselt_operation opB,
@@ -105,25 +106,28 @@ inline int64_t rocsparselt_metadata_offset_in_compressed_matrix(int64_t     num_
 {
     int64_t batch_stride = ld * num_cols;
 
-    auto datatype_bpe = [&] {
+    auto datatype_bits = [&] {
         switch(type)
         {
         case HIP_R_32F:
-            return 4;
+            return 32;
         case HIP_R_16F:
         case HIP_R_16BF:
-            return 2;
+            return 16;
         case HIP_R_8F_E4M3_FNUZ:
         case HIP_R_8F_E5M2_FNUZ:
         case HIP_R_8I:
-            return 1;
+            return 8;
+        case HIP_R_4I:
+            return 4;
         default:
             return 0;
         }
     };
 
-    auto    bpe    = datatype_bpe();
-    int64_t offset = num_batches * batch_stride * bpe;
+    // I4 values are packed two to a byte, and the metadata starts at the next byte
+    auto    bits   = datatype_bits();
+    int64_t offset = (num_batches * batch_stride * bits + 7) / 8;
     return offset;
 }
 
@@ -209,6 +213,7 @@ inline rocsparselt_status validateMatrixArgs(const _rocsparselt_handle* handle,
     switch(valueType)
     {
     case HIP_R_8I:
+    case HIP_R_4I:
     case HIP_R_8F_E4M3_FNUZ:
     case HIP_R_8F_E5M2_FNUZ:
         num_elements = 16;
@@ -253,13 +258,30 @@ inline rocsparselt_status validateMatrixArgs(const _rocsparselt_handle* handle,
     }
 
     //TODO should support other datatype in the future.
+    bool supported = false;
     switch(valueType)
     {
     case HIP_R_16F:
     case HIP_R_16BF:
     case HIP_R_8I:
+    case HIP_R_8F_E4M3_FNUZ:
+    case HIP_R_8F_E5M2_FNUZ:
+        supported = true;
+        break;
+    // F32 is an output type of FP8 inputs only, so it is never structured
+    case HIP_R_32F:
+        supported = matrixType != rocsparselt_matrix_type_structured;
+        break;
+    // I4 holds the weights of weight-only quantization, packed two to a byte,
+    // so it is always structured
+    case HIP_R_4I:
+        supported = matrixType == rocsparselt_matrix_type_structured;
         break;
     default:
+        break;
+    }
+    if(!supported)
+    {
         hipsparselt_cerr << "datatype (" << hipDataType_to_string(valueType) << ") is not supported"
                          << std::endl;
         log_error(handle, __func__, "datatype is not supported");
@@ -344,17 +366,41 @@ inline rocsparselt_status validateMatmulDescrArgs(const _rocsparselt_handle* han
         return rocsparselt_status_invalid_size;
     }
 
-    switch(type_a)
+    // Weight-only quantization pairs an I8 or I4 structured matrix with an H or
+    // BF16 dense matrix, which then sets the types of the problem
+    bool        sparse_a    = matrix_type_a == rocsparselt_matrix_type_structured;
+    hipDataType type_w      = sparse_a ? type_a : type_b;
+    hipDataType type_in     = sparse_a ? type_b : type_a;
+    bool        weight_only = (type_w == HIP_R_8I || type_w == HIP_R_4I)
+                       && (type_in == HIP_R_16F || type_in == HIP_R_16BF);
+
+    switch(type_in)
     {
     case HIP_R_16BF:
     case HIP_R_16F:
-        if(!(type_a == type_b && type_a == type_c && type_a == type_d))
+        // H/H/S and BF16/BF16/S, with the same output or a quantized I8, F8 or BF8 one
+        if((type_a != type_b && !weight_only) || type_c != type_d
+           || !(type_d == type_in || type_d == HIP_R_8I || type_d == HIP_R_8F_E4M3_FNUZ
+                || type_d == HIP_R_8F_E5M2_FNUZ))
         {
             log_error(handle, __func__, "datatype of matrices are inconsistent");
             return rocsparselt_status_not_implemented;
         }
+        if(compute_type != rocsparselt_compute_f32)
+        {
+            log_error(handle, __func__, "computType must be f32");
+            return rocsparselt_status_not_implemented;
+        }
+        break;
     case HIP_R_8F_E4M3_FNUZ:
     case HIP_R_8F_E5M2_FNUZ:
+        // F8/F8/S with H, BF16 or S outputs
+        if(type_a != type_b || type_c != type_d
+           || !(type_d == HIP_R_16F || type_d == HIP_R_16BF || type_d == HIP_R_32F))
+        {
+            log_error(handle, __func__, "datatype of matrices are inconsistent");
+            return rocsparselt_status_not_implemented;
+        }
         if(compute_type != rocsparselt_compute_f32)
         {
             log_error(handle, __func__, "computType must be f32");
@@ -377,7 +423,7 @@ inline rocsparselt_status validateMatmulDescrArgs(const _rocsparselt_handle* han
         }
         break;
     default:
-        log_error(handle, __func__, "datatype", hipDataType_to_string(type_a), "is not supported");
+        log_error(handle, __func__, "datatype", hipDataType_to_string(type_in), "is not supported");
         return rocsparselt_status_not_implemented;
     }
 
@@ -408,10 +454,11 @@ inline rocsparselt_status validateMatmulDescrArgs(const _rocsparselt_handle* han
 }
 
 template <typename Ti, typename To, typename Tc>
-rocsparselt_status ConstructRocSparseLtProblem(const char*                                 caller,
-                                               RocsparseltContractionProblem<Ti, To, Tc>** prob,
-                                               const _rocsparselt_matmul_descr*            matDescr,
-                                               const Tc*    alpha         = nullptr,
+rocsparselt_status
+    ConstructRocSparseLtProblem(const char*                                               caller,
+                                std::optional<RocsparseltContractionProblem<Ti, To, Tc>>& prob,
+                                const _rocsparselt_matmul_descr*                          matDescr,
+                                const Tc*    alpha         = nullptr,
                                                const Tc*    beta          = nullptr,
                                                const Ti*    a             = nullptr,
                                                const Ti*    b             = nullptr,
@@ -423,21 +470,122 @@ rocsparselt_status ConstructRocSparseLtProblem(const char*
                                                hipStream_t* streams       = nullptr,
                                                int32_t      numStreams    = 0);
 
+/*******************************************************************************
+ * rocsparselt_device_supports() tells whether the device kernels, Tensile or   *
+ * not, can run prob. The epilogues below are only implemented by the host      *
+ * backend; when prob uses one of them, *missing names it.                      *
+ ******************************************************************************/
+template <typename Ti, typename To, typename Tc>
+bool rocsparselt_device_supports(const RocsparseltContractionProblem<Ti, To, Tc>& prob,
+                                 const char**                                     missing = nullptr)
+{
+    const char* feature = nullptr;
+
+    // The kernel arguments carry beta as a scalar and no scales of A and B, and the
+    // activationType of the kernels predates SiLU and HardSwish. Their epilogue writes
+    // each product to D, so it cannot combine pairs of them, and it neither scales,
+    // rounds stochastically nor takes the maxima of D. The E of the Tensile epilogue is
+    // an output before the activation rather than an input added after it. A and B are
+    // of one type, with no dequantization of int8 or int4 weights.
+    if(prob.beta_vector_scaling)
+        feature = "beta vector scaling";
+    else if(prob.scale_a || prob.scale_b)
+        feature = "scales of A and B";
+    else if(prob.act_type == hipsparselt_activation_type::silu)
+        feature = "SiLU activation";
+    else if(prob.act_type == hipsparselt_activation_type::hardswish)
+        feature = "HardSwish activation";
+    else if(prob.gated)
+        feature = "gated epilogue";
+    else if(prob.scale_d || prob.amax_d || prob.rounding == rocsparselt_rounding_stochastic
+            || (sizeof(Ti) == 2 && sizeof(To) == 1))
+        feature = "quantization of D";
+    else if(prob.residual || prob.batch_residual || prob.bias_grad)
+        feature = "residual and bias gradient epilogues";
+    else if(prob.weight_bits)
+        feature = "weight-only quantization";
+
+    if(missing)
+        *missing = feature;
+    return feature == nullptr;
+}
+
+// Rejects a problem that only the host backend can run, with one error naming what
+// the device kernels lack
+template <typename Ti, typename To, typename Tc>
+rocsparselt_status checkDeviceSupport(const char*                                      caller,
+                                      const RocsparseltContractionProblem<Ti, To, Tc>& prob)
+{
+    const char* missing;
+    if(rocsparselt_device_supports(prob, &missing))
+        return rocsparselt_status_success;
+    hipsparselt_cerr << "The device kernels do not support " << missing
+                     << ", use the host backend" << std::endl;
+    log_error(prob.handle, caller, "the device kernels do not support", missing);
+    return rocsparselt_status_not_implemented;
+}
+
+#if BUILD_WITH_TENSILE
+// Finds the top configs of the problem of matmulDescr, with m rows instead of the
+// M of the descriptor when m is not 0
 template <typename Ti, typename To, typename Tc>
 rocsparselt_status findTopConfigs(const _rocsparselt_matmul_descr* matmulDescr,
                                   _rocsparselt_matmul_config*      configs,
                                   int*                             config_max_id,
-                                  const int                        requestConfigs = 10)
+                                  const int                        requestConfigs = 10,
+                                  int64_t                          m              = 0)
 {
-    RocsparseltContractionProblem<Ti, To, Tc>* prob;
-    Tc                                         alpha = static_cast<Tc>(1.0f);
-    Tc                                         beta  = static_cast<Tc>(1.0f);
-    auto                                       status
-        = ConstructRocSparseLtProblem<Ti, To, Tc>(__func__, &prob, matmulDescr, &alpha, &beta);
+    std::optional<RocsparseltContractionProblem<Ti, To, Tc>> prob;
+    Tc                                                       alpha = static_cast<Tc>(1.0f);
+    Tc                                                       beta  = static_cast<Tc>(1.0f);
+    auto                                                     status
+        = ConstructRocSparseLtProblem<Ti, To, Tc>(__func__,
+                                                  prob,
+                                                  matmulDescr,
+                                                  &alpha,
+                                                  &beta,
+                                                  nullptr,
+                                                  nullptr,
+                                                  nullptr,
+                                                  nullptr,
+                                                  !matmulDescr->pointer_array_batch);
+    if(status == rocsparselt_status_success)
+        status = checkDeviceSupport(__func__, *prob);
     if(status != rocsparselt_status_success)
         return status;
+    if(m != 0)
+        (matmulDescr->_swap_ab ? prob->n : prob->m) = m;
     getBestSolutions<Ti, To, Tc>(*prob, requestConfigs, configs, config_max_id);
-    delete prob;
     return status;
 }
+#else
+// Loads the kernels of the problem type of matmulDescr, the counterpart of
+// findTopConfigs for the kernels that are not built by Tensile. No kernels leave
+// config_max_id at 0.
+template <typename Ti, typename To, typename Tc>
+rocsparselt_status findKernelConfigs(const _rocsparselt_matmul_descr* matmulDescr,
+                                     int*                             config_max_id)
+{
+    std::optional<RocsparseltContractionProblem<Ti, To, Tc>> prob;
+    Tc                                                       alpha = static_cast<Tc>(1.0f);
+    Tc                                                       beta  = static_cast<Tc>(1.0f);
+    auto                                                     status
+        = ConstructRocSparseLtProblem<Ti, To, Tc>(__func__,
+                                                  prob,
+                                                  matmulDescr,
+                                                  &alpha,
+                                                  &beta,
+                                                  nullptr,
+                                                  nullptr,
+                                                  nullptr,
+                                                  nullptr,
+                                                  !matmulDescr->pointer_array_batch);
+    if(status == rocsparselt_status_success)
+        status = checkDeviceSupport(__func__, *prob);
+    if(status != rocsparselt_status_success)
+        return status;
+    initSolutions<Ti, To, Tc>(prob->handle, matmulDescr->op_A, matmulDescr->op_B, config_max_id);
+    return status;
+}
+#endif
 #endif
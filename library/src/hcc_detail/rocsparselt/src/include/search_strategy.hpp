@@ -0,0 +1,120 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+#ifndef ROCSPARSELT_SEARCH_STRATEGY_HPP
+#define ROCSPARSELT_SEARCH_STRATEGY_HPP
+
+#include "rocsparselt.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+/*******************************************************************************
+ * rocsparselt_matmul_search() picks the fastest config through a search
+ * strategy. A strategy only sees a sampler that runs a candidate config once
+ * and reports its time, so it is host-only and can be driven by a synthetic
+ * timer. Every candidate is run once untimed first, as a warm-up.
+ *
+ * exhaustive : every candidate is timed `iterations` times and the lowest mean
+ *              wins, which is how the search worked before strategies.
+ * halving    : successive halving. Each round times the surviving candidates
+ *              a few more times, drops the ones that are clearly slower than
+ *              the leader, then keeps the faster half by median.
+ * racing     : like halving, but candidates only leave when they are clearly
+ *              slower.
+ *
+ * "Clearly slower" means the candidate's confidence interval of the median
+ * lies entirely above the leader's. halving and racing stop when one
+ * candidate is left or all survivors have `iterations` samples; the survivor
+ * with the lowest median wins.
+ *
+ * With a budget, no sample is started once the sampled time (warm-ups
+ * included) exceeds budget_ms; the best candidate sampled so far wins.
+ *
+ * The strategy and budget come from the HIPSPARSELT_SEARCH_STRATEGY and
+ * HIPSPARSELT_SEARCH_BUDGET_MS environment variables, see
+ * rocsparselt_search_options_from_env().
+ ******************************************************************************/
+enum class rocsparselt_search_strategy
+{
+    exhaustive,
+    halving,
+    racing,
+};
+
+struct RocsparseltSearchOptions
+{
+    rocsparselt_search_strategy strategy   = rocsparselt_search_strategy::halving;
+    int                         iterations = 10; // upper bound of timed samples per candidate
+    float                       budget_ms  = 0.f; // 0: no budget
+};
+
+// Runs candidate once and stores its time in ms
+using RocsparseltSearchSampler = std::function<rocsparselt_status(int candidate, float& ms)>;
+
+class RocsparseltSearchStrategy
+{
+public:
+    virtual ~RocsparseltSearchStrategy() = default;
+
+    /***************************************************************************
+     * Picks the fastest of candidates into best. Returns the first error of   *
+     * the sampler, or rocsparselt_status_internal_error when no candidate was *
+     * timed.                                                                  *
+     ***************************************************************************/
+    virtual rocsparselt_status run(const std::vector<int>&         candidates,
+                                   const RocsparseltSearchSampler& sample,
+                                   int&                            best)
+        = 0;
+};
+
+std::unique_ptr<RocsparseltSearchStrategy>
+    rocsparselt_make_search_strategy(const RocsparseltSearchOptions& options);
+
+/*******************************************************************************
+ * Median of samples and a 95% confidence interval for it, estimated from the
+ * median absolute deviation. With fewer than three samples the interval is
+ * unbounded.
+ ******************************************************************************/
+struct RocsparseltSampleStats
+{
+    float median;
+    float lower;
+    float upper;
+};
+
+RocsparseltSampleStats rocsparselt_sample_stats(std::vector<float> samples);
+
+/*******************************************************************************
+ * Strategy and budget set by HIPSPARSELT_SEARCH_STRATEGY ("exhaustive",
+ * "halving" or "racing") and HIPSPARSELT_SEARCH_BUDGET_MS. Unset or unknown
+ * values keep the defaults.
+ ******************************************************************************/
+RocsparseltSearchOptions rocsparselt_search_options_from_env();
+
+#endif // ROCSPARSELT_SEARCH_STRATEGY_HPP
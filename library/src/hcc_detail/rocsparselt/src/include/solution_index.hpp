@@ -0,0 +1,116 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+#ifndef ROCSPARSELT_SOLUTION_INDEX_HPP
+#define ROCSPARSELT_SOLUTION_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*******************************************************************************
+ * The Tensile logic files are Equality tables: solutions are tuned for exact
+ * problem sizes only. For a size between them, the solution index finds the
+ * nearest tuned sizes of the same problem type and lets their solutions vote.
+ * A neighbor's vote weighs 1 / (1 + distance), scaled by the GFLOPS recorded
+ * for it relative to the best neighbor. The distance is Euclidean over log2 of
+ * M, N, batch and K, so twice the size is equally far at any scale.
+ *
+ * The table of tuned sizes is generated from the logic files at build time by
+ * utils/addSolutionSizes.py. Only hipsparselt-solution-index-bench builds the
+ * index: left one out, a tuned size gets its own solution first from the vote
+ * no more often than from its nearest size alone, about one time in seven, so
+ * getBestSolutions() keeps to Tensile's selection.
+ ******************************************************************************/
+struct RocsparseltTunedSize
+{
+    const char* arch; // e.g. "gfx942"
+    int32_t     type_ab; // Tensile::DataType of A and B
+    int32_t     type_cd; // Tensile::DataType of C and D
+    bool        trans_a;
+    bool        trans_b;
+    int32_t     sparse; // 1: A is compressed, 2: B is compressed
+    int64_t     m;
+    int64_t     n;
+    int64_t     batch;
+    int64_t     k;
+    const char* solution; // Tensile solution name
+    double      gflops;
+};
+
+extern const RocsparseltTunedSize rocsparselt_tuned_sizes[];
+extern const size_t               rocsparselt_tuned_sizes_count;
+
+// KD-tree over tuned sizes of one problem type
+class RocsparseltSizeIndex
+{
+public:
+    struct Neighbor
+    {
+        const RocsparseltTunedSize* size;
+        double                      distance;
+    };
+
+    struct Vote
+    {
+        const char* solution;
+        double      weight;
+    };
+
+    explicit RocsparseltSizeIndex(const std::vector<const RocsparseltTunedSize*>& sizes);
+
+    size_t size() const
+    {
+        return m_nodes.size();
+    }
+
+    // Up to count nearest sizes, nearest first
+    std::vector<Neighbor> nearest(int64_t m, int64_t n, int64_t batch, int64_t k, size_t count) const;
+
+    // Solutions of neighbors by decreasing weight; ties keep the nearer one first
+    static std::vector<Vote> vote(const std::vector<Neighbor>& neighbors);
+
+private:
+    struct Node
+    {
+        double                      point[4];
+        const RocsparseltTunedSize* size;
+    };
+
+    // The tree is implicit: a range's node is its middle, split on the axis of its depth
+    void build(size_t begin, size_t end, int depth);
+    void search(const double*          point,
+                size_t                 begin,
+                size_t                 end,
+                int                    depth,
+                size_t                 count,
+                std::vector<Neighbor>& heap) const;
+
+    std::vector<Node> m_nodes;
+};
+
+#endif // ROCSPARSELT_SOLUTION_INDEX_HPP
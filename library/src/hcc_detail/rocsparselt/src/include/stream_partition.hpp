@@ -0,0 +1,77 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+#ifndef ROCSPARSELT_STREAM_PARTITION_HPP
+#define ROCSPARSELT_STREAM_PARTITION_HPP
+
+#include <cstdint>
+#include <vector>
+
+/*******************************************************************************
+ * rocsparselt_matmul() spreads a problem over the streams it is given. The
+ * planner is host-only: it cuts the problem into at most num_streams
+ * contiguous partitions of balanced size, and the launcher runs partition i
+ * on stream i, forked from and joined back onto stream 0 with events.
+ *
+ * A batched problem is cut by batch. A single batch is cut along one output
+ * dimension (`extent`) on macro tile boundaries, so that no partition adds
+ * a partial tile; the launcher picks the dimension of the dense operand,
+ * which leaves the compressed operand and its metadata whole.
+ *
+ * One partition covering the whole problem means no split.
+ ******************************************************************************/
+struct RocsparseltStreamPartition
+{
+    int64_t batch_begin;
+    int64_t batch_count;
+    int64_t begin; // first index along the split output dimension
+    int64_t count;
+};
+
+std::vector<RocsparseltStreamPartition> rocsparselt_plan_stream_partitions(int64_t batch_count,
+                                                                           int64_t extent,
+                                                                           int64_t tile,
+                                                                           int32_t num_streams);
+
+/*******************************************************************************
+ * rocsparselt_matmul_grouped() runs whole problems, one per group, and
+ * spreads the groups over the streams instead of cutting them. The scheduler
+ * takes the groups longest first and gives each to the stream with the least
+ * work so far (LPT order), which bounds the busiest stream at 4/3 of the best
+ * possible split. Launches are returned in the order to enqueue them: by
+ * decreasing cost, so every stream starts with its largest group.
+ ******************************************************************************/
+struct RocsparseltGroupLaunch
+{
+    int32_t group;
+    int32_t stream;
+};
+
+std::vector<RocsparseltGroupLaunch> rocsparselt_schedule_groups(const std::vector<double>& costs,
+                                                                int32_t num_streams);
+
+#endif // ROCSPARSELT_STREAM_PARTITION_HPP
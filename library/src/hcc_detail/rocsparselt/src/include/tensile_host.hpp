@@ -108,6 +108,7 @@ struct RocsparseltContractionProblem
     int64_t                     bias_stride;
     hipDataType                 bias_type;
     bool                        alpha_vector_scaling;
+    bool                        beta_vector_scaling;
 
     void*  workspace;
     size_t workspaceSize;
@@ -115,6 +116,38 @@ struct RocsparseltContractionProblem
     hipStream_t* streams;
     int32_t      numStreams;
 
+    // split-K request of the alg selection, see rocsparselt_matmul_split_k
+    int                      split_k         = 0;
+    rocsparselt_split_k_mode split_k_mode    = rocsparselt_split_k_mode_two_kernels;
+    int                      split_k_buffers = 0;
+
+    // Per-tensor scales of A and B, see rocsparselt_matmul_a_scale_pointer
+    const float* scale_a = nullptr;
+    const float* scale_b = nullptr;
+
+    // Gated epilogue, see rocsparselt_matmul_gated_epilogue
+    bool gated = false;
+
+    // Quantization of D, see rocsparselt_matmul_d_scale_pointer
+    const float*              scale_d       = nullptr;
+    rocsparselt_rounding_mode rounding      = rocsparselt_rounding_nearest_even;
+    uint64_t                  rounding_seed = 0;
+    float*                    amax_d        = nullptr;
+
+    // Residual and bias gradient, see rocsparselt_matmul_residual_pointer. The residual has
+    // the layout of C, and with pointer-array batches one pointer per batch like it
+    const To*                      residual       = nullptr;
+    const To* const*               batch_residual = nullptr;
+    float*                         bias_grad      = nullptr;
+    rocsparselt_bias_gradient_mode bias_grad_mode = rocsparselt_bias_gradient_rows;
+
+    // Weight-only quantization, see rocsparselt_matmul_weight_scale_pointer. The sparse
+    // operand then holds int8 or packed int4 weights of weight_bits bits, not Ti values
+    int          weight_bits  = 0;
+    const float* weight_scale = nullptr;
+    const float* weight_zero  = nullptr;
+    int64_t      weight_group = 0;
+
     // gemm
     // gemm_strided_batched
     RocsparseltContractionProblem(const _rocsparselt_handle*  handle,
@@ -152,6 +185,7 @@ struct RocsparseltContractionProblem
                                   int64_t                     bias_stride,
                                   hipDataType                 bias_type,
                                   bool                        alpha_vector_scaling,
+                                  bool                        beta_vector_scaling,
                                   void*                       workspace,
                                   size_t                      workspaceSize,
                                   hipStream_t*                streams,
@@ -200,6 +234,7 @@ struct RocsparseltContractionProblem
         , bias_stride(bias_stride)
         , bias_type(bias_type)
         , alpha_vector_scaling(alpha_vector_scaling)
+        , beta_vector_scaling(beta_vector_scaling)
         , workspace(workspace)
         , workspaceSize(workspaceSize)
         , streams(streams)
@@ -249,6 +284,7 @@ struct RocsparseltContractionProblem
                                   int64_t                     bias_stride,
                                   hipDataType                 bias_type,
                                   bool                        alpha_vector_scaling,
+                                  bool                        beta_vector_scaling,
                                   void*                       workspace,
                                   size_t                      workspaceSize,
                                   hipStream_t*                streams,
@@ -297,6 +333,7 @@ struct RocsparseltContractionProblem
         , bias_stride(bias_stride)
         , bias_type(bias_type)
         , alpha_vector_scaling(alpha_vector_scaling)
+        , beta_vector_scaling(beta_vector_scaling)
         , workspace(workspace)
         , workspaceSize(workspaceSize)
         , streams(streams)
@@ -347,6 +384,7 @@ struct RocsparseltContractionProblem
                                   int64_t                     bias_stride,
                                   hipDataType                 bias_type,
                                   bool                        alpha_vector_scaling,
+                                  bool                        beta_vector_scaling,
                                   void*                       workspace,
                                   size_t                      workspaceSize,
                                   hipStream_t*                streams,
@@ -395,6 +433,7 @@ struct RocsparseltContractionProblem
         , bias_stride(bias_stride)
         , bias_type(bias_type)
         , alpha_vector_scaling(alpha_vector_scaling)
+        , beta_vector_scaling(beta_vector_scaling)
         , workspace(workspace)
         , workspaceSize(workspaceSize)
         , streams(streams)
@@ -475,16 +514,21 @@ struct RocsparseltContractionProblem
                             "bias_type",
                             hipDataType_to_string(prob.bias_type),
                             "alpha_vector_scaling",
-                            prob.alpha_vector_scaling));
+                            prob.alpha_vector_scaling,
+                            "beta_vector_scaling",
+                            prob.beta_vector_scaling));
     };
 };
 
 /*******************************************************************************
  * runContractionProblem() solves a RocsparseltContractionProblem                  *
+ * When launch_cache is not NULL, the Tensile problem and the selected solution  *
+ * are stored in it and reused by later calls with the same plan.               *
  *******************************************************************************/
 template <typename Ti, typename To, typename Tc>
 rocsparselt_status runContractionProblem(RocsparseltContractionProblem<Ti, To, Tc> const& problem,
                                          _rocsparselt_matmul_config*                      configs,
+                                         _rocsparselt_matmul_launch_cache* launch_cache,
                                          int*                                             config_id,
                                          const int config_max_id,
                                          const int search_iterations);
@@ -500,6 +544,11 @@ rocsparselt_status getBestSolutions(const RocsparseltContractionProblem<Ti, To,
  ***********************************************************************************/
 std::atomic_bool& rocsparselt_internal_tensile_is_initialized();
 
+/*******************************************************************************
+ * Hit and miss counters of the process-wide getBestSolutions() solution cache *
+ *******************************************************************************/
+void rocsparselt_internal_solution_cache_counters(uint64_t* hits, uint64_t* misses);
+
 /**********************************************
  * Whether to suppress Tensile error messages *
  **********************************************/
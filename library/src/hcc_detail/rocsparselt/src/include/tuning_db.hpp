@@ -0,0 +1,64 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+#ifndef ROCSPARSELT_TUNING_DB_HPP
+#define ROCSPARSELT_TUNING_DB_HPP
+
+#include "handle.h"
+#include <string>
+
+/*******************************************************************************
+ * The tuning database keeps the config_id found by rocsparselt_matmul_search()
+ * in the file named by the ROCSPARSELT_TUNING_DB environment variable, so that
+ * rocsparselt_matmul_plan_init() of a later process can select the tuned
+ * solution without timing the configs again.
+ *
+ * The file is a header followed by fixed-size, checksummed records which are
+ * only ever appended. Readers map the file and take the last matching record;
+ * records written by another library build (see
+ * rocsparselt_internal_get_library_path()) never match.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Look up the tuned config of a plan. Returns true and sets config_id when the
+ * database holds a record which is still valid for the plan's configs.
+ ******************************************************************************/
+bool rocsparselt_tuning_db_lookup(const _rocsparselt_matmul_plan* plan, int* config_id);
+
+/*******************************************************************************
+ * Append the config_id found by rocsparselt_matmul_search() for a plan.
+ ******************************************************************************/
+void rocsparselt_tuning_db_store(const _rocsparselt_matmul_plan* plan, int config_id);
+
+/*******************************************************************************
+ * Path of the kernel library file loaded by the backend (Tensile or HIP kernel
+ * launcher). Its size and modification time are part of the tuning key, so
+ * tuning records are invalidated when the library changes.
+ ******************************************************************************/
+std::string rocsparselt_internal_get_library_path();
+
+#endif // ROCSPARSELT_TUNING_DB_HPP
@@ -31,6 +31,7 @@
 
 #include "auxiliary.hpp"
 #include "handle.h"
+#include "hipsparselt_float8.hpp"
 #include "logging.h"
 #include <algorithm>
 #include <exception>
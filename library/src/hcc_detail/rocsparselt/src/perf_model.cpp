@@ -0,0 +1,225 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "perf_model.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+
+namespace
+{
+    int64_t ceil_div(int64_t a, int64_t b)
+    {
+        return (a + b - 1) / b;
+    }
+
+    // Ranks from 1, ties share the mean of their ranks
+    std::vector<double> ranks_of(const std::vector<double>& values)
+    {
+        std::vector<int> order(values.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(
+            order.begin(), order.end(), [&](int a, int b) { return values[a] < values[b]; });
+
+        std::vector<double> ranks(values.size());
+        for(size_t i = 0; i < order.size();)
+        {
+            size_t j = i;
+            while(j + 1 < order.size() && values[order[j + 1]] == values[order[i]])
+                j++;
+            for(size_t t = i; t <= j; t++)
+                ranks[order[t]] = (i + j) / 2.0 + 1;
+            i = j + 1;
+        }
+        return ranks;
+    }
+}
+
+RocsparseltModelDevice rocsparselt_model_device(const std::string& arch,
+                                                int32_t            cu_count,
+                                                int64_t            lds_bytes_per_cu,
+                                                int32_t            max_threads_per_cu,
+                                                int64_t            clock_khz,
+                                                int64_t            memory_clock_khz,
+                                                int32_t            memory_bus_bits)
+{
+    RocsparseltModelDevice device;
+    device.cu_count           = std::max(cu_count, 1);
+    device.lds_bytes_per_cu   = lds_bytes_per_cu > 0 ? lds_bytes_per_cu : 65536;
+    device.max_threads_per_cu = max_threads_per_cu > 0 ? max_threads_per_cu : 2048;
+    device.clock_ghz          = clock_khz > 0 ? clock_khz / 1e6 : 1.0;
+
+    // Double data rate
+    device.bandwidth_gbs = memory_clock_khz > 0 && memory_bus_bits > 0
+                               ? memory_clock_khz * 1e3 * memory_bus_bits / 8 * 2 / 1e9
+                               : 1000.0;
+
+    // Dense FP16 MFMA flops per clock of a CU
+    if(arch.compare(0, 6, "gfx950") == 0)
+        device.flops_per_clock_per_cu = 4096;
+    else if(arch.compare(0, 5, "gfx94") == 0)
+        device.flops_per_clock_per_cu = 2048;
+    else
+        device.flops_per_clock_per_cu = 1024;
+
+    device.launch_us = 4.0;
+    return device;
+}
+
+double rocsparselt_model_time_us(const RocsparseltModelProblem& problem,
+                                 const RocsparseltModelKernel&  kernel,
+                                 const RocsparseltModelDevice&  device)
+{
+    int64_t mt0   = std::max<int64_t>(kernel.macro_tile_m, 1);
+    int64_t mt1   = std::max<int64_t>(kernel.macro_tile_n, 1);
+    int64_t du    = std::max<int64_t>(kernel.depth_u, 1);
+    int64_t gsu   = std::max<int64_t>(kernel.global_split_u, 1);
+    int64_t batch = std::max<int64_t>(problem.batch, 1);
+
+    int64_t tiles_m = ceil_div(problem.m, mt0);
+    int64_t tiles_n = ceil_div(problem.n, mt1);
+    int64_t groups  = tiles_m * tiles_n * batch * gsu;
+    if(groups == 0)
+        return device.launch_us;
+
+    // The compressed operand keeps half of K, plus 2-bit indices of what it kept
+    double a_bytes = problem.sparse_a ? problem.a_bytes / 2.0 + 0.125 : problem.a_bytes;
+    double b_bytes = problem.sparse_a ? problem.b_bytes : problem.b_bytes / 2.0 + 0.125;
+
+    // LDS holds a DepthU slice of both tiles, double buffered by the prefetch
+    double  lds_per_group = (mt0 * a_bytes + mt1 * b_bytes) * du * 2;
+    int64_t occupancy     = std::max<int64_t>(
+        1,
+        std::min<int64_t>(device.lds_bytes_per_cu / std::max(lds_per_group, 1.0),
+                          device.max_threads_per_cu / std::max(kernel.workgroup_size, 1)));
+    int64_t slots = device.cu_count * occupancy;
+
+    int64_t k_padded        = ceil_div(ceil_div(problem.k, gsu), du) * du;
+    double  flops_per_group = 2.0 * mt0 * mt1 * k_padded;
+    double  output_bytes    = mt0 * mt1 * (gsu > 1 ? problem.partial_bytes : problem.c_bytes);
+
+    // Sparse matrix cores do twice the dense work per clock, integer ones twice again
+    double flops_per_us = device.flops_per_clock_per_cu * device.clock_ghz * 1e3 * 2
+                          * (problem.int8 ? 2 : 1);
+    double bytes_per_us = device.bandwidth_gbs * 1e3;
+
+    // Work groups are dispatched along M first. Those of a wave which share a row or
+    // a column of tiles read its A or B tile from memory once and then from L2.
+    auto wave_us = [&](int64_t active) {
+        int64_t grid    = tiles_m * tiles_n;
+        int64_t covered = std::min(active, grid);
+        int64_t rows    = std::min(covered, tiles_m);
+        int64_t columns = ceil_div(covered, tiles_m);
+        int64_t grids   = ceil_div(active, grid);
+        double  bytes   = grids * (rows * mt0 * a_bytes + columns * mt1 * b_bytes) * k_padded
+                       + active * output_bytes;
+
+        double math   = ceil_div(active, device.cu_count) * flops_per_group / flops_per_us;
+        double memory = bytes / bytes_per_us;
+        return std::max(math, memory);
+    };
+
+    double time = (groups / slots) * wave_us(slots) + device.launch_us;
+    if(groups % slots)
+        time += wave_us(groups % slots);
+
+    if(gsu > 1)
+    {
+        // With global accumulation, a reduction kernel reads every partial result and
+        // writes D. Without it, a kernel initializes D and the atomic adds of each split
+        // read it back. Either way costs one more pass over the partials and D.
+        double outputs = double(problem.m) * problem.n * batch;
+        time += outputs * (gsu * problem.partial_bytes + problem.c_bytes) / bytes_per_us
+                + device.launch_us;
+    }
+
+    return time;
+}
+
+std::vector<int> rocsparselt_model_rank(const RocsparseltModelProblem&             problem,
+                                        const std::vector<RocsparseltModelKernel>& kernels,
+                                        const RocsparseltModelDevice&              device)
+{
+    std::vector<double> times;
+    for(auto& kernel : kernels)
+        times.push_back(rocsparselt_model_time_us(problem, kernel, device));
+
+    std::vector<int> order(kernels.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(
+        order.begin(), order.end(), [&](int a, int b) { return times[a] < times[b]; });
+    return order;
+}
+
+RocsparseltModelAgreement rocsparselt_model_agreement(const std::vector<double>& predicted,
+                                                      const std::vector<double>& measured)
+{
+    RocsparseltModelAgreement agreement{1.0, 1.0, 0.0};
+    size_t                    n = std::min(predicted.size(), measured.size());
+    if(n < 2)
+        return agreement;
+
+    std::vector<double> p(predicted.begin(), predicted.begin() + n);
+    std::vector<double> t(measured.begin(), measured.begin() + n);
+
+    // Spearman: Pearson correlation of the ranks
+    auto   rp = ranks_of(p);
+    auto   rt = ranks_of(t);
+    double mean = (n + 1) / 2.0, cov = 0, var_p = 0, var_t = 0;
+    for(size_t i = 0; i < n; i++)
+    {
+        cov += (rp[i] - mean) * (rt[i] - mean);
+        var_p += (rp[i] - mean) * (rp[i] - mean);
+        var_t += (rt[i] - mean) * (rt[i] - mean);
+    }
+    agreement.spearman = var_p > 0 && var_t > 0 ? cov / std::sqrt(var_p * var_t) : 0.0;
+
+    // Kendall tau-a: pairs in the same order minus pairs in opposite order
+    int64_t concordant = 0, discordant = 0;
+    for(size_t i = 0; i < n; i++)
+        for(size_t j = i + 1; j < n; j++)
+        {
+            double s = (p[i] - p[j]) * (t[i] - t[j]);
+            concordant += s > 0;
+            discordant += s < 0;
+        }
+    agreement.kendall = double(concordant - discordant) / (n * (n - 1) / 2);
+
+    size_t first   = std::min_element(p.begin(), p.end()) - p.begin();
+    double fastest = *std::min_element(t.begin(), t.end());
+    agreement.regret = fastest > 0 ? t[first] / fastest - 1 : 0.0;
+
+    return agreement;
+}
+
+bool rocsparselt_model_ranking_from_env()
+{
+    const char* env = getenv("HIPSPARSELT_SOLUTION_RANKING");
+    return env && strcmp(env, "model") == 0;
+}
@@ -34,6 +34,7 @@
 #include "rocsparselt.h"
 #include "rocsparselt_spmm_utils.hpp"
 #include "status.h"
+#include "tuning_db.hpp"
 #include "utility.hpp"
 
 #include <hip/hip_runtime_api.h>
@@ -165,6 +166,78 @@ rocsparselt_status rocsparselt_destroy(const rocsparselt_handle* handle)
     return rocsparselt_status_success;
 }
 
+/********************************************************************************
+ * \brief select the execution backend of a handle
+ *******************************************************************************/
+rocsparselt_status rocsparselt_set_backend(rocsparselt_handle* handle, rocsparselt_backend backend)
+{
+    if(handle == nullptr)
+    {
+        hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    auto _handle = reinterpret_cast<_rocsparselt_handle*>(handle);
+    if(!_handle->isInit())
+    {
+        hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    log_api(_handle, __func__, "handle[in]", _handle, "backend[in]", backend);
+
+    switch(backend)
+    {
+    case rocsparselt_backend_host:
+        break;
+    case rocsparselt_backend_device:
+        // A handle initialized for the host backend without a device cannot move to it
+        if(_handle->device < 0)
+        {
+            hipsparselt_cerr << "handle has no HIP device" << std::endl;
+            log_error(_handle, __func__, "handle has no HIP device");
+            return rocsparselt_status_invalid_value;
+        }
+        break;
+    default:
+        hipsparselt_cerr << "backend " << backend << " is invalid" << std::endl;
+        log_error(_handle, __func__, "backend is invalid");
+        return rocsparselt_status_invalid_value;
+    }
+    _handle->backend = backend;
+    return rocsparselt_status_success;
+}
+
+/********************************************************************************
+ * \brief get the execution backend of a handle
+ *******************************************************************************/
+rocsparselt_status rocsparselt_get_backend(const rocsparselt_handle* handle,
+                                           rocsparselt_backend*      backend)
+{
+    if(handle == nullptr)
+    {
+        hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handle);
+    if(!_handle->isInit())
+    {
+        hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    if(backend == nullptr)
+    {
+        log_error(_handle, __func__, "backend is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    log_api(_handle, __func__, "handle[in]", _handle, "backend[out]", backend);
+    *backend = _handle->backend;
+    return rocsparselt_status_success;
+}
+
 /********************************************************************************
  * \brief rocsparse_mat_descr is a structure holding the rocsparselt matrix
  * content. It must be initialized using rocsparselt_dense_descr_init() or
@@ -801,11 +874,13 @@ rocsparselt_status rocsparselt_matmul_descr_init(const rocsparselt_handle*    ha
             _matmulDescr->m            = m;
             _matmulDescr->n            = n;
             _matmulDescr->k            = k;
-            switch(_matA->type)
+            // The bias follows the dense matrix, whose type is that of A and B
+            // unless the structured matrix holds weight-only quantized weights
+            switch(_matmulDescr->input_type())
             {
             case HIP_R_16BF:
             case HIP_R_16F:
-                _matmulDescr->bias_type = _matA->type;
+                _matmulDescr->bias_type = _matmulDescr->input_type();
                 break;
             default:
                 _matmulDescr->bias_type = HIP_R_32F;
@@ -935,7 +1010,8 @@ rocsparselt_status
                 if(enable)
                 {
                     if(act_type == rocsparselt_matmul_activation_sigmoid
-                       || act_type == rocsparselt_matmul_activation_tanh)
+                       || act_type == rocsparselt_matmul_activation_tanh
+                       || act_type == rocsparselt_matmul_activation_silu)
                     {
                         if(_matmulDescr->matrix_D->type == HIP_R_8I)
                         {
@@ -965,6 +1041,8 @@ rocsparselt_status
             case rocsparselt_matmul_activation_leakyrelu:
             case rocsparselt_matmul_activation_sigmoid:
             case rocsparselt_matmul_activation_tanh:
+            case rocsparselt_matmul_activation_silu:
+            case rocsparselt_matmul_activation_hardswish:
                 assign_activation(matmulAttribute);
                 break;
             case rocsparselt_matmul_activation_relu_upperbound:
@@ -982,6 +1060,9 @@ rocsparselt_status
             case rocsparselt_matmul_activation_tanh_beta:
                 assign_data(&_matmulDescr->activation_tanh_beta);
                 break;
+            case rocsparselt_matmul_activation_silu_beta:
+                assign_data(&_matmulDescr->activation_silu_beta);
+                break;
             case rocsparselt_matmul_activation_gelu_scaling:
                 assign_data(&_matmulDescr->activation_gelu_scaling);
                 if(status == rocsparselt_status_success)
@@ -1043,6 +1124,179 @@ rocsparselt_status
                 assign_data(&_matmulDescr->alpha_vector_scaling);
                 break;
             }
+            case rocsparselt_matmul_beta_vector_scaling:
+            {
+                assign_data(&_matmulDescr->beta_vector_scaling);
+                break;
+            }
+            case rocsparselt_matmul_pointer_array_batch:
+            {
+                assign_data(&_matmulDescr->pointer_array_batch);
+                break;
+            }
+            case rocsparselt_matmul_dynamic_m_min:
+            {
+                int64_t min_m = 0;
+                assign_data(&min_m);
+                if(status != rocsparselt_status_success)
+                    break;
+                if(min_m < 0 || min_m > _matmulDescr->m)
+                {
+                    hipsparselt_cerr << "The smallest dynamic M must be between 0 and the M of the "
+                                        "matrix multiplication ("
+                                     << _matmulDescr->m << "), current: " << min_m << std::endl;
+                    log_error(_handle, __func__, "dynamic M min is out of range");
+                    return rocsparselt_status_invalid_value;
+                }
+                // M is a dimension of the compressed matrix when A is structured
+                if(min_m != 0 && _matmulDescr->is_sparse_a)
+                {
+                    hipsparselt_cerr << "A dynamic M needs a dense matrix A" << std::endl;
+                    log_error(_handle, __func__, "A dynamic M needs a dense matrix A");
+                    return rocsparselt_status_not_implemented;
+                }
+                _matmulDescr->dynamic_m_min = min_m;
+                break;
+            }
+            case rocsparselt_matmul_gated_epilogue:
+            {
+                int gated = 0;
+                assign_data(&gated);
+                if(status != rocsparselt_status_success)
+                    break;
+                // The gate and up values come in pairs along the M of a structured A
+                // or the N of a structured B
+                int64_t paired = _matmulDescr->is_sparse_a ? _matmulDescr->m : _matmulDescr->n;
+                if(gated && paired % 2 != 0)
+                {
+                    hipsparselt_cerr << "A gated epilogue needs an even "
+                                     << (_matmulDescr->is_sparse_a ? "M" : "N")
+                                     << ", current: " << paired << std::endl;
+                    log_error(_handle, __func__, "gated epilogue needs an even size");
+                    return rocsparselt_status_invalid_size;
+                }
+                _matmulDescr->gated_epilogue = gated;
+                break;
+            }
+            case rocsparselt_matmul_a_scale_pointer:
+            case rocsparselt_matmul_b_scale_pointer:
+            {
+                if((status = validateGetAttributeDataSize<void*>(dataSize))
+                   != rocsparselt_status_success)
+                {
+                    log_error(_handle, __func__, "dataSize is invalid");
+                    return status;
+                }
+                memcpy(matmulAttribute == rocsparselt_matmul_a_scale_pointer
+                           ? &_matmulDescr->a_scale_pointer
+                           : &_matmulDescr->b_scale_pointer,
+                       data,
+                       sizeof(const float*));
+                break;
+            }
+            case rocsparselt_matmul_d_scale_pointer:
+            case rocsparselt_matmul_d_amax_pointer:
+            {
+                if((status = validateGetAttributeDataSize<void*>(dataSize))
+                   != rocsparselt_status_success)
+                {
+                    log_error(_handle, __func__, "dataSize is invalid");
+                    return status;
+                }
+                memcpy(matmulAttribute == rocsparselt_matmul_d_scale_pointer
+                           ? static_cast<void*>(&_matmulDescr->d_scale_pointer)
+                           : static_cast<void*>(&_matmulDescr->d_amax_pointer),
+                       data,
+                       sizeof(float*));
+                break;
+            }
+            case rocsparselt_matmul_d_rounding_mode:
+            {
+                int mode = 0;
+                assign_data(&mode);
+                if(status != rocsparselt_status_success)
+                    break;
+                if(mode != rocsparselt_rounding_nearest_even
+                   && mode != rocsparselt_rounding_stochastic)
+                {
+                    log_error(_handle, __func__, "rounding mode ", mode, " is invalid");
+                    return rocsparselt_status_invalid_value;
+                }
+                _matmulDescr->d_rounding_mode = static_cast<rocsparselt_rounding_mode>(mode);
+                break;
+            }
+            case rocsparselt_matmul_d_rounding_seed:
+            {
+                assign_data(&_matmulDescr->d_rounding_seed);
+                break;
+            }
+            case rocsparselt_matmul_residual_pointer:
+            case rocsparselt_matmul_bias_gradient_pointer:
+            {
+                if((status = validateGetAttributeDataSize<void*>(dataSize))
+                   != rocsparselt_status_success)
+                {
+                    log_error(_handle, __func__, "dataSize is invalid");
+                    return status;
+                }
+                memcpy(matmulAttribute == rocsparselt_matmul_residual_pointer
+                           ? static_cast<void*>(&_matmulDescr->residual_pointer)
+                           : static_cast<void*>(&_matmulDescr->bias_gradient_pointer),
+                       data,
+                       sizeof(void*));
+                break;
+            }
+            case rocsparselt_matmul_bias_gradient_mode:
+            {
+                int mode = 0;
+                assign_data(&mode);
+                if(status != rocsparselt_status_success)
+                    break;
+                if(mode != rocsparselt_bias_gradient_rows
+                   && mode != rocsparselt_bias_gradient_columns)
+                {
+                    log_error(_handle, __func__, "bias gradient mode ", mode, " is invalid");
+                    return rocsparselt_status_invalid_value;
+                }
+                _matmulDescr->bias_gradient_mode
+                    = static_cast<rocsparselt_bias_gradient_mode>(mode);
+                break;
+            }
+            case rocsparselt_matmul_weight_scale_pointer:
+            case rocsparselt_matmul_weight_zero_pointer:
+            {
+                if((status = validateGetAttributeDataSize<void*>(dataSize))
+                   != rocsparselt_status_success)
+                {
+                    log_error(_handle, __func__, "dataSize is invalid");
+                    return status;
+                }
+                memcpy(matmulAttribute == rocsparselt_matmul_weight_scale_pointer
+                           ? &_matmulDescr->weight_scale_pointer
+                           : &_matmulDescr->weight_zero_pointer,
+                       data,
+                       sizeof(const float*));
+                break;
+            }
+            case rocsparselt_matmul_weight_group_size:
+            {
+                int group = 0;
+                assign_data(&group);
+                if(status != rocsparselt_status_success)
+                    break;
+                // A group covers whole runs of 8 elements, so that the values
+                // compressed from one run share a scale
+                if(group < 0 || group % 8 != 0)
+                {
+                    hipsparselt_cerr << "The weight group size must be 0 or a positive multiple of "
+                                        "8, current: "
+                                     << group << std::endl;
+                    log_error(_handle, __func__, "weight group size ", group, " is invalid");
+                    return rocsparselt_status_invalid_value;
+                }
+                _matmulDescr->weight_group_size = group;
+                break;
+            }
             default:
                 log_error(
                     _handle, __func__, "matmulAttribute", matmulAttribute, "is not implemented");
@@ -1146,6 +1400,8 @@ rocsparselt_status
             case rocsparselt_matmul_activation_leakyrelu:
             case rocsparselt_matmul_activation_sigmoid:
             case rocsparselt_matmul_activation_tanh:
+            case rocsparselt_matmul_activation_silu:
+            case rocsparselt_matmul_activation_hardswish:
                 retrive_activation(matmulAttribute);
                 break;
             case rocsparselt_matmul_activation_relu_upperbound:
@@ -1163,6 +1419,9 @@ rocsparselt_status
             case rocsparselt_matmul_activation_tanh_beta:
                 retrive_data(_matmulDescr->activation_tanh_beta);
                 break;
+            case rocsparselt_matmul_activation_silu_beta:
+                retrive_data(_matmulDescr->activation_silu_beta);
+                break;
 
             case rocsparselt_matmul_bias_pointer:
                 if((status = validateGetAttributeDataSize<void*>(dataSize))
@@ -1205,6 +1464,110 @@ rocsparselt_status
                 retrive_data(_matmulDescr->alpha_vector_scaling);
                 break;
             }
+            case rocsparselt_matmul_beta_vector_scaling:
+            {
+                retrive_data(_matmulDescr->beta_vector_scaling);
+                break;
+            }
+            case rocsparselt_matmul_pointer_array_batch:
+            {
+                retrive_data(_matmulDescr->pointer_array_batch);
+                break;
+            }
+            case rocsparselt_matmul_dynamic_m_min:
+            {
+                retrive_data(_matmulDescr->dynamic_m_min);
+                break;
+            }
+            case rocsparselt_matmul_gated_epilogue:
+            {
+                retrive_data(_matmulDescr->gated_epilogue);
+                break;
+            }
+            case rocsparselt_matmul_a_scale_pointer:
+            case rocsparselt_matmul_b_scale_pointer:
+            {
+                if((status = validateGetAttributeDataSize<void*>(dataSize))
+                   != rocsparselt_status_success)
+                {
+                    log_error(_handle, __func__, "dataSize is invalid");
+                    return status;
+                }
+                memcpy(data,
+                       matmulAttribute == rocsparselt_matmul_a_scale_pointer
+                           ? &_matmulDescr->a_scale_pointer
+                           : &_matmulDescr->b_scale_pointer,
+                       sizeof(const float*));
+                break;
+            }
+            case rocsparselt_matmul_d_scale_pointer:
+            case rocsparselt_matmul_d_amax_pointer:
+            {
+                if((status = validateGetAttributeDataSize<void*>(dataSize))
+                   != rocsparselt_status_success)
+                {
+                    log_error(_handle, __func__, "dataSize is invalid");
+                    return status;
+                }
+                memcpy(data,
+                       matmulAttribute == rocsparselt_matmul_d_scale_pointer
+                           ? static_cast<const void*>(&_matmulDescr->d_scale_pointer)
+                           : static_cast<const void*>(&_matmulDescr->d_amax_pointer),
+                       sizeof(float*));
+                break;
+            }
+            case rocsparselt_matmul_d_rounding_mode:
+            {
+                retrive_data(static_cast<int>(_matmulDescr->d_rounding_mode));
+                break;
+            }
+            case rocsparselt_matmul_d_rounding_seed:
+            {
+                retrive_data(_matmulDescr->d_rounding_seed);
+                break;
+            }
+            case rocsparselt_matmul_residual_pointer:
+            case rocsparselt_matmul_bias_gradient_pointer:
+            {
+                if((status = validateGetAttributeDataSize<void*>(dataSize))
+                   != rocsparselt_status_success)
+                {
+                    log_error(_handle, __func__, "dataSize is invalid");
+                    return status;
+                }
+                memcpy(data,
+                       matmulAttribute == rocsparselt_matmul_residual_pointer
+                           ? static_cast<const void*>(&_matmulDescr->residual_pointer)
+                           : static_cast<const void*>(&_matmulDescr->bias_gradient_pointer),
+                       sizeof(void*));
+                break;
+            }
+            case rocsparselt_matmul_bias_gradient_mode:
+            {
+                retrive_data(static_cast<int>(_matmulDescr->bias_gradient_mode));
+                break;
+            }
+            case rocsparselt_matmul_weight_scale_pointer:
+            case rocsparselt_matmul_weight_zero_pointer:
+            {
+                if((status = validateGetAttributeDataSize<void*>(dataSize))
+                   != rocsparselt_status_success)
+                {
+                    log_error(_handle, __func__, "dataSize is invalid");
+                    return status;
+                }
+                memcpy(data,
+                       matmulAttribute == rocsparselt_matmul_weight_scale_pointer
+                           ? &_matmulDescr->weight_scale_pointer
+                           : &_matmulDescr->weight_zero_pointer,
+                       sizeof(const float*));
+                break;
+            }
+            case rocsparselt_matmul_weight_group_size:
+            {
+                retrive_data(_matmulDescr->weight_group_size);
+                break;
+            }
             default:
                 log_error(
                     _handle, __func__, "matmulAttribute", matmulAttribute, "is not implemented");
@@ -1280,68 +1643,171 @@ rocsparselt_status
 
             auto _algSelection = reinterpret_cast<_rocsparselt_matmul_alg_selection*>(algSelection);
 
-            auto in_type      = _matmulDescr->matrix_A->type;
+            auto in_type      = _matmulDescr->input_type();
             auto out_type     = _matmulDescr->matrix_D->type;
             auto compute_type = _matmulDescr->compute_type;
 
             int                               config_max_id = 0;
             _rocsparselt_matmul_alg_selection tmpAlgSelection(_handle);
 
-#if BUILD_WITH_TENSILE
-            constexpr int requestConfigs = 10; // find top 10 configs.
-
-            rocsparselt_status status = rocsparselt_status_success;
-
-            if(in_type == HIP_R_16F && out_type == HIP_R_16F
-               && compute_type == rocsparselt_compute_f32)
-            {
-                status = findTopConfigs<__half, __half, float>(
-                    _matmulDescr, &(tmpAlgSelection.configs[0]), &config_max_id, requestConfigs);
-            }
-            else if(in_type == HIP_R_16BF && out_type == HIP_R_16BF
-                    && compute_type == rocsparselt_compute_f32)
+            // M buckets of a dynamic-M descriptor, none for a fixed M
+            int first_bucket = 0, last_bucket = -1;
+            if(_matmulDescr->dynamic_m_min)
             {
-                status = findTopConfigs<hip_bfloat16, hip_bfloat16, float>(
-                    _matmulDescr, &(tmpAlgSelection.configs[0]), &config_max_id, requestConfigs);
+                first_bucket = rocsparselt_dynamic_m_bucket(_matmulDescr->dynamic_m_min);
+                last_bucket  = rocsparselt_dynamic_m_bucket(_matmulDescr->m);
             }
-            else if(in_type == HIP_R_8I && out_type == HIP_R_8I
-                    && compute_type == rocsparselt_compute_i32)
+
+            if(_handle->backend == rocsparselt_backend_host)
             {
-                status = findTopConfigs<int8_t, int8_t, float>(
-                    _matmulDescr, &(tmpAlgSelection.configs[0]), &config_max_id, requestConfigs);
+                // The host backend has a single algorithm that takes the split-K
+                // factor at run time; its workspace follows the split-K request,
+                // see getHostSpmmWorkspaceSize().
+                config_max_id                                  = 1;
+                tmpAlgSelection.configs[0].max_workspace_bytes = 0;
+                tmpAlgSelection.configs[0].split_k             = 0;
+                for(int b = first_bucket; b <= last_bucket; b++)
+                    tmpAlgSelection.dynamic_m_configs[b] = tmpAlgSelection.configs[0];
             }
-            else if(in_type == HIP_R_8I && out_type == HIP_R_16F
-                    && compute_type == rocsparselt_compute_i32)
+            else
             {
-                status = findTopConfigs<int8_t, __half, float>(
-                    _matmulDescr, &(tmpAlgSelection.configs[0]), &config_max_id, requestConfigs);
+#if BUILD_WITH_TENSILE
+                constexpr int requestConfigs = 10; // find top 10 configs.
+
+                // Finds the top configs of the problem with m rows, 0 for the M of the descriptor
+                auto find_top_configs = [&](int64_t                     m,
+                                            _rocsparselt_matmul_config* topConfigs,
+                                            int*                        foundConfigs,
+                                            int                         request) {
+                    if(in_type == HIP_R_16F && out_type == HIP_R_16F
+                       && compute_type == rocsparselt_compute_f32)
+                        return findTopConfigs<__half, __half, float>(
+                            _matmulDescr, topConfigs, foundConfigs, request, m);
+                    else if(in_type == HIP_R_16F && out_type == HIP_R_8I
+                            && compute_type == rocsparselt_compute_f32)
+                        return findTopConfigs<__half, int8_t, float>(
+                            _matmulDescr, topConfigs, foundConfigs, request, m);
+                    else if(in_type == HIP_R_16F && out_type == HIP_R_8F_E4M3_FNUZ
+                            && compute_type == rocsparselt_compute_f32)
+                        return findTopConfigs<__half, hipsparselt_f8, float>(
+                            _matmulDescr, topConfigs, foundConfigs, request, m);
+                    else if(in_type == HIP_R_16F && out_type == HIP_R_8F_E5M2_FNUZ
+                            && compute_type == rocsparselt_compute_f32)
+                        return findTopConfigs<__half, hipsparselt_bf8, float>(
+                            _matmulDescr, topConfigs, foundConfigs, request, m);
+                    else if(in_type == HIP_R_16BF && out_type == HIP_R_16BF
+                            && compute_type == rocsparselt_compute_f32)
+                        return findTopConfigs<hip_bfloat16, hip_bfloat16, float>(
+                            _matmulDescr, topConfigs, foundConfigs, request, m);
+                    else if(in_type == HIP_R_16BF && out_type == HIP_R_8I
+                            && compute_type == rocsparselt_compute_f32)
+                        return findTopConfigs<hip_bfloat16, int8_t, float>(
+                            _matmulDescr, topConfigs, foundConfigs, request, m);
+                    else if(in_type == HIP_R_16BF && out_type == HIP_R_8F_E4M3_FNUZ
+                            && compute_type == rocsparselt_compute_f32)
+                        return findTopConfigs<hip_bfloat16, hipsparselt_f8, float>(
+                            _matmulDescr, topConfigs, foundConfigs, request, m);
+                    else if(in_type == HIP_R_16BF && out_type == HIP_R_8F_E5M2_FNUZ
+                            && compute_type == rocsparselt_compute_f32)
+                        return findTopConfigs<hip_bfloat16, hipsparselt_bf8, float>(
+                            _matmulDescr, topConfigs, foundConfigs, request, m);
+                    else if(in_type == HIP_R_8I && out_type == HIP_R_8I
+                            && compute_type == rocsparselt_compute_i32)
+                        return findTopConfigs<int8_t, int8_t, float>(
+                            _matmulDescr, topConfigs, foundConfigs, request, m);
+                    else if(in_type == HIP_R_8I && out_type == HIP_R_16F
+                            && compute_type == rocsparselt_compute_i32)
+                        return findTopConfigs<int8_t, __half, float>(
+                            _matmulDescr, topConfigs, foundConfigs, request, m);
+                    else if(in_type == HIP_R_8I && out_type == HIP_R_16BF
+                            && compute_type == rocsparselt_compute_i32)
+                        return findTopConfigs<int8_t, hip_bfloat16, float>(
+                            _matmulDescr, topConfigs, foundConfigs, request, m);
+                    else if(in_type == HIP_R_8F_E4M3_FNUZ && out_type == HIP_R_16F
+                            && compute_type == rocsparselt_compute_f32)
+                        return findTopConfigs<hipsparselt_f8, __half, float>(
+                            _matmulDescr, topConfigs, foundConfigs, request, m);
+                    else if(in_type == HIP_R_8F_E4M3_FNUZ && out_type == HIP_R_16BF
+                            && compute_type == rocsparselt_compute_f32)
+                        return findTopConfigs<hipsparselt_f8, hip_bfloat16, float>(
+                            _matmulDescr, topConfigs, foundConfigs, request, m);
+                    else if(in_type == HIP_R_8F_E4M3_FNUZ && out_type == HIP_R_32F
+                            && compute_type == rocsparselt_compute_f32)
+                        return findTopConfigs<hipsparselt_f8, float, float>(
+                            _matmulDescr, topConfigs, foundConfigs, request, m);
+                    else if(in_type == HIP_R_8F_E5M2_FNUZ && out_type == HIP_R_16F
+                            && compute_type == rocsparselt_compute_f32)
+                        return findTopConfigs<hipsparselt_bf8, __half, float>(
+                            _matmulDescr, topConfigs, foundConfigs, request, m);
+                    else if(in_type == HIP_R_8F_E5M2_FNUZ && out_type == HIP_R_16BF
+                            && compute_type == rocsparselt_compute_f32)
+                        return findTopConfigs<hipsparselt_bf8, hip_bfloat16, float>(
+                            _matmulDescr, topConfigs, foundConfigs, request, m);
+                    else if(in_type == HIP_R_8F_E5M2_FNUZ && out_type == HIP_R_32F
+                            && compute_type == rocsparselt_compute_f32)
+                        return findTopConfigs<hipsparselt_bf8, float, float>(
+                            _matmulDescr, topConfigs, foundConfigs, request, m);
+                    return rocsparselt_status_success;
+                };
+
+                rocsparselt_status status = find_top_configs(
+                    0, &(tmpAlgSelection.configs[0]), &config_max_id, requestConfigs);
+                if(status != rocsparselt_status_success)
+                    return status;
+
+                // A dynamic-M descriptor also gets the best config of each of its M
+                // buckets, found for the largest M of the bucket.
+                for(int b = first_bucket; config_max_id && b <= last_bucket; b++)
+                {
+                    int64_t bucket_m
+                        = std::min(uint64_t(1) << b, static_cast<uint64_t>(_matmulDescr->m));
+
+                    // getBestSolutions may add a split-K config for each requested one
+                    _rocsparselt_matmul_config bucketConfigs[2];
+                    int                        found = 0;
+
+                    status = find_top_configs(bucket_m, bucketConfigs, &found, 1);
+                    if(status != rocsparselt_status_success)
+                        return status;
+                    if(!found)
+                    {
+                        hipsparselt_cerr << "There are no solutions for M = " << bucket_m
+                                         << std::endl;
+                        log_error(_handle, __func__, "There are no solutions for M", bucket_m);
+                        return rocsparselt_status_not_implemented;
+                    }
+                    tmpAlgSelection.dynamic_m_configs[b] = bucketConfigs[0];
+                }
+#else
+                rocsparselt_status status = rocsparselt_status_success;
+                if(in_type == HIP_R_16F && out_type == HIP_R_16F
+                   && compute_type == rocsparselt_compute_f32)
+                    status = findKernelConfigs<__half, __half, float>(_matmulDescr, &config_max_id);
+                else if(in_type == HIP_R_16BF && out_type == HIP_R_16BF
+                        && compute_type == rocsparselt_compute_f32)
+                    status = findKernelConfigs<hip_bfloat16, hip_bfloat16, float>(_matmulDescr,
+                                                                                  &config_max_id);
+                else if(in_type == HIP_R_8I && out_type == HIP_R_8I
+                        && compute_type == rocsparselt_compute_i32)
+                    status = findKernelConfigs<int8_t, int8_t, float>(_matmulDescr, &config_max_id);
+                if(status != rocsparselt_status_success)
+                    return status;
+                // The kernel of a config is looked up at launch time, which also
+                // applies the split-K request.
+                for(int i = 0; i < config_max_id; i++)
+                {
+                    tmpAlgSelection.configs[i].max_workspace_bytes = 0;
+                    tmpAlgSelection.configs[i].split_k             = 0;
+                }
+                for(int b = first_bucket; config_max_id && b <= last_bucket; b++)
+                    tmpAlgSelection.dynamic_m_configs[b] = tmpAlgSelection.configs[0];
+#endif
             }
-            else if(in_type == HIP_R_8I && out_type == HIP_R_16BF
-                    && compute_type == rocsparselt_compute_i32)
+            if(_matmulDescr->dynamic_m_min)
             {
-                status = findTopConfigs<int8_t, hip_bfloat16, float>(
-                    _matmulDescr, &(tmpAlgSelection.configs[0]), &config_max_id, requestConfigs);
+                tmpAlgSelection.dynamic_m_min = _matmulDescr->dynamic_m_min;
+                tmpAlgSelection.dynamic_m_max = _matmulDescr->m;
             }
-            if(status != rocsparselt_status_success)
-                return status;
-#else
-            if(in_type == HIP_R_16F && out_type == HIP_R_16F
-               && compute_type == rocsparselt_compute_f32)
-                initSolutions<__half, __half, float>(
-                    _handle, _matmulDescr->op_A, _matmulDescr->op_B, &config_max_id);
-            else if(in_type == HIP_R_16BF && out_type == HIP_R_16BF
-                    && compute_type == rocsparselt_compute_f32)
-                initSolutions<hip_bfloat16, hip_bfloat16, float>(
-                    _handle, _matmulDescr->op_A, _matmulDescr->op_B, &config_max_id);
-            else if(in_type == HIP_R_8I && out_type == HIP_R_8I
-                    && compute_type == rocsparselt_compute_i32)
-                initSolutions<int8_t, int8_t, float>(
-                    _handle, _matmulDescr->op_A, _matmulDescr->op_B, &config_max_id);
-            for(int i = 0; i < config_max_id; i++)
-            {
-                configs[i].max_workspace_bytes = 0;
-            }
-#endif
             if(!config_max_id)
             {
                 hipsparselt_cerr << "There are no solutions for this problem size" << std::endl;
@@ -1434,8 +1900,18 @@ rocsparselt_status
                                      << (_algSelection->config_max_id - 1) << "]" << std::endl;
                     return rocsparselt_status_invalid_value;
                 }
+                if(!_algSelection->configs[*config_id].matches_split_k(
+                       _algSelection->split_k, _algSelection->split_k_mode))
+                {
+                    hipsparselt_cerr << "config " << *config_id
+                                     << " does not run the requested split-K factor "
+                                     << _algSelection->split_k << std::endl;
+                    log_error(_handle, __func__, "config does not run the requested split-K");
+                    return rocsparselt_status_invalid_value;
+                }
 
-                _algSelection->config_id = *config_id;
+                _algSelection->config_id      = *config_id;
+                _algSelection->user_config_id = true;
                 break;
             }
             case rocsparselt_matmul_alg_config_max_id:
@@ -1466,6 +1942,81 @@ rocsparselt_status
                 _algSelection->search_iterations = *search_iterations;
                 break;
             }
+            case rocsparselt_matmul_split_k:
+            case rocsparselt_matmul_split_k_mode:
+            {
+                if((status = validateSetAttributeDataSize<int>(dataSize))
+                   != rocsparselt_status_success)
+                {
+                    log_error(_handle, __func__, "dataSize is invalid");
+                    return status;
+                }
+
+                int                      split_k      = _algSelection->split_k;
+                rocsparselt_split_k_mode split_k_mode = _algSelection->split_k_mode;
+                if(attribute == rocsparselt_matmul_split_k)
+                {
+                    split_k = *reinterpret_cast<const int*>(data);
+                    if(split_k < 1)
+                    {
+                        hipsparselt_cerr
+                            << "The split-K factor must be greater or equal to 1, current: "
+                            << split_k << std::endl;
+                        log_error(_handle, __func__, "split-K factor must >= 1");
+                        return rocsparselt_status_invalid_value;
+                    }
+                }
+                else
+                {
+                    split_k_mode = static_cast<rocsparselt_split_k_mode>(
+                        *reinterpret_cast<const int*>(data));
+                    if(split_k_mode != rocsparselt_splik_k_mode_one_kernel
+                       && split_k_mode != rocsparselt_split_k_mode_two_kernels)
+                    {
+                        log_error(_handle, __func__, "split-K mode", split_k_mode, "is invalid");
+                        return rocsparselt_status_invalid_value;
+                    }
+                }
+
+                // Move to the best ranked config which runs the request.
+                int config_id = _algSelection->find_split_k_config(split_k, split_k_mode);
+                if(config_id < 0)
+                {
+                    hipsparselt_cerr << "There are no solutions with split-K factor " << split_k
+                                     << " and mode " << split_k_mode << " for this problem"
+                                     << std::endl;
+                    log_error(_handle, __func__, "no solutions for the split-K request");
+                    return rocsparselt_status_not_implemented;
+                }
+
+                _algSelection->config_id    = config_id;
+                _algSelection->split_k      = split_k;
+                _algSelection->split_k_mode = split_k_mode;
+                if(_algSelection->split_k_buffers >= split_k)
+                    _algSelection->split_k_buffers = 0;
+                break;
+            }
+            case rocsparselt_matmul_split_k_buffers:
+            {
+                if((status = validateSetAttributeDataSize<int>(dataSize))
+                   != rocsparselt_status_success)
+                {
+                    log_error(_handle, __func__, "dataSize is invalid");
+                    return status;
+                }
+
+                const int* split_k_buffers = reinterpret_cast<const int*>(data);
+                if(*split_k_buffers < 1 || *split_k_buffers >= _algSelection->split_k)
+                {
+                    hipsparselt_cerr << "The value of rocsparselt_matmul_split_k_buffers data "
+                                     << *split_k_buffers << " is out of the range [1, "
+                                     << (_algSelection->split_k - 1) << "]" << std::endl;
+                    log_error(_handle, __func__, "split-K buffers is out of range");
+                    return rocsparselt_status_invalid_value;
+                }
+                _algSelection->split_k_buffers = *split_k_buffers;
+                break;
+            }
             default:
                 return rocsparselt_status_not_implemented;
             }
@@ -1553,6 +2104,20 @@ rocsparselt_status
             case rocsparselt_matmul_search_iterations:
                 *reinterpret_cast<int*>(data) = _algSelection->search_iterations;
                 break;
+            case rocsparselt_matmul_split_k:
+            {
+                // when not set, the split factor of the selected config
+                auto& config = _algSelection->configs[_algSelection->config_id];
+                *reinterpret_cast<int*>(data)
+                    = _algSelection->split_k ? _algSelection->split_k : config.split_k;
+                break;
+            }
+            case rocsparselt_matmul_split_k_mode:
+                *reinterpret_cast<int*>(data) = _algSelection->split_k_mode;
+                break;
+            case rocsparselt_matmul_split_k_buffers:
+                *reinterpret_cast<int*>(data) = _algSelection->split_k_buffers;
+                break;
             default:
                 log_error(_handle, __func__, "attribute", attribute, "is not supported");
                 return rocsparselt_status_not_implemented;
@@ -1647,12 +2212,38 @@ rocsparselt_status
             return rocsparselt_status_invalid_size;
         }
 
+        // Each M bucket of a dynamic-M descriptor needs its config in the alg selection
+        if(_matmulDescr->dynamic_m_min
+           && (!_algSelection->dynamic_m_min
+               || rocsparselt_dynamic_m_bucket(_matmulDescr->dynamic_m_min)
+                      < rocsparselt_dynamic_m_bucket(_algSelection->dynamic_m_min)
+               || rocsparselt_dynamic_m_bucket(_matmulDescr->m)
+                      > rocsparselt_dynamic_m_bucket(_algSelection->dynamic_m_max)))
+        {
+            log_error(_handle,
+                      __func__,
+                      "algSelection was not initialized for the dynamic M range of matmulDescr");
+            return rocsparselt_status_invalid_value;
+        }
+
         auto                     _plan = reinterpret_cast<_rocsparselt_matmul_plan*>(plan);
         _rocsparselt_matmul_plan tmpPlan(_handle);
         memcpy(_plan, &tmpPlan, sizeof(_rocsparselt_matmul_plan));
 
         _plan->matmul_descr  = new _rocsparselt_matmul_descr(*_matmulDescr);
         _plan->alg_selection = const_cast<_rocsparselt_matmul_alg_selection*>(_algSelection);
+        _plan->launch_cache  = new _rocsparselt_matmul_launch_cache;
+
+        int tuned_config_id;
+        if(!_algSelection->user_config_id && _handle->backend == rocsparselt_backend_device
+           && rocsparselt_tuning_db_lookup(_plan, &tuned_config_id)
+           && _algSelection->configs[tuned_config_id].matches_split_k(_algSelection->split_k,
+                                                                      _algSelection->split_k_mode))
+        {
+            log_info(_handle, __func__, "tuned config_id", tuned_config_id);
+            _plan->alg_selection->config_id = tuned_config_id;
+        }
+
         log_api(_handle,
                 __func__,
                 "plan[out]",
@@ -0,0 +1,283 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "search_strategy.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    // Timed samples per candidate in each halving / racing round
+    constexpr int ROUND_SAMPLES = 3;
+
+    /***************************************************************************
+     * Tracks the sampled time against the budget. Warm-ups count as well,     *
+     * since they take as long as a timed run.                                 *
+     ***************************************************************************/
+    class SearchBudget
+    {
+    public:
+        explicit SearchBudget(float budget_ms)
+            : m_budget_ms(budget_ms)
+        {
+        }
+
+        bool exhausted() const
+        {
+            return m_budget_ms > 0.f && m_spent_ms >= m_budget_ms;
+        }
+
+        void spend(float ms)
+        {
+            m_spent_ms += ms;
+        }
+
+    private:
+        float m_budget_ms;
+        float m_spent_ms = 0.f;
+    };
+
+    struct Candidate
+    {
+        int                    id;
+        std::vector<float>     samples;
+        RocsparseltSampleStats stats;
+    };
+
+    class ExhaustiveSearch : public RocsparseltSearchStrategy
+    {
+    public:
+        explicit ExhaustiveSearch(const RocsparseltSearchOptions& options)
+            : m_options(options)
+        {
+        }
+
+        rocsparselt_status run(const std::vector<int>&         candidates,
+                               const RocsparseltSearchSampler& sample,
+                               int&                            best) override
+        {
+            SearchBudget budget(m_options.budget_ms);
+            float        min_ms = std::numeric_limits<float>::max();
+
+            for(int id : candidates)
+            {
+                float sum_ms = 0.f, ms;
+                int   count  = 0;
+                for(int i = 0; i <= m_options.iterations && !budget.exhausted(); i++)
+                {
+                    auto status = sample(id, ms);
+                    if(status != rocsparselt_status_success)
+                        return status;
+                    budget.spend(ms);
+                    // the first run is the warm-up
+                    if(i > 0)
+                    {
+                        sum_ms += ms;
+                        count++;
+                    }
+                }
+                if(count == 0)
+                    break;
+
+                if(sum_ms / count < min_ms)
+                {
+                    min_ms = sum_ms / count;
+                    best   = id;
+                }
+            }
+            return min_ms == std::numeric_limits<float>::max() ? rocsparselt_status_internal_error
+                                                               : rocsparselt_status_success;
+        }
+
+    private:
+        RocsparseltSearchOptions m_options;
+    };
+
+    /***************************************************************************
+     * Successive halving and racing share the rounds; halving additionally    *
+     * keeps only the faster half after each round.                            *
+     ***************************************************************************/
+    class AdaptiveSearch : public RocsparseltSearchStrategy
+    {
+    public:
+        AdaptiveSearch(const RocsparseltSearchOptions& options, bool halve)
+            : m_options(options)
+            , m_halve(halve)
+        {
+        }
+
+        rocsparselt_status run(const std::vector<int>&         candidates,
+                               const RocsparseltSearchSampler& sample,
+                               int&                            best) override
+        {
+            SearchBudget           budget(m_options.budget_ms);
+            std::vector<Candidate> alive;
+            float                  ms;
+
+            for(int id : candidates)
+                alive.push_back({id, {}, {}});
+
+            auto by_median = [](const Candidate& a, const Candidate& b) {
+                return a.stats.median < b.stats.median;
+            };
+
+            while(!alive.empty() && !budget.exhausted())
+            {
+                bool sampled = false;
+                for(auto& c : alive)
+                {
+                    // warm up right before the first timed run, so that a
+                    // budget cut leaves fully timed candidates to compare
+                    if(c.samples.empty() && !budget.exhausted())
+                    {
+                        auto status = sample(c.id, ms);
+                        if(status != rocsparselt_status_success)
+                            return status;
+                        budget.spend(ms);
+                    }
+
+                    int target
+                        = std::min<int>(c.samples.size() + ROUND_SAMPLES, m_options.iterations);
+                    while((int)c.samples.size() < target && !budget.exhausted())
+                    {
+                        auto status = sample(c.id, ms);
+                        if(status != rocsparselt_status_success)
+                            return status;
+                        budget.spend(ms);
+                        c.samples.push_back(ms);
+                        sampled = true;
+                    }
+                }
+                if(!sampled)
+                    break;
+
+                // Candidates the budget cut off before their first sample are out
+                alive.erase(std::remove_if(alive.begin(),
+                                           alive.end(),
+                                           [](const Candidate& c) { return c.samples.empty(); }),
+                            alive.end());
+                for(auto& c : alive)
+                    c.stats = rocsparselt_sample_stats(c.samples);
+
+                // stable so that ties keep the candidate order, like the exhaustive search
+                std::stable_sort(alive.begin(), alive.end(), by_median);
+                float leader_upper = alive.front().stats.upper;
+                alive.erase(std::remove_if(alive.begin(),
+                                           alive.end(),
+                                           [&](const Candidate& c) {
+                                               return c.stats.lower > leader_upper;
+                                           }),
+                            alive.end());
+                if(m_halve)
+                    alive.resize((alive.size() + 1) / 2, alive.front());
+
+                if(alive.size() == 1)
+                    break;
+            }
+
+            if(alive.empty() || alive.front().samples.empty())
+                return rocsparselt_status_internal_error;
+
+            best = std::min_element(alive.begin(), alive.end(), by_median)->id;
+            return rocsparselt_status_success;
+        }
+
+    private:
+        RocsparseltSearchOptions m_options;
+        bool                     m_halve;
+    };
+}
+
+std::unique_ptr<RocsparseltSearchStrategy>
+    rocsparselt_make_search_strategy(const RocsparseltSearchOptions& options)
+{
+    switch(options.strategy)
+    {
+    case rocsparselt_search_strategy::exhaustive:
+        return std::make_unique<ExhaustiveSearch>(options);
+    case rocsparselt_search_strategy::racing:
+        return std::make_unique<AdaptiveSearch>(options, false);
+    case rocsparselt_search_strategy::halving:
+    default:
+        return std::make_unique<AdaptiveSearch>(options, true);
+    }
+}
+
+RocsparseltSampleStats rocsparselt_sample_stats(std::vector<float> samples)
+{
+    auto median_of = [](std::vector<float>& v) {
+        size_t half = v.size() / 2;
+        std::nth_element(v.begin(), v.begin() + half, v.end());
+        float upper = v[half];
+        if(v.size() % 2)
+            return upper;
+        return (*std::max_element(v.begin(), v.begin() + half) + upper) / 2;
+    };
+
+    RocsparseltSampleStats stats;
+    stats.median = median_of(samples);
+    if(samples.size() < 3)
+    {
+        stats.lower = -std::numeric_limits<float>::infinity();
+        stats.upper = std::numeric_limits<float>::infinity();
+        return stats;
+    }
+
+    for(auto& s : samples)
+        s = std::fabs(s - stats.median);
+    float mad = median_of(samples);
+
+    // 1.4826 * MAD estimates the standard deviation of normal noise, and the
+    // median's standard error is sqrt(pi / 2) times that of the mean
+    float half_width = 1.96f * 1.2533f * 1.4826f * mad / std::sqrt(float(samples.size()));
+    stats.lower      = stats.median - half_width;
+    stats.upper      = stats.median + half_width;
+    return stats;
+}
+
+RocsparseltSearchOptions rocsparselt_search_options_from_env()
+{
+    RocsparseltSearchOptions options;
+
+    if(const char* env = getenv("HIPSPARSELT_SEARCH_STRATEGY"))
+    {
+        if(strcmp(env, "exhaustive") == 0)
+            options.strategy = rocsparselt_search_strategy::exhaustive;
+        else if(strcmp(env, "halving") == 0)
+            options.strategy = rocsparselt_search_strategy::halving;
+        else if(strcmp(env, "racing") == 0)
+            options.strategy = rocsparselt_search_strategy::racing;
+    }
+
+    if(const char* env = getenv("HIPSPARSELT_SEARCH_BUDGET_MS"))
+        options.budget_ms = std::max(0.f, strtof(env, nullptr));
+
+    return options;
+}
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "solution_index.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    void to_point(int64_t m, int64_t n, int64_t batch, int64_t k, double* point)
+    {
+        int64_t sizes[] = {m, n, batch, k};
+        for(int i = 0; i < 4; i++)
+            point[i] = std::log2(double(std::max<int64_t>(sizes[i], 1)));
+    }
+
+    // Orders a max-heap of neighbors by squared distance, the table order breaks ties
+    bool nearer(const RocsparseltSizeIndex::Neighbor& a, const RocsparseltSizeIndex::Neighbor& b)
+    {
+        return a.distance < b.distance || (a.distance == b.distance && a.size < b.size);
+    }
+}
+
+RocsparseltSizeIndex::RocsparseltSizeIndex(const std::vector<const RocsparseltTunedSize*>& sizes)
+{
+    for(auto size : sizes)
+    {
+        Node node;
+        to_point(size->m, size->n, size->batch, size->k, node.point);
+        node.size = size;
+        m_nodes.push_back(node);
+    }
+    build(0, m_nodes.size(), 0);
+}
+
+void RocsparseltSizeIndex::build(size_t begin, size_t end, int depth)
+{
+    if(end - begin < 2)
+        return;
+
+    size_t mid  = begin + (end - begin) / 2;
+    int    axis = depth % 4;
+    std::nth_element(m_nodes.begin() + begin,
+                     m_nodes.begin() + mid,
+                     m_nodes.begin() + end,
+                     [axis](const Node& a, const Node& b) { return a.point[axis] < b.point[axis]; });
+    build(begin, mid, depth + 1);
+    build(mid + 1, end, depth + 1);
+}
+
+void RocsparseltSizeIndex::search(const double*          point,
+                                  size_t                 begin,
+                                  size_t                 end,
+                                  int                    depth,
+                                  size_t                 count,
+                                  std::vector<Neighbor>& heap) const
+{
+    if(begin >= end)
+        return;
+
+    size_t      mid  = begin + (end - begin) / 2;
+    int         axis = depth % 4;
+    const Node& node = m_nodes[mid];
+
+    Neighbor candidate{node.size, 0.0};
+    for(int i = 0; i < 4; i++)
+        candidate.distance += (point[i] - node.point[i]) * (point[i] - node.point[i]);
+
+    if(heap.size() < count)
+    {
+        heap.push_back(candidate);
+        std::push_heap(heap.begin(), heap.end(), nearer);
+    }
+    else if(nearer(candidate, heap.front()))
+    {
+        std::pop_heap(heap.begin(), heap.end(), nearer);
+        heap.back() = candidate;
+        std::push_heap(heap.begin(), heap.end(), nearer);
+    }
+
+    // The side of the point first; the other side only if it can hold a nearer size
+    double diff       = point[axis] - node.point[axis];
+    size_t near_begin = diff < 0 ? begin : mid + 1;
+    size_t near_end   = diff < 0 ? mid : end;
+    size_t far_begin  = diff < 0 ? mid + 1 : begin;
+    size_t far_end    = diff < 0 ? end : mid;
+
+    search(point, near_begin, near_end, depth + 1, count, heap);
+    if(heap.size() < count || diff * diff <= heap.front().distance)
+        search(point, far_begin, far_end, depth + 1, count, heap);
+}
+
+std::vector<RocsparseltSizeIndex::Neighbor> RocsparseltSizeIndex::nearest(
+    int64_t m, int64_t n, int64_t batch, int64_t k, size_t count) const
+{
+    std::vector<Neighbor> heap;
+    if(!count)
+        return heap;
+
+    double point[4];
+    to_point(m, n, batch, k, point);
+    heap.reserve(count);
+    search(point, 0, m_nodes.size(), 0, count, heap);
+
+    std::sort_heap(heap.begin(), heap.end(), nearer);
+    for(auto& neighbor : heap)
+        neighbor.distance = std::sqrt(neighbor.distance);
+    return heap;
+}
+
+std::vector<RocsparseltSizeIndex::Vote>
+    RocsparseltSizeIndex::vote(const std::vector<Neighbor>& neighbors)
+{
+    double best = 0;
+    for(auto& neighbor : neighbors)
+        best = std::max(best, neighbor.size->gflops);
+
+    std::vector<Vote> votes;
+    for(auto& neighbor : neighbors)
+    {
+        double weight = (best > 0 ? neighbor.size->gflops / best : 1.0) / (1 + neighbor.distance);
+        auto   it     = std::find_if(votes.begin(), votes.end(), [&](const Vote& vote) {
+            return strcmp(vote.solution, neighbor.size->solution) == 0;
+        });
+        if(it != votes.end())
+            it->weight += weight;
+        else
+            votes.push_back({neighbor.size->solution, weight});
+    }
+
+    std::stable_sort(votes.begin(), votes.end(), [](const Vote& a, const Vote& b) {
+        return a.weight > b.weight;
+    });
+    return votes;
+}
@@ -46,6 +46,24 @@
         }                                     \
     } while(0)
 
+namespace
+{
+    template <typename Invocation>
+    void printLaunchBounds(std::ostream& stream, Invocation const& kernel)
+    {
+        stream << "Kernel " << kernel.kernelName << "\n"
+               << " l"
+               << " (" << kernel.workGroupSize.x << ", " << kernel.workGroupSize.y << ". "
+               << kernel.workGroupSize.z << ")"
+               << " x g"
+               << " (" << kernel.numWorkGroups.x << ", " << kernel.numWorkGroups.y << ". "
+               << kernel.numWorkGroups.z << ")"
+               << " = "
+               << "(" << kernel.numWorkItems.x << ", " << kernel.numWorkItems.y << ". "
+               << kernel.numWorkItems.z << ") \n";
+    }
+} // namespace
+
 SolutionAdapter::SolutionAdapter() {}
 
 SolutionAdapter::SolutionAdapter(std::string const& name)
@@ -97,9 +115,11 @@ hipError_t SolutionAdapter::loadLibrary(std::string const& path)
         return hipErrorInvalidContext;
     }
 
-    function_table funcs
-        = {{"get_kernel_byte", NULL}, {"get_kernel_params", NULL}, {"get_kernel_counts", NULL}};
-    hipError_t status;
+    function_table funcs = {{"get_kernel_byte", NULL},
+                            {"get_kernel_params", NULL},
+                            {"get_kernel_counts", NULL},
+                            {"get_kernel_total", NULL}};
+    hipError_t     status;
     for(auto& func : funcs)
     {
         if((status = load_lib_functions(handle, func.first.c_str(), &func.second)) != hipSuccess)
@@ -108,6 +128,24 @@ hipError_t SolutionAdapter::loadLibrary(std::string const& path)
 
     {
         std::lock_guard<std::mutex> guard(m_access);
+        // Kernel ids are only unique within a library, so the id table
+        // serves the first library loaded; later ones use the name lookup.
+        // The count is published after the table it covers is filled, and a
+        // table is never freed while the adapter lives.
+        if(m_lib_handles.empty())
+        {
+            size_t (*get_kernel_total)();
+            *(void**)(&get_kernel_total) = funcs["get_kernel_total"];
+            size_t total                 = get_kernel_total();
+            m_functions.reset(new std::atomic<hipFunction_t>[total]);
+            for(size_t i = 0; i < total; i++)
+                m_functions[i].store(nullptr, std::memory_order_relaxed);
+            m_functionCount.store(total, std::memory_order_release);
+        }
+        else
+        {
+            m_functionCount.store(0, std::memory_order_release);
+        }
         m_lib_handles.push_back(handle);
         m_lib_functions.push_back(funcs);
         m_loadedLibNames.push_back(concatenate(path));
@@ -126,8 +164,11 @@ hipError_t SolutionAdapter::loadCodeObject(const _rocsparselt_handle* handle,
                                            std::string const&         name)
 {
     //check if the module already exist.
-    if(m_modules.find(name) != m_modules.end())
-        return hipSuccess;
+    {
+        std::lock_guard<std::mutex> guard(m_access);
+        if(m_modules.find(name) != m_modules.end())
+            return hipSuccess;
+    }
 
     for(auto& fucs : m_lib_functions)
     {
@@ -135,7 +176,7 @@ hipError_t SolutionAdapter::loadCodeObject(const _rocsparselt_handle* handle,
         if(it == fucs.end())
             continue;
 
-        unsigned char* (*get_kernel_byte)(const char*);
+        const unsigned char* (*get_kernel_byte)(const char*);
         *(void**)(&get_kernel_byte) = it->second;
         auto k_bytes                = get_kernel_byte(name.c_str());
 
@@ -202,6 +243,29 @@ hipError_t SolutionAdapter::getKernel(hipFunction_t& rv, std::string const& name
     return err;
 }
 
+hipError_t SolutionAdapter::resolveKernel(const _rocsparselt_handle* handle,
+                                          std::string const&         name,
+                                          int                        id,
+                                          hipFunction_t&             rv)
+{
+    bool indexed
+        = id >= 0 && static_cast<size_t>(id) < m_functionCount.load(std::memory_order_acquire);
+    if(indexed)
+    {
+        rv = m_functions[id].load(std::memory_order_acquire);
+        if(rv != nullptr)
+            return hipSuccess;
+    }
+
+    HIP_CHECK_RETURN(loadCodeObject(handle, name));
+    HIP_CHECK_RETURN(getKernel(rv, name));
+
+    // Racing threads resolve the same function, so the last store wins harmlessly
+    if(indexed)
+        m_functions[id].store(rv, std::memory_order_release);
+    return hipSuccess;
+}
+
 hipError_t SolutionAdapter::launchKernel(const _rocsparselt_handle* handle,
                                          KernelInvocation const&    kernel)
 {
@@ -218,30 +282,73 @@ hipError_t SolutionAdapter::launchKernel(const _rocsparselt_handle* handle,
     if(handle->layer_mode & rocsparselt_layer_mode_log_trace)
     {
         std::ostringstream stream;
-        stream << "Kernel " << kernel.kernelName << "\n"
-               << " l"
-               << " (" << kernel.workGroupSize.x << ", " << kernel.workGroupSize.y << ". "
-               << kernel.workGroupSize.z << ")"
-               << " x g"
-               << " (" << kernel.numWorkGroups.x << ", " << kernel.numWorkGroups.y << ". "
-               << kernel.numWorkGroups.z << ")"
-               << " = "
-               << "(" << kernel.numWorkItems.x << ", " << kernel.numWorkItems.y << ". "
-               << kernel.numWorkItems.z << ") \n"
-               << kernel.args << std::endl;
+        printLaunchBounds(stream, kernel);
+        stream << kernel.args << std::endl;
         log_trace(handle, __func__, stream.str());
     }
 
-    HIP_CHECK_RETURN(loadCodeObject(handle, kernel.kernelName));
-
     hipFunction_t function;
-    HIP_CHECK_RETURN(getKernel(function, kernel.kernelName));
+    HIP_CHECK_RETURN(resolveKernel(handle, kernel.kernelName, kernel.kernelId, function));
+
+    return launchFunction(handle,
+                          function,
+                          kernel.numWorkItems,
+                          kernel.workGroupSize,
+                          kernel.sharedMemBytes,
+                          kernel.args.data(),
+                          kernel.args.size(),
+                          stream,
+                          startEvent,
+                          stopEvent,
+                          iter);
+}
+
+hipError_t SolutionAdapter::launchKernel(const _rocsparselt_handle*    handle,
+                                         PackedKernelInvocation const& kernel,
+                                         PackedKernelArguments const&  args,
+                                         hipStream_t                   stream,
+                                         hipEvent_t                    startEvent,
+                                         hipEvent_t                    stopEvent,
+                                         int                           iter)
+{
+    if(handle->layer_mode & rocsparselt_layer_mode_log_trace)
+    {
+        std::ostringstream stream;
+        printLaunchBounds(stream, kernel);
+        kernel.layout.print(stream, args.data());
+        log_trace(handle, __func__, stream.str());
+    }
 
-    void*  kernelArgs = const_cast<void*>(kernel.args.data());
-    size_t argsSize   = kernel.args.size();
+    hipFunction_t function;
+    HIP_CHECK_RETURN(resolveKernel(handle, kernel.kernelName, kernel.kernelId, function));
+
+    return launchFunction(handle,
+                          function,
+                          kernel.numWorkItems,
+                          kernel.workGroupSize,
+                          kernel.sharedMemBytes,
+                          args.data(),
+                          args.size(),
+                          stream,
+                          startEvent,
+                          stopEvent,
+                          iter);
+}
 
+hipError_t SolutionAdapter::launchFunction(const _rocsparselt_handle* handle,
+                                           hipFunction_t              function,
+                                           dim3 const&                numWorkItems,
+                                           dim3 const&                workGroupSize,
+                                           size_t                     sharedMemBytes,
+                                           void const*                args,
+                                           size_t                     argsSize,
+                                           hipStream_t                stream,
+                                           hipEvent_t                 startEvent,
+                                           hipEvent_t                 stopEvent,
+                                           int                        iter)
+{
     void* hipLaunchParams[] = {HIP_LAUNCH_PARAM_BUFFER_POINTER,
-                               kernelArgs,
+                               const_cast<void*>(args),
                                HIP_LAUNCH_PARAM_BUFFER_SIZE,
                                &argsSize,
                                HIP_LAUNCH_PARAM_END};
@@ -250,13 +357,13 @@ hipError_t SolutionAdapter::launchKernel(const _rocsparselt_handle* handle,
         HIP_CHECK_RETURN(hipEventRecord(startEvent, stream));
     for(int i = 0; i < iter; i++)
         HIP_CHECK_RETURN(hipExtModuleLaunchKernel(function,
-                                                  kernel.numWorkItems.x,
-                                                  kernel.numWorkItems.y,
-                                                  kernel.numWorkItems.z,
-                                                  kernel.workGroupSize.x,
-                                                  kernel.workGroupSize.y,
-                                                  kernel.workGroupSize.z,
-                                                  kernel.sharedMemBytes, // sharedMem
+                                                  numWorkItems.x,
+                                                  numWorkItems.y,
+                                                  numWorkItems.z,
+                                                  workGroupSize.x,
+                                                  workGroupSize.y,
+                                                  workGroupSize.z,
+                                                  sharedMemBytes, // sharedMem
                                                   stream, // stream
                                                   nullptr,
                                                   (void**)&hipLaunchParams,
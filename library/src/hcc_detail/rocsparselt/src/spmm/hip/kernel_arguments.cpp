@@ -244,3 +244,43 @@ auto KernelArguments::end() const -> const_iterator
 {
     return const_iterator(*this, "");
 }
+
+size_t KernelArgumentsLayout::offset(std::string const& name) const
+{
+    for(auto const& record : m_records)
+    {
+        if(record.name == name)
+            return record.offset;
+    }
+
+    throw std::runtime_error("Argument " + name + " not found in layout.");
+}
+
+void KernelArgumentsLayout::print(std::ostream& stream, void const* data) const
+{
+    auto const* bytes      = static_cast<uint8_t const*>(data);
+    size_t      prevOffset = 0;
+    for(auto const& record : m_records)
+    {
+        if(prevOffset != record.offset)
+        {
+            stream << "[" << prevOffset << ".." << record.offset - 1 << "] <padding>" << std::endl;
+        }
+
+        stream << "[" << record.offset << ".." << record.offset + record.size - 1 << "] "
+               << record.name << ":";
+
+        auto oldFill  = stream.fill();
+        auto oldWidth = stream.width();
+        stream << std::hex;
+        for(size_t i = record.offset; i < record.offset + record.size; i++)
+            stream << " " << std::setfill('0') << std::setw(2) << static_cast<uint32_t>(bytes[i]);
+        stream << std::dec;
+        stream.fill(oldFill);
+        stream.width(oldWidth);
+
+        stream << std::endl;
+
+        prevOffset = record.offset + record.size;
+    }
+}
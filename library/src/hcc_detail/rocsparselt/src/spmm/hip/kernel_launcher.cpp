@@ -31,7 +31,9 @@
 #include "hipsparselt_ostream.hpp"
 #include "rocsparselt-types.h"
 #include "rocsparselt.h"
+#include "rocsparselt_spmm_utils.hpp"
 #include "status.h"
+#include "tuning_db.hpp"
 #include "utility.hpp"
 
 #include <atomic>
@@ -68,6 +70,10 @@ namespace
     }
 #endif
 
+    // Path of the first loaded kernel library, set by KernelLauncher::initialize()
+    std::string    kernel_library_path;
+    std::once_flag kernel_library_once;
+
     size_t totalAllcoatedElement(std::vector<size_t>& sizes,
                                  std::vector<size_t>& strides,
                                  size_t               offset)
@@ -97,17 +103,19 @@ namespace
         return totalAllocatedElementsNonBatch;
     };
 
-    template <typename Ti, typename To, typename Tc>
-    auto ConstructKernelInvoke(const RocsparseltContractionProblem<Ti, To, Tc>& prob,
-                               const KernelParams&                              kernel)
+    /*****************************************************************************
+     * FillKernelInvocation computes the launch bounds of a kernel and appends  *
+     * its arguments to args, which is either a KernelArguments or a            *
+     * PackedKernelArgumentsBuilder.                                            *
+     *****************************************************************************/
+    template <typename Ti, typename To, typename Tc, typename Invocation, typename Args>
+    void FillKernelInvocation(const RocsparseltContractionProblem<Ti, To, Tc>& prob,
+                              const KernelParams&                              kernel,
+                              Invocation&                                      ki,
+                              Args&                                            args)
     {
-        KernelInvocation ki;
-
-        ki.args = KernelArguments();
-
-        ki.args.reserve(1024, 128);
-
         ki.kernelName = kernel.SolutionNameMin;
+        ki.kernelId   = kernel.KernelId;
 
         ki.workGroupSize.x = kernel.WorkGroup[0] * kernel.WorkGroup[1] * kernel.WorkGroup[2];
         ki.workGroupSize.y = 1;
@@ -281,20 +289,20 @@ namespace
                   ? totalAllcoatedElement(sizes_b, strides_b, (size_t)0)
                   : totalAllcoatedElementNonBatch(sizes_b, strides_b, batchIndex);
 
-        ki.args.append<uint64_t>("tensor2dSizeC", tensor2dSizeC);
-        ki.args.append<uint64_t>("tensor2dSizeA", tensor2dSizeA);
-        ki.args.append<uint64_t>("tensor2dSizeB", tensor2dSizeB);
+        args.template append<uint64_t>("tensor2dSizeC", tensor2dSizeC);
+        args.template append<uint64_t>("tensor2dSizeA", tensor2dSizeA);
+        args.template append<uint64_t>("tensor2dSizeB", tensor2dSizeB);
 
-        ki.args.append<To const*>("d", prob.D);
-        ki.args.append<To const*>("c", prob.C);
-        ki.args.append<Ti const*>("a", prob.A);
-        ki.args.append<Ti const*>("b", prob.B);
+        args.template append<To const*>("d", prob.D);
+        args.template append<To const*>("c", prob.C);
+        args.template append<Ti const*>("a", prob.A);
+        args.template append<Ti const*>("b", prob.B);
 
         if(prob.sparseA)
-            ki.args.append<unsigned char const*>("metadata", prob.metadata);
+            args.template append<unsigned char const*>("metadata", prob.metadata);
 
-        ki.args.append<float>("alpha", *prob.alpha);
-        ki.args.append<float>("beta", *prob.beta);
+        args.template append<float>("alpha", *prob.alpha);
+        args.template append<float>("beta", *prob.beta);
 
         hipsparselt_activation_type act_type
             = string_to_hipsparselt_activation_type(kernel.ActivationType);
@@ -304,31 +312,31 @@ namespace
             if(kernel.ActivationHPA)
             {
                 //same as the alpha/beta type.
-                ki.args.append<float>("activation_0", prob.act_arg0);
-                ki.args.append<float>("activation_1", prob.act_arg1);
+                args.template append<float>("activation_0", prob.act_arg0);
+                args.template append<float>("activation_1", prob.act_arg1);
             }
             else
             {
-                ki.args.append<To>("activation_0", static_cast<To>(prob.act_arg0));
-                ki.args.append<To>("activation_1", static_cast<To>(prob.act_arg1));
+                args.template append<To>("activation_0", static_cast<To>(prob.act_arg0));
+                args.template append<To>("activation_1", static_cast<To>(prob.act_arg1));
             }
-            ki.args.append<uint32_t>("activationType", static_cast<uint32_t>(prob.act_type));
+            args.template append<uint32_t>("activationType", static_cast<uint32_t>(prob.act_type));
         }
 
         size_t startStrideCD = kernel.UseInitialStridesCD ? 0 : 1;
         size_t startStrideAB = kernel.UseInitialStridesAB ? 0 : 1;
 
         for(size_t i = startStrideCD; i < sizes_d.size(); i++)
-            ki.args.append<uint32_t>(concatenate_if<true>("strideD", i), strides_d[i]);
+            args.template append<uint32_t>(concatenate_if<true>("strideD", i), strides_d[i]);
 
         for(size_t i = startStrideCD; i < sizes_c.size(); i++)
-            ki.args.append<uint32_t>(concatenate_if<true>("strideC", i), strides_c[i]);
+            args.template append<uint32_t>(concatenate_if<true>("strideC", i), strides_c[i]);
 
         for(size_t i = startStrideAB; i < sizes_a.size(); i++)
-            ki.args.append<uint32_t>(concatenate_if<true>("strideA", i), strides_a[i]);
+            args.template append<uint32_t>(concatenate_if<true>("strideA", i), strides_a[i]);
 
         for(size_t i = startStrideAB; i < sizes_b.size(); i++)
-            ki.args.append<uint32_t>(concatenate_if<true>("strideB", i), strides_b[i]);
+            args.template append<uint32_t>(concatenate_if<true>("strideB", i), strides_b[i]);
 
         std::vector<size_t> problemSizes;
         problemSizes.resize(0);
@@ -339,7 +347,7 @@ namespace
         int idx = 0;
         for(auto size : problemSizes)
         {
-            ki.args.append<uint32_t>(concatenate_if<true>("size_", idx), size);
+            args.template append<uint32_t>(concatenate_if<true>("size_", idx), size);
             idx++;
         }
 
@@ -365,9 +373,9 @@ namespace
         if(staggerUIter >= 1)
             staggerUIter -= 1;
 
-        ki.args.append<int32_t>("staggerUIter", staggerUIter);
-        ki.args.append<uint32_t>("problemNumGroupTiles0", problemNumGroupTiles0);
-        ki.args.append<uint32_t>("problemNumGroupTiles1", problemNumGroupTiles1);
+        args.template append<int32_t>("staggerUIter", staggerUIter);
+        args.template append<uint32_t>("problemNumGroupTiles0", problemNumGroupTiles0);
+        args.template append<uint32_t>("problemNumGroupTiles1", problemNumGroupTiles1);
 
         uint32_t numFullBlocks            = problemNumGroupTiles1;
         uint32_t wgmRemainder1            = 0;
@@ -387,19 +395,113 @@ namespace
             magicNumberWgmRemainder1 = static_cast<uint32_t>(magicNum);
         }
 
-        ki.args.append<uint32_t>("numFullBlocks", numFullBlocks);
-        ki.args.append<uint32_t>("wgmRemainder1", wgmRemainder1);
-        ki.args.append<uint32_t>("magicNumberWgmRemainder1", magicNumberWgmRemainder1);
+        args.template append<uint32_t>("numFullBlocks", numFullBlocks);
+        args.template append<uint32_t>("wgmRemainder1", wgmRemainder1);
+        args.template append<uint32_t>("magicNumberWgmRemainder1", magicNumberWgmRemainder1);
+
+        args.template append<uint32_t>("offsetD", prob.buffer_offset_b);
+        args.template append<uint32_t>("offsetC", prob.buffer_offset_c);
+        args.template append<uint32_t>("offsetA", prob.buffer_offset_a);
+        args.template append<uint32_t>("offsetB", prob.buffer_offset_b);
 
-        ki.args.append<uint32_t>("offsetD", prob.buffer_offset_b);
-        ki.args.append<uint32_t>("offsetC", prob.buffer_offset_c);
-        ki.args.append<uint32_t>("offsetA", prob.buffer_offset_a);
-        ki.args.append<uint32_t>("offsetB", prob.buffer_offset_b);
+        args.template append<uint32_t>("pad", 0);
+    }
+
+    template <typename Ti, typename To, typename Tc>
+    auto ConstructKernelInvoke(const RocsparseltContractionProblem<Ti, To, Tc>& prob,
+                               const KernelParams&                              kernel)
+    {
+        KernelInvocation ki;
 
-        ki.args.append<uint32_t>("pad", 0);
+        ki.args = KernelArguments();
+
+        ki.args.reserve(1024, 128);
+
+        FillKernelInvocation(prob, kernel, ki, ki.args);
         return ki;
     }
 
+    // Appends kernel arguments to a fixed-offset layout and writes their values
+    struct PackedKernelArgumentsBuilder
+    {
+        KernelArgumentsLayout& layout;
+        PackedKernelArguments& args;
+
+        template <typename T>
+        void append(std::string const& name, T value)
+        {
+            size_t offset = layout.append<T>(name);
+            args.resize(layout.size());
+            args.write(offset, value);
+        }
+    };
+
+    /**************************************************************************
+     * KernelLaunchState is the backend state kept in a plan's launch cache.  *
+     * The invocation and its argument layout are built once; launches copy   *
+     * the packed arguments and only rewrite the pointers and alpha/beta.     *
+     **************************************************************************/
+    template <typename Ti, typename To, typename Tc>
+    struct KernelLaunchState
+    {
+        // Values which change the invocation
+        const KernelParams* kernel;
+        bool                alpha_zero;
+        size_t              m; // may change with each call of a dynamic-M plan
+        size_t              n;
+
+        PackedKernelInvocation invocation;
+
+        size_t offset_d;
+        size_t offset_c;
+        size_t offset_a;
+        size_t offset_b;
+        size_t offset_metadata;
+        size_t offset_alpha;
+        size_t offset_beta;
+
+        KernelLaunchState(const RocsparseltContractionProblem<Ti, To, Tc>& prob,
+                          const KernelParams&                              kernel)
+            : kernel(&kernel)
+            , alpha_zero(*prob.alpha == 0)
+            , m(prob.m)
+            , n(prob.n)
+        {
+            PackedKernelArgumentsBuilder builder{invocation.layout, invocation.args};
+            FillKernelInvocation(prob, kernel, invocation, builder);
+
+            auto const& layout = invocation.layout;
+            offset_d           = layout.offset("d");
+            offset_c           = layout.offset("c");
+            offset_a           = layout.offset("a");
+            offset_b           = layout.offset("b");
+            offset_metadata    = prob.sparseA ? layout.offset("metadata") : 0;
+            offset_alpha       = layout.offset("alpha");
+            offset_beta        = layout.offset("beta");
+        }
+
+        bool matches(const RocsparseltContractionProblem<Ti, To, Tc>& prob,
+                     const KernelParams&                              kernel) const
+        {
+            return this->kernel == &kernel && alpha_zero == (*prob.alpha == 0) && m == prob.m
+                   && n == prob.n;
+        }
+
+        // Rewrite the per-call arguments of a copy of invocation.args
+        void bind(const RocsparseltContractionProblem<Ti, To, Tc>& prob,
+                  PackedKernelArguments&                           args) const
+        {
+            args.write<To const*>(offset_d, prob.D);
+            args.write<To const*>(offset_c, prob.C);
+            args.write<Ti const*>(offset_a, prob.A);
+            args.write<Ti const*>(offset_b, prob.B);
+            if(prob.sparseA)
+                args.write<unsigned char const*>(offset_metadata, prob.metadata);
+            args.write<float>(offset_alpha, *prob.alpha);
+            args.write<float>(offset_beta, *prob.beta);
+        }
+    };
+
     /**************************************************
      * The KernelLauncher struct interfaces           *
      **************************************************/
@@ -520,6 +622,8 @@ namespace
             {
                 if(adapter.loadLibrary(dir) != hipSuccess)
                     no_match = true;
+                else
+                    std::call_once(kernel_library_once, [&] { kernel_library_path = dir; });
             }
             else
                 no_match = true;
@@ -625,12 +729,20 @@ namespace
  ******************************************************************************/
 template <typename Ti, typename To, typename Tc>
 rocsparselt_status runContractionProblem(const RocsparseltContractionProblem<Ti, To, Tc>& prob,
+                                         _rocsparselt_matmul_launch_cache* launch_cache,
                                          int*                                             config_id,
                                          const int config_max_id,
                                          const int search_iterations)
 {
+    using LaunchState = KernelLaunchState<Ti, To, Tc>;
+
     rocsparselt_status status  = rocsparselt_status_internal_error;
     size_t             max_cid = 0;
+
+    auto status_support = checkDeviceSupport(__func__, prob);
+    if(status_support != rocsparselt_status_success)
+        return status_support;
+
     try
     {
         std::shared_ptr<hipDeviceProp_t> deviceProp;
@@ -654,46 +766,76 @@ rocsparselt_status runContractionProblem(const RocsparseltContractionProblem<Ti,
         }
         else
         {
+            auto matchesSplitK = [&](const KernelParams& kernel) {
+                return rocsparselt_split_k_matches(prob.split_k,
+                                                   prob.split_k_mode,
+                                                   kernel.GlobalSplitU,
+                                                   kernel.GlobalAccumulation != 0);
+            };
+
             if(!search_iterations)
             {
+                // Configs do not know their kernel here, so apply the split-K
+                // request by moving to the first kernel which runs it.
+                if(!matchesSplitK(solution[*config_id]))
+                {
+                    auto it = std::find_if(solution, solution + max_cid, matchesSplitK);
+                    if(it == solution + max_cid)
+                    {
+                        hipsparselt_cerr << "No kernel with split-K factor " << prob.split_k
+                                         << " - skip" << std::endl;
+                        return rocsparselt_status_not_implemented;
+                    }
+                    *config_id = it - solution;
+                }
+
+                std::shared_ptr<const LaunchState> state;
+                if(launch_cache)
+                {
+                    std::lock_guard<std::mutex> lock(launch_cache->mutex);
+                    state = std::static_pointer_cast<const LaunchState>(launch_cache->state);
+                }
+
+                if(!state || !state->matches(prob, solution[*config_id]))
+                {
+                    state = std::make_shared<const LaunchState>(prob, solution[*config_id]);
+                    if(launch_cache)
+                    {
+                        std::lock_guard<std::mutex> lock(launch_cache->mutex);
+                        launch_cache->state = state;
+                    }
+                }
+
+                PackedKernelArguments args(state->invocation.args);
+                state->bind(prob, args);
                 RETURN_IF_HIP_ERROR(adapter.launchKernel(
-                    prob.handle,
-                    ConstructKernelInvoke<Ti, To, Tc>(prob, solution[*config_id]),
-                    prob.streams[0],
-                    nullptr,
-                    nullptr));
+                    prob.handle, state->invocation, args, prob.streams[0], nullptr, nullptr));
             }
             else
             {
-                float      min_ms = std::numeric_limits<float>::max();
-                hipEvent_t startEvent, stopEvent;
-                float      ms;
-                RETURN_IF_HIP_ERROR(hipEventCreate(&startEvent));
-                RETURN_IF_HIP_ERROR(hipEventCreate(&stopEvent));
+                std::vector<KernelInvocation> invocations;
+                std::vector<int>              candidates;
                 for(int id = 0; id < max_cid; id++)
                 {
-                    auto ki = ConstructKernelInvoke<Ti, To, Tc>(prob, solution[id]);
-                    //warm up
-                    RETURN_IF_HIP_ERROR(
-                        adapter.launchKernel(prob.handle, ki, prob.streams[0], nullptr, nullptr));
-
-                    RETURN_IF_HIP_ERROR(adapter.launchKernel(prob.handle,
-                                                             ki,
-                                                             prob.streams[0],
-                                                             startEvent,
-                                                             stopEvent,
-                                                             search_iterations));
+                    invocations.push_back(ConstructKernelInvoke<Ti, To, Tc>(prob, solution[id]));
+                    if(matchesSplitK(solution[id]))
+                        candidates.push_back(id);
+                }
+
+                hipEvent_t startEvent = prob.handle->search_start;
+                hipEvent_t stopEvent  = prob.handle->search_stop;
+                auto       sample     = [&](int id, float& ms) -> rocsparselt_status {
+                    RETURN_IF_HIP_ERROR(adapter.launchKernel(
+                        prob.handle, invocations[id], prob.streams[0], startEvent, stopEvent));
                     RETURN_IF_HIP_ERROR(hipEventSynchronize(stopEvent));
                     RETURN_IF_HIP_ERROR(hipEventElapsedTime(&ms, startEvent, stopEvent));
-                    if(ms < min_ms)
-                    {
-                        *config_id = id;
-                        min_ms = ms;
-                    }
+                    return rocsparselt_status_success;
+                };
 
-                }
-                RETURN_IF_HIP_ERROR(hipEventDestroy(startEvent));
-                RETURN_IF_HIP_ERROR(hipEventDestroy(stopEvent));
+                RocsparseltSearchOptions options = prob.handle->search_options;
+                options.iterations               = search_iterations;
+                RETURN_IF_ROCSPARSELT_ERROR(
+                    rocsparselt_make_search_strategy(options)->run(candidates, sample, *config_id));
             }
             status = rocsparselt_status_success;
         }
@@ -746,6 +888,15 @@ extern "C" void rocsparselt_initialize()
     get_adapter();
 }
 
+/******************************************************************************
+ * Path of the loaded kernel library, used to key the tuning database         *
+ ******************************************************************************/
+std::string rocsparselt_internal_get_library_path()
+{
+    get_adapter();
+    return kernel_library_path;
+}
+
 /*******************************************************************************************
  * Whether Kernel Launcher has been initialized for at least one device (used for testing) *
  *******************************************************************************************/
@@ -772,7 +923,11 @@ std::atomic_bool& rocsparselt_internal_kl_is_initialized()
         return str;                                                                    \
     }                                                                                  \
     template rocsparselt_status runContractionProblem<Ti, To, Tc>(                     \
-        const RocsparseltContractionProblem<Ti, To, Tc>&, int*, const int, const int); \
+        const RocsparseltContractionProblem<Ti, To, Tc>&,                              \
+        _rocsparselt_matmul_launch_cache*,                                             \
+        int*,                                                                          \
+        const int,                                                                     \
+        const int);                                                                    \
     template rocsparselt_status initSolutions<Ti, To, Tc>(                             \
         const _rocsparselt_handle*, rocsparselt_operation, rocsparselt_operation, int*);
 
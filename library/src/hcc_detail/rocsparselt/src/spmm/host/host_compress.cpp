@@ -0,0 +1,320 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "host_spmm.hpp"
+#include "definitions.h"
+#include "utility.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__) && !defined(__HIP_DEVICE_COMPILE__)
+#define ROCSPARSELT_HOST_COMPRESS_X86 1
+#endif
+
+namespace
+{
+    // Groups per chunk, sized to keep the per-chunk arrays in L1
+    constexpr int64_t COMPRESS_W = 64;
+
+    /*************************************************************************
+     * CompressArgs describes one line of independent groups. A group is     *
+     * eight dense values along n, which become four compressed values and   *
+     * one metadata byte.                                                    *
+     *                                                                       *
+     * LanesM: the dense and compressed matrices have unit m stride and the  *
+     * groups of a line are consecutive rows. Otherwise both have unit n     *
+     * stride and the groups of a line are consecutive along n. ld, c_ld and *
+     * m_ld are the strides of the other dimension.                          *
+     *************************************************************************/
+    template <typename Ti>
+    struct CompressArgs
+    {
+        const Ti*      in;
+        Ti*            out;
+        unsigned char* metadata;
+        int64_t        lanes;
+        int64_t        ld;
+        int64_t        c_ld;
+        int64_t        m_ld;
+    };
+
+    template <typename Ti>
+    using bits_t = std::conditional_t<sizeof(Ti) == 1, uint8_t, uint16_t>;
+
+    // Dense value k of group l
+    template <bool LanesM>
+    inline int64_t dense_index(int64_t l, int k, int64_t ld)
+    {
+        return LanesM ? l + k * ld : l * 8 + k;
+    }
+
+    // Compressed value s of group l
+    template <bool LanesM>
+    inline int64_t compressed_index(int64_t l, int s, int64_t c_ld)
+    {
+        return LanesM ? l + s * c_ld : l * 4 + s;
+    }
+
+    /*************************************************************************
+     * Each half of a group keeps its first two non-zero values, exactly as   *
+     * compress_kernel does: a lone non-zero in the last position goes to the *
+     * second slot, and empty slots keep zero with the 0xE metadata default.  *
+     * Values move as raw bits. Like the device kernel, -0 counts as zero and *
+     * NaN as non-zero, which for the 16 bit float types is a test of the     *
+     * bits without the sign and for the 8 bit types a test of all bits. The  *
+     * per-lane state makes every step a select, so the lane loops vectorize. *
+     *************************************************************************/
+    template <typename Ti, bool LanesM>
+    inline __attribute__((always_inline)) void compress_impl(const CompressArgs<Ti>& a)
+    {
+        constexpr bits_t<Ti> mask = sizeof(Ti) == 1 ? 0xff : 0x7fff;
+
+        for(int64_t l0 = 0; l0 < a.lanes; l0 += COMPRESS_W)
+        {
+            int64_t    w  = std::min(COMPRESS_W, a.lanes - l0);
+            const Ti*  in = a.in + dense_index<LanesM>(l0, 0, a.ld);
+            bits_t<Ti> dense[8][COMPRESS_W];
+            bits_t<Ti> values[4][COMPRESS_W];
+            uint32_t   md[COMPRESS_W];
+            int        count[COMPRESS_W];
+
+            for(int64_t l = 0; l < w; l++)
+                for(int k = 0; k < 8; k++)
+                    std::memcpy(&dense[k][l], in + dense_index<LanesM>(l, k, a.ld), sizeof(Ti));
+
+            for(int64_t l = 0; l < w; l++)
+            {
+                for(int s = 0; s < 4; s++)
+                    values[s][l] = 0;
+                md[l] = 0xEE;
+            }
+
+            for(int t = 0; t < 2; t++)
+            {
+                for(int64_t l = 0; l < w; l++)
+                    count[l] = 0;
+
+                bits_t<Ti>* first  = values[t * 2];
+                bits_t<Ti>* second = values[t * 2 + 1];
+                for(int k = 0; k < 4; k++)
+                {
+                    const bits_t<Ti>* dense_k = dense[t * 4 + k];
+                    for(int64_t l = 0; l < w; l++)
+                    {
+                        bits_t<Ti> value = dense_k[l];
+                        bool       take  = ((value & mask) != 0) & (count[l] < 2);
+                        int        slot  = (count[l] == 0 && k == 3) ? 1 : count[l];
+                        uint32_t   shift = (slot + t * 2) << 1;
+
+                        first[l]  = (take & (slot == 0)) ? value : first[l];
+                        second[l] = (take & (slot == 1)) ? value : second[l];
+                        md[l]     = take ? (md[l] & ~(0x3u << shift)) | (k << shift) : md[l];
+                        count[l]  = take ? slot + 1 : count[l];
+                    }
+                }
+            }
+
+            Ti*            out      = a.out + compressed_index<LanesM>(l0, 0, a.c_ld);
+            unsigned char* metadata = a.metadata + (LanesM ? l0 * a.m_ld : l0);
+            for(int64_t l = 0; l < w; l++)
+            {
+                for(int s = 0; s < 4; s++)
+                    std::memcpy(
+                        out + compressed_index<LanesM>(l, s, a.c_ld), &values[s][l], sizeof(Ti));
+                metadata[LanesM ? l * a.m_ld : l] = static_cast<unsigned char>(md[l]);
+            }
+        }
+    }
+
+    template <typename Ti, bool LanesM>
+    void compress_generic(const CompressArgs<Ti>& a)
+    {
+        compress_impl<Ti, LanesM>(a);
+    }
+
+#ifdef ROCSPARSELT_HOST_COMPRESS_X86
+    template <typename Ti, bool LanesM>
+    __attribute__((target("avx2,fma,f16c"))) void compress_avx2(const CompressArgs<Ti>& a)
+    {
+        compress_impl<Ti, LanesM>(a);
+    }
+
+    template <typename Ti, bool LanesM>
+    __attribute__((target("avx512f,avx512bw,avx2,fma,f16c"))) void
+        compress_avx512(const CompressArgs<Ti>& a)
+    {
+        compress_impl<Ti, LanesM>(a);
+    }
+#endif
+
+    template <typename Ti, bool LanesM>
+    auto select_compress() -> void (*)(const CompressArgs<Ti>&)
+    {
+#ifdef ROCSPARSELT_HOST_COMPRESS_X86
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+            return compress_avx512<Ti, LanesM>;
+        if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return compress_avx2<Ti, LanesM>;
+#endif
+        return compress_generic<Ti, LanesM>;
+    }
+} // namespace
+
+template <typename Ti>
+rocsparselt_status rocsparselt_smfmac_compress_host(const _rocsparselt_handle* handle,
+                                                    int64_t                    m,
+                                                    int64_t                    n,
+                                                    int64_t                    stride0,
+                                                    int64_t                    stride1,
+                                                    int64_t                    batch_stride,
+                                                    int64_t                    c_stride0,
+                                                    int64_t                    c_stride1,
+                                                    int64_t                    c_batch_stride,
+                                                    int64_t                    m_stride0,
+                                                    int64_t                    m_stride1,
+                                                    int64_t                    m_batch_stride,
+                                                    int                        num_batches,
+                                                    const Ti*                  in,
+                                                    Ti*                        out,
+                                                    unsigned char*             metadata)
+{
+    log_trace(handle, __func__, "host backend");
+
+    // The metadata is row major: one row of n / 8 bytes per m
+    bool lanes_m = stride0 == 1 && c_stride0 == 1;
+    if(!lanes_m && (stride1 != 1 || c_stride1 != 1 || m_stride1 != 1))
+        return rocsparselt_status_not_implemented;
+
+    auto compress = lanes_m ? select_compress<Ti, true>() : select_compress<Ti, false>();
+
+    CompressArgs<Ti> line{};
+    line.lanes = lanes_m ? m : n / 8;
+    line.ld    = lanes_m ? stride1 : stride0;
+    line.c_ld  = lanes_m ? c_stride1 : c_stride0;
+    line.m_ld  = lanes_m ? m_stride0 : m_stride1;
+
+    int64_t lines         = lanes_m ? n / 8 : m;
+    int64_t line_stride   = lanes_m ? 8 * stride1 : stride0;
+    int64_t c_line_stride = lanes_m ? 4 * c_stride1 : c_stride0;
+    int64_t m_line_stride = lanes_m ? m_stride1 : m_stride0;
+
+    int64_t              num_tasks = num_batches * lines;
+    std::atomic<int64_t> next{0};
+
+    return runHostWorkers(hostThreadCount(num_tasks), [&] {
+        for(int64_t task; (task = next++) < num_tasks;)
+        {
+            int64_t batch = task / lines;
+            int64_t i     = task % lines;
+
+            CompressArgs<Ti> args = line;
+            args.in               = in + batch * batch_stride + i * line_stride;
+            args.out              = out + batch * c_batch_stride + i * c_line_stride;
+            args.metadata         = metadata + batch * m_batch_stride + i * m_line_stride;
+            compress(args);
+        }
+    });
+}
+
+rocsparselt_status rocsparselt_smfmac_compress_host_i4(const _rocsparselt_handle* handle,
+                                                       int64_t                    m,
+                                                       int64_t                    n,
+                                                       int64_t                    stride0,
+                                                       int64_t                    stride1,
+                                                       int64_t                    batch_stride,
+                                                       int64_t                    c_stride0,
+                                                       int64_t                    c_stride1,
+                                                       int64_t                    c_batch_stride,
+                                                       int64_t                    m_stride0,
+                                                       int64_t                    m_stride1,
+                                                       int64_t                    m_batch_stride,
+                                                       int                        num_batches,
+                                                       const void*                in,
+                                                       void*                      out,
+                                                       unsigned char*             metadata)
+{
+    int64_t extent = stridedExtent(m, n, stride0, stride1, num_batches, batch_stride);
+    int64_t c_extent
+        = stridedExtent(m, n / 2, c_stride0, c_stride1, num_batches, c_batch_stride);
+    try
+    {
+        std::vector<int8_t> in8(extent), out8(c_extent);
+        unpack_int4(in, extent, in8.data());
+        unpack_int4(out, c_extent, out8.data());
+
+        auto status = rocsparselt_smfmac_compress_host<int8_t>(handle,
+                                                               m,
+                                                               n,
+                                                               stride0,
+                                                               stride1,
+                                                               batch_stride,
+                                                               c_stride0,
+                                                               c_stride1,
+                                                               c_batch_stride,
+                                                               m_stride0,
+                                                               m_stride1,
+                                                               m_batch_stride,
+                                                               num_batches,
+                                                               in8.data(),
+                                                               out8.data(),
+                                                               metadata);
+        if(status == rocsparselt_status_success)
+            pack_int4(out8.data(), c_extent, out);
+        return status;
+    }
+    catch(const std::bad_alloc&)
+    {
+        return rocsparselt_status_memory_error;
+    }
+}
+
+#define GENERATE_DEFINITIONS(Ti)                                      \
+    template rocsparselt_status rocsparselt_smfmac_compress_host<Ti>( \
+        const _rocsparselt_handle*,                                   \
+        int64_t,                                                      \
+        int64_t,                                                      \
+        int64_t,                                                      \
+        int64_t,                                                      \
+        int64_t,                                                      \
+        int64_t,                                                      \
+        int64_t,                                                      \
+        int64_t,                                                      \
+        int64_t,                                                      \
+        int64_t,                                                      \
+        int64_t,                                                      \
+        int,                                                          \
+        const Ti*,                                                    \
+        Ti*,                                                          \
+        unsigned char*);
+
+GENERATE_DEFINITIONS(__half)
+GENERATE_DEFINITIONS(hip_bfloat16)
+GENERATE_DEFINITIONS(int8_t)
+GENERATE_DEFINITIONS(hipsparselt_f8)
+GENERATE_DEFINITIONS(hipsparselt_bf8)
+
+#undef GENERATE_DEFINITIONS
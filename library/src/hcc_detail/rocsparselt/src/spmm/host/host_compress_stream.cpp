@@ -0,0 +1,482 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "host_spmm.hpp"
+#include "definitions.h"
+#include "rocsparselt_spmm_utils.hpp"
+#include "utility.hpp"
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <unistd.h>
+
+namespace
+{
+    // Dense bytes per panel when the caller does not choose
+    constexpr size_t DEFAULT_PANEL_BYTES = size_t(64) << 20;
+
+    /*************************************************************************
+     * The dense matrix is streamed as panels of consecutive lines, where a  *
+     * line is the contiguous run of ld elements along the unit-stride       *
+     * dimension. With unit m stride a line is one k index, eight of them   *
+     * make four compressed lines and one metadata byte per row. Otherwise a *
+     * line is one row of m and maps to one compressed line and one metadata *
+     * row. Panels hold a multiple of eight lines so neither a 2:4 group, a  *
+     * 4x4 prune tile nor a metadata byte is ever split.                     *
+     *************************************************************************/
+    struct StreamLayout
+    {
+        bool    lanes_m;
+        int64_t m;
+        int64_t n;
+        int64_t ld;
+        int64_t c_ld;
+        int64_t m_ld; // metadata bytes per row of m
+        int64_t line_len; // dense elements per line
+        int64_t lines; // dense lines per batch
+        int64_t panel_lines;
+        int     num_batches;
+        int64_t batch_stride;
+        int64_t c_batch_stride;
+        int64_t m_batch_stride;
+        size_t  metadata_offset;
+    };
+
+    template <typename Ti>
+    struct Panel
+    {
+        int                        batch = 0;
+        int64_t                    line0 = 0;
+        int64_t                    count = 0;
+        std::vector<Ti>            dense;
+        std::vector<Ti>            compressed;
+        std::vector<unsigned char> metadata;
+    };
+
+    // Elements and bytes covered by a panel of count lines
+    size_t dense_panel_size(const StreamLayout& s, int64_t count)
+    {
+        return (count - 1) * s.ld + s.line_len;
+    }
+
+    size_t compressed_panel_size(const StreamLayout& s, int64_t count)
+    {
+        return s.lanes_m ? (count / 2 - 1) * s.c_ld + s.m : (count - 1) * s.c_ld + s.n / 2;
+    }
+
+    size_t metadata_panel_size(const StreamLayout& s, int64_t count)
+    {
+        return s.lanes_m ? s.m * (count / 8) : count * s.m_ld;
+    }
+
+    template <typename Ti>
+    rocsparselt_status read_panel(const StreamLayout&        s,
+                                  rocsparselt_stream_read_fn read,
+                                  void*                      user_data,
+                                  Panel<Ti>&                 panel)
+    {
+        size_t offset = (panel.batch * s.batch_stride + panel.line0 * s.ld) * sizeof(Ti);
+        size_t size   = dense_panel_size(s, panel.count) * sizeof(Ti);
+        return read(user_data, offset, size, panel.dense.data()) == 0
+                   ? rocsparselt_status_success
+                   : rocsparselt_status_internal_error;
+    }
+
+    template <typename Ti>
+    rocsparselt_status compress_panel(const _rocsparselt_handle*   handle,
+                                      const StreamLayout&          s,
+                                      const rocsparselt_prune_alg* pruneAlg,
+                                      Panel<Ti>&                   panel)
+    {
+        // The panel is compressed as a matrix of its own, with packed
+        // compressed lines and metadata rows
+        int64_t m       = s.lanes_m ? s.m : panel.count;
+        int64_t n       = s.lanes_m ? panel.count : s.n;
+        int64_t stride0 = s.lanes_m ? 1 : s.ld;
+        int64_t stride1 = s.lanes_m ? s.ld : 1;
+
+        Ti* dense = panel.dense.data();
+        if(pruneAlg)
+        {
+            auto status = rocsparselt_smfmac_prune_host<Ti, float>(
+                handle, m, n, stride0, stride1, 1, 0, dense, dense, *pruneAlg);
+            if(status != rocsparselt_status_success)
+                return status;
+        }
+
+        return rocsparselt_smfmac_compress_host<Ti>(handle,
+                                                    m,
+                                                    n,
+                                                    stride0,
+                                                    stride1,
+                                                    0,
+                                                    s.lanes_m ? 1 : s.c_ld,
+                                                    s.lanes_m ? s.c_ld : 1,
+                                                    0,
+                                                    n / 8,
+                                                    1,
+                                                    0,
+                                                    1,
+                                                    dense,
+                                                    panel.compressed.data(),
+                                                    panel.metadata.data());
+    }
+
+    template <typename Ti>
+    rocsparselt_status write_panel(const StreamLayout&         s,
+                                   rocsparselt_stream_write_fn write,
+                                   void*                       user_data,
+                                   const Panel<Ti>&            panel,
+                                   std::vector<unsigned char>& batch_metadata)
+    {
+        int64_t c_line0  = s.lanes_m ? panel.line0 / 2 : panel.line0;
+        size_t  c_offset = (panel.batch * s.c_batch_stride + c_line0 * s.c_ld) * sizeof(Ti);
+        size_t  c_size   = compressed_panel_size(s, panel.count) * sizeof(Ti);
+        if(write(user_data, c_offset, c_size, panel.compressed.data()) != 0)
+            return rocsparselt_status_internal_error;
+
+        size_t m_base = s.metadata_offset + panel.batch * s.m_batch_stride;
+        if(!s.lanes_m || panel.count == s.lines)
+        {
+            // The metadata rows of the panel are contiguous in the output
+            size_t m_offset = m_base + (s.lanes_m ? 0 : panel.line0 * s.m_ld);
+            size_t m_size   = metadata_panel_size(s, panel.count);
+            return write(user_data, m_offset, m_size, panel.metadata.data()) == 0
+                       ? rocsparselt_status_success
+                       : rocsparselt_status_internal_error;
+        }
+
+        // Otherwise the panel holds a slice of every metadata row. The slices
+        // are gathered in batch_metadata and the rows of the batch, which are
+        // contiguous, are written with the last panel of the batch.
+        int64_t row_bytes = panel.count / 8;
+        for(int64_t i = 0; i < s.m; i++)
+            memcpy(batch_metadata.data() + i * s.m_ld + panel.line0 / 8,
+                   panel.metadata.data() + i * row_bytes,
+                   row_bytes);
+
+        if(panel.line0 + panel.count < s.lines)
+            return rocsparselt_status_success;
+        return write(user_data, m_base, batch_metadata.size(), batch_metadata.data()) == 0
+                   ? rocsparselt_status_success
+                   : rocsparselt_status_internal_error;
+    }
+
+    /*************************************************************************
+     * IoThread runs the reads and writes of compress_stream on one thread   *
+     * that lives for the whole call. post() hands it a job, wait() returns  *
+     * once the job is done.                                                 *
+     *************************************************************************/
+    class IoThread
+    {
+    public:
+        IoThread()
+            : thread([this] { loop(); })
+        {
+        }
+
+        ~IoThread()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stop = true;
+            }
+            cv.notify_all();
+            thread.join();
+        }
+
+        IoThread(const IoThread&) = delete;
+        IoThread& operator=(const IoThread&) = delete;
+
+        void post(std::function<void()> fn)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                job = std::move(fn);
+            }
+            cv.notify_all();
+        }
+
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this] { return !job; });
+        }
+
+    private:
+        void loop()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while(true)
+            {
+                cv.wait(lock, [this] { return stop || job; });
+                if(!job)
+                    return;
+
+                // job stays set while it runs, so that wait() blocks
+                lock.unlock();
+                job();
+                lock.lock();
+                job = nullptr;
+                cv.notify_all();
+            }
+        }
+
+        std::mutex              mutex;
+        std::condition_variable cv;
+        std::function<void()>   job;
+        bool                    stop = false;
+        // Started last, once the members it uses exist
+        std::thread thread;
+    };
+
+    /*************************************************************************
+     * Three-stage pipeline over the panels: while panel i is pruned and     *
+     * compressed on the calling thread (and its workers), the I/O thread    *
+     * writes panel i - 1 and then reads panel i + 1 into the same buffer.   *
+     * Two panel buffers alternate between the stages. When the panels are  *
+     * columns, each holds a slice of every metadata row, and the metadata   *
+     * of a batch is gathered so that it is written in one call.             *
+     *************************************************************************/
+    template <typename Ti>
+    rocsparselt_status compress_stream(const _rocsparselt_handle*   handle,
+                                       StreamLayout                 s,
+                                       size_t                       panelBytes,
+                                       const rocsparselt_prune_alg* pruneAlg,
+                                       rocsparselt_stream_read_fn   read,
+                                       rocsparselt_stream_write_fn  write,
+                                       void*                        user_data)
+    {
+        int64_t panel_lines = panelBytes / (s.ld * sizeof(Ti)) / 8 * 8;
+        s.panel_lines       = std::max<int64_t>(8, std::min(s.lines, panel_lines));
+
+        int64_t panels_per_batch = (s.lines + s.panel_lines - 1) / s.panel_lines;
+        int64_t num_panels       = s.num_batches * panels_per_batch;
+
+        // Buffers are sized for a full panel up front; the I/O thread never allocates
+        Panel<Ti> panels[2];
+        for(auto& panel : panels)
+        {
+            panel.dense.resize(dense_panel_size(s, s.panel_lines));
+            panel.compressed.resize(compressed_panel_size(s, s.panel_lines));
+            panel.metadata.resize(metadata_panel_size(s, s.panel_lines));
+        }
+        std::vector<unsigned char> batch_metadata;
+        if(s.lanes_m && panels_per_batch > 1)
+            batch_metadata.resize(s.m * s.m_ld);
+
+        auto assign = [&](int64_t i, Panel<Ti>& panel) {
+            panel.batch = i / panels_per_batch;
+            panel.line0 = i % panels_per_batch * s.panel_lines;
+            panel.count = std::min(s.panel_lines, s.lines - panel.line0);
+        };
+
+        assign(0, panels[0]);
+        auto status = read_panel(s, read, user_data, panels[0]);
+
+        // Declared after everything its jobs use, so it is joined first
+        auto     read_status  = rocsparselt_status_success;
+        auto     write_status = rocsparselt_status_success;
+        IoThread io;
+
+        for(int64_t i = 0; i < num_panels && status == rocsparselt_status_success; i++)
+        {
+            Panel<Ti>& current = panels[i % 2];
+            Panel<Ti>& other   = panels[(i + 1) % 2];
+
+            // other holds panel i - 1 until it is written, then receives i + 1
+            io.post([&, i] {
+                if(i > 0)
+                    write_status = write_panel(s, write, user_data, other, batch_metadata);
+                if(write_status == rocsparselt_status_success && i + 1 < num_panels)
+                {
+                    assign(i + 1, other);
+                    read_status = read_panel(s, read, user_data, other);
+                }
+            });
+            status = compress_panel(handle, s, pruneAlg, current);
+            io.wait();
+
+            if(status == rocsparselt_status_success)
+                status = write_status != rocsparselt_status_success ? write_status : read_status;
+            if(status == rocsparselt_status_success && i + 1 == num_panels)
+                status = write_panel(s, write, user_data, current, batch_metadata);
+        }
+        return status;
+    }
+
+    struct FileStream
+    {
+        int   dense_fd;
+        off_t dense_offset;
+        int   compressed_fd;
+        off_t compressed_offset;
+    };
+
+    int read_file(void* user_data, size_t offset, size_t size, void* buffer)
+    {
+        auto file = static_cast<const FileStream*>(user_data);
+        auto dst  = static_cast<char*>(buffer);
+        while(size > 0)
+        {
+            ssize_t done = pread(file->dense_fd, dst, size, file->dense_offset + offset);
+            if(done < 0 && errno == EINTR)
+                continue;
+            if(done <= 0)
+                return -1;
+            dst += done;
+            offset += done;
+            size -= done;
+        }
+        return 0;
+    }
+
+    int write_file(void* user_data, size_t offset, size_t size, const void* buffer)
+    {
+        auto file = static_cast<const FileStream*>(user_data);
+        auto src  = static_cast<const char*>(buffer);
+        while(size > 0)
+        {
+            ssize_t done = pwrite(file->compressed_fd, src, size, file->compressed_offset + offset);
+            if(done < 0 && errno == EINTR)
+                continue;
+            if(done <= 0)
+                return -1;
+            src += done;
+            offset += done;
+            size -= done;
+        }
+        return 0;
+    }
+}
+
+rocsparselt_status rocsparselt_smfmac_compress_stream_host(const _rocsparselt_handle*    handle,
+                                                           const _rocsparselt_mat_descr* matrix,
+                                                           int64_t                       m,
+                                                           int64_t                       n,
+                                                           int64_t                       stride0,
+                                                           int64_t                       stride1,
+                                                           const rocsparselt_prune_alg*  pruneAlg,
+                                                           rocsparselt_stream_read_fn    read,
+                                                           rocsparselt_stream_write_fn   write,
+                                                           void*                         user_data,
+                                                           size_t                        panelBytes)
+{
+    log_trace(handle, __func__, "host");
+
+    if(stride0 != 1 && stride1 != 1)
+        return rocsparselt_status_not_implemented;
+
+    StreamLayout s{};
+    s.lanes_m      = stride0 == 1;
+    s.m            = m;
+    s.n            = n;
+    s.ld           = matrix->ld;
+    s.c_ld         = matrix->c_ld;
+    s.m_ld         = matrix->c_k / 4;
+    s.line_len     = s.lanes_m ? m : n;
+    s.lines        = s.lanes_m ? n : m;
+    s.num_batches  = matrix->num_batches;
+    s.batch_stride = matrix->batch_stride;
+    // Only the first batch is stored when the dense matrix is broadcast
+    if(s.batch_stride == 0)
+        s.num_batches = 1;
+    s.c_batch_stride  = matrix->c_ld * matrix->c_n;
+    s.m_batch_stride  = s.c_batch_stride / 4;
+    s.metadata_offset = rocsparselt_metadata_offset_in_compressed_matrix(
+        matrix->c_n, matrix->c_ld, s.num_batches, matrix->type);
+
+    if(panelBytes == 0)
+        panelBytes = DEFAULT_PANEL_BYTES;
+
+#define STREAM_PARAMS handle, s, panelBytes, pruneAlg, read, write, user_data
+
+    try
+    {
+        switch(matrix->type)
+        {
+        case HIP_R_16F:
+            return compress_stream<__half>(STREAM_PARAMS);
+        case HIP_R_16BF:
+            return compress_stream<hip_bfloat16>(STREAM_PARAMS);
+        case HIP_R_8I:
+            return compress_stream<int8_t>(STREAM_PARAMS);
+        case HIP_R_8F_E4M3_FNUZ:
+            return compress_stream<hipsparselt_f8>(STREAM_PARAMS);
+        case HIP_R_8F_E5M2_FNUZ:
+            return compress_stream<hipsparselt_bf8>(STREAM_PARAMS);
+        default:
+            log_error(handle,
+                      "rocsparselt_smfmac_compress_stream",
+                      "datatype",
+                      hipDataType_to_string(matrix->type),
+                      "is not supported");
+            return rocsparselt_status_not_implemented;
+        }
+    }
+    catch(const std::bad_alloc&)
+    {
+        return rocsparselt_status_memory_error;
+    }
+    catch(const std::system_error&)
+    {
+        return rocsparselt_status_memory_error;
+    }
+
+#undef STREAM_PARAMS
+}
+
+rocsparselt_status rocsparselt_smfmac_compress_file_host(const _rocsparselt_handle*    handle,
+                                                         const _rocsparselt_mat_descr* matrix,
+                                                         int64_t                       m,
+                                                         int64_t                       n,
+                                                         int64_t                       stride0,
+                                                         int64_t                       stride1,
+                                                         const rocsparselt_prune_alg*  pruneAlg,
+                                                         int                           denseFd,
+                                                         int64_t                       denseOffset,
+                                                         int                           compressedFd,
+                                                         int64_t compressedOffset,
+                                                         size_t  panelBytes)
+{
+    FileStream file{denseFd, denseOffset, compressedFd, compressedOffset};
+    return rocsparselt_smfmac_compress_stream_host(handle,
+                                                   matrix,
+                                                   m,
+                                                   n,
+                                                   stride0,
+                                                   stride1,
+                                                   pruneAlg,
+                                                   read_file,
+                                                   write_file,
+                                                   &file,
+                                                   panelBytes);
+}
@@ -0,0 +1,548 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "host_spmm.hpp"
+#include "definitions.h"
+#include "rocsparselt_prune_patterns.hpp"
+#include "utility.hpp"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) && !defined(__HIP_DEVICE_COMPILE__)
+#define ROCSPARSELT_HOST_PRUNE_X86 1
+#endif
+
+namespace
+{
+    /*************************************************************************
+     * The host kernels walk the matrix as lines of independent lanes. A lane *
+     * is one 1x4 strip or one 4x4 tile. Either m or n has unit stride, and   *
+     * consecutive lanes follow that dimension, so every lane loop below has  *
+     * compile-time strides and vectorizes across strips or tiles.            *
+     *                                                                        *
+     * LanesM: stride0 == 1, lanes are consecutive rows (or 4-row tiles).     *
+     * Otherwise stride1 == 1, lanes are consecutive strips (or tiles) of a   *
+     * row. ld is the stride of the other dimension.                          *
+     *************************************************************************/
+    template <typename Ti>
+    struct PruneArgs
+    {
+        const Ti* in;
+        Ti*       out;
+        int64_t   lanes;
+        int64_t   ld;
+    };
+
+    // Lanes per chunk. The lane loops run over whole chunks, padded with zero
+    // for the last one, so they have fixed trip counts and vectorize.
+    constexpr int64_t STRIP_W = 64;
+    constexpr int64_t TILE_W  = 16;
+
+    template <typename Ti>
+    using bits_t = std::conditional_t<sizeof(Ti) == 1, uint8_t, uint16_t>;
+
+    // Values are moved as raw bits; the zero written for pruned elements is
+    // static_cast<Ti>(0.0f), which is all zero bits for every input type.
+    template <typename Ti>
+    inline bits_t<Ti> load_bits(const Ti* p)
+    {
+        bits_t<Ti> bits;
+        std::memcpy(&bits, p, sizeof(bits));
+        return bits;
+    }
+
+    template <typename Ti>
+    inline void store_bits(Ti* p, bits_t<Ti> bits)
+    {
+        std::memcpy(p, &bits, sizeof(bits));
+    }
+
+    template <typename Ti>
+    inline float abs_value(const Ti* p)
+    {
+        return std::abs(static_cast<float>(*p));
+    }
+
+    // Element k of strip l
+    template <bool LanesM>
+    inline int64_t strip_index(int64_t l, int k, int64_t ld)
+    {
+        return LanesM ? l + k * ld : l * 4 + k;
+    }
+
+    // Element (x, y) of tile l, x along m and y along n
+    template <bool LanesM>
+    inline int64_t tile_index(int64_t l, int x, int y, int64_t ld)
+    {
+        return LanesM ? l * 4 + x + y * ld : l * 4 + x * ld + y;
+    }
+
+    /*************************************************************************
+     * STRIP keeps the pair of each 1x4 strip with the largest |a| + |b|. The *
+     * pairs are visited in the same order as prune_strip_kernel and only a   *
+     * strictly larger norm replaces the current pair, so ties resolve alike. *
+     *************************************************************************/
+    template <typename Ti, bool LanesM>
+    inline __attribute__((always_inline)) void prune_strip_impl(const PruneArgs<Ti>& a)
+    {
+        for(int64_t l0 = 0; l0 < a.lanes; l0 += STRIP_W)
+        {
+            int64_t   w   = std::min(STRIP_W, a.lanes - l0);
+            const Ti* in  = a.in + strip_index<LanesM>(l0, 0, a.ld);
+            Ti*       out = a.out + strip_index<LanesM>(l0, 0, a.ld);
+            float     v_abs[4][STRIP_W];
+            float     max_norm1[STRIP_W];
+            int       pos_a[STRIP_W], pos_b[STRIP_W];
+
+            for(int64_t l = 0; l < STRIP_W; l++)
+                for(int k = 0; k < 4; k++)
+                    v_abs[k][l] = l < w ? abs_value(in + strip_index<LanesM>(l, k, a.ld)) : 0.f;
+
+            for(int64_t l = 0; l < STRIP_W; l++)
+            {
+                max_norm1[l] = -1.f;
+                pos_a[l]     = 0;
+                pos_b[l]     = 0;
+            }
+
+            for(int p = 0; p < 4; p++)
+                for(int q = p + 1; q < 4; q++)
+                    for(int64_t l = 0; l < STRIP_W; l++)
+                    {
+                        float norm1  = v_abs[p][l] + v_abs[q][l];
+                        bool  update = norm1 > max_norm1[l];
+                        pos_a[l]     = update ? p : pos_a[l];
+                        pos_b[l]     = update ? q : pos_b[l];
+                        max_norm1[l] = update ? norm1 : max_norm1[l];
+                    }
+
+            // Reads the input again instead of keeping it, so in-place pruning works
+            for(int64_t l = 0; l < w; l++)
+                for(int k = 0; k < 4; k++)
+                {
+                    int64_t    idx  = strip_index<LanesM>(l, k, a.ld);
+                    bits_t<Ti> bits = load_bits(in + idx);
+                    store_bits(out + idx, (k != pos_a[l] && k != pos_b[l]) ? 0 : bits);
+                }
+        }
+    }
+
+    /*************************************************************************
+     * TILE keeps the pattern of ROCSPARSELT_PRUNE_TILE_PATTERNS with the     *
+     * largest sum of |values|. prune_tile_kernel spreads the patterns over   *
+     * 32 threads and reduces their maxima in a tree; both steps are replayed *
+     * here, with the same summation order, so ties pick the same pattern.    *
+     *************************************************************************/
+    constexpr uint8_t tile_patterns[] = {ROCSPARSELT_PRUNE_TILE_PATTERNS};
+    constexpr int     TILE_PATTERNS   = ROCSPARSELT_PRUNE_TILE_PATTERNS_COUNT;
+    constexpr int     TILE_THREADS    = 32;
+    constexpr int     TILE_PATTERNS_PER_THREAD
+        = (TILE_PATTERNS + TILE_THREADS - 1) / TILE_THREADS;
+
+    template <typename Ti, bool LanesM>
+    inline __attribute__((always_inline)) void prune_tile_impl(const PruneArgs<Ti>& a)
+    {
+        for(int64_t l0 = 0; l0 < a.lanes; l0 += TILE_W)
+        {
+            int64_t   w   = std::min(TILE_W, a.lanes - l0);
+            const Ti* in  = a.in + tile_index<LanesM>(l0, 0, 0, a.ld);
+            Ti*       out = a.out + tile_index<LanesM>(l0, 0, 0, a.ld);
+            // |value| of element (x, y) is stored at y * 4 + x
+            float v_abs[16][TILE_W];
+            float norm_res[TILE_THREADS][TILE_W];
+            int   norm_idx[TILE_THREADS][TILE_W];
+
+            for(int64_t l = 0; l < TILE_W; l++)
+                for(int e = 0; e < 16; e++)
+                    v_abs[e][l]
+                        = l < w ? abs_value(in + tile_index<LanesM>(l, e % 4, e / 4, a.ld)) : 0.f;
+
+            for(int t = 0; t < TILE_THREADS; t++)
+            {
+                for(int64_t l = 0; l < TILE_W; l++)
+                {
+                    norm_res[t][l] = -1.f;
+                    norm_idx[t][l] = 0;
+                }
+                for(int k = 0; k < TILE_PATTERNS_PER_THREAD; k++)
+                {
+                    int            pattern = std::min(t + k * TILE_THREADS, TILE_PATTERNS - 1);
+                    const uint8_t* p       = &tile_patterns[pattern << 3];
+                    for(int64_t l = 0; l < TILE_W; l++)
+                    {
+                        float norm = v_abs[p[0]][l] + v_abs[p[1]][l] + v_abs[4 + p[2]][l]
+                                     + v_abs[4 + p[3]][l] + v_abs[8 + p[4]][l]
+                                     + v_abs[8 + p[5]][l] + v_abs[12 + p[6]][l]
+                                     + v_abs[12 + p[7]][l];
+                        bool update    = norm_res[t][l] < norm;
+                        norm_res[t][l] = update ? norm : norm_res[t][l];
+                        norm_idx[t][l] = update ? pattern : norm_idx[t][l];
+                    }
+                }
+            }
+
+            for(int stride = TILE_THREADS >> 1; stride > 0; stride >>= 1)
+                for(int t = 0; t < stride; t++)
+                    for(int64_t l = 0; l < TILE_W; l++)
+                    {
+                        bool update    = norm_res[t][l] < norm_res[t + stride][l];
+                        norm_res[t][l] = update ? norm_res[t + stride][l] : norm_res[t][l];
+                        norm_idx[t][l] = update ? norm_idx[t + stride][l] : norm_idx[t][l];
+                    }
+
+            for(int64_t l = 0; l < w; l++)
+            {
+                const uint8_t* p = &tile_patterns[norm_idx[0][l] << 3];
+                for(int e = 0; e < 16; e++)
+                {
+                    int        x    = e % 4, y = e / 4;
+                    int64_t    idx  = tile_index<LanesM>(l, x, y, a.ld);
+                    bits_t<Ti> bits = load_bits(in + idx);
+                    store_bits(out + idx, (p[y * 2] != x && p[y * 2 + 1] != x) ? 0 : bits);
+                }
+            }
+        }
+    }
+
+    /*************************************************************************
+     * Returns true if a strip of the line has more than two non-zero values. *
+     * Like the device kernel, -0 counts as zero and NaN as non-zero, which   *
+     * for the 16 bit float types is a test of the bits without the sign and  *
+     * for the 8 bit types, whose NaN is the bits of -0, a test of all bits.  *
+     *************************************************************************/
+    template <typename Ti, bool LanesM>
+    inline __attribute__((always_inline)) bool prune_check_impl(const PruneArgs<Ti>& a)
+    {
+        constexpr bits_t<Ti> mask = sizeof(Ti) == 1 ? 0xff : 0x7fff;
+
+        for(int64_t l0 = 0; l0 < a.lanes; l0 += STRIP_W)
+        {
+            int64_t   w       = std::min(STRIP_W, a.lanes - l0);
+            const Ti* in      = a.in + strip_index<LanesM>(l0, 0, a.ld);
+            int       invalid = 0;
+            for(int64_t l = 0; l < w; l++)
+            {
+                int nz = 0;
+                for(int k = 0; k < 4; k++)
+                    nz += (load_bits(in + strip_index<LanesM>(l, k, a.ld)) & mask) != 0;
+                invalid |= nz > 2;
+            }
+            if(invalid)
+                return true;
+        }
+        return false;
+    }
+
+    template <typename Ti>
+    struct PruneKernels
+    {
+        void (*strip)(const PruneArgs<Ti>&);
+        void (*tile)(const PruneArgs<Ti>&);
+        bool (*check)(const PruneArgs<Ti>&);
+    };
+
+    template <typename Ti, bool LanesM>
+    void prune_strip_generic(const PruneArgs<Ti>& a)
+    {
+        prune_strip_impl<Ti, LanesM>(a);
+    }
+
+    template <typename Ti, bool LanesM>
+    void prune_tile_generic(const PruneArgs<Ti>& a)
+    {
+        prune_tile_impl<Ti, LanesM>(a);
+    }
+
+    template <typename Ti, bool LanesM>
+    bool prune_check_generic(const PruneArgs<Ti>& a)
+    {
+        return prune_check_impl<Ti, LanesM>(a);
+    }
+
+#ifdef ROCSPARSELT_HOST_PRUNE_X86
+    template <typename Ti, bool LanesM>
+    __attribute__((target("avx2,fma,f16c"))) void prune_strip_avx2(const PruneArgs<Ti>& a)
+    {
+        prune_strip_impl<Ti, LanesM>(a);
+    }
+
+    template <typename Ti, bool LanesM>
+    __attribute__((target("avx2,fma,f16c"))) void prune_tile_avx2(const PruneArgs<Ti>& a)
+    {
+        prune_tile_impl<Ti, LanesM>(a);
+    }
+
+    template <typename Ti, bool LanesM>
+    __attribute__((target("avx2,fma,f16c"))) bool prune_check_avx2(const PruneArgs<Ti>& a)
+    {
+        return prune_check_impl<Ti, LanesM>(a);
+    }
+
+    template <typename Ti, bool LanesM>
+    __attribute__((target("avx512f,avx512bw,avx2,fma,f16c"))) void
+        prune_strip_avx512(const PruneArgs<Ti>& a)
+    {
+        prune_strip_impl<Ti, LanesM>(a);
+    }
+
+    template <typename Ti, bool LanesM>
+    __attribute__((target("avx512f,avx512bw,avx2,fma,f16c"))) void
+        prune_tile_avx512(const PruneArgs<Ti>& a)
+    {
+        prune_tile_impl<Ti, LanesM>(a);
+    }
+
+    template <typename Ti, bool LanesM>
+    __attribute__((target("avx512f,avx512bw,avx2,fma,f16c"))) bool
+        prune_check_avx512(const PruneArgs<Ti>& a)
+    {
+        return prune_check_impl<Ti, LanesM>(a);
+    }
+#endif
+
+    template <typename Ti, bool LanesM>
+    PruneKernels<Ti> select_prune_kernels()
+    {
+#ifdef ROCSPARSELT_HOST_PRUNE_X86
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+            return {prune_strip_avx512<Ti, LanesM>,
+                    prune_tile_avx512<Ti, LanesM>,
+                    prune_check_avx512<Ti, LanesM>};
+        if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return {prune_strip_avx2<Ti, LanesM>,
+                    prune_tile_avx2<Ti, LanesM>,
+                    prune_check_avx2<Ti, LanesM>};
+#endif
+        return {prune_strip_generic<Ti, LanesM>,
+                prune_tile_generic<Ti, LanesM>,
+                prune_check_generic<Ti, LanesM>};
+    }
+
+    /*************************************************************************
+     * LineLayout splits one batch into lines of lanes, where a lane covers   *
+     * group_m rows by 4 columns: 1x4 for STRIP and the check, 4x4 for TILE.  *
+     *************************************************************************/
+    struct LineLayout
+    {
+        bool    lanes_m;
+        int64_t ld;
+        int64_t lines;
+        int64_t line_stride;
+        int64_t lanes;
+    };
+
+    bool line_layout(int64_t     m,
+                     int64_t     n,
+                     int64_t     stride0,
+                     int64_t     stride1,
+                     int64_t     group_m,
+                     LineLayout& layout)
+    {
+        if(stride0 == 1)
+            layout = {true, stride1, n / 4, 4 * stride1, m / group_m};
+        else if(stride1 == 1)
+            layout = {false, stride0, m / group_m, group_m * stride0, n / 4};
+        else
+            return false;
+        return true;
+    }
+
+    // Calls line_fn(offset) for every line of every batch on the host threads
+    template <typename LineFn>
+    rocsparselt_status for_each_line(const LineLayout& layout,
+                                     int               num_batches,
+                                     int64_t           batch_stride,
+                                     const LineFn&     line_fn)
+    {
+        int64_t              num_tasks = num_batches * layout.lines;
+        std::atomic<int64_t> next{0};
+
+        return runHostWorkers(hostThreadCount(num_tasks), [&] {
+            for(int64_t task; (task = next++) < num_tasks;)
+            {
+                int64_t batch = task / layout.lines;
+                int64_t line  = task % layout.lines;
+                line_fn(batch * batch_stride + line * layout.line_stride);
+            }
+        });
+    }
+} // namespace
+
+template <typename Ti, typename Tc>
+rocsparselt_status rocsparselt_smfmac_prune_host(const _rocsparselt_handle* handle,
+                                                 int64_t                    m,
+                                                 int64_t                    n,
+                                                 int64_t                    stride0,
+                                                 int64_t                    stride1,
+                                                 int                        num_batches,
+                                                 int64_t                    batch_stride,
+                                                 const Ti*                  in,
+                                                 Ti*                        out,
+                                                 rocsparselt_prune_alg      pruneAlg)
+{
+    log_trace(handle, __func__, "host backend");
+
+    bool       tile = pruneAlg == rocsparselt_prune_smfmac_tile;
+    LineLayout layout;
+    if((!tile && pruneAlg != rocsparselt_prune_smfmac_strip)
+       || !line_layout(m, n, stride0, stride1, tile ? 4 : 1, layout))
+        return rocsparselt_status_not_implemented;
+
+    PruneKernels<Ti> kernels = layout.lanes_m ? select_prune_kernels<Ti, true>()
+                                              : select_prune_kernels<Ti, false>();
+    auto             kernel  = tile ? kernels.tile : kernels.strip;
+
+    return for_each_line(layout, num_batches, batch_stride, [&](int64_t offset) {
+        kernel({in + offset, out + offset, layout.lanes, layout.ld});
+    });
+}
+
+template <typename Ti>
+rocsparselt_status rocsparselt_smfmac_prune_check_host(const _rocsparselt_handle* handle,
+                                                       int64_t                    m,
+                                                       int64_t                    n,
+                                                       int64_t                    stride0,
+                                                       int64_t                    stride1,
+                                                       int                        num_batches,
+                                                       int64_t                    batch_stride,
+                                                       const Ti*                  in,
+                                                       int*                       out)
+{
+    log_trace(handle, __func__, "host backend");
+
+    LineLayout layout;
+    if(!line_layout(m, n, stride0, stride1, 1, layout))
+        return rocsparselt_status_not_implemented;
+
+    PruneKernels<Ti> kernels = layout.lanes_m ? select_prune_kernels<Ti, true>()
+                                              : select_prune_kernels<Ti, false>();
+    std::atomic<int> invalid{0};
+
+    auto status = for_each_line(layout, num_batches, batch_stride, [&](int64_t offset) {
+        if(!invalid.load(std::memory_order_relaxed)
+           && kernels.check({in + offset, nullptr, layout.lanes, layout.ld}))
+            invalid = 1;
+    });
+
+    *out = invalid;
+    return status;
+}
+
+rocsparselt_status rocsparselt_smfmac_prune_host_i4(const _rocsparselt_handle* handle,
+                                                    int64_t                    m,
+                                                    int64_t                    n,
+                                                    int64_t                    stride0,
+                                                    int64_t                    stride1,
+                                                    int                        num_batches,
+                                                    int64_t                    batch_stride,
+                                                    const void*                in,
+                                                    void*                      out,
+                                                    rocsparselt_prune_alg      pruneAlg)
+{
+    int64_t extent = stridedExtent(m, n, stride0, stride1, num_batches, batch_stride);
+    try
+    {
+        // out is unpacked too, so that the padding between its lines is kept
+        std::vector<int8_t> in8(extent), out8(extent);
+        unpack_int4(in, extent, in8.data());
+        unpack_int4(out, extent, out8.data());
+
+        auto status = rocsparselt_smfmac_prune_host<int8_t, float>(handle,
+                                                                    m,
+                                                                    n,
+                                                                    stride0,
+                                                                    stride1,
+                                                                    num_batches,
+                                                                    batch_stride,
+                                                                    in8.data(),
+                                                                    out8.data(),
+                                                                    pruneAlg);
+        if(status == rocsparselt_status_success)
+            pack_int4(out8.data(), extent, out);
+        return status;
+    }
+    catch(const std::bad_alloc&)
+    {
+        return rocsparselt_status_memory_error;
+    }
+}
+
+rocsparselt_status rocsparselt_smfmac_prune_check_host_i4(const _rocsparselt_handle* handle,
+                                                          int64_t                    m,
+                                                          int64_t                    n,
+                                                          int64_t                    stride0,
+                                                          int64_t                    stride1,
+                                                          int                        num_batches,
+                                                          int64_t                    batch_stride,
+                                                          const void*                in,
+                                                          int*                       out)
+{
+    int64_t extent = stridedExtent(m, n, stride0, stride1, num_batches, batch_stride);
+    try
+    {
+        std::vector<int8_t> in8(extent);
+        unpack_int4(in, extent, in8.data());
+        return rocsparselt_smfmac_prune_check_host<int8_t>(
+            handle, m, n, stride0, stride1, num_batches, batch_stride, in8.data(), out);
+    }
+    catch(const std::bad_alloc&)
+    {
+        return rocsparselt_status_memory_error;
+    }
+}
+
+#define GENERATE_DEFINITIONS(Ti, Tc)                                       \
+    template rocsparselt_status rocsparselt_smfmac_prune_host<Ti, Tc>(     \
+        const _rocsparselt_handle*,                                        \
+        int64_t,                                                           \
+        int64_t,                                                           \
+        int64_t,                                                           \
+        int64_t,                                                           \
+        int,                                                               \
+        int64_t,                                                           \
+        const Ti*,                                                         \
+        Ti*,                                                               \
+        rocsparselt_prune_alg);                                            \
+    template rocsparselt_status rocsparselt_smfmac_prune_check_host<Ti>(   \
+        const _rocsparselt_handle*,                                        \
+        int64_t,                                                           \
+        int64_t,                                                           \
+        int64_t,                                                           \
+        int64_t,                                                           \
+        int,                                                               \
+        int64_t,                                                           \
+        const Ti*,                                                         \
+        int*);
+
+GENERATE_DEFINITIONS(__half, float)
+GENERATE_DEFINITIONS(hip_bfloat16, float)
+GENERATE_DEFINITIONS(int8_t, float)
+GENERATE_DEFINITIONS(hipsparselt_f8, float)
+GENERATE_DEFINITIONS(hipsparselt_bf8, float)
+
+#undef GENERATE_DEFINITIONS
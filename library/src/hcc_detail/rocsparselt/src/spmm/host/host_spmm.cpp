@@ -0,0 +1,1009 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "host_spmm.hpp"
+#include "definitions.h"
+#include "hipsparselt_ostream.hpp"
+#include "hipsparselt_quantize.hpp"
+#include "utility.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+
+#if defined(__x86_64__) && !defined(__HIP_DEVICE_COMPILE__)
+#define ROCSPARSELT_HOST_SPMM_X86 1
+#endif
+
+namespace
+{
+    // Sparse rows per micro tile
+    constexpr int64_t MR = 4;
+    // Output columns per micro tile, one AVX-512 or two AVX2 registers of float
+    constexpr int64_t NR = 16;
+    // Dense K per block, a multiple of the 8 wide groups described by a metadata byte
+    constexpr int64_t KC = 256;
+    // Output columns per packed panel, a multiple of NR
+    constexpr int64_t NC = 256;
+    // Sparse rows per task, halved while there are fewer tasks than threads
+    constexpr int64_t RC = 64;
+
+    /*************************************************************************
+     * How a problem of rows x cols outputs per batch and depth k is cut into *
+     * output tiles of row_chunk x NC and K slices, and the bytes of the     *
+     * split-K buffers that the workspace holds.                             *
+     *************************************************************************/
+    struct HostSpmmSplit
+    {
+        // A grouped problem only splits K when its plan asks for it
+        HostSpmmSplit(int64_t                  rows,
+                      int64_t                  cols,
+                      int64_t                  k,
+                      int64_t                  batch_count,
+                      int                      split_k,
+                      rocsparselt_split_k_mode split_k_mode,
+                      int                      split_k_buffers,
+                      bool                     grouped)
+        {
+            auto tiles_of = [&](int64_t chunk) {
+                return batch_count * ((rows + chunk - 1) / chunk) * ((cols + NC - 1) / NC);
+            };
+            row_chunk = RC;
+            while(row_chunk > MR && tiles_of(row_chunk) < hostThreadLimit())
+                row_chunk /= 2;
+            tiles = tiles_of(row_chunk);
+
+            // Without a split-K request, split K while there are fewer output
+            // tiles than threads, which is the case of small M * N.
+            splits = split_k;
+            if(splits < 1 && grouped)
+                splits = 1;
+            else if(splits < 1)
+                splits = tiles > 0 && tiles < hostThreadLimit()
+                             ? (hostThreadLimit() + tiles - 1) / tiles
+                             : 1;
+            // K slices are whole metadata groups of 8
+            slice_k = k > 0 ? ((k + splits - 1) / splits + 7) / 8 * 8 : 0;
+            splits  = std::max<int64_t>(1, slice_k > 0 ? (k + slice_k - 1) / slice_k : 1);
+
+            // The partial results of slice s are summed into lane s % lanes. Lane 0
+            // takes the place of D, the others are the split-K buffers.
+            lanes = splits;
+            if(split_k_buffers > 0)
+                lanes = std::min<int64_t>(splits, split_k_buffers + 1);
+
+            // One kernel mode sums all slices of a tile in one buffer
+            if(splits > 1)
+                workspace_size = sizeof(float) * tiles * row_chunk * NC
+                                 * (split_k_mode == rocsparselt_splik_k_mode_one_kernel ? 1 : lanes);
+        }
+
+        int64_t row_chunk;
+        int64_t tiles;
+        int64_t splits; // K slices
+        int64_t slice_k; // dense K per slice, a multiple of 8
+        int64_t lanes; // partial result buffers of a tile when splitting K
+        size_t  workspace_size = 0;
+    };
+} // namespace
+
+/*******************************************************************************
+ * Per-thread buffers of the host kernel, sized for tiles of up to row_chunk
+ * sparse rows.
+ ******************************************************************************/
+struct HostSpmmScratch
+{
+    explicit HostSpmmScratch(int64_t row_chunk = RC)
+        : panel(KC * NC)
+        , vals(MR * (KC / 2))
+        , offs(MR * (KC / 2))
+        , acc(row_chunk * NC)
+    {
+    }
+    std::vector<float>   panel;
+    std::vector<float>   vals;
+    std::vector<int64_t> offs;
+    std::vector<float>   acc;
+};
+
+namespace
+{
+
+    /*************************************************************************
+     * RowBlockArgs describes MR sparse rows of one K block. vals holds their *
+     * kept values and offs the offset of the dense panel row each value is   *
+     * multiplied with, both with a leading dimension of KC / 2.              *
+     *************************************************************************/
+    struct RowBlockArgs
+    {
+        const float*   vals;
+        const int64_t* offs;
+        int64_t        kc; // kept values per row in this K block
+        const float*   panel;
+        int64_t        ldp; // leading dimension of panel and acc, a multiple of NR
+        float*         acc; // MR x ldp accumulators
+    };
+
+    // Fixed trip counts let the compiler keep c in registers and vectorize
+    // the j loop for the target of the function it is inlined into.
+    inline __attribute__((always_inline)) void row_block_impl(const RowBlockArgs& a)
+    {
+        for(int64_t c0 = 0; c0 < a.ldp; c0 += NR)
+        {
+            float c[MR][NR];
+            for(int64_t r = 0; r < MR; r++)
+                for(int64_t j = 0; j < NR; j++)
+                    c[r][j] = a.acc[r * a.ldp + c0 + j];
+
+            for(int64_t t = 0; t < a.kc; t++)
+            {
+                for(int64_t r = 0; r < MR; r++)
+                {
+                    const float  s = a.vals[r * (KC / 2) + t];
+                    const float* x = a.panel + a.offs[r * (KC / 2) + t] + c0;
+                    for(int64_t j = 0; j < NR; j++)
+                        c[r][j] += s * x[j];
+                }
+            }
+
+            for(int64_t r = 0; r < MR; r++)
+                for(int64_t j = 0; j < NR; j++)
+                    a.acc[r * a.ldp + c0 + j] = c[r][j];
+        }
+    }
+
+    void row_block_generic(const RowBlockArgs& a)
+    {
+        row_block_impl(a);
+    }
+
+#ifdef ROCSPARSELT_HOST_SPMM_X86
+    __attribute__((target("avx2,fma"))) void row_block_avx2(const RowBlockArgs& a)
+    {
+        row_block_impl(a);
+    }
+
+    __attribute__((target("avx512f,avx2,fma"))) void row_block_avx512(const RowBlockArgs& a)
+    {
+        row_block_impl(a);
+    }
+#endif
+
+    using row_block_fn = void (*)(const RowBlockArgs&);
+
+    row_block_fn select_row_block()
+    {
+#ifdef ROCSPARSELT_HOST_SPMM_X86
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f"))
+            return row_block_avx512;
+        if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return row_block_avx2;
+#endif
+        return row_block_generic;
+    }
+
+    template <typename T>
+    inline float to_float(T value)
+    {
+        return static_cast<float>(value);
+    }
+
+    // 8 bit floats decode through a table of all 256 values
+    template <int Mantissa>
+    inline float to_float(hipsparselt_float8<Mantissa> value)
+    {
+        static const std::array<float, 256> table = [] {
+            std::array<float, 256> t;
+            for(int i = 0; i < 256; i++)
+                t[i] = hipsparselt_float8<Mantissa>::decode(uint8_t(i));
+            return t;
+        }();
+        return table[value.data];
+    }
+
+    template <typename To>
+    inline To from_float(float value)
+    {
+        return static_cast<To>(value);
+    }
+
+    template <>
+    inline int8_t from_float<int8_t>(float value)
+    {
+        value = std::nearbyint(value);
+        return static_cast<int8_t>(std::min(127.f, std::max(-128.f, value)));
+    }
+
+    // Raises *amax to |v| with a compare and swap of the bits, which order
+    // non-negative floats like their values. NaN propagates.
+    inline void raise_amax(float* amax, float v)
+    {
+        v = std::fabs(v);
+        uint32_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        uint32_t* p   = reinterpret_cast<uint32_t*>(amax);
+        uint32_t  cur = __atomic_load_n(p, __ATOMIC_RELAXED);
+        while(cur < bits
+              && !__atomic_compare_exchange_n(
+                  p, &cur, bits, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            ;
+    }
+
+    // Adds v to *sum with a compare and swap, so the order of the additions,
+    // and with it the rounding of the sum, varies from run to run.
+    inline void atomic_add(float* sum, float v)
+    {
+        float cur, next;
+        __atomic_load(sum, &cur, __ATOMIC_RELAXED);
+        do
+            next = cur + v;
+        while(!__atomic_compare_exchange(
+            sum, &cur, &next, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+    }
+
+    inline float load_bias(const void* bias, hipDataType type, int64_t i)
+    {
+        switch(type)
+        {
+        case HIP_R_16F:
+            return to_float(static_cast<const __half*>(bias)[i]);
+        case HIP_R_16BF:
+            return to_float(static_cast<const hip_bfloat16*>(bias)[i]);
+        default:
+            return static_cast<const float*>(bias)[i];
+        }
+    }
+
+    inline float activation(float v, hipsparselt_activation_type type, float arg0, float arg1)
+    {
+        switch(type)
+        {
+        case hipsparselt_activation_type::abs:
+            return std::abs(v);
+        case hipsparselt_activation_type::clippedrelu:
+            return v > arg0 ? std::min(v, arg1) : 0.f;
+        case hipsparselt_activation_type::gelu:
+        {
+            constexpr float k0 = 0.7978845608028654f;
+            constexpr float k1 = 0.044715f;
+            return arg0 * 0.5f * (v * (1.f + std::tanh(k0 * (v * (1.f + k1 * (v * v))))));
+        }
+        case hipsparselt_activation_type::leakyrelu:
+            return v > 0.f ? v : v * arg0;
+        case hipsparselt_activation_type::relu:
+            return std::max(v, 0.f);
+        case hipsparselt_activation_type::sigmoid:
+            return 1.f / (1.f + std::exp(-v));
+        case hipsparselt_activation_type::tanh:
+            return std::tanh(v * arg0) * arg1;
+        case hipsparselt_activation_type::silu:
+            return v / (1.f + std::exp(-arg0 * v));
+        case hipsparselt_activation_type::hardswish:
+            return v * std::min(std::max(v + 3.f, 0.f), 6.f) / 6.f;
+        default:
+            return v;
+        }
+    }
+
+    /******************************************************************************
+     * HostSpmm views the problem as out(r, c) = sum_k S(r, k) * X(k, c), where S   *
+     * is the compressed operand with k / 2 kept values per row and X is the dense *
+     * operand. out(r, c) is D(r, c) when A is sparse and D(c, r) when B is sparse. *
+     ******************************************************************************/
+    template <typename Ti, typename To, typename Tc>
+    class HostSpmm
+    {
+    public:
+        // A grouped problem only splits K when its plan asks for it
+        explicit HostSpmm(const RocsparseltContractionProblem<Ti, To, Tc>& prob,
+                          bool                                             grouped = false)
+            : prob(prob)
+            , k(prob.k)
+            , md_row_stride(prob.k / 8)
+            , row_block(select_row_block())
+            , scale((prob.scale_a ? *prob.scale_a : 1.f) * (prob.scale_b ? *prob.scale_b : 1.f))
+        {
+            // Compressed element t of a row is addressed like column t of an
+            // operand with K / 2 columns.
+            int64_t rs_a = prob.row_stride_a, cs_a = prob.col_stride_a;
+            int64_t rs_b = prob.row_stride_b, cs_b = prob.col_stride_b;
+            bool    ta   = prob.trans_a == rocsparselt_operation_transpose;
+            bool    tb   = prob.trans_b == rocsparselt_operation_transpose;
+            if(prob.sparseA)
+            {
+                rows           = prob.m;
+                cols           = prob.n;
+                s_row_stride   = ta ? cs_a : rs_a;
+                s_t_stride     = ta ? rs_a : cs_a;
+                s_batch_stride = prob.batch_stride_a;
+                x_k_stride     = tb ? cs_b : rs_b;
+                x_c_stride     = tb ? rs_b : cs_b;
+                x_batch_stride = prob.batch_stride_b;
+            }
+            else
+            {
+                rows           = prob.n;
+                cols           = prob.m;
+                s_row_stride   = tb ? rs_b : cs_b;
+                s_t_stride     = tb ? cs_b : rs_b;
+                s_batch_stride = prob.batch_stride_b;
+                x_k_stride     = ta ? rs_a : cs_a;
+                x_c_stride     = ta ? cs_a : rs_a;
+                x_batch_stride = prob.batch_stride_a;
+            }
+
+            // The alpha and bias vectors follow the rows of the user's D, which
+            // are the columns of the problem when D is row major.
+            bool d_rows = prob.order != rocsparselt_order_row;
+            vec_by_r    = prob.sparseA == d_rows;
+            rows_d      = vec_by_r ? rows : cols;
+
+            // The tiles raise the absolute maxima of the rows of D from zero
+            if(prob.amax_d)
+                std::fill(prob.amax_d, prob.amax_d + prob.batch_count * rows_d, 0.f);
+
+            // and the sums of the bias gradient from zero. Sums over the user's rows
+            // are sums over the rows of the problem when the vectors follow them.
+            grad_by_r = (prob.bias_grad_mode == rocsparselt_bias_gradient_rows) == vec_by_r;
+            grad_len  = grad_by_r ? rows : cols;
+            if(prob.bias_grad)
+                std::fill(prob.bias_grad, prob.bias_grad + prob.batch_count * grad_len, 0.f);
+
+            // Weight-only quantized weights share a scale and zero point per group
+            // of weight_group_k along K
+            weight_group_k = prob.weight_group > 0 ? prob.weight_group : std::max<int64_t>(k, 1);
+            weight_groups  = (k + weight_group_k - 1) / weight_group_k;
+
+            HostSpmmSplit split(rows,
+                                cols,
+                                k,
+                                prob.batch_count,
+                                prob.split_k,
+                                prob.split_k_mode,
+                                prob.split_k_buffers,
+                                grouped);
+            row_chunk       = split.row_chunk;
+            splits          = split.splits;
+            slice_k         = split.slice_k;
+            lanes           = split.lanes;
+            split_k_buffers = static_cast<float*>(prob.workspace);
+            if(prob.workspace == nullptr || prob.workspaceSize < split.workspace_size)
+                split_k_buffers = nullptr;
+        }
+
+        rocsparselt_status run() const
+        {
+            if(splits == 1)
+            {
+                std::atomic<int64_t> next{0};
+                return runHostWorkers(hostThreadCount(num_tiles()), [&] {
+                    HostSpmmScratch ws(row_chunk);
+                    for(int64_t tile; (tile = next++) < num_tiles();)
+                        run_tile(tile, ws);
+                });
+            }
+
+            // The split-K buffers are the workspace, see getHostSpmmWorkspaceSize()
+            if(split_k_buffers == nullptr)
+            {
+                log_error(prob.handle, __func__, "the workspace cannot hold the split-K buffers");
+                return rocsparselt_status_invalid_value;
+            }
+
+            try
+            {
+                if(prob.split_k_mode == rocsparselt_splik_k_mode_one_kernel)
+                    return run_split_one_kernel();
+                return run_split_two_kernels();
+            }
+            catch(const std::bad_alloc&)
+            {
+                log_error(prob.handle, __func__, "cannot allocate the split-K locks");
+                return rocsparselt_status_memory_error;
+            }
+        }
+
+        // Computes and writes one output tile without splitting K. ws must hold
+        // tiles of row_chunk rows.
+        void run_tile(int64_t tile, HostSpmmScratch& ws) const
+        {
+            std::fill(ws.acc.begin(), ws.acc.begin() + tile_size(), 0.f);
+            accumulate(tile, 0, k, ws, ws.acc.data());
+            epilogue(tile, ws.acc.data());
+        }
+
+        // Output tiles that run_tile() can compute, 0 when K is split
+        int64_t pooled_tiles() const
+        {
+            return splits == 1 ? num_tiles() : 0;
+        }
+
+        int64_t tile_cost() const
+        {
+            return row_chunk * NC * (k / 2);
+        }
+
+    private:
+        int64_t row_tasks() const
+        {
+            return (rows + row_chunk - 1) / row_chunk;
+        }
+
+        int64_t col_tasks() const
+        {
+            return (cols + NC - 1) / NC;
+        }
+
+        int64_t num_tiles() const
+        {
+            return static_cast<int64_t>(prob.batch_count) * row_tasks() * col_tasks();
+        }
+
+        // Accumulators of a tile, row_chunk rows with a leading dimension of ldp
+        int64_t tile_size() const
+        {
+            return row_chunk * NC;
+        }
+
+        struct Tile
+        {
+            int64_t batch;
+            int64_t r0;
+            int64_t r1;
+            int64_t c0;
+            int64_t width;
+            int64_t ldp;
+        };
+
+        Tile get_tile(int64_t tile) const
+        {
+            Tile t;
+            t.batch = tile / (row_tasks() * col_tasks());
+            t.r0    = (tile / col_tasks()) % row_tasks() * row_chunk;
+            t.c0    = tile % col_tasks() * NC;
+            t.r1    = std::min(rows, t.r0 + row_chunk);
+            t.width = std::min(cols, t.c0 + NC) - t.c0;
+            t.ldp   = (t.width + NR - 1) / NR * NR;
+            return t;
+        }
+
+        /*************************************************************************
+         * Split-K with one pass: each task computes one K slice of a tile and    *
+         * adds it to the tile accumulators under a lock. The task that adds the *
+         * last slice writes D, so the summation order varies between runs.      *
+         *************************************************************************/
+        rocsparselt_status run_split_one_kernel() const
+        {
+            float*                  acc = split_k_buffers;
+            std::vector<std::mutex> locks(num_tiles());
+            std::vector<int64_t>    added(num_tiles(), 0);
+            std::atomic<int64_t>    next{0};
+
+            return runHostWorkers(hostThreadCount(num_tiles() * splits), [&] {
+                HostSpmmScratch ws(row_chunk);
+                for(int64_t task; (task = next++) < num_tiles() * splits;)
+                {
+                    int64_t tile = task / splits;
+                    int64_t k0   = task % splits * slice_k;
+
+                    std::fill(ws.acc.begin(), ws.acc.end(), 0.f);
+                    accumulate(tile, k0, std::min(k, k0 + slice_k), ws, ws.acc.data());
+
+                    float* sum  = acc + tile * tile_size();
+                    bool   last = false;
+                    {
+                        // the first slice of a tile overwrites what the workspace held
+                        std::lock_guard<std::mutex> lock(locks[tile]);
+                        if(added[tile] == 0)
+                            std::copy(ws.acc.begin(), ws.acc.begin() + tile_size(), sum);
+                        else
+                            for(int64_t i = 0; i < tile_size(); i++)
+                                sum[i] += ws.acc[i];
+                        last = ++added[tile] == splits;
+                    }
+                    if(last)
+                        epilogue(tile, sum);
+                }
+            });
+        }
+
+        /*************************************************************************
+         * Split-K with two passes: the first accumulates the K slices of every   *
+         * lane of a tile in a buffer of its own, the second sums the lanes in a *
+         * fixed order and writes D, so results are reproducible.                *
+         *************************************************************************/
+        rocsparselt_status run_split_two_kernels() const
+        {
+            float* acc = split_k_buffers;
+
+            std::atomic<int64_t> next{0};
+            rocsparselt_status   status = runHostWorkers(hostThreadCount(num_tiles() * lanes), [&] {
+                HostSpmmScratch ws(row_chunk);
+                for(int64_t task; (task = next++) < num_tiles() * lanes;)
+                {
+                    int64_t tile = task / lanes;
+                    float*  buf  = acc + task * tile_size();
+                    std::fill(buf, buf + tile_size(), 0.f);
+                    for(int64_t s = task % lanes; s < splits; s += lanes)
+                        accumulate(tile, s * slice_k, std::min(k, (s + 1) * slice_k), ws, buf);
+                }
+            });
+            if(status != rocsparselt_status_success)
+                return status;
+
+            next = 0;
+            return runHostWorkers(hostThreadCount(num_tiles()), [&] {
+                for(int64_t tile; (tile = next++) < num_tiles();)
+                {
+                    float* sum = acc + tile * lanes * tile_size();
+                    for(int64_t lane = 1; lane < lanes; lane++)
+                    {
+                        const float* buf = sum + lane * tile_size();
+                        for(int64_t i = 0; i < tile_size(); i++)
+                            sum[i] += buf[i];
+                    }
+                    epilogue(tile, sum);
+                }
+            });
+        }
+
+        // Adds the products of dense K range [k0, k1) of a tile to acc
+        void accumulate(
+            int64_t tile, int64_t k0, int64_t k1, HostSpmmScratch& ws, float* acc) const
+        {
+            Tile    t     = get_tile(tile);
+            int64_t batch = t.batch, r0 = t.r0, r1 = t.r1, c0 = t.c0;
+            int64_t width = t.width, ldp = t.ldp;
+
+            const Ti*            S  = sparse_values() + batch * s_batch_stride;
+            const unsigned char* md = prob.metadata + batch * (s_batch_stride / 4);
+            const Ti*            X  = dense_values(batch);
+
+            for(int64_t kb = k0; kb < k1; kb += KC)
+            {
+                int64_t kc = std::min(KC, k1 - kb);
+
+                // Pack the dense operand, zero padded to a multiple of NR columns
+                for(int64_t kk = 0; kk < kc; kk++)
+                {
+                    float*    p = ws.panel.data() + kk * ldp;
+                    const Ti* x = X + (kb + kk) * x_k_stride + c0 * x_c_stride;
+                    for(int64_t c = 0; c < width; c++)
+                        p[c] = to_float(x[c * x_c_stride]);
+                    std::fill(p + width, p + ldp, 0.f);
+                }
+
+                for(int64_t rr = r0; rr < r1; rr += MR)
+                {
+                    // Decode the kept values of MR rows and the panel rows they select
+                    for(int64_t q = 0; q < MR; q++)
+                    {
+                        float*   vals = ws.vals.data() + q * (KC / 2);
+                        int64_t* offs = ws.offs.data() + q * (KC / 2);
+                        int64_t  r    = rr + q;
+                        if(r >= r1)
+                        {
+                            std::fill(vals, vals + kc / 2, 0.f);
+                            std::fill(offs, offs + kc / 2, 0);
+                            continue;
+                        }
+
+                        const unsigned char* m = md + r * md_row_stride + kb / 8;
+                        for(int64_t g = 0; g < kc / 8; g++)
+                        {
+                            for(int64_t slot = 0; slot < 4; slot++)
+                            {
+                                int64_t t  = g * 4 + slot;
+                                int64_t kk = g * 8 + (slot >> 1) * 4 + ((m[g] >> (slot << 1)) & 0x3);
+                                offs[t]    = kk * ldp;
+                            }
+                        }
+
+                        if(prob.weight_bits)
+                            dequantize(batch, r, kb, kc, vals);
+                        else
+                        {
+                            const Ti* s = S + r * s_row_stride + (kb / 2) * s_t_stride;
+                            for(int64_t t = 0; t < kc / 2; t++)
+                                vals[t] = to_float(s[t * s_t_stride]);
+                        }
+                    }
+
+                    row_block({ws.vals.data(),
+                               ws.offs.data(),
+                               kc / 2,
+                               ws.panel.data(),
+                               ldp,
+                               acc + (rr - r0) * ldp});
+                }
+            }
+        }
+
+        /*************************************************************************
+         * Dequantizes the kc / 2 kept weights of row r from dense K kb on to     *
+         * scale * (q - zero) of their K group. A q of 0 is a pruned weight, or   *
+         * the padding of a group with fewer than two, and stays 0. The weights   *
+         * are int8 or packed int4 elements, addressed like Ti values would be,   *
+         * and kb starts a metadata group, so kept value t comes from dense K     *
+         * kb + t / 4 * 8 on.                                                     *
+         *************************************************************************/
+        void dequantize(int64_t batch, int64_t r, int64_t kb, int64_t kc, float* vals) const
+        {
+            const void* W = prob.sparseA ? static_cast<const void*>(prob.A)
+                                         : static_cast<const void*>(prob.B);
+            int64_t     e = (prob.sparseA ? prob.buffer_offset_a : prob.buffer_offset_b)
+                        + batch * s_batch_stride + r * s_row_stride + (kb / 2) * s_t_stride;
+
+            // A structured matrix broadcast to all batches has the scales of one batch
+            int64_t      row     = (s_batch_stride ? batch * rows : 0) + r;
+            const float* w_scale = prob.weight_scale + row * weight_groups;
+            const float* w_zero
+                = prob.weight_zero ? prob.weight_zero + row * weight_groups : nullptr;
+
+            for(int64_t t = 0; t < kc / 2; t++, e += s_t_stride)
+            {
+                float   q = prob.weight_bits == 4 ? load_int4(W, e)
+                                                  : static_cast<const int8_t*>(W)[e];
+                int64_t g = (kb + t / 4 * 8) / weight_group_k;
+                vals[t]   = q != 0.f ? w_scale[g] * (q - (w_zero ? w_zero[g] : 0.f)) : 0.f;
+            }
+        }
+
+        void epilogue(int64_t tile, const float* acc) const
+        {
+            Tile    t     = get_tile(tile);
+            int64_t batch = t.batch, r0 = t.r0, r1 = t.r1, c0 = t.c0;
+            int64_t width = t.width, ldp = t.ldp;
+
+            const To* C = prob.batch_C ? prob.batch_C[batch] : prob.C + batch * prob.batch_stride_c;
+            To*       D = prob.batch_D ? prob.batch_D[batch] : prob.D + batch * prob.batch_stride_d;
+            C += prob.buffer_offset_c;
+            D += prob.buffer_offset_d;
+
+            // The residual has the layout of C
+            const To* R = prob.batch_residual ? prob.batch_residual[batch]
+                          : prob.residual     ? prob.residual + batch * prob.batch_stride_c
+                                              : nullptr;
+            if(R)
+                R += prob.buffer_offset_c;
+
+            // Bias gradient sums of the tile, added to the vector once per row or column
+            float*                 grad = prob.bias_grad ? prob.bias_grad + batch * grad_len
+                                                         : nullptr;
+            std::array<float, NC> col_grad{};
+
+            const void* bias = prob.bias_vector == nullptr
+                                   ? nullptr
+                                   : static_cast<const char*>(prob.bias_vector)
+                                         + batch * prob.bias_stride
+                                               * (prob.bias_type == HIP_R_32F ? 4 : 2);
+
+            // alpha * A * B + c_v + bias of problem row r, before the activation
+            auto product = [&](int64_t r, int64_t c, float c_v) {
+                int64_t u     = vec_by_r ? r : c;
+                float   alpha = static_cast<float>(prob.alpha_vector_scaling ? prob.alpha[u]
+                                                                             : *prob.alpha);
+                float   v     = alpha * scale * acc[(r - r0) * ldp + (c - c0)] + c_v;
+                if(bias)
+                    v += load_bias(bias, prob.bias_type, u);
+                return v;
+            };
+
+            // A gated epilogue writes row r / 2 of the output, from the gate in
+            // even row r and the up projection in row r + 1. C is added to the
+            // gated result.
+            int64_t step = prob.gated ? 2 : 1;
+            for(int64_t r = r0; r < r1; r += step)
+            {
+                int64_t o        = r / step;
+                float   row_grad = 0.f;
+                for(int64_t c = c0; c < c0 + width; c++)
+                {
+                    int64_t i = prob.sparseA ? o : c;
+                    int64_t j = prob.sparseA ? c : o;
+                    int64_t u = vec_by_r ? o : c;
+
+                    float beta = static_cast<float>(prob.beta_vector_scaling ? prob.beta[u]
+                                                                            : *prob.beta);
+                    float c_v  = beta != 0.f
+                                     ? beta
+                                          * to_float(C[i * prob.row_stride_c + j * prob.col_stride_c])
+                                     : 0.f;
+                    float v;
+                    if(prob.gated)
+                        v = activation(
+                                product(r, c, 0.f), prob.act_type, prob.act_arg0, prob.act_arg1)
+                                * product(r + 1, c, 0.f)
+                            + c_v;
+                    else
+                        v = activation(
+                            product(r, c, c_v), prob.act_type, prob.act_arg0, prob.act_arg1);
+
+                    if(R)
+                        v += to_float(R[i * prob.row_stride_c + j * prob.col_stride_c]);
+
+                    // The maximum and the gradient are taken before D is scaled for
+                    // quantization
+                    if(prob.amax_d)
+                        raise_amax(prob.amax_d + batch * rows_d + u, v);
+                    if(grad && grad_by_r)
+                        row_grad += v;
+                    else if(grad)
+                        col_grad[c - c0] += v;
+                    if(prob.scale_d)
+                        v *= prob.scale_d[u];
+
+                    To& d = D[i * prob.row_stride_d + j * prob.col_stride_d];
+                    if(sizeof(To) == 1 && prob.rounding == rocsparselt_rounding_stochastic)
+                        d = hipsparselt_quantize<To>::round(
+                            v,
+                            true,
+                            hipsparselt_rounding_bits(
+                                prob.rounding_seed, batch, u, vec_by_r ? c : o));
+                    else
+                        d = from_float<To>(v);
+                }
+                if(grad && grad_by_r)
+                    atomic_add(grad + o, row_grad);
+            }
+            if(grad && !grad_by_r)
+                for(int64_t c = c0; c < c0 + width; c++)
+                    atomic_add(grad + c, col_grad[c - c0]);
+        }
+
+        const Ti* sparse_values() const
+        {
+            return prob.sparseA ? prob.A + prob.buffer_offset_a : prob.B + prob.buffer_offset_b;
+        }
+
+        // The dense operand of a batch, from its pointer array when not strided
+        const Ti* dense_values(int64_t batch) const
+        {
+            if(prob.sparseA)
+                return (prob.batch_B ? prob.batch_B[batch] : prob.B + batch * x_batch_stride)
+                       + prob.buffer_offset_b;
+            return (prob.batch_A ? prob.batch_A[batch] : prob.A + batch * x_batch_stride)
+                   + prob.buffer_offset_a;
+        }
+
+        const RocsparseltContractionProblem<Ti, To, Tc>& prob;
+
+        int64_t rows;
+        int64_t cols;
+        int64_t k;
+
+        int64_t s_row_stride;
+        int64_t s_t_stride;
+        int64_t s_batch_stride;
+        int64_t md_row_stride;
+        int64_t x_k_stride;
+        int64_t x_c_stride;
+        int64_t x_batch_stride;
+        bool    vec_by_r;
+        int64_t rows_d; // rows of the user's D, which the D scales and maxima follow
+        bool    grad_by_r; // whether the bias gradient sums over the rows of the problem
+        int64_t grad_len; // length of the bias gradient of a batch
+
+        int64_t weight_group_k; // dense K per group of the weight-only scales
+        int64_t weight_groups; // groups per row of the weight-only scales
+
+        row_block_fn row_block;
+        float        scale; // product of the scales of A and B
+
+        int64_t row_chunk;
+        int64_t splits;  // K slices
+        int64_t slice_k; // dense K per slice, a multiple of 8
+        int64_t lanes;   // partial result buffers of a tile when splitting K
+        float*  split_k_buffers; // in the workspace, nullptr when it is too small
+    };
+
+    template <typename Ti, typename To, typename Tc>
+    class HostSpmmGroupImpl final : public HostSpmmGroup
+    {
+    public:
+        explicit HostSpmmGroupImpl(const RocsparseltContractionProblem<Ti, To, Tc>& prob)
+            : prob(prob)
+            , spmm(this->prob, true)
+        {
+        }
+
+        HostSpmmGroupImpl(const HostSpmmGroupImpl&) = delete;
+        HostSpmmGroupImpl& operator=(const HostSpmmGroupImpl&) = delete;
+
+        int64_t pooled_tiles() const override
+        {
+            return spmm.pooled_tiles();
+        }
+
+        int64_t tile_cost() const override
+        {
+            return spmm.tile_cost();
+        }
+
+        void run_tile(int64_t tile, HostSpmmScratch& scratch) const override
+        {
+            spmm.run_tile(tile, scratch);
+        }
+
+        rocsparselt_status run() const override
+        {
+            return spmm.run();
+        }
+
+    private:
+        // spmm refers to prob, so prob is declared first
+        RocsparseltContractionProblem<Ti, To, Tc> prob;
+        HostSpmm<Ti, To, Tc>                      spmm;
+    };
+} // namespace
+
+template <typename Ti, typename To, typename Tc>
+rocsparselt_status runContractionProblemHost(const RocsparseltContractionProblem<Ti, To, Tc>& prob)
+{
+    if(prob.metadata == nullptr)
+    {
+        log_error(prob.handle, __func__, "metadata is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+    if(prob.weight_bits && prob.weight_scale == nullptr)
+    {
+        log_error(prob.handle, __func__, "the weight-only scales are a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    log_trace(prob.handle, __func__, "host backend");
+    return HostSpmm<Ti, To, Tc>(prob).run();
+}
+
+template <typename Ti, typename To, typename Tc>
+rocsparselt_status appendHostSpmmGroup(HostSpmmGroups&                                  groups,
+                                       const RocsparseltContractionProblem<Ti, To, Tc>& prob)
+{
+    if(prob.metadata == nullptr)
+    {
+        log_error(prob.handle, __func__, "metadata is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+    if(prob.weight_bits && prob.weight_scale == nullptr)
+    {
+        log_error(prob.handle, __func__, "the weight-only scales are a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    try
+    {
+        groups.push_back(std::make_unique<HostSpmmGroupImpl<Ti, To, Tc>>(prob));
+    }
+    catch(const std::bad_alloc&)
+    {
+        return rocsparselt_status_memory_error;
+    }
+    return rocsparselt_status_success;
+}
+
+rocsparselt_status runGroupedContractionProblemsHost(const _rocsparselt_handle* handle,
+                                                     const HostSpmmGroups&      groups)
+{
+    log_trace(handle, __func__, "host backend", groups.size());
+
+    // Tiles of the costliest groups are handed out first, and first[g] is the
+    // index of the first tile of the g-th group in that order.
+    std::vector<const HostSpmmGroup*> order;
+    for(const auto& group : groups)
+        order.push_back(group.get());
+    std::stable_sort(order.begin(), order.end(), [](const auto* a, const auto* b) {
+        return a->tile_cost() > b->tile_cost();
+    });
+
+    std::vector<int64_t> first(1, 0);
+    for(const auto* group : order)
+        first.push_back(first.back() + group->pooled_tiles());
+    int64_t tiles = first.back();
+
+    std::atomic<int64_t> next{0};
+    rocsparselt_status   status = runHostWorkers(hostThreadCount(tiles), [&] {
+        HostSpmmScratch ws;
+        for(int64_t tile; (tile = next++) < tiles;)
+        {
+            size_t g = std::upper_bound(first.begin(), first.end(), tile) - first.begin() - 1;
+            order[g]->run_tile(tile - first[g], ws);
+        }
+    });
+
+    for(const auto* group : order)
+    {
+        if(status != rocsparselt_status_success)
+            break;
+        if(group->pooled_tiles() == 0)
+            status = group->run();
+    }
+    return status;
+}
+
+size_t getHostSpmmWorkspaceSize(const _rocsparselt_matmul_descr*         matmul_descr,
+                                 const _rocsparselt_matmul_alg_selection* alg_selection)
+{
+    // M is a row count of the dense A, C and D, which HostSpmm sees as its rows
+    // when the structured operand keeps its place
+    bool    m_is_rows = matmul_descr->_is_sparse_a != matmul_descr->_swap_ab;
+    int64_t m_max     = matmul_descr->m;
+    int64_t m_min     = matmul_descr->dynamic_m_min ? matmul_descr->dynamic_m_min : m_max;
+    int64_t other     = matmul_descr->_swap_ab ? matmul_descr->_m : matmul_descr->_n;
+
+    auto split_at = [&](int64_t m) {
+        return HostSpmmSplit(m_is_rows ? m : other,
+                             m_is_rows ? other : m,
+                             matmul_descr->_k,
+                             matmul_descr->matrix_A->num_batches,
+                             alg_selection->split_k,
+                             alg_selection->split_k_mode,
+                             alg_selection->split_k_buffers,
+                             false);
+    };
+
+    // With a fixed number of slices the buffers grow with M. Only small problems
+    // are split without a request, and over those M is walked a tile edge at a
+    // time, the granularity the tiles change with.
+    size_t  size = split_at(m_max).workspace_size;
+    int64_t step = m_is_rows ? MR : NC;
+    for(int64_t m = m_min; alg_selection->split_k == 0 && m < m_max;
+        m         = (m - 1) / step * step + step + 1)
+    {
+        HostSpmmSplit split = split_at(m);
+        if(split.splits == 1)
+            break;
+        size = std::max(size, split.workspace_size);
+    }
+    return size;
+}
+
+#define GENERATE_DEFINITIONS(Ti, To, Tc)                                   \
+    template rocsparselt_status runContractionProblemHost<Ti, To, Tc>(     \
+        const RocsparseltContractionProblem<Ti, To, Tc>&);                 \
+    template rocsparselt_status appendHostSpmmGroup<Ti, To, Tc>(           \
+        HostSpmmGroups&, const RocsparseltContractionProblem<Ti, To, Tc>&);
+
+GENERATE_DEFINITIONS(__half, __half, float)
+GENERATE_DEFINITIONS(__half, int8_t, float)
+GENERATE_DEFINITIONS(__half, hipsparselt_f8, float)
+GENERATE_DEFINITIONS(__half, hipsparselt_bf8, float)
+GENERATE_DEFINITIONS(hip_bfloat16, hip_bfloat16, float)
+GENERATE_DEFINITIONS(hip_bfloat16, int8_t, float)
+GENERATE_DEFINITIONS(hip_bfloat16, hipsparselt_f8, float)
+GENERATE_DEFINITIONS(hip_bfloat16, hipsparselt_bf8, float)
+GENERATE_DEFINITIONS(int8_t, int8_t, float)
+GENERATE_DEFINITIONS(int8_t, __half, float)
+GENERATE_DEFINITIONS(int8_t, hip_bfloat16, float)
+GENERATE_DEFINITIONS(hipsparselt_f8, __half, float)
+GENERATE_DEFINITIONS(hipsparselt_f8, hip_bfloat16, float)
+GENERATE_DEFINITIONS(hipsparselt_f8, float, float)
+GENERATE_DEFINITIONS(hipsparselt_bf8, __half, float)
+GENERATE_DEFINITIONS(hipsparselt_bf8, hip_bfloat16, float)
+GENERATE_DEFINITIONS(hipsparselt_bf8, float, float)
+
+#undef GENERATE_DEFINITIONS
@@ -26,6 +26,7 @@
 
 #include "definitions.h"
 #include "handle.h"
+#include "host_spmm.hpp"
 #include "hipsparselt_ostream.hpp"
 #include "rocsparselt.h"
 #include "rocsparselt_spmm_utils.hpp"
@@ -161,6 +162,24 @@ rocsparselt_status rocsparselt_smfmac_compress_template(const _rocsparselt_handl
                                                         unsigned char*             d_metadata,
                                                         hipStream_t                stream)
 {
+    if(handle->backend == rocsparselt_backend_host)
+        return rocsparselt_smfmac_compress_host<Ti>(handle,
+                                                    m,
+                                                    n,
+                                                    stride0,
+                                                    stride1,
+                                                    batch_stride,
+                                                    c_stride0,
+                                                    c_stride1,
+                                                    c_batch_stride,
+                                                    m_stride0,
+                                                    m_stride1,
+                                                    m_batch_stride,
+                                                    num_batches,
+                                                    d_in,
+                                                    d_out,
+                                                    d_metadata);
+
     constexpr int SG0I = 16;
     constexpr int SG1J = 2;
     constexpr int TT0I = 1;
@@ -244,6 +263,33 @@ rocsparselt_status rocsparselt_smfmac_compress_impl(const _rocsparselt_handle*
         return rocsparselt_smfmac_compress_template<hip_bfloat16>(COMPRESS_PARAMS(hip_bfloat16));
     case HIP_R_8I:
         return rocsparselt_smfmac_compress_template<int8_t>(COMPRESS_PARAMS(int8_t));
+    case HIP_R_8F_E4M3_FNUZ:
+        return rocsparselt_smfmac_compress_template<hipsparselt_f8>(
+            COMPRESS_PARAMS(hipsparselt_f8));
+    case HIP_R_8F_E5M2_FNUZ:
+        return rocsparselt_smfmac_compress_template<hipsparselt_bf8>(
+            COMPRESS_PARAMS(hipsparselt_bf8));
+    case HIP_R_4I:
+        // Packed I4 weights of weight-only quantization, which only the host compresses
+        if(handle->backend == rocsparselt_backend_host)
+            return rocsparselt_smfmac_compress_host_i4(handle,
+                                                       m,
+                                                       n,
+                                                       stride0,
+                                                       stride1,
+                                                       batch_stride,
+                                                       c_stride0,
+                                                       c_stride1,
+                                                       c_batch_stride,
+                                                       m_stride0,
+                                                       m_stride1,
+                                                       m_batch_stride,
+                                                       num_batches,
+                                                       d_in,
+                                                       d_out,
+                                                       d_metadata);
+        log_error(handle, "rocsparselt_smfmac_compress", "datatype HIP_R_4I is not supported");
+        return rocsparselt_status_not_implemented;
     default:
         log_error(handle,
                   "rocsparselt_smfmac_compress",
@@ -254,6 +300,63 @@ rocsparselt_status rocsparselt_smfmac_compress_impl(const _rocsparselt_handle*
     }
 }
 
+/********************************************************************************
+ * \brief Checks the arguments shared by the streaming compress functions.
+ *******************************************************************************/
+static rocsparselt_status
+    rocsparselt_smfmac_compress_stream_check(const rocsparselt_handle*    handle,
+                                             const rocsparselt_mat_descr* sparseMatDescr,
+                                             rocsparselt_operation        op,
+                                             const rocsparselt_prune_alg* pruneAlg,
+                                             const char*                  caller)
+{
+    // Check if handle is valid
+    if(handle == nullptr)
+    {
+        hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handle);
+    if(!_handle->isInit())
+    {
+        hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    if(sparseMatDescr == nullptr)
+    {
+        log_error(_handle, caller, "sparseMatDescr is a NULL pointer");
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _sparseMatDescr = reinterpret_cast<const _rocsparselt_mat_descr*>(sparseMatDescr);
+    if(!_sparseMatDescr->isInit())
+    {
+        log_error(_handle, caller, "sparseMatDescr did not initialized or already destroyed");
+        return rocsparselt_status_invalid_handle;
+    }
+
+    if(op != rocsparselt_operation_none && op != rocsparselt_operation_transpose)
+    {
+        log_error(_handle, caller, "op is invalid");
+        return rocsparselt_status_invalid_value;
+    }
+
+    if(pruneAlg != nullptr && *pruneAlg != rocsparselt_prune_smfmac_tile
+       && *pruneAlg != rocsparselt_prune_smfmac_strip)
+    {
+        log_error(_handle, caller, "pruneAlg is invalid");
+        return rocsparselt_status_invalid_value;
+    }
+
+    // Check if matrix A is a structured matrix
+    if(_sparseMatDescr->m_type != rocsparselt_matrix_type_structured)
+    {
+        log_error(_handle, caller, "Matrix is not a structured matrix");
+        return rocsparselt_status_not_implemented;
+    }
+    return rocsparselt_status_success;
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -689,6 +792,153 @@ rocsparselt_status rocsparselt_smfmac_compress2(const rocsparselt_handle*    han
                                             stream);
 }
 
+/********************************************************************************
+ * \brief
+ *******************************************************************************/
+rocsparselt_status rocsparselt_smfmac_compress_stream(const rocsparselt_handle*    handle,
+                                                      const rocsparselt_mat_descr* sparseMatDescr,
+                                                      int                          isSparseA,
+                                                      rocsparselt_operation        op,
+                                                      const rocsparselt_prune_alg* pruneAlg,
+                                                      rocsparselt_stream_read_fn   read,
+                                                      rocsparselt_stream_write_fn  write,
+                                                      void*                        user_data,
+                                                      size_t                       panelBytes)
+
+{
+    auto status = rocsparselt_smfmac_compress_stream_check(
+        handle, sparseMatDescr, op, pruneAlg, __func__);
+    if(status != rocsparselt_status_success)
+        return status;
+
+    auto _handle         = reinterpret_cast<const _rocsparselt_handle*>(handle);
+    auto _sparseMatDescr = reinterpret_cast<_rocsparselt_mat_descr*>(
+        const_cast<rocsparselt_mat_descr*>(sparseMatDescr));
+
+    // Check if pointer is valid
+    if(read == nullptr)
+    {
+        log_error(_handle, __func__, "read is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    if(write == nullptr)
+    {
+        log_error(_handle, __func__, "write is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    initSparseMatrixLayout(op, sparseMatDescr, isSparseA);
+
+    log_api(_handle,
+            __func__,
+            "sparseMatDescr[in]",
+            *_sparseMatDescr,
+            "isSparseA[in]",
+            isSparseA,
+            "op[in]",
+            rocsparselt_operation_to_string(op),
+            "pruneAlg[in]",
+            pruneAlg,
+            "user_data[in]",
+            user_data,
+            "panelBytes[in]",
+            panelBytes);
+
+    int64_t m, n, stride0, stride1, c_stride0, c_stride1;
+    get_compress_matrix_size(
+        isSparseA, op, _sparseMatDescr, m, n, stride0, stride1, c_stride0, c_stride1);
+
+    return rocsparselt_smfmac_compress_stream_host(_handle,
+                                                   _sparseMatDescr,
+                                                   m,
+                                                   n,
+                                                   stride0,
+                                                   stride1,
+                                                   pruneAlg,
+                                                   read,
+                                                   write,
+                                                   user_data,
+                                                   panelBytes);
+}
+
+/********************************************************************************
+ * \brief
+ *******************************************************************************/
+rocsparselt_status rocsparselt_smfmac_compress_file(const rocsparselt_handle*    handle,
+                                                    const rocsparselt_mat_descr* sparseMatDescr,
+                                                    int                          isSparseA,
+                                                    rocsparselt_operation        op,
+                                                    const rocsparselt_prune_alg* pruneAlg,
+                                                    int                          denseFd,
+                                                    int64_t                      denseOffset,
+                                                    int                          compressedFd,
+                                                    int64_t                      compressedOffset,
+                                                    size_t                       panelBytes)
+
+{
+    auto status = rocsparselt_smfmac_compress_stream_check(
+        handle, sparseMatDescr, op, pruneAlg, __func__);
+    if(status != rocsparselt_status_success)
+        return status;
+
+    auto _handle         = reinterpret_cast<const _rocsparselt_handle*>(handle);
+    auto _sparseMatDescr = reinterpret_cast<_rocsparselt_mat_descr*>(
+        const_cast<rocsparselt_mat_descr*>(sparseMatDescr));
+
+    if(denseFd < 0 || compressedFd < 0)
+    {
+        log_error(_handle, __func__, "file descriptor is invalid");
+        return rocsparselt_status_invalid_value;
+    }
+
+    if(denseOffset < 0 || compressedOffset < 0)
+    {
+        log_error(_handle, __func__, "file offset is negative");
+        return rocsparselt_status_invalid_value;
+    }
+
+    initSparseMatrixLayout(op, sparseMatDescr, isSparseA);
+
+    log_api(_handle,
+            __func__,
+            "sparseMatDescr[in]",
+            *_sparseMatDescr,
+            "isSparseA[in]",
+            isSparseA,
+            "op[in]",
+            rocsparselt_operation_to_string(op),
+            "pruneAlg[in]",
+            pruneAlg,
+            "denseFd[in]",
+            denseFd,
+            "denseOffset[in]",
+            denseOffset,
+            "compressedFd[in]",
+            compressedFd,
+            "compressedOffset[in]",
+            compressedOffset,
+            "panelBytes[in]",
+            panelBytes);
+
+    int64_t m, n, stride0, stride1, c_stride0, c_stride1;
+    get_compress_matrix_size(
+        isSparseA, op, _sparseMatDescr, m, n, stride0, stride1, c_stride0, c_stride1);
+
+    return rocsparselt_smfmac_compress_file_host(_handle,
+                                                 _sparseMatDescr,
+                                                 m,
+                                                 n,
+                                                 stride0,
+                                                 stride1,
+                                                 pruneAlg,
+                                                 denseFd,
+                                                 denseOffset,
+                                                 compressedFd,
+                                                 compressedOffset,
+                                                 panelBytes);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,9 +26,11 @@
 
 #include "definitions.h"
 #include "handle.h"
+#include "host_spmm.hpp"
 #include "rocsparselt.h"
 #include "status.h"
 #include "utility.hpp"
+#include "rocsparselt_prune_patterns.hpp"
 #include "rocsparselt_spmm_utils.hpp"
 
 #include "hipsparselt_ostream.hpp"
@@ -234,32 +236,8 @@ __global__
     __shared__ int norm_idx[THREADS_PER_SG * SG0I * SG1J];
 
     // 90 patterns, that pick 2 elements from each row and column from a 4x4 tile, total pick 8 elements.
-    // the first pattern: 0, 2, 0, 2, 1, 3, 1, 3 => COL#(ROW#,ROW#) = 0(0,2), 1(0,2), 2(1,3), 3(1,3)
     __constant__ static uint8_t pos_patterns[90 * 4 * 2] = {
-        0, 2, 0, 2, 1, 3, 1, 3, 0, 2, 0, 3, 1, 3, 1, 2, 0, 2, 0, 3, 1, 2, 1, 3, 0, 2, 0, 1, 1, 3,
-        2, 3, 0, 2, 0, 1, 2, 3, 1, 3, 0, 2, 1, 3, 0, 2, 1, 3, 0, 2, 1, 3, 0, 3, 1, 2, 0, 2, 1, 3,
-        0, 1, 2, 3, 0, 2, 1, 3, 1, 3, 0, 2, 0, 2, 1, 3, 1, 2, 0, 3, 0, 2, 1, 3, 2, 3, 0, 1, 0, 2,
-        1, 2, 0, 3, 1, 3, 0, 2, 1, 2, 1, 3, 0, 3, 0, 2, 2, 3, 0, 1, 1, 3, 0, 2, 2, 3, 1, 3, 0, 1,
-        0, 3, 0, 2, 1, 3, 1, 2, 0, 3, 0, 2, 1, 2, 1, 3, 0, 3, 0, 3, 1, 2, 1, 2, 0, 3, 0, 1, 1, 2,
-        2, 3, 0, 3, 0, 1, 2, 3, 1, 2, 0, 3, 1, 3, 0, 2, 1, 2, 0, 3, 1, 3, 1, 2, 0, 2, 0, 3, 1, 2,
-        0, 2, 1, 3, 0, 3, 1, 2, 0, 3, 1, 2, 0, 3, 1, 2, 0, 1, 2, 3, 0, 3, 1, 2, 1, 3, 0, 2, 0, 3,
-        1, 2, 1, 2, 0, 3, 0, 3, 1, 2, 2, 3, 0, 1, 0, 3, 2, 3, 0, 1, 1, 2, 0, 3, 2, 3, 1, 2, 0, 1,
-        0, 1, 0, 2, 1, 3, 2, 3, 0, 1, 0, 2, 2, 3, 1, 3, 0, 1, 0, 3, 1, 2, 2, 3, 0, 1, 0, 3, 2, 3,
-        1, 2, 0, 1, 0, 1, 2, 3, 2, 3, 0, 1, 1, 3, 0, 2, 2, 3, 0, 1, 1, 3, 2, 3, 0, 2, 0, 1, 1, 2,
-        0, 3, 2, 3, 0, 1, 1, 2, 2, 3, 0, 3, 0, 1, 2, 3, 0, 2, 1, 3, 0, 1, 2, 3, 0, 3, 1, 2, 0, 1,
-        2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 1, 3, 0, 2, 0, 1, 2, 3, 1, 2, 0, 3, 0, 1, 2, 3, 2, 3, 0, 1,
-        1, 3, 0, 2, 0, 2, 1, 3, 1, 3, 0, 2, 0, 3, 1, 2, 1, 3, 0, 2, 0, 1, 2, 3, 1, 3, 0, 2, 1, 3,
-        0, 2, 1, 3, 0, 2, 1, 2, 0, 3, 1, 3, 0, 2, 2, 3, 0, 1, 1, 3, 0, 3, 0, 2, 1, 2, 1, 3, 0, 3,
-        1, 2, 0, 2, 1, 3, 0, 1, 0, 2, 2, 3, 1, 3, 0, 1, 2, 3, 0, 2, 1, 3, 1, 3, 0, 2, 0, 2, 1, 3,
-        1, 2, 0, 2, 0, 3, 1, 3, 1, 2, 0, 3, 0, 2, 1, 3, 2, 3, 0, 2, 0, 1, 1, 3, 2, 3, 0, 1, 0, 2,
-        1, 2, 0, 2, 0, 3, 1, 3, 1, 2, 0, 2, 1, 3, 0, 3, 1, 2, 0, 3, 0, 2, 1, 3, 1, 2, 0, 3, 0, 3,
-        1, 2, 1, 2, 0, 3, 0, 1, 2, 3, 1, 2, 0, 3, 1, 3, 0, 2, 1, 2, 0, 3, 1, 2, 0, 3, 1, 2, 0, 3,
-        2, 3, 0, 1, 1, 2, 0, 1, 0, 3, 2, 3, 1, 2, 0, 1, 2, 3, 0, 3, 1, 2, 1, 3, 0, 2, 0, 3, 1, 2,
-        1, 3, 0, 3, 0, 2, 1, 2, 1, 2, 0, 3, 0, 3, 1, 2, 2, 3, 0, 3, 0, 1, 1, 2, 2, 3, 0, 1, 0, 3,
-        2, 3, 0, 2, 0, 1, 1, 3, 2, 3, 0, 2, 1, 3, 0, 1, 2, 3, 0, 3, 0, 1, 1, 2, 2, 3, 0, 3, 1, 2,
-        0, 1, 2, 3, 0, 1, 0, 2, 1, 3, 2, 3, 0, 1, 0, 3, 1, 2, 2, 3, 0, 1, 0, 1, 2, 3, 2, 3, 0, 1,
-        1, 3, 0, 2, 2, 3, 0, 1, 1, 2, 0, 3, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 1, 3, 0, 2, 0, 1, 2, 3,
-        1, 3, 0, 1, 0, 2, 2, 3, 1, 2, 0, 3, 0, 1, 2, 3, 1, 2, 0, 1, 0, 3, 2, 3, 2, 3, 0, 1, 0, 1,
+        ROCSPARSELT_PRUNE_TILE_PATTERNS
     };
 
     constexpr unsigned int MT0I = SG0I * TT0I;
@@ -409,6 +387,10 @@ rocsparselt_status rocsparselt_smfmac_prune_template(const _rocsparselt_handle*
                                                      rocsparselt_prune_alg      pruneAlg,
                                                      hipStream_t                stream)
 {
+    if(handle->backend == rocsparselt_backend_host)
+        return rocsparselt_smfmac_prune_host<Ti, Tc>(
+            handle, m, n, stride0, stride1, num_batches, batch_stride, d_in, d_out, pruneAlg);
+
     if(pruneAlg == rocsparselt_prune_smfmac_strip)
     {
         constexpr int SG0I    = 16;
@@ -528,6 +510,10 @@ rocsparselt_status rocsparselt_smfmac_prune_check_template(const _rocsparselt_ha
                                                            int*                       d_out,
                                                            hipStream_t                stream)
 {
+    if(handle->backend == rocsparselt_backend_host)
+        return rocsparselt_smfmac_prune_check_host<Ti>(
+            handle, m, n, stride0, stride1, num_batches, batch_stride, d_in, d_out);
+
     constexpr int SG0I = 16;
     constexpr int SG1J = 4;
     constexpr int TT0I = 1;
@@ -598,6 +584,19 @@ rocsparselt_status rocsparselt_smfmac_prune_impl(const _rocsparselt_handle*    h
         return rocsparselt_smfmac_prune_template<hip_bfloat16, float>(PRUNE_PARAMS(hip_bfloat16));
     case HIP_R_8I:
         return rocsparselt_smfmac_prune_template<int8_t, float>(PRUNE_PARAMS(int8_t));
+    case HIP_R_8F_E4M3_FNUZ:
+        return rocsparselt_smfmac_prune_template<hipsparselt_f8, float>(
+            PRUNE_PARAMS(hipsparselt_f8));
+    case HIP_R_8F_E5M2_FNUZ:
+        return rocsparselt_smfmac_prune_template<hipsparselt_bf8, float>(
+            PRUNE_PARAMS(hipsparselt_bf8));
+    case HIP_R_4I:
+        // Packed I4 weights of weight-only quantization, which only the host prunes
+        if(handle->backend == rocsparselt_backend_host)
+            return rocsparselt_smfmac_prune_host_i4(
+                handle, m, n, stride0, stride1, num_batches, batch_stride, d_in, d_out, pruneAlg);
+        log_error(handle, "rocsparselt_smfmac_prune", "datatype HIP_R_4I is not supported");
+        return rocsparselt_status_not_implemented;
     default:
         log_error(handle,
                   "rocsparselt_smfmac_prune",
@@ -646,6 +645,18 @@ rocsparselt_status rocsparselt_smfmac_prune_check_impl(const _rocsparselt_handle
             PRUNE_CHECK_PARAMS(hip_bfloat16));
     case HIP_R_8I:
         return rocsparselt_smfmac_prune_check_template<int8_t>(PRUNE_CHECK_PARAMS(int8_t));
+    case HIP_R_8F_E4M3_FNUZ:
+        return rocsparselt_smfmac_prune_check_template<hipsparselt_f8>(
+            PRUNE_CHECK_PARAMS(hipsparselt_f8));
+    case HIP_R_8F_E5M2_FNUZ:
+        return rocsparselt_smfmac_prune_check_template<hipsparselt_bf8>(
+            PRUNE_CHECK_PARAMS(hipsparselt_bf8));
+    case HIP_R_4I:
+        if(handle->backend == rocsparselt_backend_host)
+            return rocsparselt_smfmac_prune_check_host_i4(
+                handle, m, n, stride0, stride1, num_batches, batch_stride, d_in, d_out);
+        log_error(handle, "rocsparselt_smfmac_prune_check", "datatype HIP_R_4I is not supported");
+        return rocsparselt_status_not_implemented;
     default:
         log_error(handle,
                   "rocsparselt_smfmac_prune_check",
@@ -28,10 +28,89 @@
 #include "definitions.h"
 #include "handle.h"
 #include "rocsparselt_spmm_utils.hpp"
+#include "stream_partition.hpp"
+#include "tuning_db.hpp"
 #include "utility.hpp"
 
 #include <hip/hip_runtime_api.h>
 
+namespace
+{
+    // Workspace of the config selected in the plan, and of the config of each M
+    // bucket of a dynamic-M plan. The host backend needs it for split-K.
+    size_t plan_workspace_size(const _rocsparselt_matmul_plan* plan)
+    {
+        const auto* alg_selection = plan->alg_selection;
+        const auto* matmul_descr  = plan->matmul_descr;
+        if(alg_selection->config_max_id == 0)
+            return 0;
+        if(plan->handle->backend == rocsparselt_backend_host)
+            return getHostSpmmWorkspaceSize(matmul_descr, alg_selection);
+
+        size_t size = alg_selection->configs[alg_selection->config_id].max_workspace_bytes;
+        if(matmul_descr->dynamic_m_min)
+            for(int b = rocsparselt_dynamic_m_bucket(matmul_descr->dynamic_m_min);
+                b <= rocsparselt_dynamic_m_bucket(matmul_descr->m);
+                b++)
+                size = std::max(size, alg_selection->dynamic_m_configs[b].max_workspace_bytes);
+        return size;
+    }
+
+    // Each group of a grouped matmul has its own 256-byte aligned workspace slice
+    constexpr size_t GROUP_WORKSPACE_ALIGNMENT = 256;
+
+    /*************************************************************************
+     * Checks the groups of a grouped matmul, and stores where the workspace  *
+     * slice of each group starts and how large the whole workspace is.       *
+     *************************************************************************/
+    rocsparselt_status check_groups(const char*                     caller,
+                                    const _rocsparselt_handle*      handle,
+                                    const rocsparselt_matmul_group* groups,
+                                    int32_t                         groupCount,
+                                    bool                            check_pointers,
+                                    std::vector<size_t>&            offsets,
+                                    size_t&                         workspaceSize)
+    {
+        if(groupCount < 0)
+        {
+            log_error(handle, caller, "groupCount", groupCount, "is negative");
+            return rocsparselt_status_invalid_size;
+        }
+
+        if(groups == nullptr && groupCount > 0)
+        {
+            log_error(handle, caller, "groups is a NULL pointer");
+            return rocsparselt_status_invalid_pointer;
+        }
+
+        workspaceSize = 0;
+        offsets.assign(groupCount, 0);
+        for(int32_t i = 0; i < groupCount; i++)
+        {
+            const auto& group = groups[i];
+            auto        plan  = reinterpret_cast<const _rocsparselt_matmul_plan*>(group.plan);
+            if(plan == nullptr || !plan->isInit())
+            {
+                log_error(handle, caller, "the plan of group", i, "is invalid");
+                return rocsparselt_status_invalid_handle;
+            }
+
+            if(check_pointers
+               && (group.alpha == nullptr || group.d_A == nullptr || group.d_B == nullptr
+                   || group.beta == nullptr || group.d_C == nullptr || group.d_D == nullptr))
+            {
+                log_error(handle, caller, "group", i, "has a NULL pointer");
+                return rocsparselt_status_invalid_pointer;
+            }
+
+            offsets[i] = workspaceSize;
+            workspaceSize += (plan_workspace_size(plan) + GROUP_WORKSPACE_ALIGNMENT - 1)
+                             / GROUP_WORKSPACE_ALIGNMENT * GROUP_WORKSPACE_ALIGNMENT;
+        }
+        return rocsparselt_status_success;
+    }
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -77,21 +156,20 @@ rocsparselt_status rocsparselt_matmul_get_workspace(const rocsparselt_handle*
     }
 
     {
-        if(_plan->alg_selection->config_max_id == 0)
-            *workspaceSize = 0;
-        else
-        {
-            *workspaceSize = _plan->alg_selection->configs[_plan->alg_selection->config_id]
-                                 .max_workspace_bytes;
-        }
+        *workspaceSize = plan_workspace_size(_plan);
         log_api(_handle, __func__, *workspaceSize);
         return rocsparselt_status_success;
     }
 }
 
+/********************************************************************************
+ * \brief Runs or, with search set, tunes the plan with m rows of A, C and D, or
+ * with the M of the matrix descriptors when m is negative.
+ *******************************************************************************/
 rocsparselt_status rocsparselt_matmul_impl(const char*                    caller,
                                            const rocsparselt_handle*      handle,
                                            const rocsparselt_matmul_plan* plan,
+                                           int64_t                        m,
                                            const void*                    alpha,
                                            const void*                    d_A,
                                            const void*                    d_B,
@@ -128,6 +206,24 @@ rocsparselt_status rocsparselt_matmul_impl(const char*                    caller
         return rocsparselt_status_invalid_handle;
     }
 
+    // Only a dynamic-M plan runs an M other than the one of its descriptor
+    const _rocsparselt_matmul_descr* matmul_descr = _plan->matmul_descr;
+    if(m < 0)
+        m = matmul_descr->m;
+    else if(!matmul_descr->dynamic_m_min)
+    {
+        log_error(_handle, caller, "plan does not have a dynamic M");
+        return rocsparselt_status_invalid_value;
+    }
+    else if(m < matmul_descr->dynamic_m_min || m > matmul_descr->m)
+    {
+        hipsparselt_cerr << "The parameter number 3 (m) had an illegal value: " << m
+                         << ", expected a value in [" << matmul_descr->dynamic_m_min << ", "
+                         << matmul_descr->m << "]" << std::endl;
+        log_error(_handle, caller, "m is out of the dynamic M range of the plan");
+        return rocsparselt_status_invalid_size;
+    }
+
     // Check if pointer is valid
     if(alpha == nullptr)
     {
@@ -165,10 +261,25 @@ rocsparselt_status rocsparselt_matmul_impl(const char*                    caller
         return rocsparselt_status_invalid_pointer;
     }
 
-    size_t workspaceSize
-        = _plan->alg_selection->config_max_id == 0
-              ? 0
-              : _plan->alg_selection->configs[_plan->alg_selection->config_id].max_workspace_bytes;
+    // With pointer-array batches, the dense matrix, C and D hold one pointer per batch
+    if(matmul_descr->pointer_array_batch)
+    {
+        const char* names[]  = {matmul_descr->is_sparse_a ? "d_B" : "d_A", "d_C", "d_D"};
+        const void* arrays[] = {matmul_descr->is_sparse_a ? d_B : d_A, d_C, d_D};
+        for(int i = 0; i < 3; i++)
+        {
+            for(int64_t b = 0; b < matmul_descr->matrix_A->num_batches; b++)
+            {
+                if(static_cast<const void* const*>(arrays[i])[b] == nullptr)
+                {
+                    log_error(_handle, caller, names[i], "holds a NULL pointer at batch", b);
+                    return rocsparselt_status_invalid_pointer;
+                }
+            }
+        }
+    }
+
+    size_t workspaceSize = plan_workspace_size(_plan);
     if(workspace == nullptr && workspaceSize != 0)
     {
         hipsparselt_cerr << "The parameter number 9 (workspace) had an illegal value "
@@ -200,14 +311,16 @@ rocsparselt_status rocsparselt_matmul_impl(const char*                    caller
     int config_max_id     = _plan->alg_selection->config_max_id;
     int search_iterations = search ? _plan->alg_selection->search_iterations : 0; //default
 
-#define EX_PARM                                                                              \
-    caller, _handle, _plan, alpha, beta, d_A, d_B, d_C, d_D, workspace, streams, numStreams, \
+#define EX_PARM                                                                                 \
+    caller, _handle, _plan, m, alpha, beta, d_A, d_B, d_C, d_D, workspace, streams, numStreams, \
         &config_id, config_max_id, search_iterations
 
     log_api(_handle,
             caller,
             "plan[in]",
             *_plan,
+            "m[in]",
+            m,
             "alpha[in]",
             alpha,
             "d_A[in]",
@@ -234,6 +347,13 @@ rocsparselt_status rocsparselt_matmul_impl(const char*                    caller
     {
         log_info(_handle, caller, "found the best config_id", config_id);
         _plan->alg_selection->config_id = config_id;
+        // A dynamic-M plan also runs it for the M bucket it was found for.
+        if(matmul_descr->dynamic_m_min)
+            _plan->alg_selection->dynamic_m_configs[rocsparselt_dynamic_m_bucket(m)]
+                = _plan->alg_selection->configs[config_id];
+        // Only the best config of an unrestricted search is worth reusing.
+        else if(_handle->backend == rocsparselt_backend_device && !_plan->alg_selection->split_k)
+            rocsparselt_tuning_db_store(_plan, config_id);
     }
     return status;
 }
@@ -254,8 +374,45 @@ rocsparselt_status rocsparselt_matmul(const rocsparselt_handle*      handle,
                                       int32_t                        numStreams)
 
 {
+    return rocsparselt_matmul_impl(__func__,
+                                   handle,
+                                   plan,
+                                   -1,
+                                   alpha,
+                                   d_A,
+                                   d_B,
+                                   beta,
+                                   d_C,
+                                   d_D,
+                                   workspace,
+                                   streams,
+                                   numStreams);
+}
+
+/********************************************************************************
+ * \brief
+ *******************************************************************************/
+rocsparselt_status rocsparselt_matmul_dynamic_m(const rocsparselt_handle*      handle,
+                                                const rocsparselt_matmul_plan* plan,
+                                                int64_t                        m,
+                                                const void*                    alpha,
+                                                const void*                    d_A,
+                                                const void*                    d_B,
+                                                const void*                    beta,
+                                                const void*                    d_C,
+                                                void*                          d_D,
+                                                void*                          workspace,
+                                                hipStream_t*                   streams,
+                                                int32_t                        numStreams)
+
+{
+    if(m < 0)
+    {
+        hipsparselt_cerr << "The parameter number 3 (m) had an illegal value: " << m << std::endl;
+        return rocsparselt_status_invalid_size;
+    }
     return rocsparselt_matmul_impl(
-        __func__, handle, plan, alpha, d_A, d_B, beta, d_C, d_D, workspace, streams, numStreams);
+        __func__, handle, plan, m, alpha, d_A, d_B, beta, d_C, d_D, workspace, streams, numStreams);
 }
 
 /********************************************************************************
@@ -277,6 +434,7 @@ rocsparselt_status rocsparselt_matmul_search(const rocsparselt_handle* handle,
     return rocsparselt_matmul_impl(__func__,
                                    handle,
                                    plan,
+                                   -1,
                                    alpha,
                                    d_A,
                                    d_B,
@@ -288,32 +446,237 @@ rocsparselt_status rocsparselt_matmul_search(const rocsparselt_handle* handle,
                                    numStreams,
                                    true);
 }
+
+/********************************************************************************
+ * \brief
+ *******************************************************************************/
+rocsparselt_status rocsparselt_matmul_grouped_get_workspace(const rocsparselt_handle*       handle,
+                                                            const rocsparselt_matmul_group* groups,
+                                                            int32_t groupCount,
+                                                            size_t* workspaceSize)
+{
+    // Check if handle is valid
+    if(handle == nullptr)
+    {
+        hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handle);
+    if(!_handle->isInit())
+    {
+        hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    // Check if pointer is valid
+    if(workspaceSize == nullptr)
+    {
+        log_error(_handle, __func__, "workspaceSize is a NULL pointer");
+        return rocsparselt_status_invalid_pointer;
+    }
+
+    std::vector<size_t> offsets;
+    auto status
+        = check_groups(__func__, _handle, groups, groupCount, false, offsets, *workspaceSize);
+    if(status != rocsparselt_status_success)
+        return status;
+
+    log_api(_handle, __func__, *workspaceSize);
+    return rocsparselt_status_success;
+}
+
+/********************************************************************************
+ * \brief
+ *******************************************************************************/
+rocsparselt_status rocsparselt_matmul_grouped(const rocsparselt_handle*       handle,
+                                              const rocsparselt_matmul_group* groups,
+                                              int32_t                         groupCount,
+                                              void*                           workspace,
+                                              hipStream_t*                    streams,
+                                              int32_t                         numStreams)
+{
+    // Check if handle is valid
+    if(handle == nullptr)
+    {
+        hipsparselt_cerr << "handle is a NULL pointer" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+    auto _handle = reinterpret_cast<const _rocsparselt_handle*>(handle);
+    if(!_handle->isInit())
+    {
+        hipsparselt_cerr << "handle did not initialized or already destroyed" << std::endl;
+        return rocsparselt_status_invalid_handle;
+    }
+
+    if(numStreams < 0)
+    {
+        log_error(_handle, __func__, "numStreams should >= 0");
+        return rocsparselt_status_invalid_value;
+    }
+    else if(streams == nullptr && numStreams > 0)
+    {
+        log_error(_handle,
+                  __func__,
+                  "streams should not be a NULL pointer because the numStreams is not 0");
+        return rocsparselt_status_invalid_value;
+    }
+
+    std::vector<size_t> offsets;
+    size_t              workspaceSize;
+    auto status = check_groups(__func__, _handle, groups, groupCount, true, offsets, workspaceSize);
+    if(status != rocsparselt_status_success)
+        return status;
+
+    if(workspace == nullptr && workspaceSize != 0)
+    {
+        log_error(_handle, __func__, "expected workspace is not a NULL pointer");
+        return rocsparselt_status_invalid_value;
+    }
+
+    log_api(_handle,
+            __func__,
+            "groups[in]",
+            groups,
+            "groupCount[in]",
+            groupCount,
+            "workspace[in]",
+            workspace,
+            "workspaceSize[in]",
+            workspaceSize,
+            "streams[in]",
+            streams,
+            "numStreams[in]",
+            numStreams);
+
+    if(groupCount == 0)
+        return rocsparselt_status_success;
+
+    // Runs group i on one stream with its own slice of the workspace. With the
+    // host backend and host_groups set, the group is only appended to it.
+    hipStream_t null_stream = nullptr;
+    auto run_group = [&](int32_t i, hipStream_t* stream, HostSpmmGroups* host_groups) {
+        auto  plan      = reinterpret_cast<const _rocsparselt_matmul_plan*>(groups[i].plan);
+        void* slice     = workspace ? static_cast<char*>(workspace) + offsets[i] : nullptr;
+        int   config_id = plan->alg_selection->config_id;
+        return rocsparselt_spmm_template(__func__,
+                                         _handle,
+                                         plan,
+                                         plan->matmul_descr->m,
+                                         groups[i].alpha,
+                                         groups[i].beta,
+                                         groups[i].d_A,
+                                         groups[i].d_B,
+                                         groups[i].d_C,
+                                         groups[i].d_D,
+                                         slice,
+                                         stream,
+                                         1,
+                                         &config_id,
+                                         plan->alg_selection->config_max_id,
+                                         0,
+                                         host_groups);
+    };
+
+    if(_handle->backend == rocsparselt_backend_host)
+    {
+        HostSpmmGroups host_groups;
+        for(int32_t i = 0; i < groupCount && status == rocsparselt_status_success; i++)
+            status = run_group(i, &null_stream, &host_groups);
+        if(status != rocsparselt_status_success)
+            return status;
+        return runGroupedContractionProblemsHost(_handle, host_groups);
+    }
+
+    // The groups are balanced over the streams by their multiply-adds
+    std::vector<double> costs(groupCount);
+    for(int32_t i = 0; i < groupCount; i++)
+    {
+        auto plan  = reinterpret_cast<const _rocsparselt_matmul_plan*>(groups[i].plan);
+        auto descr = plan->matmul_descr;
+        costs[i]   = static_cast<double>(descr->_m) * descr->_n * descr->_k
+                   * descr->matrix_A->num_batches;
+    }
+    int32_t used_streams = std::min(numStreams, groupCount);
+    auto    launches     = rocsparselt_schedule_groups(costs, std::max(used_streams, 1));
+
+    /*************************************************************************
+     * As in a rocsparselt_matmul() split over several streams, the other     *
+     * streams start after the work already queued on streams[0] (event 0),   *
+     * and streams[0] waits for each of them (event s). The events can be     *
+     * destroyed as soon as the waits are enqueued.                           *
+     *************************************************************************/
+    auto record_and_wait = [](hipEvent_t event, hipStream_t record_on, hipStream_t wait_on) {
+        if(hipEventRecord(event, record_on) != hipSuccess
+           || hipStreamWaitEvent(wait_on, event, 0) != hipSuccess)
+            return rocsparselt_status_internal_error;
+        return rocsparselt_status_success;
+    };
+
+    std::vector<hipEvent_t> events(used_streams > 1 ? used_streams : 0);
+    for(size_t s = 0; s < events.size(); s++)
+    {
+        if(hipEventCreateWithFlags(&events[s], hipEventDisableTiming) != hipSuccess)
+        {
+            events.resize(s);
+            for(auto event : events)
+                (void)hipEventDestroy(event);
+            log_error(_handle, __func__, "cannot create the events that join the streams");
+            return rocsparselt_status_internal_error;
+        }
+    }
+
+    for(size_t s = 1; s < events.size() && status == rocsparselt_status_success; s++)
+        status = record_and_wait(events[0], streams[0], streams[s]);
+
+    for(size_t l = 0; l < launches.size() && status == rocsparselt_status_success; l++)
+    {
+        const auto& launch = launches[l];
+        status = run_group(
+            launch.group, numStreams == 0 ? &null_stream : &streams[launch.stream], nullptr);
+        if(status != rocsparselt_status_success)
+            log_error(_handle, __func__, "group", launch.group, "failed");
+    }
+
+    // Join even after a failure, so that streams[0] covers whatever was launched
+    for(size_t s = 1; s < events.size(); s++)
+    {
+        auto joined = record_and_wait(events[s], streams[s], streams[0]);
+        if(status == rocsparselt_status_success)
+            status = joined;
+    }
+
+    for(auto event : events)
+        (void)hipEventDestroy(event);
+
+    return status;
+}
 #ifdef __cplusplus
 }
 #endif
 
 template <typename Ti, typename To, typename Tc>
-rocsparselt_status ConstructRocSparseLtProblem(const char*                                 caller,
-                                               RocsparseltContractionProblem<Ti, To, Tc>** prob,
-                                               const _rocsparselt_matmul_descr* matmul_descr,
-                                               const Tc*                        alpha,
-                                               const Tc*                        beta,
-                                               const Ti*                        a,
-                                               const Ti*                        b,
-                                               const To*                        c,
-                                               To*                              d,
-                                               bool                             strided_batch,
-                                               void*                            workspace,
-                                               size_t                           workspaceSize,
-                                               hipStream_t*                     streams,
-                                               int32_t                          numStreams)
+rocsparselt_status
+    ConstructRocSparseLtProblem(const char*                                               caller,
+                                std::optional<RocsparseltContractionProblem<Ti, To, Tc>>& prob,
+                                const _rocsparselt_matmul_descr* matmul_descr,
+                                const Tc*                        alpha,
+                                const Tc*                        beta,
+                                const Ti*                        a,
+                                const Ti*                        b,
+                                const To*                        c,
+                                To*                              d,
+                                bool                             strided_batch,
+                                void*                            workspace,
+                                size_t                           workspaceSize,
+                                hipStream_t*                     streams,
+                                int32_t                          numStreams)
 {
-    std::shared_ptr<Tc> _one = std::make_shared<Tc>(static_cast<Tc>(1));
+    static const Tc _one = static_cast<Tc>(1);
     if(alpha == nullptr)
-        alpha = _one.get();
+        alpha = &_one;
 
     if(beta == nullptr)
-        beta = _one.get();
+        beta = &_one;
 
     int64_t              metadata_offset;
     const unsigned char* metadata;
@@ -392,6 +755,13 @@ rocsparselt_status ConstructRocSparseLtProblem(const char*
         act_args[0] = matmul_descr->activation_tanh_alpha;
         act_args[1] = matmul_descr->activation_tanh_beta;
     }
+    else if(matmul_descr->activation == rocsparselt_matmul_activation_silu)
+    {
+        act_type    = hipsparselt_activation_type::silu;
+        act_args[0] = matmul_descr->activation_silu_beta;
+    }
+    else if(matmul_descr->activation == rocsparselt_matmul_activation_hardswish)
+        act_type = hipsparselt_activation_type::hardswish;
 
     int64_t   _batch_stride_a, _offset_a;
     int64_t   _batch_stride_b, _offset_b;
@@ -416,57 +786,114 @@ rocsparselt_status ConstructRocSparseLtProblem(const char*
         _b              = a;
     }
 
-    (*prob) = new RocsparseltContractionProblem<Ti, To, Tc>(matmul_descr->handle,
-                                                            matmul_descr->_op_A,
-                                                            matmul_descr->_op_B,
-                                                            matmul_descr->matrix_D->order,
-                                                            matmul_descr->_m,
-                                                            matmul_descr->_n,
-                                                            matmul_descr->_k,
-                                                            alpha,
-                                                            _a,
-                                                            nullptr,
-                                                            matmul_descr->_lda,
-                                                            _batch_stride_a,
-                                                            _offset_a,
-                                                            _b,
-                                                            nullptr,
-                                                            matmul_descr->_ldb,
-                                                            _batch_stride_b,
-                                                            _offset_b,
-                                                            beta,
-                                                            c,
-                                                            nullptr,
-                                                            matmul_descr->matrix_C->ld,
-                                                            matmul_descr->matrix_C->batch_stride,
-                                                            offset_c,
-                                                            d,
-                                                            nullptr,
-                                                            matmul_descr->matrix_D->ld,
-                                                            matmul_descr->matrix_D->batch_stride,
-                                                            offset_d,
-                                                            num_batches_a,
-                                                            strided_batch,
-                                                            matmul_descr->_is_sparse_a,
-                                                            metadata,
-                                                            act_type,
-                                                            act_args[0],
-                                                            act_args[1],
-                                                            matmul_descr->bias_pointer,
-                                                            matmul_descr->bias_stride,
-                                                            matmul_descr->bias_type,
-                                                            matmul_descr->alpha_vector_scaling,
-                                                            workspace,
-                                                            workspaceSize,
-                                                            streams,
-                                                            numStreams);
+    // Pointer-array batches: the dense operand, C and D are arrays of one pointer per batch
+    const Ti* const* batch_a = nullptr;
+    const Ti* const* batch_b = nullptr;
+    const To* const* batch_c = nullptr;
+    To* const*       batch_d = nullptr;
+    if(!strided_batch)
+    {
+        if(matmul_descr->_is_sparse_a)
+        {
+            batch_b = reinterpret_cast<const Ti* const*>(_b);
+            _b      = nullptr;
+        }
+        else
+        {
+            batch_a = reinterpret_cast<const Ti* const*>(_a);
+            _a      = nullptr;
+        }
+        batch_c = reinterpret_cast<const To* const*>(c);
+        batch_d = reinterpret_cast<To* const*>(d);
+        c       = nullptr;
+        d       = nullptr;
+    }
+
+    prob.emplace(matmul_descr->handle,
+                 matmul_descr->_op_A,
+                 matmul_descr->_op_B,
+                 matmul_descr->matrix_D->order,
+                 matmul_descr->_m,
+                 matmul_descr->_n,
+                 matmul_descr->_k,
+                 alpha,
+                 _a,
+                 batch_a,
+                 matmul_descr->_lda,
+                 _batch_stride_a,
+                 _offset_a,
+                 _b,
+                 batch_b,
+                 matmul_descr->_ldb,
+                 _batch_stride_b,
+                 _offset_b,
+                 beta,
+                 c,
+                 batch_c,
+                 matmul_descr->matrix_C->ld,
+                 matmul_descr->matrix_C->batch_stride,
+                 offset_c,
+                 d,
+                 batch_d,
+                 matmul_descr->matrix_D->ld,
+                 matmul_descr->matrix_D->batch_stride,
+                 offset_d,
+                 num_batches_a,
+                 strided_batch,
+                 matmul_descr->_is_sparse_a,
+                 metadata,
+                 act_type,
+                 act_args[0],
+                 act_args[1],
+                 matmul_descr->bias_pointer,
+                 matmul_descr->bias_stride,
+                 matmul_descr->bias_type,
+                 matmul_descr->alpha_vector_scaling,
+                 matmul_descr->beta_vector_scaling,
+                 workspace,
+                 workspaceSize,
+                 streams,
+                 numStreams);
+
+    // A and B trade places when swapped, and so do their scales
+    prob->scale_a = matmul_descr->_swap_ab ? matmul_descr->b_scale_pointer
+                                           : matmul_descr->a_scale_pointer;
+    prob->scale_b = matmul_descr->_swap_ab ? matmul_descr->a_scale_pointer
+                                           : matmul_descr->b_scale_pointer;
+    prob->gated   = matmul_descr->gated_epilogue;
+
+    // The scales and maxima of D follow its rows, which swapping A and B keeps
+    prob->scale_d       = matmul_descr->d_scale_pointer;
+    prob->rounding      = matmul_descr->d_rounding_mode;
+    prob->rounding_seed = matmul_descr->d_rounding_seed;
+    prob->amax_d        = matmul_descr->d_amax_pointer;
+
+    // The residual takes the layout of C, including its batch pointers
+    if(strided_batch)
+        prob->residual = reinterpret_cast<const To*>(matmul_descr->residual_pointer);
+    else
+        prob->batch_residual = reinterpret_cast<const To* const*>(matmul_descr->residual_pointer);
+    prob->bias_grad      = matmul_descr->bias_gradient_pointer;
+    prob->bias_grad_mode = matmul_descr->bias_gradient_mode;
+
+    // Weight-only quantized weights are dequantized by the groups of the rows of the
+    // structured matrix, which stay its rows when A and B are swapped
+    if(matmul_descr->is_weight_only())
+    {
+        hipDataType weight_type = matmul_descr->is_sparse_a ? matmul_descr->matrix_A->type
+                                                            : matmul_descr->matrix_B->type;
+        prob->weight_bits       = weight_type == HIP_R_4I ? 4 : 8;
+        prob->weight_scale      = matmul_descr->weight_scale_pointer;
+        prob->weight_zero       = matmul_descr->weight_zero_pointer;
+        prob->weight_group      = matmul_descr->weight_group_size;
+    }
     return rocsparselt_status_success;
 }
 
 #define GENERATE_DEFINITIONS(Ti, To, Tc)                                 \
     template rocsparselt_status ConstructRocSparseLtProblem<Ti, To, Tc>( \
         const char*,                                                     \
-        RocsparseltContractionProblem<Ti, To, Tc>**,                     \
+        std::optional<RocsparseltContractionProblem<Ti, To, Tc>>&,       \
         const _rocsparselt_matmul_descr*,                                \
         const Tc*,                                                       \
         const Tc*,                                                       \
@@ -481,9 +908,21 @@ rocsparselt_status ConstructRocSparseLtProblem(const char*
         int32_t);
 
 GENERATE_DEFINITIONS(__half, __half, float)
+GENERATE_DEFINITIONS(__half, int8_t, float)
+GENERATE_DEFINITIONS(__half, hipsparselt_f8, float)
+GENERATE_DEFINITIONS(__half, hipsparselt_bf8, float)
 GENERATE_DEFINITIONS(hip_bfloat16, hip_bfloat16, float)
+GENERATE_DEFINITIONS(hip_bfloat16, int8_t, float)
+GENERATE_DEFINITIONS(hip_bfloat16, hipsparselt_f8, float)
+GENERATE_DEFINITIONS(hip_bfloat16, hipsparselt_bf8, float)
 GENERATE_DEFINITIONS(int8_t, int8_t, float)
 GENERATE_DEFINITIONS(int8_t, __half, float)
 GENERATE_DEFINITIONS(int8_t, hip_bfloat16, float)
+GENERATE_DEFINITIONS(hipsparselt_f8, __half, float)
+GENERATE_DEFINITIONS(hipsparselt_f8, hip_bfloat16, float)
+GENERATE_DEFINITIONS(hipsparselt_f8, float, float)
+GENERATE_DEFINITIONS(hipsparselt_bf8, __half, float)
+GENERATE_DEFINITIONS(hipsparselt_bf8, hip_bfloat16, float)
+GENERATE_DEFINITIONS(hipsparselt_bf8, float, float)
 
 #undef GENERATE_DEFINITIONS
@@ -31,6 +31,7 @@
 //#include "gemm_tensile.hpp"
 
 #include "handle.h"
+#include "host_spmm.hpp"
 #include "hipsparselt_ostream.hpp"
 #include "utility.hpp"
 #if BUILD_WITH_TENSILE
@@ -38,11 +39,13 @@
 #else
 #include "kernel_launcher.hpp"
 #endif
+#include <optional>
 
 template <typename Ti, typename To = Ti, typename Tc = To>
 rocsparselt_status spmm_typecasting(const char*                     caller,
                                     const _rocsparselt_handle*      handle,
                                     const _rocsparselt_matmul_plan* plan,
+                                    int64_t                         m,
                                     const void*                     alpha,
                                     const void*                     beta,
                                     const void*                     a,
@@ -53,22 +56,40 @@ rocsparselt_status spmm_typecasting(const char*                     caller,
                                     hipStream_t*                    streams,
                                     int32_t                         numStreams,
                                     int*                            config_id,
-                                    const int                       config_max_id,
-                                    const int                       search_iterations)
+                                    int                             config_max_id,
+                                    const int                       search_iterations,
+                                    HostSpmmGroups*                 host_groups)
 {
-    // check alignment of pointers before casting
-    if(!isAligned(a, sizeof(Ti)) || !isAligned(b, sizeof(Ti)) || !isAligned(c, sizeof(Ti))
+    // check alignment of pointers before casting, but for the packed bytes of
+    // weight-only quantized weights
+    bool weight_only = plan->matmul_descr->is_weight_only();
+    bool sparse_a    = plan->matmul_descr->is_sparse_a;
+    if((!(weight_only && sparse_a) && !isAligned(a, sizeof(Ti)))
+       || (!(weight_only && !sparse_a) && !isAligned(b, sizeof(Ti))) || !isAligned(c, sizeof(Ti))
        || !isAligned(d, sizeof(To)))
     {
         hipsparselt_cerr << "memmory is not aligned" << std::endl;
         return rocsparselt_status_invalid_size;
     }
 
-    RocsparseltContractionProblem<Ti, To, Tc>* problem;
+    // A dynamic-M plan runs the best config of the M bucket, unless a config is
+    // being searched for, was set by the user, or must run the split-K request.
+    _rocsparselt_matmul_alg_selection* alg_selection    = plan->alg_selection;
+    _rocsparselt_matmul_config*        configs          = &alg_selection->configs[0];
+    int                                bucket_config_id = 0;
+    if(plan->matmul_descr->dynamic_m_min && !search_iterations && !alg_selection->user_config_id
+       && !alg_selection->split_k)
+    {
+        configs       = &alg_selection->dynamic_m_configs[rocsparselt_dynamic_m_bucket(m)];
+        config_id     = &bucket_config_id;
+        config_max_id = 1;
+    }
+
+    std::optional<RocsparseltContractionProblem<Ti, To, Tc>> problem;
 
     auto status = ConstructRocSparseLtProblem(
         caller,
-        &problem,
+        problem,
         plan->matmul_descr,
         reinterpret_cast<const Tc*>(alpha),
         reinterpret_cast<const Tc*>(beta),
@@ -76,33 +97,52 @@ rocsparselt_status spmm_typecasting(const char*                     caller,
         reinterpret_cast<const Ti*>(b),
         reinterpret_cast<const To*>(c),
         (To*)d,
-        true,
+        !plan->matmul_descr->pointer_array_batch,
         workspace,
-        plan->alg_selection->config_max_id == 0
-            ? 0
-            : plan->alg_selection->configs[plan->alg_selection->config_id].max_workspace_bytes,
+        config_max_id == 0 ? 0 : configs[*config_id].max_workspace_bytes,
         streams,
         numStreams);
 
     if(status != rocsparselt_status_success)
         return status;
 
+    // M is a row count of the dense A, C and D, see rocsparselt_matmul_dynamic_m_min
+    (plan->matmul_descr->_swap_ab ? problem->n : problem->m) = m;
+
+    problem->split_k         = plan->alg_selection->split_k;
+    problem->split_k_mode    = plan->alg_selection->split_k_mode;
+    problem->split_k_buffers = plan->alg_selection->split_k_buffers;
+
+    // The host backend keeps the split-K buffers in the workspace
+    if(handle->backend == rocsparselt_backend_host)
+        problem->workspaceSize = getHostSpmmWorkspaceSize(plan->matmul_descr, alg_selection);
+
+    if(handle->backend == rocsparselt_backend_host && host_groups != nullptr)
+        return appendHostSpmmGroup<Ti, To, Tc>(*host_groups, *problem);
+
+    if(handle->backend == rocsparselt_backend_host)
+        return runContractionProblemHost<Ti, To, Tc>(*problem);
+
     status = runContractionProblem<Ti, To, Tc>(*problem,
 #if BUILD_WITH_TENSILE
-                                               &plan->alg_selection->configs[0],
+                                               configs,
 #endif
+                                               plan->launch_cache,
                                                config_id,
                                                config_max_id,
                                                search_iterations);
 
-    delete problem;
-
     return status;
 }
 
+/*******************************************************************************
+ * Runs the problem of plan, or, with the host backend and host_groups set,
+ * only appends it to host_groups for runGroupedContractionProblemsHost().
+ ******************************************************************************/
 inline rocsparselt_status rocsparselt_spmm_template(const char*                     caller,
                                                     const _rocsparselt_handle*      handle,
                                                     const _rocsparselt_matmul_plan* plan,
+                                                    int64_t                         m,
                                                     const void*                     alpha,
                                                     const void*                     beta,
                                                     const void*                     a,
@@ -114,13 +154,14 @@ inline rocsparselt_status rocsparselt_spmm_template(const char*
                                                     int32_t                         numStreams,
                                                     int*                            config_id,
                                                     const int                       config_max_id,
-                                                    const int search_iterations)
+                                                    const int       search_iterations,
+                                                    HostSpmmGroups* host_groups = nullptr)
 {
     rocsparselt_status rs_status = rocsparselt_status_not_implemented;
 
-#define EX_TYPECASTING_PARM                                                                   \
-    caller, handle, plan, alpha, beta, a, b, c, d, workspace, streams, numStreams, config_id, \
-        config_max_id, search_iterations
+#define EX_TYPECASTING_PARM                                                                      \
+    caller, handle, plan, m, alpha, beta, a, b, c, d, workspace, streams, numStreams, config_id, \
+        config_max_id, search_iterations, host_groups
 
     hipDataType              a_type       = plan->matmul_descr->matrix_A->type;
     hipDataType              b_type       = plan->matmul_descr->matrix_B->type;
@@ -128,6 +169,10 @@ inline rocsparselt_status rocsparselt_spmm_template(const char*
     hipDataType              d_type       = plan->matmul_descr->matrix_D->type;
     rocsparselt_compute_type compute_type = plan->matmul_descr->compute_type;
 
+    // Weight-only quantized weights are dequantized to the type of the dense matrix
+    if(plan->matmul_descr->is_weight_only())
+        a_type = b_type = plan->matmul_descr->input_type();
+
     if(a_type == HIP_R_16F && b_type == HIP_R_16F)
     {
         if(c_type == HIP_R_16F && d_type == HIP_R_16F)
@@ -137,6 +182,27 @@ inline rocsparselt_status rocsparselt_spmm_template(const char*
                 rs_status = spmm_typecasting<__half, __half, float>(EX_TYPECASTING_PARM);
             }
         }
+        else if(c_type == HIP_R_8I && d_type == HIP_R_8I)
+        {
+            if(compute_type == rocsparselt_compute_f32)
+            {
+                rs_status = spmm_typecasting<__half, int8_t, float>(EX_TYPECASTING_PARM);
+            }
+        }
+        else if(c_type == HIP_R_8F_E4M3_FNUZ && d_type == HIP_R_8F_E4M3_FNUZ)
+        {
+            if(compute_type == rocsparselt_compute_f32)
+            {
+                rs_status = spmm_typecasting<__half, hipsparselt_f8, float>(EX_TYPECASTING_PARM);
+            }
+        }
+        else if(c_type == HIP_R_8F_E5M2_FNUZ && d_type == HIP_R_8F_E5M2_FNUZ)
+        {
+            if(compute_type == rocsparselt_compute_f32)
+            {
+                rs_status = spmm_typecasting<__half, hipsparselt_bf8, float>(EX_TYPECASTING_PARM);
+            }
+        }
     }
     else if(a_type == HIP_R_16BF && b_type == HIP_R_16BF)
     {
@@ -148,6 +214,29 @@ inline rocsparselt_status rocsparselt_spmm_template(const char*
                     = spmm_typecasting<hip_bfloat16, hip_bfloat16, float>(EX_TYPECASTING_PARM);
             }
         }
+        else if(c_type == HIP_R_8I && d_type == HIP_R_8I)
+        {
+            if(compute_type == rocsparselt_compute_f32)
+            {
+                rs_status = spmm_typecasting<hip_bfloat16, int8_t, float>(EX_TYPECASTING_PARM);
+            }
+        }
+        else if(c_type == HIP_R_8F_E4M3_FNUZ && d_type == HIP_R_8F_E4M3_FNUZ)
+        {
+            if(compute_type == rocsparselt_compute_f32)
+            {
+                rs_status
+                    = spmm_typecasting<hip_bfloat16, hipsparselt_f8, float>(EX_TYPECASTING_PARM);
+            }
+        }
+        else if(c_type == HIP_R_8F_E5M2_FNUZ && d_type == HIP_R_8F_E5M2_FNUZ)
+        {
+            if(compute_type == rocsparselt_compute_f32)
+            {
+                rs_status
+                    = spmm_typecasting<hip_bfloat16, hipsparselt_bf8, float>(EX_TYPECASTING_PARM);
+            }
+        }
     }
     else if(a_type == HIP_R_8I && b_type == HIP_R_8I)
     {
@@ -173,6 +262,56 @@ inline rocsparselt_status rocsparselt_spmm_template(const char*
             }
         }
     }
+    else if(a_type == HIP_R_8F_E4M3_FNUZ && b_type == HIP_R_8F_E4M3_FNUZ)
+    {
+        if(c_type == HIP_R_16F && d_type == HIP_R_16F)
+        {
+            if(compute_type == rocsparselt_compute_f32)
+            {
+                rs_status = spmm_typecasting<hipsparselt_f8, __half, float>(EX_TYPECASTING_PARM);
+            }
+        }
+        else if(c_type == HIP_R_16BF && d_type == HIP_R_16BF)
+        {
+            if(compute_type == rocsparselt_compute_f32)
+            {
+                rs_status
+                    = spmm_typecasting<hipsparselt_f8, hip_bfloat16, float>(EX_TYPECASTING_PARM);
+            }
+        }
+        else if(c_type == HIP_R_32F && d_type == HIP_R_32F)
+        {
+            if(compute_type == rocsparselt_compute_f32)
+            {
+                rs_status = spmm_typecasting<hipsparselt_f8, float, float>(EX_TYPECASTING_PARM);
+            }
+        }
+    }
+    else if(a_type == HIP_R_8F_E5M2_FNUZ && b_type == HIP_R_8F_E5M2_FNUZ)
+    {
+        if(c_type == HIP_R_16F && d_type == HIP_R_16F)
+        {
+            if(compute_type == rocsparselt_compute_f32)
+            {
+                rs_status = spmm_typecasting<hipsparselt_bf8, __half, float>(EX_TYPECASTING_PARM);
+            }
+        }
+        else if(c_type == HIP_R_16BF && d_type == HIP_R_16BF)
+        {
+            if(compute_type == rocsparselt_compute_f32)
+            {
+                rs_status
+                    = spmm_typecasting<hipsparselt_bf8, hip_bfloat16, float>(EX_TYPECASTING_PARM);
+            }
+        }
+        else if(c_type == HIP_R_32F && d_type == HIP_R_32F)
+        {
+            if(compute_type == rocsparselt_compute_f32)
+            {
+                rs_status = spmm_typecasting<hipsparselt_bf8, float, float>(EX_TYPECASTING_PARM);
+            }
+        }
+    }
     else
     {
         rs_status = rocsparselt_status_not_implemented;
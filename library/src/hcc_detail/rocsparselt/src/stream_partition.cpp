@@ -0,0 +1,91 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "stream_partition.hpp"
+
+#include <algorithm>
+
+std::vector<RocsparseltStreamPartition> rocsparselt_plan_stream_partitions(int64_t batch_count,
+                                                                           int64_t extent,
+                                                                           int64_t tile,
+                                                                           int32_t num_streams)
+{
+    std::vector<RocsparseltStreamPartition> parts;
+
+    // Cuts `units` into `count` contiguous ranges whose sizes differ by at most one
+    auto balance = [](int64_t units, int64_t count, auto&& emit) {
+        for(int64_t i = 0, begin = 0; i < count; i++)
+        {
+            int64_t size = units / count + (i < units % count ? 1 : 0);
+            emit(begin, size);
+            begin += size;
+        }
+    };
+
+    if(num_streams > 1 && batch_count > 1)
+    {
+        balance(batch_count,
+                std::min<int64_t>(num_streams, batch_count),
+                [&](int64_t begin, int64_t size) {
+                    parts.push_back({begin, size, 0, extent});
+                });
+    }
+    else if(num_streams > 1 && batch_count == 1 && tile > 0 && extent > tile)
+    {
+        int64_t tiles = (extent + tile - 1) / tile;
+        balance(tiles, std::min<int64_t>(num_streams, tiles), [&](int64_t begin, int64_t size) {
+            int64_t first = begin * tile;
+            int64_t last  = std::min(extent, (begin + size) * tile);
+            parts.push_back({0, 1, first, last - first});
+        });
+    }
+    else
+        parts.push_back({0, batch_count, 0, extent});
+
+    return parts;
+}
+
+std::vector<RocsparseltGroupLaunch> rocsparselt_schedule_groups(const std::vector<double>& costs,
+                                                                int32_t num_streams)
+{
+    std::vector<RocsparseltGroupLaunch> launches(costs.size());
+    for(size_t i = 0; i < costs.size(); i++)
+        launches[i] = {static_cast<int32_t>(i), 0};
+
+    std::stable_sort(launches.begin(), launches.end(), [&](const auto& a, const auto& b) {
+        return costs[a.group] > costs[b.group];
+    });
+
+    std::vector<double> load(std::max(num_streams, 1), 0.0);
+    for(auto& launch : launches)
+    {
+        launch.stream = static_cast<int32_t>(std::min_element(load.begin(), load.end())
+                                             - load.begin());
+        load[launch.stream] += costs[launch.group];
+    }
+
+    return launches;
+}
@@ -29,8 +29,11 @@
 #include "tensile_host.hpp"
 #include "activation.hpp"
 #include "definitions.h"
+#include "perf_model.hpp"
 #include "rocsparselt_spmm_utils.hpp"
 #include "status.h"
+#include "stream_partition.hpp"
+#include "tuning_db.hpp"
 #include "utility.hpp"
 /*****************************************************************************
  * This is the only file in rocsparselt which should #include Tensile headers    *
@@ -47,14 +50,21 @@
 #include <Tensile/hip/HipHardware.hpp>
 #include <Tensile/hip/HipSolutionAdapter.hpp>
 #include <Tensile/hip/HipUtils.hpp>
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <complex>
 #include <exception>
 #include <iomanip>
+#include <list>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
+#include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 #include <glob.h>
@@ -81,6 +91,9 @@ namespace
     }
 #endif
 
+    // Path of the loaded TensileLibrary file, set once by TensileHost::initialize()
+    std::string tensile_library_path;
+
     /******************************************************
      * Map a rocsparselt type to a corresponding Tensile type *
      ******************************************************/
@@ -102,6 +115,18 @@ namespace
         using tensile_type = Tensile::BFloat16;
     };
 
+    template <>
+    struct rocsparselt_to_tensile_type<hipsparselt_f8>
+    {
+        using tensile_type = Tensile::Float8;
+    };
+
+    template <>
+    struct rocsparselt_to_tensile_type<hipsparselt_bf8>
+    {
+        using tensile_type = Tensile::BFloat8;
+    };
+
     // int8_t -> int8_t (supported for MI-kernel) / rocsparselt_int8x4 -> PackedInt8x4
     template <>
     struct rocsparselt_to_tensile_type<int8_t>
@@ -128,6 +153,12 @@ namespace
     template <>
     constexpr auto tensile_datatype<float> = Tensile::DataType::Float;
 
+    template <>
+    constexpr auto tensile_datatype<hipsparselt_f8> = Tensile::DataType::Float8;
+
+    template <>
+    constexpr auto tensile_datatype<hipsparselt_bf8> = Tensile::DataType::BFloat8;
+
     /*************************************************************************
      * Class for converting alpha and beta between rocsparselt and Tensile types *
      * By default, alpha and beta are the same type as Tc compute_type       *
@@ -161,6 +192,10 @@ namespace
             return Tensile::DataType::BFloat16;
         case HIP_R_8I:
             return Tensile::DataType::Int8;
+        case HIP_R_8F_E4M3_FNUZ:
+            return Tensile::DataType::Float8;
+        case HIP_R_8F_E5M2_FNUZ:
+            return Tensile::DataType::BFloat8;
         default:
             assert(!"hipblasltDatatype_to_tensile_type: non-supported type");
             return Tensile::DataType::None;
@@ -574,6 +609,19 @@ namespace
                     path += "/" + processor;
             }
 
+#ifdef HIPSPARSELT_TENSILE_LAZY_LOAD
+            // Code objects are loaded on first use of a solution, so only the
+            // problem types the application runs are loaded
+            if(adapter.initializeLazyLoading(processor, path) != hipSuccess)
+            {
+                static hipsparselt_internal_ostream& once
+                    = hipsparselt_cerr
+                      << "\nrocsparselt warning: Could not initialize lazy loading from " << path
+                      << ". Make sure that ROCSPARSELT_TENSILE_LIBPATH is set correctly."
+                      << std::endl;
+                (void)once;
+            }
+#else
             // only load modules for the current architecture
             auto dir = path + "/*" + processor + "*co";
 
@@ -630,17 +678,26 @@ namespace
                       << std::endl;
                 (void)once;
             }
+#endif
 
             // We initialize a local static variable with a lambda function call to avoid
             // race conditions when multiple threads with different device IDs try to
             // initialize library. This ensures that only one thread initializes library,
             // and other threads trying to initialize library wait for it to complete.
             static int once = [&] {
+#ifdef HIPSPARSELT_TENSILE_LAZY_LOAD
+                // The lazy master library only holds the problem type index; the
+                // logic of a problem type is deserialized on its first lookup
+                path += "/TensileLibrary_lazy_" + processor;
+#else
+                path += "/TensileLibrary";
+#endif
 #ifdef TENSILE_YAML
-                path += "/TensileLibrary.yaml";
+                path += ".yaml";
 #else
-                path += "/TensileLibrary.dat";
+                path += ".dat";
 #endif
+                tensile_library_path = path;
                 if(!TestPath(path))
                 {
                     hipsparselt_cerr << "\nhipsparselt_error: Cannot read " << path << ": "
@@ -758,6 +815,540 @@ namespace
             hipsparselt_cerr << msg << std::endl;
     }
 
+    /**************************************************************************
+     * The stream of partition i of a launch. Without streams, the problem    *
+     * runs on the null stream.                                               *
+     **************************************************************************/
+    template <typename Ti, typename To, typename Tc>
+    hipStream_t LaunchStream(const RocsparseltContractionProblem<Ti, To, Tc>& prob, size_t i = 0)
+    {
+        return prob.numStreams > 0 ? prob.streams[i] : nullptr;
+    }
+
+    /**************************************************************************
+     * The part of a problem covered by a stream partition, with its own      *
+     * slice of the workspace. A single batch is cut along the rows of D when *
+     * B is sparse and along the columns when A is sparse, so only the dense  *
+     * operand is offset by rows or columns. A partition of a pointer-array   *
+     * problem covers one batch, whose pointers are read from the arrays, and *
+     * is a strided problem of its own.                                       *
+     **************************************************************************/
+    template <typename Ti, typename To, typename Tc>
+    RocsparseltContractionProblem<Ti, To, Tc>
+        PartitionProblem(const RocsparseltContractionProblem<Ti, To, Tc>& prob,
+                         const RocsparseltStreamPartition&                part,
+                         size_t                                           workspace_slice,
+                         size_t                                           index)
+    {
+        RocsparseltContractionProblem<Ti, To, Tc> sub = prob;
+
+        size_t batch       = part.batch_begin;
+        size_t sparse_size = prob.sparseA ? prob.batch_stride_a : prob.batch_stride_b;
+        size_t bias_size   = prob.bias_type == HIP_R_32F ? 4 : 2;
+
+        sub.batch_count = part.batch_count;
+
+        sub.A = prob.batch_A ? prob.batch_A[batch] : prob.A + batch * prob.batch_stride_a;
+        sub.B = prob.batch_B ? prob.batch_B[batch] : prob.B + batch * prob.batch_stride_b;
+        sub.C = prob.batch_C ? prob.batch_C[batch] : prob.C + batch * prob.batch_stride_c;
+        sub.D = prob.batch_D ? prob.batch_D[batch] : prob.D + batch * prob.batch_stride_d;
+        if(!prob.strided_batch)
+        {
+            sub.strided_batch = true;
+            sub.batch_A       = nullptr;
+            sub.batch_B       = nullptr;
+            sub.batch_C       = nullptr;
+            sub.batch_D       = nullptr;
+        }
+        if(prob.metadata)
+            sub.metadata = prob.metadata + batch * (sparse_size / 4);
+        if(prob.bias_vector)
+            sub.bias_vector = static_cast<const char*>(prob.bias_vector)
+                              + batch * prob.bias_stride * bias_size;
+
+        size_t begin   = part.begin;
+        bool   split_m = !prob.sparseA;
+        if(split_m)
+        {
+            sub.m = part.count;
+            sub.A += begin
+                     * (prob.trans_a == rocsparselt_operation_none ? prob.row_stride_a
+                                                                   : prob.col_stride_a);
+            sub.C += begin * prob.row_stride_c;
+            sub.D += begin * prob.row_stride_d;
+        }
+        else
+        {
+            sub.n = part.count;
+            sub.B += begin
+                     * (prob.trans_b == rocsparselt_operation_none ? prob.col_stride_b
+                                                                   : prob.row_stride_b);
+            sub.C += begin * prob.col_stride_c;
+            sub.D += begin * prob.col_stride_d;
+        }
+
+        // The alpha, beta and bias vectors run along M in column order and along N in row order
+        if(split_m == (prob.order == rocsparselt_order_column))
+        {
+            if(prob.alpha_vector_scaling)
+                sub.alpha = prob.alpha + begin;
+            if(prob.beta_vector_scaling)
+                sub.beta = prob.beta + begin;
+            if(sub.bias_vector)
+                sub.bias_vector = static_cast<const char*>(sub.bias_vector) + begin * bias_size;
+        }
+
+        sub.workspace = prob.workspace == nullptr
+                            ? nullptr
+                            : static_cast<char*>(prob.workspace) + index * workspace_slice;
+        sub.workspaceSize = workspace_slice;
+        return sub;
+    }
+
+    /**************************************************************************
+     * Batch `batch` of a pointer-array problem, as a strided problem of one  *
+     * batch. The batches differ only in their pointers, so batch 0 stands    *
+     * for the whole problem when solutions are selected and timed.           *
+     **************************************************************************/
+    template <typename Ti, typename To, typename Tc>
+    RocsparseltContractionProblem<Ti, To, Tc>
+        PointerArrayBatch(const RocsparseltContractionProblem<Ti, To, Tc>& prob, int64_t batch)
+    {
+        int64_t extent = prob.sparseA ? prob.n : prob.m;
+        return PartitionProblem(prob, {batch, 1, 0, extent}, prob.workspaceSize, 0);
+    }
+
+    /**************************************************************************
+     * Whether D overwrites C. The batches of a pointer-array problem do when *
+     * C and D are the same array.                                            *
+     **************************************************************************/
+    template <typename Ti, typename To, typename Tc>
+    bool CEqualsD(const RocsparseltContractionProblem<Ti, To, Tc>& prob)
+    {
+        return prob.strided_batch ? prob.C == prob.D
+                                  : static_cast<const void*>(prob.batch_C)
+                                        == static_cast<const void*>(prob.batch_D);
+    }
+
+    /**************************************************************************
+     * A stream partition with the Tensile problem and solution which run it, *
+     * and the index of its stream                                            *
+     **************************************************************************/
+    struct TensilePartition
+    {
+        RocsparseltStreamPartition                    range;
+        size_t                                        stream;
+        Tensile::ContractionProblemGemm               problem;
+        std::shared_ptr<Tensile::ContractionSolution> solution;
+    };
+
+    /**************************************************************************
+     * Splits a problem over num_streams streams, see stream_partition.hpp.   *
+     * Returns no partitions when the problem runs on a single stream,        *
+     * including when the selected solution does not accept a partition or    *
+     * its workspace slice.                                                   *
+     *                                                                        *
+     * Tensile launches a pointer-array problem one batch at a time, so it    *
+     * always gets partitions, one per batch and ordered by stream. Those go  *
+     * to stream 0 alone when the solution does not accept a split.           *
+     **************************************************************************/
+    template <typename Ti, typename To, typename Tc>
+    std::vector<TensilePartition> PlanPartitions(
+        const RocsparseltContractionProblem<Ti, To, Tc>&                        prob,
+        int32_t                                                                num_streams,
+        const _rocsparselt_matmul_config&                                       config,
+        const Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>& library,
+        const Tensile::Hardware&                                               hardware,
+        const Tensile::ContractionSolution&                                    solution,
+        size_t&                                                                workspace_slice)
+    {
+        std::vector<TensilePartition> partitions;
+        bool                          pointer_array = !prob.strided_batch;
+        if(num_streams < 2 && !pointer_array)
+            return partitions;
+
+        const auto& macro_tile = solution.sizeMapping.macroTile;
+        bool        split_m    = !prob.sparseA;
+        auto        ranges     = rocsparselt_plan_stream_partitions(prob.batch_count,
+                                                           split_m ? prob.m : prob.n,
+                                                           split_m ? macro_tile.x : macro_tile.y,
+                                                           num_streams);
+        if(ranges.size() < 2 && !pointer_array)
+            return partitions;
+
+        workspace_slice = prob.workspace == nullptr ? 0 : prob.workspaceSize / ranges.size();
+        if(ranges.size() > 1)
+            workspace_slice -= workspace_slice % 256;
+
+        for(size_t i = 0; i < ranges.size(); i++)
+        {
+            auto    range = ranges[i];
+            int64_t last  = range.batch_begin + range.batch_count;
+            if(pointer_array)
+                range.batch_count = 1;
+
+            for(; range.batch_begin < last; range.batch_begin += range.batch_count)
+            {
+                auto sub = PartitionProblem(prob, range, workspace_slice, i);
+                auto problem
+                    = ConstructTensileProblem(sub, config.use_bias, config.use_scale_alpha_vec);
+                auto part_solution = library.getSolutionByIndex(problem, hardware, config.index);
+                if(!part_solution
+                   || part_solution->requiredWorkspaceSize(problem, hardware) > workspace_slice)
+                {
+                    if(pointer_array && num_streams > 1)
+                        return PlanPartitions(
+                            prob, 1, config, library, hardware, solution, workspace_slice);
+                    return {};
+                }
+                partitions.push_back({range, i, std::move(problem), std::move(part_solution)});
+            }
+        }
+        return partitions;
+    }
+
+    /**************************************************************************
+     * TensileLaunchState is the backend state kept in a plan's launch cache. *
+     * It holds everything runContractionProblem derives from the plan, so    *
+     * that later launches only rebuild the Tensile inputs.                   *
+     **************************************************************************/
+    template <typename Ti, typename To, typename Tc>
+    struct TensileLaunchState
+    {
+        // Values which change the Tensile problem or the selected solution
+        int     solution_index;
+        int     use_bias;
+        int     use_scale_alpha_vec;
+        bool    c_equals_d;
+        Tc      alpha;
+        Tc      beta;
+        size_t  workspace_size;
+        int32_t num_streams;
+        size_t  m; // may change with each call of a dynamic-M plan
+        size_t  n;
+
+        Tensile::hip::SolutionAdapter*                adapter;
+        std::shared_ptr<Tensile::Hardware>            hardware;
+        Tensile::ContractionProblemGemm               problem;
+        std::shared_ptr<Tensile::ContractionSolution> solution;
+
+        // Empty when the problem runs in one launch
+        std::vector<TensilePartition> partitions;
+        size_t                        workspace_slice;
+
+        TensileLaunchState(const RocsparseltContractionProblem<Ti, To, Tc>& prob,
+                           const _rocsparselt_matmul_config&                config,
+                           Tensile::hip::SolutionAdapter*                   adapter,
+                           std::shared_ptr<Tensile::Hardware>               hardware,
+                           Tensile::ContractionProblemGemm                  problem,
+                           std::shared_ptr<Tensile::ContractionSolution>    solution,
+                           std::vector<TensilePartition>                    partitions,
+                           size_t                                           workspace_slice)
+            : solution_index(config.index)
+            , use_bias(config.use_bias)
+            , use_scale_alpha_vec(config.use_scale_alpha_vec)
+            , c_equals_d(CEqualsD(prob))
+            , alpha(alphaKey(prob))
+            , beta(*prob.beta)
+            , workspace_size(prob.workspaceSize)
+            , num_streams(prob.numStreams)
+            , m(prob.m)
+            , n(prob.n)
+            , adapter(adapter)
+            , hardware(std::move(hardware))
+            , problem(std::move(problem))
+            , solution(std::move(solution))
+            , partitions(std::move(partitions))
+            , workspace_slice(workspace_slice)
+        {
+        }
+
+        // alpha is a device vector when alpha_vector_scaling is enabled
+        static Tc alphaKey(const RocsparseltContractionProblem<Ti, To, Tc>& prob)
+        {
+            return prob.alpha_vector_scaling ? static_cast<Tc>(1) : *prob.alpha;
+        }
+
+        bool matches(const RocsparseltContractionProblem<Ti, To, Tc>& prob,
+                     const _rocsparselt_matmul_config&                config) const
+        {
+            return solution_index == config.index && use_bias == config.use_bias
+                   && use_scale_alpha_vec == config.use_scale_alpha_vec
+                   && c_equals_d == CEqualsD(prob) && alpha == alphaKey(prob)
+                   && beta == *prob.beta && workspace_size == prob.workspaceSize
+                   && num_streams == prob.numStreams && m == prob.m && n == prob.n;
+        }
+    };
+
+    /**************************************************************************
+     * Runs the partitions in order, each on its stream. Stream 0 records a   *
+     * fork event which every other stream waits for before its first         *
+     * partition, and waits for the join event each of them records after     *
+     * its last one. The events belong to the plan's launch cache and are     *
+     * reused, so the sequence is enqueued under its lock. Partitions which   *
+     * all run on stream 0 need neither.                                      *
+     **************************************************************************/
+    template <typename Ti, typename To, typename Tc>
+    rocsparselt_status LaunchPartitions(const TensileLaunchState<Ti, To, Tc>&            state,
+                                        const RocsparseltContractionProblem<Ti, To, Tc>& prob,
+                                        _rocsparselt_matmul_launch_cache* launch_cache)
+    {
+        const auto&                  partitions  = state.partitions;
+        size_t                       num_streams = partitions.back().stream + 1;
+        std::unique_lock<std::mutex> lock;
+        hipStream_t                  stream0 = LaunchStream(prob);
+
+        if(num_streams > 1)
+        {
+            lock = std::unique_lock<std::mutex>(launch_cache->mutex);
+
+            auto& events = launch_cache->events;
+            while(events.size() < num_streams)
+            {
+                hipEvent_t event;
+                RETURN_IF_HIP_ERROR(hipEventCreateWithFlags(&event, hipEventDisableTiming));
+                events.push_back(event);
+            }
+            RETURN_IF_HIP_ERROR(hipEventRecord(events[0], stream0));
+        }
+
+        for(size_t i = 0; i < partitions.size(); i++)
+        {
+            const auto& part   = partitions[i];
+            size_t      s      = part.stream;
+            hipStream_t stream = LaunchStream(prob, s);
+            bool        first  = i == 0 || partitions[i - 1].stream != s;
+            bool        last   = i + 1 == partitions.size() || partitions[i + 1].stream != s;
+            if(s > 0 && first)
+                RETURN_IF_HIP_ERROR(hipStreamWaitEvent(stream, launch_cache->events[0], 0));
+
+            auto sub     = PartitionProblem(prob, part.range, state.workspace_slice, s);
+            auto inputs  = GetTensileInputs(sub);
+            auto kernels = part.solution->solve(part.problem, inputs, *state.hardware);
+            RETURN_IF_HIP_ERROR(state.adapter->launchKernels(kernels, stream, nullptr, nullptr));
+
+            if(s > 0 && last)
+            {
+                RETURN_IF_HIP_ERROR(hipEventRecord(launch_cache->events[s], stream));
+                RETURN_IF_HIP_ERROR(hipStreamWaitEvent(stream0, launch_cache->events[s], 0));
+            }
+        }
+        return rocsparselt_status_success;
+    }
+
+    /**************************************************************************
+     * SolutionMemo is a process-wide, sharded LRU cache of getBestSolutions() *
+     * results. It is keyed by every field of the problem which affects the   *
+     * Tensile solution lookup, and also remembers problems without solution. *
+     * The total capacity is read from ROCSPARSELT_SOLUTION_CACHE_SIZE        *
+     * (default 1024 entries, 0 disables the cache).                          *
+     **************************************************************************/
+    class SolutionMemo
+    {
+    public:
+        using Key     = std::array<int64_t, 36>;
+        using Configs = std::vector<_rocsparselt_matmul_config>;
+
+        static SolutionMemo& instance()
+        {
+            static SolutionMemo memo;
+            return memo;
+        }
+
+        bool find(const Key& key, Configs& configs)
+        {
+            if(m_shard_capacity == 0)
+                return false;
+
+            auto&                       shard = m_shards[KeyHash{}(key) % NumShards];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            auto it = shard.map.find(key);
+            if(it == shard.map.end())
+            {
+                m_misses.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            // move to the front of the LRU list
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            configs = it->second->second;
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        void insert(const Key& key, Configs configs)
+        {
+            if(m_shard_capacity == 0)
+                return;
+
+            auto&                       shard = m_shards[KeyHash{}(key) % NumShards];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            auto it = shard.map.find(key);
+            if(it != shard.map.end())
+            {
+                it->second->second = std::move(configs);
+                shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+                return;
+            }
+
+            shard.lru.emplace_front(key, std::move(configs));
+            shard.map.emplace(key, shard.lru.begin());
+            if(shard.map.size() > m_shard_capacity)
+            {
+                shard.map.erase(shard.lru.back().first);
+                shard.lru.pop_back();
+            }
+        }
+
+        uint64_t hits() const
+        {
+            return m_hits.load(std::memory_order_relaxed);
+        }
+
+        uint64_t misses() const
+        {
+            return m_misses.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr size_t NumShards = 16;
+
+        struct KeyHash
+        {
+            size_t operator()(const Key& key) const
+            {
+                // FNV-1a over the key fields
+                uint64_t hash = 0xcbf29ce484222325ull;
+                for(auto value : key)
+                {
+                    hash ^= static_cast<uint64_t>(value);
+                    hash *= 0x100000001b3ull;
+                }
+                return hash ^ (hash >> 32);
+            }
+        };
+
+        struct Shard
+        {
+            using Entry = std::pair<Key, Configs>;
+
+            std::mutex                                                         mutex;
+            std::list<Entry>                                                   lru;
+            std::unordered_map<Key, typename std::list<Entry>::iterator, KeyHash> map;
+        };
+
+        SolutionMemo()
+        {
+            const char* env      = getenv("ROCSPARSELT_SOLUTION_CACHE_SIZE");
+            size_t      capacity = env ? strtoul(env, nullptr, 10) : 1024;
+            m_shard_capacity     = (capacity + NumShards - 1) / NumShards;
+        }
+
+        size_t                m_shard_capacity;
+        Shard                 m_shards[NumShards];
+        std::atomic<uint64_t> m_hits{0};
+        std::atomic<uint64_t> m_misses{0};
+    };
+
+    /*************************************************************************
+     * Canonical SolutionMemo key of a problem. It covers everything which   *
+     * ConstructTensileProblem() reads, plus the device and requestConfigs.  *
+     *************************************************************************/
+    template <typename Ti, typename To, typename Tc>
+    SolutionMemo::Key MakeSolutionKey(const RocsparseltContractionProblem<Ti, To, Tc>& prob,
+                                      int requestConfigs)
+    {
+        auto bits = [](double value) {
+            int64_t result;
+            memcpy(&result, &value, sizeof(result));
+            return result;
+        };
+
+        // same alpha as the Tensile alpha restriction
+        Tc alpha = prob.k ? (prob.alpha_vector_scaling ? static_cast<Tc>(1) : *prob.alpha)
+                          : static_cast<Tc>(0);
+
+        return {prob.handle->device,
+                static_cast<int64_t>(tensile_datatype<Ti>),
+                static_cast<int64_t>(tensile_datatype<To>),
+                static_cast<int64_t>(tensile_datatype<Tc>),
+                prob.trans_a,
+                prob.trans_b,
+                prob.order,
+                static_cast<int64_t>(prob.m),
+                static_cast<int64_t>(prob.n),
+                static_cast<int64_t>(prob.k && *prob.alpha ? prob.k : 0),
+                static_cast<int64_t>(prob.batch_count),
+                static_cast<int64_t>(prob.row_stride_a),
+                static_cast<int64_t>(prob.col_stride_a),
+                static_cast<int64_t>(prob.batch_stride_a),
+                static_cast<int64_t>(prob.row_stride_b),
+                static_cast<int64_t>(prob.col_stride_b),
+                static_cast<int64_t>(prob.batch_stride_b),
+                static_cast<int64_t>(prob.row_stride_c),
+                static_cast<int64_t>(prob.col_stride_c),
+                static_cast<int64_t>(prob.batch_stride_c),
+                static_cast<int64_t>(prob.row_stride_d),
+                static_cast<int64_t>(prob.col_stride_d),
+                static_cast<int64_t>(prob.batch_stride_d),
+                bits(static_cast<double>(alpha)),
+                bits(static_cast<double>(*prob.beta)),
+                static_cast<int64_t>(prob.workspaceSize),
+                prob.strided_batch,
+                prob.C == prob.D,
+                prob.sparseA,
+                static_cast<int64_t>(prob.act_type),
+                prob.act_arg0 == 1.f,
+                prob.bias_vector != nullptr,
+                prob.bias_vector != nullptr ? static_cast<int64_t>(prob.bias_type) : 0,
+                prob.bias_stride,
+                prob.alpha_vector_scaling,
+                requestConfigs};
+    }
+
+    /*************************************************************************
+     * Inputs of the cost model (perf_model.hpp) for a problem, a solution   *
+     * and the device                                                        *
+     *************************************************************************/
+    template <typename Ti, typename To, typename Tc>
+    RocsparseltModelProblem MakeModelProblem(const RocsparseltContractionProblem<Ti, To, Tc>& prob)
+    {
+        return {static_cast<int64_t>(prob.m),
+                static_cast<int64_t>(prob.n),
+                static_cast<int64_t>(prob.k && *prob.alpha ? prob.k : 0),
+                static_cast<int64_t>(prob.batch_count),
+                static_cast<int32_t>(sizeof(Ti)),
+                static_cast<int32_t>(sizeof(Ti)),
+                static_cast<int32_t>(sizeof(To)),
+                static_cast<int32_t>(sizeof(Tc)),
+                prob.sparseA,
+                std::is_same<Ti, int8_t>{}};
+    }
+
+    RocsparseltModelKernel MakeModelKernel(const Tensile::ContractionSolution& solution)
+    {
+        auto& sizes = solution.sizeMapping;
+        return {static_cast<int64_t>(sizes.macroTile.x),
+                static_cast<int64_t>(sizes.macroTile.y),
+                static_cast<int64_t>(sizes.depthU),
+                static_cast<int64_t>(sizes.globalSplitU),
+                static_cast<int32_t>(sizes.workGroupSize.x * sizes.workGroupSize.y
+                                     * sizes.workGroupSize.z)};
+    }
+
+    RocsparseltModelDevice MakeModelDevice(const hipDeviceProp_t& prop)
+    {
+        return rocsparselt_model_device(prop.gcnArchName,
+                                        prop.multiProcessorCount,
+                                        prop.maxSharedMemoryPerMultiProcessor,
+                                        prop.maxThreadsPerMultiProcessor,
+                                        prop.clockRate,
+                                        prop.memoryClockRate,
+                                        prop.memoryBusWidth);
+    }
+
 } // namespace
 
 /******************************************************************************
@@ -767,23 +1358,26 @@ namespace
 template <typename Ti, typename To, typename Tc>
 rocsparselt_status runContractionProblem(const RocsparseltContractionProblem<Ti, To, Tc>& prob,
                                          _rocsparselt_matmul_config*                      configs,
+                                         _rocsparselt_matmul_launch_cache* launch_cache,
                                          int*                                             config_id,
                                          const int config_max_id,
                                          const int search_iterations)
 {
+    using LaunchState = TensileLaunchState<Ti, To, Tc>;
+
     rocsparselt_status                            status = rocsparselt_status_internal_error;
     std::shared_ptr<Tensile::ContractionSolution> solution;
 
+    auto status_support = checkDeviceSupport(__func__, prob);
+    if(status_support != rocsparselt_status_success)
+        return status_support;
+
     try
     {
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>> library;
         std::shared_ptr<hipDeviceProp_t>                                                 deviceProp;
         std::shared_ptr<Tensile::Hardware>                                               hardware;
 
-        auto& adapter = get_library_and_adapter(&library, &deviceProp, prob.handle->device);
-
-        hardware = Tensile::hip::GetDevice(*deviceProp);
-
         if(!config_max_id || configs == nullptr)
         {
             hipsparselt_internal_ostream msg;
@@ -792,11 +1386,6 @@ rocsparselt_status runContractionProblem(const RocsparseltContractionProblem<Ti,
         }
         else
         {
-            auto tensile_prob = ConstructTensileProblem(
-                prob, configs[*config_id].use_bias, configs[*config_id].use_scale_alpha_vec);
-
-            auto tensile_inputs = GetTensileInputs(prob);
-
             if(!search_iterations)
             {
                 if(configs[*config_id].max_workspace_bytes > prob.workspaceSize
@@ -808,30 +1397,102 @@ rocsparselt_status runContractionProblem(const RocsparseltContractionProblem<Ti,
                     return rocsparselt_status_internal_error;
                 }
 
-                solution = library->getSolutionByIndex(
-                    tensile_prob, *hardware, configs[*config_id].index);
-                if(!solution)
+                std::shared_ptr<const LaunchState> state;
+                if(launch_cache)
                 {
-                    hipsparselt_cerr << "Solution of config:" << *config_id
-                                     << " does not exists - skip" << std::endl;
-                    return rocsparselt_status_not_implemented;
+                    std::lock_guard<std::mutex> lock(launch_cache->mutex);
+                    state = std::static_pointer_cast<const LaunchState>(launch_cache->state);
                 }
 
-                RETURN_IF_HIP_ERROR(
-                    adapter.launchKernels(solution->solve(tensile_prob, tensile_inputs, *hardware),
-                                          prob.streams[0],
-                                          nullptr,
-                                          nullptr));
+                // Build the Tensile problem and look up the solution only when the plan
+                // has not been launched yet, or the selected config/scalars changed.
+                if(!state || !state->matches(prob, configs[*config_id]))
+                {
+                    auto& adapter
+                        = get_library_and_adapter(&library, &deviceProp, prob.handle->device);
+                    hardware = Tensile::hip::GetDevice(*deviceProp);
+
+                    auto tensile_prob = ConstructTensileProblem(
+                        prob.strided_batch ? prob : PointerArrayBatch(prob, 0),
+                        configs[*config_id].use_bias,
+                        configs[*config_id].use_scale_alpha_vec);
+
+                    solution = library->getSolutionByIndex(
+                        tensile_prob, *hardware, configs[*config_id].index);
+                    if(!solution)
+                    {
+                        hipsparselt_cerr << "Solution of config:" << *config_id
+                                         << " does not exists - skip" << std::endl;
+                        return rocsparselt_status_not_implemented;
+                    }
+
+                    // Multi-stream launches need the plan's events
+                    std::vector<TensilePartition> partitions;
+                    size_t                        workspace_slice = 0;
+                    if(launch_cache || !prob.strided_batch)
+                        partitions = PlanPartitions(prob,
+                                                    launch_cache ? prob.numStreams : 1,
+                                                    configs[*config_id],
+                                                    *library,
+                                                    *hardware,
+                                                    *solution,
+                                                    workspace_slice);
+                    if(partitions.empty() && !prob.strided_batch)
+                    {
+                        hipsparselt_cerr << "Solution of config:" << *config_id
+                                         << " does not run the batches of a pointer array - skip"
+                                         << std::endl;
+                        return rocsparselt_status_not_implemented;
+                    }
+
+                    state = std::make_shared<const LaunchState>(prob,
+                                                                configs[*config_id],
+                                                                &adapter,
+                                                                hardware,
+                                                                std::move(tensile_prob),
+                                                                solution,
+                                                                std::move(partitions),
+                                                                workspace_slice);
+                    if(launch_cache)
+                    {
+                        std::lock_guard<std::mutex> lock(launch_cache->mutex);
+                        launch_cache->state = state;
+                    }
+                }
+                solution = state->solution;
+
+                if(!state->partitions.empty())
+                    RETURN_IF_ROCSPARSELT_ERROR(LaunchPartitions(*state, prob, launch_cache));
+                else
+                {
+                    auto tensile_inputs = GetTensileInputs(prob);
+                    RETURN_IF_HIP_ERROR(state->adapter->launchKernels(
+                        state->solution->solve(state->problem, tensile_inputs, *state->hardware),
+                        LaunchStream(prob),
+                        nullptr,
+                        nullptr));
+                }
             }
             else
             {
-                float      min_ms = std::numeric_limits<float>::max();
-                hipEvent_t startEvent, stopEvent;
-                float      ms, sum_ms;
-                RETURN_IF_HIP_ERROR(hipEventCreate(&startEvent));
-                RETURN_IF_HIP_ERROR(hipEventCreate(&stopEvent));
+                auto& adapter = get_library_and_adapter(&library, &deviceProp, prob.handle->device);
+                hardware      = Tensile::hip::GetDevice(*deviceProp);
+
+                // Only the first batch of a pointer-array problem is timed
+                auto timed = prob.strided_batch ? prob : PointerArrayBatch(prob, 0);
+
+                auto tensile_prob = ConstructTensileProblem(
+                    timed, configs[*config_id].use_bias, configs[*config_id].use_scale_alpha_vec);
+                auto tensile_inputs = GetTensileInputs(timed);
+
+                std::vector<int>                                           candidates;
+                std::vector<std::shared_ptr<Tensile::ContractionSolution>> solutions(
+                    config_max_id);
                 for(int id = 0; id < config_max_id; id++)
                 {
+                    if(!configs[id].matches_split_k(prob.split_k, prob.split_k_mode))
+                        continue;
+
                     if(configs[id].max_workspace_bytes > prob.workspaceSize
                        || (configs[id].max_workspace_bytes > 0 && prob.workspace == nullptr))
                     {
@@ -841,46 +1502,67 @@ rocsparselt_status runContractionProblem(const RocsparseltContractionProblem<Ti,
                         continue;
                     }
 
-                    solution
+                    solutions[id]
                         = library->getSolutionByIndex(tensile_prob, *hardware, configs[id].index);
-                    if(!solution)
+                    if(!solutions[id])
                     {
                         hipsparselt_cerr << "Solution of config:" << id << " does not exists - skip"
                                          << std::endl;
                         continue;
                     }
+                    candidates.push_back(id);
+                }
 
-                    //warm up
+                // every sample of each candidate, warm-up first
+                std::map<int, std::vector<float>> timings;
+
+                hipEvent_t startEvent = prob.handle->search_start;
+                hipEvent_t stopEvent  = prob.handle->search_stop;
+                auto       sample     = [&](int id, float& ms) -> rocsparselt_status {
+                    solution = solutions[id];
                     RETURN_IF_HIP_ERROR(adapter.launchKernels(
                         solution->solve(tensile_prob, tensile_inputs, *hardware),
-                        prob.streams[0],
-                        nullptr,
-                        nullptr));
+                        LaunchStream(prob),
+                        startEvent,
+                        stopEvent));
+                    RETURN_IF_HIP_ERROR(hipEventSynchronize(stopEvent));
+                    RETURN_IF_HIP_ERROR(hipEventElapsedTime(&ms, startEvent, stopEvent));
+                    timings[id].push_back(ms);
+                    return rocsparselt_status_success;
+                };
 
-                    sum_ms = 0.0f;
-                    for(int i = 0; i < search_iterations; i++)
-                    {
-                        RETURN_IF_HIP_ERROR(adapter.launchKernels(
-                            solution->solve(tensile_prob, tensile_inputs, *hardware),
-                            prob.streams[0],
-                            startEvent,
-                            stopEvent));
-                        RETURN_IF_HIP_ERROR(hipEventSynchronize(stopEvent));
-                        RETURN_IF_HIP_ERROR(hipEventElapsedTime(&ms, startEvent, stopEvent));
-                        sum_ms += ms;
-                    }
+                RocsparseltSearchOptions options = prob.handle->search_options;
+                options.iterations               = search_iterations;
+                RETURN_IF_ROCSPARSELT_ERROR(
+                    rocsparselt_make_search_strategy(options)->run(candidates, sample, *config_id));
 
-                    if(sum_ms < min_ms)
+                // Validate the cost model against the timed samples
+                if(prob.handle->layer_mode & rocsparselt_layer_mode_log_info)
+                {
+                    auto                model  = MakeModelProblem(timed);
+                    auto                device = MakeModelDevice(*deviceProp);
+                    std::vector<double> predicted, measured;
+                    for(auto& timing : timings)
                     {
-                        min_ms     = sum_ms;
-                        *config_id = id;
+                        if(timing.second.size() < 2)
+                            continue;
+                        predicted.push_back(rocsparselt_model_time_us(
+                            model, MakeModelKernel(*solutions[timing.first]), device));
+                        std::vector<float> samples(timing.second.begin() + 1, timing.second.end());
+                        measured.push_back(rocsparselt_sample_stats(std::move(samples)).median);
                     }
+                    auto agreement = rocsparselt_model_agreement(predicted, measured);
+                    log_info(prob.handle,
+                             __func__,
+                             "cost model vs. search, candidates",
+                             predicted.size(),
+                             "spearman",
+                             agreement.spearman,
+                             "kendall",
+                             agreement.kendall,
+                             "regret",
+                             agreement.regret);
                 }
-                RETURN_IF_HIP_ERROR(hipEventDestroy(startEvent));
-                RETURN_IF_HIP_ERROR(hipEventDestroy(stopEvent));
-
-                if(min_ms == std::numeric_limits<float>::max())
-                    return rocsparselt_status_internal_error;
             }
 
             status = rocsparselt_status_success;
@@ -904,7 +1586,8 @@ rocsparselt_status runContractionProblem(const RocsparseltContractionProblem<Ti,
 
 /******************************************************************************
  * getBestSolutions calls Tensile's findTopSolutions and converts to          *
- * _rocsparselt_matmul_config.                                                *
+ * _rocsparselt_matmul_config. Up to requestConfigs split-K solutions follow  *
+ * the top ones, so configs must hold 2 * requestConfigs entries.             *
  ******************************************************************************/
 template <typename Ti, typename To, typename Tc>
 rocsparselt_status getBestSolutions(const RocsparseltContractionProblem<Ti, To, Tc>& prob,
@@ -912,6 +1595,34 @@ rocsparselt_status getBestSolutions(const RocsparseltContractionProblem<Ti, To,
                                     _rocsparselt_matmul_config*                      configs,
                                     int*                                             foundConfigs)
 {
+    // The batches of a pointer-array problem run as strided problems of one batch
+    if(!prob.strided_batch)
+        return getBestSolutions(PointerArrayBatch(prob, 0), requestConfigs, configs, foundConfigs);
+
+    const char* missing;
+    if(!rocsparselt_device_supports(prob, &missing))
+    {
+        log_info(prob.handle, __func__, "no Tensile solution supports", missing);
+        *foundConfigs = 0;
+        return rocsparselt_status_success;
+    }
+
+    auto&                 memo = SolutionMemo::instance();
+    SolutionMemo::Key     key  = MakeSolutionKey(prob, requestConfigs);
+    SolutionMemo::Configs memoized;
+    if(memo.find(key, memoized))
+    {
+        *foundConfigs = memoized.size();
+        std::copy(memoized.begin(), memoized.end(), configs);
+        log_info(prob.handle,
+                 __func__,
+                 "solution cache hit, hits",
+                 memo.hits(),
+                 "misses",
+                 memo.misses());
+        return rocsparselt_status_success;
+    }
+
     std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblemGemm>> library;
     std::shared_ptr<hipDeviceProp_t>                                                 deviceProp;
     std::shared_ptr<Tensile::Hardware>                                               hardware;
@@ -921,15 +1632,42 @@ rocsparselt_status getBestSolutions(const RocsparseltContractionProblem<Ti, To,
 
     hardware          = Tensile::hip::GetDevice(*deviceProp);
     auto tensile_prob = ConstructTensileProblem(prob);
+
+    // With HIPSPARSELT_SOLUTION_RANKING=model, the cost model ranks all solutions
+    // instead, in the order of their index where it predicts a tie.
+    using SolutionList              = std::vector<std::shared_ptr<Tensile::ContractionSolution>>;
+    static const bool rankByModel   = rocsparselt_model_ranking_from_env();
+    auto              findSolutions = [&]() -> SolutionList {
+        if(!rankByModel)
+            return library->findTopSolutions(tensile_prob, *hardware, requestConfigs);
+
+        SolutionList all;
+        for(auto& solution : library->findAllSolutions(tensile_prob, *hardware))
+            all.push_back(solution);
+        std::sort(all.begin(), all.end(), [](auto& a, auto& b) { return a->index < b->index; });
+
+        std::vector<RocsparseltModelKernel> kernels;
+        for(auto& solution : all)
+            kernels.push_back(MakeModelKernel(*solution));
+
+        auto ranked = rocsparselt_model_rank(
+            MakeModelProblem(prob), kernels, MakeModelDevice(*deviceProp));
+
+        SolutionList top;
+        for(size_t i = 0; i < ranked.size() && i < static_cast<size_t>(requestConfigs); i++)
+            top.push_back(all[ranked[i]]);
+        return top;
+    };
+
     // auto handle = prob.handle;
-    auto solutions = library->findTopSolutions(tensile_prob, *hardware, requestConfigs);
+    auto solutions = findSolutions();
 
     *foundConfigs = std::min((int)solutions.size(), requestConfigs);
 
     // Finding alternative solutions.
     auto findAlternativeSolution = [&](int useBias, int useScaleAlphaVec) {
         tensile_prob  = ConstructTensileProblem(prob, useBias, useScaleAlphaVec);
-        solutions     = library->findTopSolutions(tensile_prob, *hardware, requestConfigs);
+        solutions     = findSolutions();
         *foundConfigs = std::min((int)solutions.size(), requestConfigs);
     };
 
@@ -963,6 +1701,37 @@ rocsparselt_status getBestSolutions(const RocsparseltContractionProblem<Ti, To,
         }
     }
 
+    // findTopSolutions ranks by predicted throughput and seldom returns split-K
+    // kernels, which pay off when M * N is too small to fill the device. Add the
+    // lowest indexed solution of each other GlobalSplitU, so that the search and
+    // rocsparselt_matmul_split_k can reach them.
+    if(*foundConfigs > 0)
+    {
+        std::set<size_t> splitFactors;
+        for(size_t i = 0; i < *foundConfigs; i++)
+            splitFactors.insert(solutions[i]->sizeMapping.globalSplitU);
+
+        std::map<size_t, std::shared_ptr<Tensile::ContractionSolution>> splitSolutions;
+        for(auto& solution : library->findAllSolutions(tensile_prob, *hardware))
+        {
+            size_t gsu = solution->sizeMapping.globalSplitU;
+            if(splitFactors.count(gsu))
+                continue;
+            auto& best = splitSolutions[gsu];
+            if(!best || solution->index < best->index)
+                best = solution;
+        }
+
+        solutions.resize(*foundConfigs);
+        for(auto& split : splitSolutions)
+        {
+            if(solutions.size() >= 2 * static_cast<size_t>(requestConfigs))
+                break;
+            solutions.push_back(split.second);
+        }
+        *foundConfigs = solutions.size();
+    }
+
     for(size_t i = 0; i < *foundConfigs; i++)
     {
         auto solution                  = solutions[i];
@@ -970,7 +1739,11 @@ rocsparselt_status getBestSolutions(const RocsparseltContractionProblem<Ti, To,
         configs[i].max_workspace_bytes = solution->requiredWorkspaceSize(tensile_prob, *hardware);
         configs[i].use_bias            = tensile_prob.useBias();
         configs[i].use_scale_alpha_vec = tensile_prob.useScaleAlphaVec();
+        configs[i].split_k             = solution->sizeMapping.globalSplitU;
+        configs[i].global_accumulation = solution->sizeMapping.globalAccumulation;
     }
+
+    memo.insert(key, SolutionMemo::Configs(configs, configs + *foundConfigs));
     return rocsparselt_status_success;
 }
 
@@ -983,6 +1756,25 @@ extern "C" void rocsparselt_initialize()
     get_library_and_adapter();
 }
 
+/******************************************************************************
+ * Path of the loaded Tensile library, used to key the tuning database        *
+ ******************************************************************************/
+std::string rocsparselt_internal_get_library_path()
+{
+    get_library_and_adapter();
+    return tensile_library_path;
+}
+
+/******************************************************************************
+ * Hit and miss counters of the getBestSolutions() solution cache             *
+ ******************************************************************************/
+void rocsparselt_internal_solution_cache_counters(uint64_t* hits, uint64_t* misses)
+{
+    auto& memo = SolutionMemo::instance();
+    *hits      = memo.hits();
+    *misses    = memo.misses();
+}
+
 /***********************************************************************************
  * Whether Tensile has been initialized for at least one device (used for testing) *
  ***********************************************************************************/
@@ -1001,6 +1793,7 @@ std::atomic_bool& rocsparselt_internal_tensile_is_initialized()
     template rocsparselt_status runContractionProblem<Ti, To, Tc>( \
         const RocsparseltContractionProblem<Ti, To, Tc>&,          \
         _rocsparselt_matmul_config*,                               \
+        _rocsparselt_matmul_launch_cache*,                         \
         int*,                                                      \
         const int,                                                 \
         const int);                                                \
@@ -1008,9 +1801,21 @@ std::atomic_bool& rocsparselt_internal_tensile_is_initialized()
         const RocsparseltContractionProblem<Ti, To, Tc>&, int, _rocsparselt_matmul_config*, int*);
 
 GENERATE_DEFINITIONS(__half, __half, float)
+GENERATE_DEFINITIONS(__half, int8_t, float)
+GENERATE_DEFINITIONS(__half, hipsparselt_f8, float)
+GENERATE_DEFINITIONS(__half, hipsparselt_bf8, float)
 GENERATE_DEFINITIONS(hip_bfloat16, hip_bfloat16, float)
+GENERATE_DEFINITIONS(hip_bfloat16, int8_t, float)
+GENERATE_DEFINITIONS(hip_bfloat16, hipsparselt_f8, float)
+GENERATE_DEFINITIONS(hip_bfloat16, hipsparselt_bf8, float)
 GENERATE_DEFINITIONS(int8_t, int8_t, float)
 GENERATE_DEFINITIONS(int8_t, __half, float)
 GENERATE_DEFINITIONS(int8_t, hip_bfloat16, float)
+GENERATE_DEFINITIONS(hipsparselt_f8, __half, float)
+GENERATE_DEFINITIONS(hipsparselt_f8, hip_bfloat16, float)
+GENERATE_DEFINITIONS(hipsparselt_f8, float, float)
+GENERATE_DEFINITIONS(hipsparselt_bf8, __half, float)
+GENERATE_DEFINITIONS(hipsparselt_bf8, hip_bfloat16, float)
+GENERATE_DEFINITIONS(hipsparselt_bf8, float, float)
 
 #undef GENERATE_DEFINITIONS
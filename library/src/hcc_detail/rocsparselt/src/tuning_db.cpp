@@ -0,0 +1,306 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "tuning_db.hpp"
+#include "hipsparselt_ostream.hpp"
+#include "utility.hpp"
+#include <hipsparselt/hipsparselt-version.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr char     TuningDbMagic[8]  = {'R', 'S', 'L', 'T', 'T', 'U', 'N', 'E'};
+    constexpr uint32_t TuningDbVersion   = 1;
+    constexpr uint32_t TuningRecordMagic = 0x52535452; // "RTSR"
+
+    struct TuningDbHeader
+    {
+        char     magic[8];
+        uint32_t version;
+        uint32_t record_size;
+    };
+
+    /***************************************************************************
+     * A tuning record. Every field before config_max_id is part of the key.  *
+     ***************************************************************************/
+    struct TuningRecord
+    {
+        uint32_t magic;
+        uint32_t checksum; // of all bytes following this field
+        uint64_t library_hash;
+        char     arch[32];
+        int32_t  type_a;
+        int32_t  type_b;
+        int32_t  type_c;
+        int32_t  type_d;
+        int32_t  compute_type;
+        int32_t  op_a;
+        int32_t  op_b;
+        int32_t  order;
+        int32_t  sparse_a;
+        int32_t  activation;
+        int32_t  bias;
+        int32_t  bias_type;
+        int32_t  alpha_vector_scaling;
+        int32_t  beta_vector_scaling;
+        int32_t  pointer_array_batch; // was padding, 0 in older records
+        int64_t  m;
+        int64_t  n;
+        int64_t  k;
+        int64_t  batch;
+        // value
+        int32_t config_max_id;
+        int32_t config_id;
+        int32_t solution_index;
+        int32_t padding;
+    };
+
+    static_assert(sizeof(TuningRecord) % 8 == 0, "TuningRecord must be 8-byte aligned");
+
+    uint64_t fnv1a(const void* data, size_t size, uint64_t hash = 0xcbf29ce484222325ull)
+    {
+        auto bytes = static_cast<const uint8_t*>(data);
+        for(size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    uint32_t recordChecksum(const TuningRecord& record)
+    {
+        constexpr size_t begin = offsetof(TuningRecord, library_hash);
+        return static_cast<uint32_t>(
+            fnv1a(reinterpret_cast<const uint8_t*>(&record) + begin, sizeof(record) - begin));
+    }
+
+    const char* tuningDbPath()
+    {
+        const char* path = getenv("ROCSPARSELT_TUNING_DB");
+        return path && *path ? path : nullptr;
+    }
+
+    // Hash of the library version and the loaded kernel library file
+    uint64_t libraryHash()
+    {
+        std::string library = rocsparselt_internal_get_library_path();
+        std::string id      = std::to_string(hipsparseltVersionMajor) + "."
+                         + std::to_string(hipsparseltVersionMinor) + "."
+                         + std::to_string(hipsparseltVersionPatch) + ":" + library;
+#ifndef WIN32
+        struct stat st;
+        if(stat(library.c_str(), &st) == 0)
+            id += ":" + std::to_string(st.st_size) + ":" + std::to_string(st.st_mtime);
+#endif
+        return fnv1a(id.data(), id.size());
+    }
+
+    // Fill the key fields of a record from a plan
+    TuningRecord makeKey(const _rocsparselt_matmul_plan* plan)
+    {
+        const _rocsparselt_matmul_descr* descr = plan->matmul_descr;
+
+        TuningRecord record;
+        memset(&record, 0, sizeof(record));
+        record.magic        = TuningRecordMagic;
+        record.library_hash = libraryHash();
+
+        // strip out xnack/ecc from name
+        std::string arch(plan->handle->properties.gcnArchName);
+        arch = arch.substr(0, arch.find(":"));
+        strncpy(record.arch, arch.c_str(), sizeof(record.arch) - 1);
+
+        record.type_a               = descr->matrix_A->type;
+        record.type_b               = descr->matrix_B->type;
+        record.type_c               = descr->matrix_C->type;
+        record.type_d               = descr->matrix_D->type;
+        record.compute_type         = descr->compute_type;
+        record.op_a                 = descr->op_A;
+        record.op_b                 = descr->op_B;
+        record.order                = descr->matrix_D->order;
+        record.sparse_a             = descr->is_sparse_a;
+        record.activation           = descr->activation;
+        record.bias                 = descr->bias_pointer != nullptr;
+        record.bias_type            = record.bias ? descr->bias_type : 0;
+        record.alpha_vector_scaling = descr->alpha_vector_scaling;
+        record.beta_vector_scaling  = descr->beta_vector_scaling;
+        record.pointer_array_batch  = descr->pointer_array_batch;
+        record.m                    = descr->m;
+        record.n                    = descr->n;
+        record.k                    = descr->k;
+        record.batch                = descr->matrix_A->num_batches;
+        return record;
+    }
+
+    bool sameKey(const TuningRecord& lhs, const TuningRecord& rhs)
+    {
+        return memcmp(&lhs.library_hash,
+                      &rhs.library_hash,
+                      offsetof(TuningRecord, config_max_id) - offsetof(TuningRecord, library_hash))
+               == 0;
+    }
+} // namespace
+
+bool rocsparselt_tuning_db_lookup(const _rocsparselt_matmul_plan* plan, int* config_id)
+{
+#ifdef WIN32
+    return false;
+#else
+    const char* path = tuningDbPath();
+    if(!path)
+        return false;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if(fd < 0)
+        return false;
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(TuningDbHeader)))
+    {
+        close(fd);
+        return false;
+    }
+
+    size_t size = st.st_size;
+    void*  data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(data == MAP_FAILED)
+        return false;
+
+    auto header = static_cast<const TuningDbHeader*>(data);
+    bool found  = false;
+    if(memcmp(header->magic, TuningDbMagic, sizeof(TuningDbMagic)) == 0
+       && header->version == TuningDbVersion && header->record_size == sizeof(TuningRecord))
+    {
+        TuningRecord key   = makeKey(plan);
+        TuningRecord match = {};
+
+        auto bytes = static_cast<const uint8_t*>(data);
+        for(size_t offset = sizeof(TuningDbHeader); offset + sizeof(TuningRecord) <= size;
+            offset += sizeof(TuningRecord))
+        {
+            TuningRecord record;
+            memcpy(&record, bytes + offset, sizeof(record));
+            if(record.magic != TuningRecordMagic || record.checksum != recordChecksum(record))
+                continue;
+            if(sameKey(record, key))
+            {
+                match = record;
+                found = true;
+            }
+        }
+
+        // The record is only valid for the same set of configs
+        const _rocsparselt_matmul_alg_selection* alg = plan->alg_selection;
+        if(found
+           && (match.config_max_id != alg->config_max_id || match.config_id < 0
+               || match.config_id >= alg->config_max_id
+               || alg->configs[match.config_id].index != match.solution_index))
+        {
+            log_info(plan->handle, __func__, "tuning record is stale, path", path);
+            found = false;
+        }
+
+        if(found)
+            *config_id = match.config_id;
+    }
+    munmap(data, size);
+    return found;
+#endif
+}
+
+void rocsparselt_tuning_db_store(const _rocsparselt_matmul_plan* plan, int config_id)
+{
+#ifndef WIN32
+    const char* path = tuningDbPath();
+    if(!path)
+        return;
+
+    TuningRecord record   = makeKey(plan);
+    record.config_max_id  = plan->alg_selection->config_max_id;
+    record.config_id      = config_id;
+    record.solution_index = plan->alg_selection->configs[config_id].index;
+    record.checksum       = recordChecksum(record);
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if(fd < 0)
+    {
+        log_error(plan->handle, __func__, "cannot open tuning database", path);
+        return;
+    }
+
+    // Writers are serialized; readers rely on the records being append-only
+    flock(fd, LOCK_EX);
+
+    std::vector<uint8_t> buffer;
+    struct stat          st;
+    if(fstat(fd, &st) == 0)
+    {
+        size_t size = st.st_size;
+        if(size < sizeof(TuningDbHeader))
+        {
+            // new database, or one whose header was only partially written
+            if(size && ftruncate(fd, 0) != 0)
+                log_error(plan->handle, __func__, "cannot truncate tuning database", path);
+            TuningDbHeader header;
+            memcpy(header.magic, TuningDbMagic, sizeof(TuningDbMagic));
+            header.version     = TuningDbVersion;
+            header.record_size = sizeof(TuningRecord);
+            buffer.insert(buffer.end(),
+                          reinterpret_cast<const uint8_t*>(&header),
+                          reinterpret_cast<const uint8_t*>(&header) + sizeof(header));
+        }
+        else if(size_t torn = (size - sizeof(TuningDbHeader)) % sizeof(TuningRecord))
+        {
+            // realign after a record which was only partially written
+            buffer.resize(sizeof(TuningRecord) - torn, 0);
+        }
+
+        buffer.insert(buffer.end(),
+                      reinterpret_cast<const uint8_t*>(&record),
+                      reinterpret_cast<const uint8_t*>(&record) + sizeof(record));
+        if(write(fd, buffer.data(), buffer.size()) != static_cast<ssize_t>(buffer.size()))
+            log_error(plan->handle, __func__, "cannot write tuning database", path);
+    }
+
+    flock(fd, LOCK_UN);
+    close(fd);
+#endif
+}
@@ -58,6 +58,8 @@ const char* hipDataType_to_string(hipDataType type)
         return "f32_r";
     case HIP_R_8I:
         return "i8_r";
+    case HIP_R_4I:
+        return "i4_r";
     case HIP_R_16BF:
         return "bf16_r";
     case HIP_R_8F_E4M3_FNUZ:
@@ -163,6 +165,10 @@ const char* rocsparselt_activation_type_to_string(rocsparselt_matmul_descr_attri
         return "sigmoid";
     case rocsparselt_matmul_activation_tanh:
         return "tanh";
+    case rocsparselt_matmul_activation_silu:
+        return "silu";
+    case rocsparselt_matmul_activation_hardswish:
+        return "hardswish";
     default:
         return "none";
     }
@@ -24,12 +24,27 @@
  *
  *******************************************************************************/
 
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
 using namespace std;
 
-void bin_2_hex(string infilename, ofstream* outfile, string dataname)
+// Code objects are placed in the blob at this alignment so that
+// hipModuleLoadData can read their ELF headers in place.
+constexpr size_t kernel_alignment = 16;
+
+struct kernel_entry
+{
+    string name;
+    size_t offset;
+    size_t length;
+};
+
+kernel_entry bin_2_hex(string infilename, ofstream* outfile, string dataname, size_t* offset)
 {
     ifstream infile;
     infile.open(infilename, ios_base::binary);
@@ -39,30 +54,24 @@ void bin_2_hex(string infilename, ofstream* outfile, string dataname)
         exit(-1);
     }
 
-    char          readByte;
-    unsigned char readByte2;
-    int           cnt = 0;
+    vector<unsigned char> bytes((istreambuf_iterator<char>(infile)), istreambuf_iterator<char>());
+    infile.close();
 
-    *outfile << "{ \"" << dataname.substr(0, dataname.length() - 3) << "\", " << endl;
-    *outfile << "{ " << endl;
+    size_t padding = (kernel_alignment - *offset % kernel_alignment) % kernel_alignment;
+    for(size_t cnt = 0; cnt < padding; cnt++)
+        *outfile << " 0x00,";
 
-    while(!infile.eof())
+    kernel_entry entry{dataname.substr(0, dataname.length() - 3), *offset + padding, bytes.size()};
+
+    for(size_t cnt = 0; cnt < bytes.size(); cnt++)
     {
         if(cnt % 16 == 0)
-        {
-            *outfile << " " << endl;
-            *outfile << "   ";
-        }
-        infile.get(readByte);
-        readByte2 = (unsigned char)readByte;
-        cnt++;
-        *outfile << "0x" << setfill('0') << setw(2);
-        *outfile << hex << (unsigned int)readByte2;
-        *outfile << ",";
+            *outfile << "\n   ";
+        *outfile << " 0x" << setfill('0') << setw(2) << hex << (unsigned int)bytes[cnt] << ",";
     }
-
-    *outfile << "\n}}, \n";
-    infile.close();
+    *outfile << dec;
+    *offset = entry.offset + entry.length;
+    return entry;
 }
 
 std::string get_kernel_name(char* filename)
@@ -91,23 +100,52 @@ int main(int argc, char** argv)
         exit(-1);
     }
 
-    //outfile << "#ifndef SPMM_KERNELS_H\n#define SPMM_KERNELS_H" << endl;
-    //outfile << "#include \"" << outfilename << ".hpp\"" << endl;
-    outfile << "#include <map>" << endl;
-    outfile << "#include <string>" << endl;
-    outfile << "#include <vector>" << endl;
-    outfile << "std::map<std::string, std::vector<unsigned char>> kernel_map = {" << endl;
+    // All code objects are emitted into one read-only blob, followed by a
+    // table of {name, offset, length} sorted by name. Both live in .rodata,
+    // so loading the library copies nothing onto the heap and the pages are
+    // shared between processes through the page cache.
+    outfile << "#include <algorithm>" << endl;
+    outfile << "#include <cstddef>" << endl;
+    outfile << "#include <cstring>" << endl;
+    outfile << "namespace {" << endl;
+    outfile << "struct kernel_entry { const char* name; size_t offset; size_t length; };" << endl;
+    outfile << "alignas(" << kernel_alignment << ") const unsigned char kernel_blob[] = {";
+
+    vector<kernel_entry> entries;
+    size_t               offset = 0;
     for(int i = 3; i < filenum; i++)
     {
-        bin_2_hex(argv[i], &outfile, get_kernel_name(argv[i]));
+        entries.push_back(bin_2_hex(argv[i], &outfile, get_kernel_name(argv[i]), &offset));
     }
+    // keep the array non-empty when no code object is given.
+    outfile << "\n    0x00,\n};" << endl;
+
+    sort(entries.begin(), entries.end(), [](kernel_entry const& a, kernel_entry const& b) {
+        return a.name < b.name;
+    });
+
+    outfile << "constexpr kernel_entry kernel_table[] = {" << endl;
+    for(auto const& entry : entries)
+        outfile << "    {\"" << entry.name << "\", " << entry.offset << ", " << entry.length
+                << "}," << endl;
+    // sentinel, keeps the table non-empty when no code object is given.
+    outfile << "    {nullptr, 0, 0}," << endl;
     outfile << "};" << endl;
+    outfile << "constexpr size_t kernel_count = " << entries.size() << ";" << endl;
+    outfile << "} // namespace" << endl;
 
-    outfile << "extern \"C\" int get_map_size() { return kernel_map.size(); }" << endl;
-    outfile << "extern \"C\" unsigned char* get_kernel_byte(const char* name) { return "
-               "kernel_map[name].data(); }"
+    outfile << "extern \"C\" int get_map_size() { return kernel_count; }" << endl;
+    outfile << "extern \"C\" const unsigned char* get_kernel_byte(const char* name)" << endl;
+    outfile << "{" << endl;
+    outfile << "    auto last = kernel_table + kernel_count;" << endl;
+    outfile << "    auto it = std::lower_bound(kernel_table, last, name," << endl;
+    outfile << "        [](kernel_entry const& e, const char* n) { return std::strcmp(e.name, n) < 0; "
+               "});"
             << endl;
-    //outfile << "#endif" << endl;
+    outfile << "    if(it == last || std::strcmp(it->name, name) != 0)" << endl;
+    outfile << "        return nullptr;" << endl;
+    outfile << "    return kernel_blob + it->offset;" << endl;
+    outfile << "}" << endl;
     outfile.close();
 
     outfile.open(hppfilename, ios_base::binary | ios_base::app);
@@ -52,6 +52,7 @@ class KernelArguments:
     Activation = False
     ActivationHPA = False
     ActivationType = ""
+    KernelId = -1
 
 def writefile(filename, kernel_maps):
     with open(filename, 'w') as f:
@@ -104,6 +105,7 @@ def writefile(filename, kernel_maps):
             f.write("    bool Activation;\n")
             f.write("    bool ActivationHPA;\n")
             f.write("    char ActivationType[32];\n")
+            f.write("    int KernelId;\n")
             f.write("};\n")
 
             f.write("std::map<std::string, std::vector<KernelParams>> kernel_params = \n{\n")
@@ -114,17 +116,22 @@ def writefile(filename, kernel_maps):
                     wg = "{} {}, {}, {}{}".format("{", ka.WorkGroup[0], ka.WorkGroup[1], ka.WorkGroup[2], "}")
                     tt = "{} {}, {}, {}{}".format("{", ka.ThreadTile[0], ka.ThreadTile[1], ka.ThreadTile[2], "}")
                     mt = "{} {}, {}, {}{}".format("{", ka.MacroTile[0], ka.MacroTile[1], ka.MacroTile[2], "}")
-                    values = "\"{}\", {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, \"{}\"".format(
+                    values = "\"{}\", {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, \"{}\", {}".format(
                             ka.SolutionNameMin, ka.DataType, ka.DestDataType, ka.ComputeDataType,
                             "true" if ka.TransposeA else "false", "true" if ka.TransposeB else "false",
                             wg, tt, mt,
                             ka.StaggerU, ka.DepthU, ka.GlobalSplitU, ka.StaggerStrideShift, ka.WorkGroupMapping, ka.PackBatchDims,
                             "true" if ka.UseInitialStridesA else "false", "true" if ka.UseInitialStridesCD else "false",
                             "true" if ka.ActivationFused else "false", 0 if not ka.GlobalAccumulation else ka.GlobalAccumulation,
-                            "true" if ka.Activation else "false", "true" if ka.ActivationHPA else "false", ka.ActivationType)
+                            "true" if ka.Activation else "false", "true" if ka.ActivationHPA else "false", ka.ActivationType,
+                            ka.KernelId)
                     f.write("{}{}{},\n".format("{", values, "}"))
                 f.write("}},\n")
             f.write("};\n")
+            f.write("extern \"C\" size_t get_kernel_total()\n")
+            f.write("{\n")
+            f.write("    return {};\n".format(sum(len(v) for v in kernel_maps.values())))
+            f.write("};\n")
             f.write("extern \"C\" KernelParams* get_kernel_params(const char* name)\n")
             f.write("{\n")
             f.write("    auto it = kernel_params.find(name);\n")
@@ -223,6 +230,14 @@ def main(args):
                     print(e)
                     return
 
+    # Number the kernels densely, so that the runtime can index its table of
+    # resolved kernel functions with KernelId instead of hashing the name.
+    kernel_id = 0
+    for key in kernel_maps.keys():
+        for ka in kernel_maps[key]:
+            ka.KernelId = kernel_id
+            kernel_id += 1
+
     writefile(filename, kernel_maps)
 
 if __name__=="__main__":
@@ -0,0 +1,110 @@
+#!/usr/bin/python
+# ########################################################################
+# Copyright (c) 2024 Advanced Micro Devices, Inc.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+# ########################################################################
+
+# Writes the tuned problem sizes of the Tensile logic files, with the solution
+# and GFLOPS recorded for each, as the rocsparselt_tuned_sizes table of
+# solution_index.hpp.
+#
+# Usage: addSolutionSizes.py --filename tuned_sizes.cpp --logic <logic dir>
+
+import sys
+import getopt
+import yaml
+import os
+
+class TunedSize:
+    Arch = ""
+    DataType = 4
+    DestDataType = 4
+    TransposeA = False
+    TransposeB = False
+    Sparse = 1
+    Size = [0, 0, 0, 0]
+    Solution = ""
+    GFlops = 0.0
+
+def writefile(filename, sizes):
+    names = sorted(set(s.Solution for s in sizes))
+    with open(filename, 'w') as f:
+        f.write("// Generated by addSolutionSizes.py from the Tensile logic files\n")
+        f.write("#include \"solution_index.hpp\"\n")
+        f.write("\n")
+        for i, name in enumerate(names):
+            f.write("static const char solution{}[] = \"{}\";\n".format(i, name))
+        f.write("\n")
+        f.write("extern const RocsparseltTunedSize rocsparselt_tuned_sizes[] = \n{\n")
+        index = {name: i for i, name in enumerate(names)}
+        for s in sizes:
+            f.write("    {}\"{}\", {}, {}, {}, {}, {}, {}, {}, {}, {}, solution{}, {}{},\n".format(
+                    "{", s.Arch, s.DataType, s.DestDataType,
+                    "true" if s.TransposeA else "false", "true" if s.TransposeB else "false",
+                    s.Sparse, s.Size[0], s.Size[1], s.Size[2], s.Size[3],
+                    index[s.Solution], repr(float(s.GFlops)), "}"))
+        f.write("};\n")
+        f.write("extern const size_t rocsparselt_tuned_sizes_count = {};\n".format(len(sizes)))
+
+def main(args):
+
+    sizes = []
+
+    (opts, rem) = getopt.getopt(args, '', ['filename=', 'logic='])
+    optDict = dict(opts)
+    filename = optDict.get('--filename', '')
+    loader = getattr(yaml, 'CSafeLoader', yaml.SafeLoader)
+
+    for root, dirs, files in sorted(os.walk(optDict.get('--logic', '.'))):
+        for file_name in sorted(files):
+            if not file_name.upper().endswith(".YAML"):
+                continue
+            with open(os.path.join(root, file_name), 'r') as f:
+                try:
+                    # [version, schedule, arch, devices, problem type, solutions,
+                    #  index order, exact logic, ...]
+                    contents = yaml.load(f, Loader=loader)
+                    problem = contents[4]
+                    solutions = {s.get('SolutionIndex'): s.get('SolutionNameMin') for s in contents[5]}
+                    for entry in contents[7]:
+                        s = TunedSize()
+                        s.Arch = contents[2]
+                        s.DataType = problem.get('DataType')
+                        s.DestDataType = problem.get('DestDataType')
+                        s.TransposeA = problem.get('TransposeA')
+                        s.TransposeB = problem.get('TransposeB')
+                        s.Sparse = problem.get('Sparse')
+                        # free index of A, free index of B, batch, summation;
+                        # leading dimensions may follow
+                        s.Size = entry[0][0:4]
+                        s.Solution = solutions[entry[1][0]]
+                        s.GFlops = entry[1][1]
+                        sizes.append(s)
+                except Exception as e:
+                    print('Failed to read file: {}'.format(file_name))
+                    print(e)
+                    return 1
+
+    writefile(filename, sizes)
+    return 0
+
+if __name__=="__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,170 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+#ifndef HIPSPARSELT_FLOAT8_HPP
+#define HIPSPARSELT_FLOAT8_HPP
+
+#include <cstdint>
+#include <hip/hip_runtime.h>
+#include <ostream>
+
+/*******************************************************************************
+ * Software 8 bit floats of the FNUZ formats of HIP_R_8F_E4M3_FNUZ and
+ * HIP_R_8F_E5M2_FNUZ: a sign, 7 - Mantissa exponent bits with a bias of
+ * 2^(exponent bits - 1), and Mantissa mantissa bits. There are no infinities
+ * and no negative zero; 0x80 is the only NaN.
+ *
+ * float converts with round to nearest even, or with stochastic rounding by
+ * encode_stochastic. Values beyond the largest finite value, infinities
+ * included, saturate to it, and NaN becomes 0x80. The
+ * conversions are bit manipulations only, so the host and device give the
+ * same results and the host can check them exhaustively.
+ *******************************************************************************/
+template <int Mantissa>
+struct hipsparselt_float8
+{
+    static constexpr int      mantissa_bits = Mantissa;
+    static constexpr int      exponent_bits = 7 - Mantissa;
+    static constexpr int      bias          = 1 << (exponent_bits - 1);
+    static constexpr uint8_t  nan_bits      = 0x80;
+    static constexpr uint8_t  max_bits      = 0x7f;
+    static constexpr uint32_t max_float_bits
+        = uint32_t((1 << exponent_bits) - 1 - bias + 127) << 23
+          | uint32_t((1 << Mantissa) - 1) << (23 - Mantissa);
+
+    uint8_t data;
+
+    hipsparselt_float8() = default;
+
+    explicit __host__ __device__ hipsparselt_float8(float v)
+        : data(encode(v))
+    {
+    }
+
+    __host__ __device__ operator float() const
+    {
+        return decode(data);
+    }
+
+    static __host__ __device__ hipsparselt_float8 from_bits(uint8_t bits)
+    {
+        hipsparselt_float8 x;
+        x.data = bits;
+        return x;
+    }
+
+    static __host__ __device__ uint8_t encode(float v)
+    {
+        return encode(v, false, 0);
+    }
+
+    // Rounds up when the dropped fraction of the unit exceeds the high bits of
+    // random, so with the probability of that fraction
+    static __host__ __device__ uint8_t encode_stochastic(float v, uint32_t random)
+    {
+        return encode(v, true, random);
+    }
+
+private:
+    static __host__ __device__ uint8_t encode(float v, bool stochastic, uint32_t random)
+    {
+        uint32_t u;
+        __builtin_memcpy(&u, &v, sizeof(u));
+        uint32_t sign = (u >> 24) & 0x80;
+        uint32_t mag  = u & 0x7fffffff;
+
+        if(mag > 0x7f800000)
+            return nan_bits;
+        if(mag >= max_float_bits)
+            return sign | max_bits;
+
+        // An exponent field below 1 is a denormal of the 8 bit format, whose
+        // unit is 2^(1 - bias - Mantissa). float denormals all round to zero.
+        int32_t  exponent = int32_t(mag >> 23) - 127 + bias;
+        uint32_t mantissa = (mag & 0x7fffff) | 0x800000;
+        uint32_t shift    = 23 - Mantissa + (exponent < 1 ? 1 - exponent : 0);
+        if((mag >> 23) == 0 || shift > 24)
+            return 0;
+
+        uint32_t bits = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1);
+        uint32_t half = 1u << (shift - 1);
+        if(exponent >= 1)
+            bits = (uint32_t(exponent) << Mantissa) | (bits & ((1u << Mantissa) - 1));
+        // A carry out of the mantissa moves to the next exponent, as it should
+        if(stochastic)
+            bits += rest > (random >> (32 - shift));
+        else
+            bits += rest > half || (rest == half && (bits & 1));
+
+        return bits == 0 ? 0 : sign | bits;
+    }
+
+public:
+    static __host__ __device__ float decode(uint8_t bits)
+    {
+        uint32_t u;
+        if(bits == nan_bits)
+            u = 0x7fc00000;
+        else if((bits & 0x7f) == 0)
+            u = 0;
+        else
+        {
+            int32_t  exponent = (bits >> Mantissa) & ((1 << exponent_bits) - 1);
+            uint32_t mantissa = bits & ((1 << Mantissa) - 1);
+            if(exponent == 0)
+            {
+                // Denormal: normalize the mantissa, which is not zero here
+                exponent = 1;
+                while(!(mantissa & (1u << Mantissa)))
+                {
+                    mantissa <<= 1;
+                    exponent--;
+                }
+                mantissa &= (1u << Mantissa) - 1;
+            }
+            u = (uint32_t(bits & 0x80) << 24) | (uint32_t(exponent - bias + 127) << 23)
+                | (mantissa << (23 - Mantissa));
+        }
+        float v;
+        __builtin_memcpy(&v, &u, sizeof(v));
+        return v;
+    }
+};
+
+// HIP_R_8F_E4M3_FNUZ, largest finite value 240
+using hipsparselt_f8 = hipsparselt_float8<3>;
+// HIP_R_8F_E5M2_FNUZ, largest finite value 57344
+using hipsparselt_bf8 = hipsparselt_float8<2>;
+
+template <int Mantissa>
+inline std::ostream& operator<<(std::ostream& os, hipsparselt_float8<Mantissa> x)
+{
+    return os << float(x);
+}
+
+#endif // HIPSPARSELT_FLOAT8_HPP
@@ -6,6 +6,7 @@
 
 #include "activation.hpp"
 #include "auxiliary.hpp"
+#include "hipsparselt_float8.hpp"
 #include <cmath>
 #include <complex>
 #include <condition_variable>
@@ -329,6 +330,13 @@ public:
         return os << float(bf16);
     }
 
+    template <int Mantissa>
+    friend hipsparselt_internal_ostream& operator<<(hipsparselt_internal_ostream& os,
+                                                    hipsparselt_float8<Mantissa>  f8)
+    {
+        return os << float(f8);
+    }
+
     // Integer output
     friend hipsparselt_internal_ostream& operator<<(hipsparselt_internal_ostream& os, int32_t x)
     {
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+#ifndef HIPSPARSELT_QUANTIZE_HPP
+#define HIPSPARSELT_QUANTIZE_HPP
+
+#include "hipsparselt_float8.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <hip/hip_runtime.h>
+
+/*******************************************************************************
+ * Quantization of D to 8 bits, see HIPSPARSELT_MATMUL_D_ROUNDING_MODE. The
+ * random bits of stochastic rounding are a hash of the seed and the position
+ * of the element in D, so a result does not depend on the order in which the
+ * tiles are computed and the clients can reproduce it.
+ *******************************************************************************/
+inline __host__ __device__ uint64_t hipsparselt_mix64(uint64_t x)
+{
+    // The finalizer of splitmix64
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// Random bits of element (row, col) of batch of the user's D
+inline __host__ __device__ uint32_t hipsparselt_rounding_bits(uint64_t seed,
+                                                              int64_t  batch,
+                                                              int64_t  row,
+                                                              int64_t  col)
+{
+    uint64_t x = hipsparselt_mix64(seed + 0x9e3779b97f4a7c15ull);
+    x          = hipsparselt_mix64(x ^ uint64_t(batch));
+    x          = hipsparselt_mix64(x ^ uint64_t(row));
+    x          = hipsparselt_mix64(x ^ uint64_t(col));
+    return uint32_t(x >> 32);
+}
+
+// Converts a float to To, rounding stochastically with random when asked.
+// 8 bit types saturate.
+template <typename To>
+struct hipsparselt_quantize
+{
+    static __host__ __device__ To round(float v, bool, uint32_t)
+    {
+        return static_cast<To>(v);
+    }
+};
+
+template <>
+struct hipsparselt_quantize<int8_t>
+{
+    static __host__ __device__ int8_t round(float v, bool stochastic, uint32_t random)
+    {
+        float r;
+        if(stochastic)
+        {
+            // Rounds up when the fraction, as 32 bits, exceeds random
+            float lo = std::floor(v);
+            r        = lo + ((v - lo) * 4294967296.f > float(random) ? 1.f : 0.f);
+        }
+        else
+            r = std::nearbyint(v);
+        return static_cast<int8_t>(std::min(127.f, std::max(-128.f, r)));
+    }
+};
+
+template <int Mantissa>
+struct hipsparselt_quantize<hipsparselt_float8<Mantissa>>
+{
+    static __host__ __device__ hipsparselt_float8<Mantissa>
+        round(float v, bool stochastic, uint32_t random)
+    {
+        using T = hipsparselt_float8<Mantissa>;
+        return stochastic ? T::from_bits(T::encode_stochastic(v, random)) : T(v);
+    }
+};
+
+#endif // HIPSPARSELT_QUANTIZE_HPP
@@ -546,6 +546,27 @@ hipsparseStatus_t hipsparseLtDestroy(const hipsparseLtHandle_t* handle)
     return hipCUSPARSEStatusToHIPStatus(cusparseLtDestroy((const cusparseLtHandle_t*)handle));
 }
 
+// cuSPARSELt always runs on the device
+hipsparseStatus_t hipsparseLtSetBackend(hipsparseLtHandle_t* handle, hipsparseLtBackend_t backend)
+{
+    if(handle == nullptr)
+        return HIPSPARSE_STATUS_INVALID_VALUE;
+    if(backend == HIPSPARSELT_BACKEND_HOST)
+        return HIPSPARSE_STATUS_NOT_SUPPORTED;
+    if(backend != HIPSPARSELT_BACKEND_DEVICE)
+        return HIPSPARSE_STATUS_INVALID_VALUE;
+    return HIPSPARSE_STATUS_SUCCESS;
+}
+
+hipsparseStatus_t hipsparseLtGetBackend(const hipsparseLtHandle_t* handle,
+                                        hipsparseLtBackend_t*      backend)
+{
+    if(handle == nullptr || backend == nullptr)
+        return HIPSPARSE_STATUS_INVALID_VALUE;
+    *backend = HIPSPARSELT_BACKEND_DEVICE;
+    return HIPSPARSE_STATUS_SUCCESS;
+}
+
 hipsparseStatus_t hipsparseLtGetVersion(const hipsparseLtHandle_t* handle, int* version)
 {
     return hipCUSPARSEStatusToHIPStatus(
@@ -811,6 +832,88 @@ hipsparseStatus_t hipsparseLtMatmulSearch(const hipsparseLtHandle_t* handle,
                                                                numStreams));
 }
 
+// cuSPARSELt has no dynamic-M descriptors, see HIPSPARSELT_MATMUL_DYNAMIC_M_MIN
+hipsparseStatus_t hipsparseLtMatmulDynamicM(const hipsparseLtHandle_t*     handle,
+                                            const hipsparseLtMatmulPlan_t* plan,
+                                            int64_t                        m,
+                                            const void*                    alpha,
+                                            const void*                    d_A,
+                                            const void*                    d_B,
+                                            const void*                    beta,
+                                            const void*                    d_C,
+                                            void*                          d_D,
+                                            void*                          workspace,
+                                            hipStream_t*                   streams,
+                                            int32_t                        numStreams)
+{
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
+// cuSPARSELt has no grouped matmul: the groups run one after the other, each
+// with its own 256-byte aligned slice of the workspace.
+hipsparseStatus_t hipsparseLtMatmulGroupedGetWorkspace(const hipsparseLtHandle_t*      handle,
+                                                       const hipsparseLtMatmulGroup_t* groups,
+                                                       int32_t                         groupCount,
+                                                       size_t* workspaceSize)
+{
+    if(groupCount < 0 || (groups == nullptr && groupCount > 0) || workspaceSize == nullptr)
+        return HIPSPARSE_STATUS_INVALID_VALUE;
+
+    *workspaceSize = 0;
+    for(int32_t i = 0; i < groupCount; i++)
+    {
+        size_t size;
+        auto   status = hipCUSPARSEStatusToHIPStatus(
+            cusparseLtMatmulGetWorkspace((const cusparseLtHandle_t*)handle,
+                                         (const cusparseLtMatmulPlan_t*)groups[i].plan,
+                                         &size));
+        if(status != HIPSPARSE_STATUS_SUCCESS)
+            return status;
+        *workspaceSize += (size + 255) / 256 * 256;
+    }
+    return HIPSPARSE_STATUS_SUCCESS;
+}
+
+hipsparseStatus_t hipsparseLtMatmulGrouped(const hipsparseLtHandle_t*      handle,
+                                           const hipsparseLtMatmulGroup_t* groups,
+                                           int32_t                         groupCount,
+                                           void*                           workspace,
+                                           hipStream_t*                    streams,
+                                           int32_t                         numStreams)
+{
+    if(groupCount < 0 || (groups == nullptr && groupCount > 0))
+        return HIPSPARSE_STATUS_INVALID_VALUE;
+
+    size_t offset = 0;
+    for(int32_t i = 0; i < groupCount; i++)
+    {
+        size_t size;
+        auto   status = hipCUSPARSEStatusToHIPStatus(
+            cusparseLtMatmulGetWorkspace((const cusparseLtHandle_t*)handle,
+                                         (const cusparseLtMatmulPlan_t*)groups[i].plan,
+                                         &size));
+        if(status != HIPSPARSE_STATUS_SUCCESS)
+            return status;
+
+        status = hipCUSPARSEStatusToHIPStatus(
+            cusparseLtMatmul((const cusparseLtHandle_t*)handle,
+                             (const cusparseLtMatmulPlan_t*)groups[i].plan,
+                             groups[i].alpha,
+                             groups[i].d_A,
+                             groups[i].d_B,
+                             groups[i].beta,
+                             groups[i].d_C,
+                             groups[i].d_D,
+                             workspace == nullptr ? nullptr : (char*)workspace + offset,
+                             streams,
+                             numStreams));
+        if(status != HIPSPARSE_STATUS_SUCCESS)
+            return status;
+        offset += (size + 255) / 256 * 256;
+    }
+    return HIPSPARSE_STATUS_SUCCESS;
+}
+
 /* helper */
 // prune
 hipsparseStatus_t hipsparseLtSpMMAPrune(const hipsparseLtHandle_t*           handle,
@@ -942,6 +1045,33 @@ hipsparseStatus_t hipsparseLtSpMMACompress2(const hipsparseLtHandle_t*        ha
                                  stream));
 }
 
+hipsparseStatus_t hipsparseLtSpMMACompressStream(const hipsparseLtHandle_t*        handle,
+                                                 const hipsparseLtMatDescriptor_t* sparseMatDescr,
+                                                 int                               isSparseA,
+                                                 hipsparseOperation_t              op,
+                                                 const hipsparseLtPruneAlg_t*      pruneAlg,
+                                                 hipsparseLtStreamReadFn_t         readDense,
+                                                 hipsparseLtStreamWriteFn_t        writeCompressed,
+                                                 void*                             userData,
+                                                 size_t                            panelBytes)
+{
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
+hipsparseStatus_t hipsparseLtSpMMACompressFile(const hipsparseLtHandle_t*        handle,
+                                               const hipsparseLtMatDescriptor_t* sparseMatDescr,
+                                               int                               isSparseA,
+                                               hipsparseOperation_t              op,
+                                               const hipsparseLtPruneAlg_t*      pruneAlg,
+                                               int                               denseFd,
+                                               int64_t                           denseOffset,
+                                               int                               compressedFd,
+                                               int64_t                           compressedOffset,
+                                               size_t                            panelBytes)
+{
+    return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
 void hipsparseLtInitialize() {}
 
 hipsparseStatus_t hipsparseLtGetGitRevision(hipsparseLtHandle_t handle, char* rev)